@@ -0,0 +1,239 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "BenchSystem.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "mpi.hpp"
+#include "System.hpp"
+#include "Particle.hpp"
+#include "VerletList.hpp"
+#include "FixedPairList.hpp"
+#include "esutil/RNG.hpp"
+#include "bc/OrthorhombicBC.hpp"
+#include "storage/DomainDecomposition.hpp"
+#include "integrator/VelocityVerletLE.hpp"
+#include "interaction/LennardJones.hpp"
+#include "interaction/VerletListInteractionTemplate.hpp"
+#include "interaction/FENE.hpp"
+#include "interaction/FixedPairListInteractionTemplate.hpp"
+#include "interaction/CoulombRSpace.hpp"
+#include "interaction/CoulombKSpaceSPME.hpp"
+#include "interaction/CellListAllParticlesInteractionTemplate.hpp"
+
+namespace espressopp
+{
+namespace bench
+{
+using namespace interaction;
+
+namespace
+{
+const real skin = 0.3;
+const real wcaCutoff = 1.122462048309373;  // 2^(1/6)
+
+/** lattice sites in serpentine order, consecutive sites are nearest neighbours */
+std::vector<Int3D> serpentineLattice(int n)
+{
+    std::vector<Int3D> sites;
+    sites.reserve(static_cast<size_t>(n) * n * n);
+    for (int z = 0; z < n; z++)
+    {
+        for (int yy = 0; yy < n; yy++)
+        {
+            int y = (z % 2 == 0) ? yy : n - 1 - yy;
+            int row = z * n + yy;
+            for (int xx = 0; xx < n; xx++)
+            {
+                int x = (row % 2 == 0) ? xx : n - 1 - xx;
+                sites.push_back(Int3D(x, y, z));
+            }
+        }
+    }
+    return sites;
+}
+}  // namespace
+
+BenchSystem::Kind BenchSystem::kindFromString(const std::string& name)
+{
+    if (name == "lj") return LJFluid;
+    if (name == "melt" || name == "sheared") return Melt;
+    if (name == "charged") return Charged;
+    throw std::invalid_argument("unknown benchmark system '" + name +
+                                "', use lj, melt, sheared or charged");
+}
+
+Int3D BenchSystem::makeNodeGrid(int n, const Real3D& box)
+{
+    Int3D best(n, 1, 1);
+    real bestSurface = std::numeric_limits<real>::max();
+    for (int i = 1; i <= n; i++)
+    {
+        if (n % i) continue;
+        for (int j = 1; j <= n / i; j++)
+        {
+            if ((n / i) % j) continue;
+            int k = n / i / j;
+            real a = box[0] / i, b = box[1] / j, c = box[2] / k;
+            real surface = a * b + b * c + a * c;
+            if (surface < bestSurface)
+            {
+                bestSurface = surface;
+                best = Int3D(i, j, k);
+            }
+        }
+    }
+    return best;
+}
+
+BenchSystem::BenchSystem(
+    Kind _kind, longint _nParticles, real _shearRate, int chainLength, long seed, real dt)
+    : kind(_kind), shearRate(_shearRate)
+{
+    real density = 0.8442;
+    cutoff = 2.5;
+    if (kind == Melt)
+    {
+        density = 0.85;
+        cutoff = wcaCutoff;
+    }
+    else if (kind == Charged)
+    {
+        density = 0.5;
+    }
+
+    int n = std::max(4, static_cast<int>(std::lround(std::cbrt(real(_nParticles)))));
+    if (kind == Charged && n % 2) n++;  // neutral
+    nParticles = static_cast<longint>(n) * n * n;
+    real a = std::cbrt(1.0 / density);
+    box = Real3D(n * a);
+
+    system = std::make_shared<System>();
+    system->rng = std::make_shared<esutil::RNG>(seed);
+    system->bc = std::make_shared<bc::OrthorhombicBC>(system->rng, box);
+    system->setSkin(skin);
+
+    nodeGrid = makeNodeGrid(system->comm->size(), box);
+    for (int d = 0; d < 3; d++)
+    {
+        cellGrid[d] = std::max(1, static_cast<int>(box[d] / (nodeGrid[d] * (cutoff + skin))));
+    }
+    if (shearRate != 0.0 && cellGrid[2] < 2)
+    {
+        std::ostringstream msg;
+        msg << "sheared systems need at least two cells along z per CPU, "
+            << "use more particles than " << _nParticles;
+        throw std::invalid_argument(msg.str());
+    }
+    storage = std::make_shared<storage::DomainDecomposition>(system, nodeGrid, cellGrid, 1);
+    system->storage = storage;
+
+    // the same configuration on every CPU, each one keeps its own particles
+    std::vector<Int3D> sites = serpentineLattice(n);
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<real> jitter(-0.05 * a, 0.05 * a);
+    std::normal_distribution<real> maxwell(0.0, 1.0);
+    std::vector<Real3D> pos(nParticles), vel(nParticles);
+    Real3D vcm(0.0);
+    for (longint i = 0; i < nParticles; i++)
+    {
+        for (int d = 0; d < 3; d++)
+        {
+            pos[i][d] = (sites[i][d] + 0.5) * a + jitter(gen);
+            vel[i][d] = maxwell(gen);
+        }
+        vcm += vel[i];
+    }
+    vcm /= nParticles;
+    for (longint i = 0; i < nParticles; i++)
+    {
+        Particle* p = storage->addParticle(i, pos[i]);
+        if (!p) continue;
+        p->mass() = 1.0;
+        p->type() = 0;
+        p->velocity() = vel[i] - vcm;
+        if (kind == Charged)
+        {
+            p->q() = ((sites[i][0] + sites[i][1] + sites[i][2]) % 2) ? -1.0 : 1.0;
+        }
+    }
+    storage->decompose();
+
+    verletList = std::make_shared<VerletList>(system, cutoff, true);
+    typedef VerletListInteractionTemplate<LennardJones> VerletListLennardJones;
+    std::shared_ptr<VerletListLennardJones> lj =
+        std::make_shared<VerletListLennardJones>(verletList);
+    lj->setPotential(0, 0, LennardJones(1.0, 1.0, kind == LJFluid ? cutoff : wcaCutoff));
+    system->addInteraction(lj);
+    interactionNames.push_back("VerletListLennardJones");
+
+    if (kind == Melt)
+    {
+        bonds = std::make_shared<FixedPairList>(storage);
+        for (longint i = 0; i + 1 < nParticles; i++)
+        {
+            if ((i + 1) % chainLength) bonds->add(i, i + 1);
+        }
+        std::shared_ptr<FENE> fene =
+            std::make_shared<FENE>(30.0, 0.0, 1.5, std::numeric_limits<real>::infinity());
+        system->addInteraction(
+            std::make_shared<FixedPairListInteractionTemplate<FENE> >(system, bonds, fene));
+        interactionNames.push_back("FixedPairListFENE");
+    }
+    else if (kind == Charged)
+    {
+        real alpha = 3.0 / cutoff;  // erfc(alpha rc) ~ 2e-5
+        typedef VerletListInteractionTemplate<CoulombRSpace> VerletListCoulombRSpace;
+        std::shared_ptr<VerletListCoulombRSpace> rspace =
+            std::make_shared<VerletListCoulombRSpace>(verletList);
+        rspace->setPotential(0, 0, CoulombRSpace(1.0, alpha, cutoff));
+        system->addInteraction(rspace);
+        interactionNames.push_back("VerletListCoulombRSpace");
+
+        Int3D mesh;
+        for (int d = 0; d < 3; d++) mesh[d] = 2 * static_cast<int>(std::ceil(box[d] / 1.2));
+        std::shared_ptr<CoulombKSpaceSPME> spme =
+            std::make_shared<CoulombKSpaceSPME>(system, 1.0, alpha, mesh, 5);
+        system->addInteraction(
+            std::make_shared<CellListAllParticlesInteractionTemplate<CoulombKSpaceSPME> >(storage,
+                                                                                          spme));
+        interactionNames.push_back("CellListCoulombKSpaceSPME");
+    }
+
+    integrator = std::make_shared<integrator::VelocityVerletLE>(system, shearRate);
+    integrator->setTimeStep(dt);
+}
+
+BenchSystem::~BenchSystem()
+{
+    // the integrator and the interactions hold references to the system
+    integrator.reset();
+    system->shortRangeInteractions.clear();
+}
+
+}  // namespace bench
+}  // namespace espressopp
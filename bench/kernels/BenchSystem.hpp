@@ -0,0 +1,106 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _BENCH_BENCHSYSTEM_HPP
+#define _BENCH_BENCHSYSTEM_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+#include "Real3D.hpp"
+#include "Int3D.hpp"
+
+namespace espressopp
+{
+class System;
+class VerletList;
+class FixedPairList;
+
+namespace storage
+{
+class DomainDecomposition;
+}
+
+namespace integrator
+{
+class VelocityVerletLE;
+}
+
+namespace bench
+{
+/** Synthetic systems for the kernel benchmarks.
+
+    The particles sit on a simple cubic lattice with a small random
+    displacement. Every CPU generates the same configuration from the seed
+    and keeps the particles of its own domain, so the setup does not
+    depend on the number of CPUs.
+
+    - LJFluid: Lennard-Jones fluid, density 0.8442, cutoff 2.5
+    - Melt: bead-spring melt (WCA + FENE), density 0.85, the chains follow
+      the lattice in a serpentine path so that all bonds start at the
+      lattice spacing
+    - Charged: NaCl-like lattice of +1/-1 charges with WCA, real space
+      Coulomb and smooth particle mesh Ewald, density 0.5
+
+    All systems are integrated with VelocityVerletLE, so a non-zero shear
+    rate gives the sheared version of any of them.
+*/
+class BenchSystem
+{
+public:
+    enum Kind
+    {
+        LJFluid,
+        Melt,
+        Charged
+    };
+
+    BenchSystem(
+        Kind kind, longint nParticles, real shearRate, int chainLength, long seed, real dt = 0.005);
+    ~BenchSystem();
+
+    static Kind kindFromString(const std::string& name);
+
+    Kind kind;
+    longint nParticles;  // actual number of particles, the cube of the lattice size
+    Real3D box;
+    real cutoff;  // largest short range cutoff
+    real shearRate;
+    Int3D nodeGrid, cellGrid;
+
+    std::shared_ptr<System> system;
+    std::shared_ptr<storage::DomainDecomposition> storage;
+    std::shared_ptr<VerletList> verletList;
+    std::shared_ptr<FixedPairList> bonds;  // only for Melt
+    std::shared_ptr<integrator::VelocityVerletLE> integrator;
+    std::vector<std::string> interactionNames;  // in the order of system->shortRangeInteractions
+
+    /** Node grid with the smallest domain surface for n CPUs */
+    static Int3D makeNodeGrid(int n, const Real3D& box);
+};
+
+}  // namespace bench
+}  // namespace espressopp
+
+#endif
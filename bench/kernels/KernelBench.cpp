@@ -0,0 +1,344 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Kernel microbenchmarks on synthetic systems, see README.
+
+  Every line of the output is one measurement: the wall time of the slowest
+  CPU divided by the total number of particles and by the number of steps
+  (or calls), in ns. Run under mpirun with different numbers of CPUs and
+  sizes to get scaling curves.
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mpi.hpp"
+#include "main/espressopp_common.hpp"
+#include "System.hpp"
+#include "VerletList.hpp"
+#include "FixedPairList.hpp"
+#include "esutil/Timer.hpp"
+#include "interaction/Interaction.hpp"
+#include "storage/DomainDecomposition.hpp"
+#include "integrator/VelocityVerletLE.hpp"
+#include "vectorization/Vectorization.hpp"
+#include "vectorization/VerletList.hpp"
+#include "vectorization/interaction/VerletListLennardJones.hpp"
+
+#include "BenchSystem.hpp"
+
+using namespace espressopp;
+using namespace espressopp::bench;
+
+namespace
+{
+struct Options
+{
+    std::vector<std::string> systems;
+    std::vector<longint> sizes;
+    std::vector<real> shearRates;
+    int steps;
+    int warmup;
+    int reps;
+    int chainLength;
+    long seed;
+
+    Options()
+        : systems({"lj", "melt", "sheared", "charged"}),
+          sizes({32000}),
+          shearRates({0.01, 0.1, 1.0}),
+          steps(200),
+          warmup(20),
+          reps(50),
+          chainLength(50),
+          seed(12345)
+    {
+    }
+};
+
+void usage()
+{
+    std::cout
+        << "usage: espp_kernel_bench [options]\n"
+        << "  --systems LIST       lj,melt,sheared,charged (default: all)\n"
+        << "  --sizes LIST         approximate numbers of particles (default: 32000)\n"
+        << "  --shear-rates LIST   shear rates of the sheared melt (default: 0.01,0.1,1.0)\n"
+        << "  --steps N            integration steps per measurement (default: 200)\n"
+        << "  --warmup N           steps before the measurement (default: 20)\n"
+        << "  --reps N             calls of the isolated kernels (default: 50)\n"
+        << "  --chain-length N     beads per chain of the melts (default: 50)\n"
+        << "  --seed N             seed of the configuration (default: 12345)\n";
+}
+
+template <class T>
+std::vector<T> splitList(const std::string& arg)
+{
+    std::vector<T> values;
+    std::istringstream in(arg);
+    std::string item;
+    while (std::getline(in, item, ','))
+    {
+        std::istringstream conv(item);
+        T value;
+        if (!(conv >> value)) throw std::invalid_argument("cannot parse '" + item + "'");
+        values.push_back(value);
+    }
+    return values;
+}
+
+Options parseOptions(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help")
+        {
+            if (mpiWorld->rank() == 0) usage();
+            finalizeMPIEnv();
+            std::exit(0);
+        }
+        if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+        std::string value = argv[++i];
+        if (arg == "--systems")
+            opt.systems = splitList<std::string>(value);
+        else if (arg == "--sizes")
+            opt.sizes = splitList<longint>(value);
+        else if (arg == "--shear-rates")
+            opt.shearRates = splitList<real>(value);
+        else if (arg == "--steps")
+            opt.steps = std::atoi(value.c_str());
+        else if (arg == "--warmup")
+            opt.warmup = std::atoi(value.c_str());
+        else if (arg == "--reps")
+            opt.reps = std::atoi(value.c_str());
+        else if (arg == "--chain-length")
+            opt.chainLength = std::atoi(value.c_str());
+        else if (arg == "--seed")
+            opt.seed = std::atol(value.c_str());
+        else
+            throw std::invalid_argument("unknown option " + arg);
+    }
+    if (opt.steps <= 0 || opt.reps <= 0 || opt.chainLength < 2)
+        throw std::invalid_argument("steps and reps must be positive, chain-length at least 2");
+    return opt;
+}
+
+/** prints the measurements of one system */
+class Report
+{
+public:
+    Report(const std::string& _system, const BenchSystem& bs)
+        : system(_system), nParticles(bs.nParticles), shearRate(bs.shearRate)
+    {
+    }
+
+    static void header()
+    {
+        if (mpiWorld->rank() != 0) return;
+        std::printf("# %-8s %9s %4s %7s  %-40s %12s\n", "system", "N", "np", "shear", "component",
+                    "ns/part/step");
+    }
+
+    /** seconds is the local time for count steps or calls */
+    void operator()(const std::string& component, real seconds, int count) const
+    {
+        real maxSeconds;
+        mpi::all_reduce(*mpiWorld, seconds, maxSeconds, mpi::maximum<real>());
+        if (mpiWorld->rank() != 0) return;
+        std::printf("  %-8s %9ld %4d %7.3g  %-40s %12.3f\n", system.c_str(),
+                    static_cast<long>(nParticles), mpiWorld->size(), shearRate, component.c_str(),
+                    1.0e9 * maxSeconds / (real(nParticles) * count));
+        std::fflush(stdout);
+    }
+
+private:
+    std::string system;
+    longint nParticles;
+    real shearRate;
+};
+
+/** local wall time of reps calls of kernel, all CPUs start together */
+template <class Kernel>
+real timeKernel(int reps, Kernel kernel)
+{
+    esutil::WallTimer timer;
+    mpiWorld->barrier();
+    timer.reset();
+    for (int i = 0; i < reps; i++) kernel();
+    return timer.getElapsedTime();
+}
+
+void benchIntegrator(BenchSystem& bs, const Report& report, const Options& opt)
+{
+    bs.integrator->run(opt.warmup);
+    mpiWorld->barrier();
+    bs.integrator->run(opt.steps);
+
+    real t[10];
+    bs.integrator->loadTimers(t);
+    report("VelocityVerletLE::run", t[0], opt.steps);
+    for (size_t i = 0; i < bs.interactionNames.size() && i < 3; i++)
+    {
+        report("  addForces " + bs.interactionNames[i], t[1 + i], opt.steps);
+    }
+    report("  updateGhosts", t[4], opt.steps);
+    report("  collectGhostForces", t[5], opt.steps);
+    report("  integrate1", t[6], opt.steps);
+    report("  integrate2", t[7], opt.steps);
+    report("  resort", t[8], opt.steps);
+    report("  other", t[9], opt.steps);
+}
+
+void benchKernels(BenchSystem& bs, const Report& report, const Options& opt)
+{
+    storage::DomainDecomposition& storage = *bs.storage;
+    const interaction::InteractionList& il = bs.system->shortRangeInteractions;
+
+    for (size_t i = 0; i < il.size(); i++)
+    {
+        report("addForces " + bs.interactionNames[i],
+               timeKernel(opt.reps, [&]() { il[i]->addForces(); }), opt.reps);
+    }
+    report("VerletList::rebuild", timeKernel(opt.reps, [&]() { bs.verletList->rebuild(); }),
+           opt.reps);
+    report("Storage::updateGhosts", timeKernel(opt.reps, [&]() { storage.updateGhosts(); }),
+           opt.reps);
+    report("Storage::collectGhostForces",
+           timeKernel(opt.reps, [&]() { storage.collectGhostForces(); }), opt.reps);
+    report("Storage::decompose (with listeners)",
+           timeKernel(opt.reps, [&]() { storage.decompose(); }), opt.reps);
+    if (bs.bonds)
+    {
+        report("FixedPairList::onParticlesChanged",
+               timeKernel(opt.reps, [&]() { bs.bonds->onParticlesChanged(); }), opt.reps);
+    }
+    if (bs.shearRate != 0.0)
+    {
+        // the cell map is left shifted, so this has to be the last kernel on this system
+        storage::Storage& base = storage;
+        int shift = 0;
+        report("Storage::remapNeighbourCells",
+               timeKernel(opt.reps, [&]() { base.remapNeighbourCells(++shift); }), opt.reps);
+        storage.decompose();
+    }
+}
+
+void benchVectorization(BenchSystem& bs, const Report& report, const Options& opt)
+{
+    namespace vec = espressopp::vectorization;
+    std::shared_ptr<vec::Vectorization> vectorization =
+        std::make_shared<vec::Vectorization>(bs.system, bs.integrator);
+    std::shared_ptr<vec::VerletList> vl =
+        std::make_shared<vec::VerletList>(bs.system, vectorization, bs.cutoff, true);
+    vec::interaction::VerletListLennardJones lj(vl);
+    lj.setPotential(0, 0, vec::interaction::LennardJones(1.0, 1.0, bs.cutoff));
+    bs.storage->decompose();  // fills the particle array
+
+    report("vectorization::VerletList::rebuild", timeKernel(opt.reps, [&]() { vl->rebuild(); }),
+           opt.reps);
+    // aftInitF and aftCalcFLocal copy positions in and forces out, as in a step
+    auto step = [&]() {
+        bs.integrator->aftInitF();
+        lj.addForces();
+        bs.integrator->aftCalcFLocal();
+    };
+    report("vectorization::VerletListLennardJones", timeKernel(opt.reps, step), opt.reps);
+    vectorization->setMixedPrecision(true);
+    vl->rebuild();  // pad the list to float lanes
+    report("vectorization::VerletListLennardJones mixed", timeKernel(opt.reps, step), opt.reps);
+    // WCA is the same kernel with the cutoff at the minimum
+    lj.setPotential(0, 0, vec::interaction::LennardJones(1.0, 1.0, std::pow(2.0, 1.0 / 6.0)));
+    report("vectorization::VerletListLennardJones WCA mixed", timeKernel(opt.reps, step),
+           opt.reps);
+    lj.setPotential(0, 0, vec::interaction::LennardJones(1.0, 1.0, bs.cutoff));
+    vectorization->setMixedPrecision(false);
+    vl->rebuild();
+
+    // the clusters are only compact with spatially sorted cells
+    bs.storage->setSpatialSort(true);
+    bs.storage->decompose();
+    vl->setClusterPairs(true);
+    report("vectorization::VerletList::rebuild cluster",
+           timeKernel(opt.reps, [&]() { vl->rebuild(); }), opt.reps);
+    report("vectorization::VerletListLennardJones cluster", timeKernel(opt.reps, step), opt.reps);
+
+    vl->disconnect();
+    vectorization->disconnect();
+}
+
+void runSystem(const std::string& name, longint size, real shearRate, const Options& opt)
+{
+    BenchSystem bs(BenchSystem::kindFromString(name), size, shearRate, opt.chainLength, opt.seed);
+    Report report(name, bs);
+    benchIntegrator(bs, report, opt);
+    benchKernels(bs, report, opt);
+
+    if (bs.kind == BenchSystem::LJFluid)
+    {
+        // on a fresh system, Vectorization listens to the storage from now on
+        BenchSystem fresh(BenchSystem::LJFluid, size, 0.0, opt.chainLength, opt.seed);
+        benchVectorization(fresh, report, opt);
+    }
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    initMPIEnv(argc, argv);
+    int status = 0;
+    try
+    {
+        Options opt = parseOptions(argc, argv);
+        Report::header();
+        for (size_t s = 0; s < opt.systems.size(); s++)
+        {
+            for (size_t n = 0; n < opt.sizes.size(); n++)
+            {
+                if (opt.systems[s] == "sheared")
+                {
+                    for (size_t r = 0; r < opt.shearRates.size(); r++)
+                    {
+                        runSystem(opt.systems[s], opt.sizes[n], opt.shearRates[r], opt);
+                    }
+                }
+                else
+                {
+                    runSystem(opt.systems[s], opt.sizes[n], 0.0, opt);
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        if (mpiWorld->rank() == 0) std::cerr << "espp_kernel_bench: " << e.what() << "\n";
+        status = 1;
+    }
+    finalizeMPIEnv();
+    return status;
+}
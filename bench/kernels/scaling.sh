@@ -0,0 +1,20 @@
+#!/bin/sh
+# Scaling curves of the kernel benchmarks on one machine.
+#
+#   ./scaling.sh <build dir> [max CPUs] [sizes] [further options]
+#
+# runs espp_kernel_bench with 1, 2, 4, ... CPUs up to max CPUs (default: all
+# cores) and writes all measurements to kernel_bench_<np>.dat
+
+BUILD=${1:?usage: scaling.sh <build dir> [max CPUs] [sizes] [options]}
+MAXNP=${2:-$(nproc)}
+SIZES=${3:-4000,32000,256000}
+shift $(($# < 3 ? $# : 3))
+
+BENCH="$BUILD/bench/kernels/espp_kernel_bench"
+NP=1
+while [ "$NP" -le "$MAXNP" ]; do
+    echo "running on $NP CPUs"
+    mpirun -np "$NP" "$BENCH" --sizes "$SIZES" "$@" > "kernel_bench_$NP.dat" || exit 1
+    NP=$((NP * 2))
+done
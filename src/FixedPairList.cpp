@@ -54,6 +54,13 @@ FixedPairList::FixedPairList(std::shared_ptr<storage::Storage> _storage)
 {
     LOG4ESPP_INFO(theLogger, "construct FixedPairList");
 
+    // a bond partner below the subdomain is no ghost with eighth-shell communication
+    if (storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "FixedPairList: not available with eighth-shell ghost communication");
+    }
+
     sigBeforeSend = storage->beforeSendParticles.connect(std::bind(
         &FixedPairList::beforeSendParticles, this, std::placeholders::_1, std::placeholders::_2));
     sigAfterRecv = storage->afterRecvParticles.connect(std::bind(
@@ -276,6 +283,12 @@ void FixedPairList::onParticlesChanged()
 {
     LOG4ESPP_INFO(theLogger, "rebuild local bond list from global\n");
 
+    if (storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "FixedPairList: not available with eighth-shell ghost communication");
+    }
+
     System& system = storage->getSystemRef();
     esutil::Error err(system.comm);
 
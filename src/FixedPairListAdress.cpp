@@ -172,6 +172,12 @@ void FixedPairListAdress::beforeSendParticles(ParticleList& pl, OutBuffer& buf)
 // override parent function (use lookupAdrATParticle())
 void FixedPairListAdress::onParticlesChanged()
 {
+    if (storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "FixedPairListAdress: not available with eighth-shell ghost communication");
+    }
+
     LOG4ESPP_INFO(theLogger, "rebuild local bond list from global\n");
 
     System& system = storage->getSystemRef();
@@ -48,6 +48,13 @@ FixedQuadrupleList::FixedQuadrupleList(std::shared_ptr<storage::Storage> _storag
 {
     LOG4ESPP_INFO(theLogger, "construct FixedQuadrupleList");
 
+    // a bond partner below the subdomain is no ghost with eighth-shell communication
+    if (storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "FixedQuadrupleList: not available with eighth-shell ghost communication");
+    }
+
     sigBeforeSend = storage->beforeSendParticles.connect(
         std::bind(&FixedQuadrupleList::beforeSendParticles, this, std::placeholders::_1,
                   std::placeholders::_2));
@@ -264,6 +271,12 @@ void FixedQuadrupleList::afterRecvParticles(ParticleList &pl, InBuffer &buf)
 
 void FixedQuadrupleList::onParticlesChanged()
 {
+    if (storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "FixedQuadrupleList: not available with eighth-shell ghost communication");
+    }
+
     // (re-)generate the local quadruple list from the global list
     // printf("FixedQuadrupleList: rebuild local quadruple list from global\n");
     System &system = storage->getSystemRef();
@@ -183,6 +183,12 @@ void FixedQuadrupleListAdress::beforeSendParticles(ParticleList &pl, OutBuffer &
 
 void FixedQuadrupleListAdress::onParticlesChanged()
 {
+    if (storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "FixedQuadrupleListAdress: not available with eighth-shell ghost communication");
+    }
+
     // (re-)generate the local quadruple list from the global list
     LOG4ESPP_INFO(theLogger, "Rebuild local bond list from global\n");
 
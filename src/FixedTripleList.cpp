@@ -46,6 +46,13 @@ FixedTripleList::FixedTripleList(std::shared_ptr<storage::Storage> _storage)
 {
     LOG4ESPP_INFO(theLogger, "construct FixedTripleList");
 
+    // a bond partner below the subdomain is no ghost with eighth-shell communication
+    if (storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "FixedTripleList: not available with eighth-shell ghost communication");
+    }
+
     sigBeforeSend = storage->beforeSendParticles.connect(std::bind(
         &FixedTripleList::beforeSendParticles, this, std::placeholders::_1, std::placeholders::_2));
     sigAfterRecv = storage->afterRecvParticles.connect(std::bind(
@@ -265,6 +272,12 @@ void FixedTripleList::afterRecvParticles(ParticleList &pl, InBuffer &buf)
 
 void FixedTripleList::onParticlesChanged()
 {
+    if (storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "FixedTripleList: not available with eighth-shell ghost communication");
+    }
+
     System &system = storage->getSystemRef();
     esutil::Error err(system.comm);
 
@@ -192,6 +192,12 @@ void FixedTripleListAdress::beforeSendParticles(ParticleList& pl, OutBuffer& buf
 // override parent function (use lookupAdrATParticle())
 void FixedTripleListAdress::onParticlesChanged()
 {
+    if (storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "FixedTripleListAdress: not available with eighth-shell ghost communication");
+    }
+
     LOG4ESPP_INFO(theLogger, "rebuild local bond list from global\n");
 
     System& system = storage->getSystemRef();
@@ -29,6 +29,7 @@
 //#include <algorithm>
 #include <functional>
 #include "storage/Storage.hpp"
+#include "iterator/CellListIterator.hpp"
 #include "Buffer.hpp"
 
 #include "System.hpp"
@@ -42,7 +43,7 @@ namespace espressopp
 LOG4ESPP_LOGGER(FixedTupleListAdress::theLogger, "FixedTupleListAdress");
 
 FixedTupleListAdress::FixedTupleListAdress(std::shared_ptr<storage::Storage> _storage)
-    : storage(_storage), globalTuples()
+    : storage(_storage), globalTuples(), flatTuplesValid(false)
 {
     LOG4ESPP_INFO(theLogger, "construct FixedTupleListAdress");
 
@@ -54,6 +55,9 @@ FixedTupleListAdress::FixedTupleListAdress(std::shared_ptr<storage::Storage> _st
                   std::placeholders::_2));
     sigOnTupleChanged = storage->onTuplesChanged.connect(
         std::bind(&FixedTupleListAdress::onParticlesChanged, this));
+    // the ghosts are only complete after onParticlesChanged
+    sigOnParticlesChanged = storage->onParticlesChanged.connect(
+        std::bind(&FixedTupleListAdress::invalidateFlatTuples, this));
 }
 
 FixedTupleListAdress::~FixedTupleListAdress()
@@ -62,6 +66,7 @@ FixedTupleListAdress::~FixedTupleListAdress()
     sigBeforeSend.disconnect();
     sigAfterRecv.disconnect();
     sigOnTupleChanged.disconnect();
+    sigOnParticlesChanged.disconnect();
 }
 
 bool FixedTupleListAdress::addT(tuple pids)
@@ -109,6 +114,7 @@ bool FixedTupleListAdress::addT(tuple pids)
     if (returnVal)
     {
         this->add(vp, tmp);  // add to TupleList
+        flatTuplesValid = false;
 
         // ADD THE GLOBAL PARTICLES (ids)
         globalTuples.insert(make_pair(pidK, pidstmp));
@@ -300,6 +306,7 @@ void FixedTupleListAdress::onParticlesChanged()
     LOG4ESPP_INFO(theLogger, "rebuild local particle list from global tuples\n");
 
     this->clear();
+    flatTuplesValid = false;
     // std::cout << " ---- CLEAR TUPLES ----  \n\n";
 
     Particle* vp = nullptr;
@@ -368,6 +375,30 @@ void FixedTupleListAdress::onParticlesChanged()
     // std::cout << "\n";
 }
 
+void FixedTupleListAdress::buildFlatTuples()
+{
+    flatTuples.vps.clear();
+    flatTuples.offsets.clear();
+    flatTuples.ats.clear();
+    flatTuples.missing = nullptr;
+
+    flatTuples.offsets.push_back(0);
+    CellList localCells = storage->getLocalCells();
+    for (espressopp::iterator::CellListIterator cit(localCells); !cit.isDone(); ++cit)
+    {
+        TupleList::iterator it = this->find(&(*cit));
+        if (it == this->end())
+        {
+            if (!flatTuples.missing) flatTuples.missing = &(*cit);
+            continue;
+        }
+        flatTuples.vps.push_back(&(*cit));
+        flatTuples.ats.insert(flatTuples.ats.end(), it->second.begin(), it->second.end());
+        flatTuples.offsets.push_back(flatTuples.ats.size());
+    }
+    flatTuplesValid = true;
+}
+
 /****************************************************
 ** REGISTRATION WITH PYTHON
 ****************************************************/
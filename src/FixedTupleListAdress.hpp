@@ -40,7 +40,7 @@ namespace espressopp
 class FixedTupleListAdress : public TupleList
 {
 protected:
-    boost::signals2::connection sigOnTupleChanged, sigAfterRecv, sigBeforeSend;
+    boost::signals2::connection sigOnTupleChanged, sigAfterRecv, sigBeforeSend, sigOnParticlesChanged;
     std::shared_ptr<storage::Storage> storage;
     typedef std::vector<longint> tuple;
     typedef boost::unordered_map<longint, tuple> GlobalTuples;
@@ -61,6 +61,24 @@ public:
     void afterRecvParticles(ParticleList& pl, class InBuffer& buf);
     void onParticlesChanged();
 
+    /** The tuples of all local VPs (reals and ghosts) in cell order, as one contiguous
+        block per VP: the AT particles of vps[i] are ats[offsets[i]] ... ats[offsets[i+1]-1].
+        missing is the first local particle without a tuple, if any.
+    */
+    struct FlatTuples
+    {
+        std::vector<Particle*> vps;
+        std::vector<int> offsets;
+        std::vector<Particle*> ats;
+        Particle* missing;
+    };
+    /** the flat tuples, rebuilt if the particles changed since the last call */
+    const FlatTuples& getFlatTuples()
+    {
+        if (!flatTuplesValid) buildFlatTuples();
+        return flatTuples;
+    }
+
     // int getNumPart(longint pid); // get number of particles in globalmap for given pid
 
     // This signals the AT particles to rebuild AT fixed pair, triple, quadruple bonds
@@ -73,6 +91,11 @@ public:
 private:
     tuple tmppids;
     bool addT(tuple pids);  // add tuple
+
+    FlatTuples flatTuples;
+    bool flatTuplesValid;
+    void buildFlatTuples();
+    void invalidateFlatTuples() { flatTuplesValid = false; }
     static LOG4ESPP_DECL_LOGGER(theLogger);
 };
 }  // namespace espressopp
@@ -47,6 +47,7 @@ void Particle::registerPython()
         .add_property("vradius", &Particle::getVRadius, &Particle::setVRadius)
         .add_property("imageBox", &Particle::getImageBox, &Particle::setImageBox)
         .add_property("isGhost", &Particle::getGhostStatus, &Particle::setGhostStatus)
+        .add_property("inAdrZone", &Particle::getAdrZoneStatus)
         .add_property("lambda_adr", &Particle::getLambda, &Particle::setLambda)
         .add_property("lambda_adrd", &Particle::getLambdaDeriv, &Particle::setLambdaDeriv)
         .add_property("varmass", &Particle::getVarmass, &Particle::setVarmass)
@@ -175,7 +175,7 @@ struct ParticleLocal
     // the image of the particle
     Int3D i;
     bool ghost;
-    bool dummy1;
+    bool adrZone;  // in the AdResS zone, set by VerletListAdress::rebuild()
     bool dummy2;
     bool dummy3;
 
@@ -338,6 +338,10 @@ struct Particle
     bool getGhostStatus() const { return l.ghost; }
     void setGhostStatus(const bool& gs) { l.ghost = gs; }
 
+    bool& inAdrZone() { return l.adrZone; }
+    const bool& inAdrZone() const { return l.adrZone; }
+    bool getAdrZoneStatus() const { return l.adrZone; }
+
     // weight/lambda (used in H-Adress)
     real& lambda() { return p.lambda; }
     const real& lambda() const { return p.lambda; }
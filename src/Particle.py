@@ -113,6 +113,11 @@ The Particle class. Particles are used to model atoms, coarse-grained beads, etc
 
         boolean flag to indicate whether particle is ghost particle or not
 
+.. py:data:: bool espressopp.Particle.inAdrZone
+
+        (read-only) whether the particle was within reach of an AdResS region at the
+        last rebuild of the VerletListAdress
+
 .. py:data:: Int3D espressopp.Particle.imageBox
 
         particle's image box
@@ -261,6 +266,9 @@ class ParticleLocal(object):
     @isGhost.setter
     def isGhost(self, val): self.__getTmp().isGhost = val
 
+    @property
+    def inAdrZone(self): return self.__getTmp().inAdrZone
+
     @property
     def lambda_adr(self): return self.__getTmp().lambda_adr
     @lambda_adr.setter
@@ -46,6 +46,15 @@ System::System()
     CommunicatorIsInitialized = false;
 
     maxCutoff = 0.0;
+    shearOffset = 0.0;
+    NGridSize={1,1,1};
+    ghostShift=0;
+    lebcMode = 0;
+    shearRate = 0.0;
+    irank=0;
+    dyadicP_xz=.0;
+    dyadicP_zx=.0;
+    ifViscosity=false;
 }
 
 /// \param fComm Fortran-style MPI communicator
@@ -77,12 +86,9 @@ void System::setSkin(real _skin)
     skin = _skin;
     if (storage)
     {
-        // TODO !! It may give an error for decompositions different from
-        // DomainDecomposition
-        // probably function getInt3DCellGrid() should be pure virtual in Storage
-        Int3D cellGr = storage->getInt3DCellGrid();
+        // compare with the cell size, not with the number of cells
         real cs = maxCutoff + skin;
-        if (cs > std::min(std::min(cellGr[0], cellGr[1]), cellGr[2]))
+        if (cs > storage->getMaxCellCutoff())
         {
             storage->cellAdjust();
         }
@@ -94,6 +100,7 @@ real System::getSkin() { return skin; }
 
 void System::addInteraction(std::shared_ptr<interaction::Interaction> ia)
 {
+    ia->addedToSystem();
     shortRangeInteractions.push_back(ia);
 
     // check if the cutoff of this interaction is bigger then maxCutoff
@@ -120,6 +127,7 @@ void System::removeInteraction(int i)
     size_t iIter = i;
     real maxCutoffDelete = shortRangeInteractions[iIter]->getMaxCutoff();
 
+    shortRangeInteractions[iIter]->removedFromSystem();
     shortRangeInteractions.erase(shortRangeInteractions.begin() + i);
 
     // check if the maxCutoff changed or not
@@ -213,6 +221,7 @@ void System::registerPython()
         //      .def_readwrite("shortRangeInteractions",
         //		     &System::shortRangeInteractions)
         .def_readonly("maxCutoff", &System::maxCutoff)
+        .def_readwrite("shearOffset", &System::shearOffset)
         .def("addInteraction", &System::addInteraction)
         .def("removeInteraction", &System::removeInteraction)
         .def("getInteraction", &System::getInteraction)
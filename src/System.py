@@ -40,6 +40,8 @@ class.
 * the boundary conditions `bc` for the system (e.g. OrthorhombicBC)
 * a random number generator `rng` which is for example used by a thermostat
 * the `skin` which is needed for the Verlet lists and the cell grid
+* the `shearOffset`, the x-offset of the periodic images across the z boundary
+  under Lees-Edwards conditions, updated by integrator.VelocityVerletLE
 * a list of short range interactions that apply to the system these
   interactions are added with the `addInteraction()` method of the System
 
@@ -225,7 +227,7 @@ if pmi.isController:
     class System(metaclass=pmi.Proxy):
         pmiproxydefs = dict(
           cls = 'espressopp.SystemLocal',
-          pmiproperty = ['storage', 'bc', 'rng', 'skin', 'maxCutoff', 'integrator'],
+          pmiproperty = ['storage', 'bc', 'rng', 'skin', 'maxCutoff', 'shearOffset', 'integrator'],
           pmicall = ['addInteraction','removeInteraction', 'removeInteractionByName',
                 'getInteraction', 'getNumberOfInteractions','scaleVolume', 'setTrace',
                 'getAllInteractions', 'getInteractionByName', 'getNameOfInteraction']
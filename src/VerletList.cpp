@@ -41,9 +41,13 @@ LOG4ESPP_LOGGER(VerletList::theLogger, "VerletList");
 /*-------------------------------------------------------------*/
 
 // cut is a cutoff (without skin)
-VerletList::VerletList(
-    std::shared_ptr<System> system, real _cut, bool rebuildVL, bool useBuffers, bool useSOA)
-    : SystemAccess(system), useBuffers(useBuffers), useSOA(useSOA)
+VerletList::VerletList(std::shared_ptr<System> system,
+                       real _cut,
+                       bool rebuildVL,
+                       bool useBuffers,
+                       bool useSOA,
+                       bool useCSR)
+    : SystemAccess(system), useBuffers(useBuffers), useSOA(useSOA), useCSR(useCSR)
 {
     LOG4ESPP_INFO(theLogger, "construct VerletList, cut = " << _cut);
 
@@ -81,6 +85,37 @@ void VerletList::disconnect()
     connectionResort.disconnect();
 }
 
+void VerletList::setPruneBuffer(real _pruneBuffer)
+{
+    if (_pruneBuffer < 0.0)
+    {
+        throw std::invalid_argument("VerletList: the prune buffer must not be negative");
+    }
+    if (_pruneBuffer > 0.0 && _pruneBuffer >= getSystem()->getSkin())
+    {
+        throw std::invalid_argument("VerletList: the prune buffer must be smaller than the skin");
+    }
+    pruneBuffer = _pruneBuffer;
+    rebuild();
+}
+
+void VerletList::attachPruning()
+{
+    if (pruners++ == 0) rebuild();
+}
+
+void VerletList::detachPruning()
+{
+    if (pruners > 0 && --pruners == 0) rebuild();
+}
+
+void VerletList::setUseCSR(bool _useCSR)
+{
+    if (useCSR == _useCSR) return;
+    useCSR = _useCSR;
+    rebuild();
+}
+
 /*-------------------------------------------------------------*/
 
 void VerletList::rebuild()
@@ -93,17 +128,28 @@ void VerletList::rebuild()
     cutsq = cutVerlet * cutVerlet;
 
     vlPairs.clear();
+    csrParticles.clear();
+    csrOffsets.clear();
+    csrNeighbors.clear();
+    csrPairsValid = false;
+    outerParticles.clear();
+    outerOffsets.clear();
+    outerNeighbors.clear();
+    buildingOuter = pruning();
+
+    if (!exclusionsValid) buildExclusions();
 
     if (useBuffers)
     {
-        rebuildUsingBuffers(exList.size(), useSOA);
+        rebuildUsingBuffers(!exIds.empty(), useSOA);
     }
     else
     {
         // add particles to adress zone
         CellList cl = getSystem()->storage->getRealCells();
         LOG4ESPP_DEBUG(theLogger, "local cell list size = " << cl.size());
-        for (CellListAllPairsIterator it(cl); it.isValid(); ++it)
+        for (CellListAllPairsIterator it(cl, getSystem()->storage->getGhostPairCells());
+             it.isValid(); ++it)
         {
             checkPair(*it->first, *it->second);
             LOG4ESPP_DEBUG(theLogger,
@@ -111,10 +157,113 @@ void VerletList::rebuild()
         }
     }
 
+    if (useCSR || buildingOuter)
+    {
+        csrOffsets.push_back(csrNeighbors.size());
+    }
+    if (useCSR)
+    {
+        // drop the storage of a previously expanded pair list
+        PairList().swap(vlPairs);
+    }
+    if (buildingOuter)
+    {
+        outerParticles.swap(csrParticles);
+        outerOffsets.swap(csrOffsets);
+        outerNeighbors.swap(csrNeighbors);
+        buildingOuter = false;
+    }
+
     builds++;
     timeRebuild += timer.getElapsedTime() - currTime;
+
+    if (pruning()) prune();
+
     LOG4ESPP_DEBUG(theLogger, "rebuilt VerletList (count=" << builds << "), cutsq = " << cutsq
-                                                           << " local size = " << vlPairs.size());
+                                                           << " local size = " << localSize());
+}
+
+void VerletList::prune()
+{
+    if (!pruning()) return;
+
+    real currTime = timer.getElapsedTime();
+
+    vlPairs.clear();
+    csrParticles.clear();
+    csrOffsets.clear();
+    csrNeighbors.clear();
+    csrPairsValid = false;
+
+    const real cutPrune = cut + pruneBuffer;
+    const real cutPrunesq = cutPrune * cutPrune;
+    for (size_t i = 0; i + 1 < outerOffsets.size(); ++i)
+    {
+        Particle& p1 = *outerParticles[i];
+        const Real3D pos1 = p1.position();
+        for (size_t j = outerOffsets[i]; j < outerOffsets[i + 1]; ++j)
+        {
+            Particle& p2 = *outerNeighbors[j];
+            if ((pos1 - p2.position()).sqr() <= cutPrunesq) addPair(p1, p2);
+        }
+    }
+    if (useCSR) csrOffsets.push_back(csrNeighbors.size());
+
+    // reference positions for checkPrune, the local cells are fixed until the next rebuild
+    prunePositions.clear();
+    for (Cell* cell : getSystem()->storage->getLocalCells())
+    {
+        for (Particle& p : cell->particles) prunePositions.push_back(p.position());
+    }
+
+    prunes++;
+    timeRebuild += timer.getElapsedTime() - currTime;
+    LOG4ESPP_DEBUG(theLogger, "pruned VerletList (count=" << prunes << "), outer size = "
+                                                          << outerNeighbors.size()
+                                                          << " local size = " << localSize());
+}
+
+bool VerletList::checkPrune()
+{
+    if (!pruning()) return false;
+
+    // a pair outside of cut + pruneBuffer at the last prune can only have come
+    // closer than cut if one of the two particles moved more than pruneBuffer / 2
+    const real maxSqDist = 0.25 * pruneBuffer * pruneBuffer;
+    size_t i = 0;
+    bool moved = false;
+    for (Cell* cell : getSystem()->storage->getLocalCells())
+    {
+        for (Particle& p : cell->particles)
+        {
+            if (i == prunePositions.size() || (p.position() - prunePositions[i]).sqr() > maxSqDist)
+            {
+                moved = true;
+                break;
+            }
+            ++i;
+        }
+        if (moved) break;
+    }
+    if (i != prunePositions.size()) moved = true;
+
+    if (moved) prune();
+    return moved;
+}
+
+void VerletList::expandCSR()
+{
+    vlPairs.clear();
+    vlPairs.reserve(csrNeighbors.size());
+    for (size_t i = 0; i + 1 < csrOffsets.size(); ++i)
+    {
+        Particle* p1 = csrParticles[i];
+        for (size_t j = csrOffsets[i]; j < csrOffsets[i + 1]; ++j)
+        {
+            vlPairs.add(p1, csrNeighbors[j]);
+        }
+    }
+    csrPairsValid = true;
 }
 
 /*-------------------------------------------------------------*/
@@ -123,18 +272,25 @@ template <bool USE_EXCLUSION_LIST, bool USE_SOA>
 void VerletList::_rebuildUsingBuffers()
 {
     const CellList& realCells = getSystem()->storage->getRealCells();
+    const CellList& ghostPairCells = getSystem()->storage->getGhostPairCells();
     const size_t numRealCells = realCells.size();
 
+    // real cells first, then the ghost cells that own pairs (eighth-shell only), which
+    // have no self-loop
+    std::vector<Cell*> pairCells(realCells.begin(), realCells.end());
+    pairCells.insert(pairCells.end(), ghostPairCells.begin(), ghostPairCells.end());
+    const size_t numPairCells = pairCells.size();
+
     // stores the range of neighbor particles belonging to cell i: with end=c_range[i]
     std::vector<int> c_range;
-    c_range.reserve(numRealCells);
+    c_range.reserve(numPairCells);
 
     // get the number of particles in all neighbor cells
     size_t c_reserve = 0;
-    for (size_t icell = 0; icell < numRealCells; icell++)
+    for (size_t icell = 0; icell < numPairCells; icell++)
     {
         size_t row_reserve = 0;
-        for (NeighborCellInfo& nc : realCells[icell]->neighborCells)
+        for (NeighborCellInfo& nc : pairCells[icell]->neighborCells)
         {
             if (!nc.useForAllPairs)
             {
@@ -175,10 +331,10 @@ void VerletList::_rebuildUsingBuffers()
 
     // fill buffer
     size_t ip = 0;
-    for (size_t icell = 0; icell < numRealCells; icell++)
+    for (size_t icell = 0; icell < numPairCells; icell++)
     {
         size_t end = c_range[icell];
-        for (NeighborCellInfo& nc : realCells[icell]->neighborCells)
+        for (NeighborCellInfo& nc : pairCells[icell]->neighborCells)
         {
             if (!nc.useForAllPairs)
             {
@@ -207,17 +363,18 @@ void VerletList::_rebuildUsingBuffers()
 
     // rebuild neighbor list
     size_t start = 0;
-    for (size_t icell = 0; icell < numRealCells; icell++)
+    for (size_t icell = 0; icell < numPairCells; icell++)
     {
         size_t end = c_range[icell];
-        ParticleList& particles = realCells[icell]->particles;
+        ParticleList& particles = pairCells[icell]->particles;
         size_t numParticles = particles.size();
+        const size_t selfEnd = (icell < numRealCells) ? numParticles : 0;
         for (size_t p1 = 0; p1 < numParticles; p1++)
         {
             Particle& part1 = particles[p1];
 
             // self-loop
-            for (size_t p2 = p1 + 1; p2 < numParticles; p2++)
+            for (size_t p2 = p1 + 1; p2 < selfEnd; p2++)
             {
                 Particle& part2 = particles[p2];
                 checkPair(part1, part2);
@@ -236,10 +393,12 @@ void VerletList::_rebuildUsingBuffers()
             {
                 p1_pos = part1.position();
             }
-            size_t id1;
+            // the sorted exclusions of particle 1, mostly empty
+            const longint* exBegin = nullptr;
+            const longint* exEnd = nullptr;
             if (USE_EXCLUSION_LIST)
             {
-                id1 = part1.id();
+                exclusionRange(part1.id(), exBegin, exEnd);
             }
             const size_t type1 = part1.type();
 
@@ -262,15 +421,13 @@ void VerletList::_rebuildUsingBuffers()
 
                 if (distsq > cutsq) continue;
 
-                if (USE_EXCLUSION_LIST)
+                if (USE_EXCLUSION_LIST && exBegin != exEnd)
                 {
-                    size_t const& id2 = c_id[p2];
-                    if (exList.count(std::make_pair(id1, id2)) == 1) continue;
-                    if (exList.count(std::make_pair(id2, id1)) == 1) continue;
+                    if (isExcluded(exBegin, exEnd, c_id[p2])) continue;
                 }
 
                 max_type = std::max(max_type, std::max(type1, c_type[p2]));
-                vlPairs.add(&part1, c_p[p2]);
+                addPair(part1, *c_p[p2]);
             }
         }
         start = end;
@@ -289,12 +446,17 @@ void VerletList::checkPair(Particle& pt1, Particle& pt2)
 
     if (distsq > cutsq) return;
 
-    // see if it's in the exclusion list (both directions)
-    if (exList.count(std::make_pair(pt1.id(), pt2.id())) == 1) return;
-    if (exList.count(std::make_pair(pt2.id(), pt1.id())) == 1) return;
+    // see if it's in the exclusion list, which holds both directions
+    if (!exIds.empty())
+    {
+        const longint* exBegin;
+        const longint* exEnd;
+        exclusionRange(pt1.id(), exBegin, exEnd);
+        if (isExcluded(exBegin, exEnd, pt2.id())) return;
+    }
 
     max_type = std::max(max_type, std::max(pt1.type(), pt2.type()));
-    vlPairs.add(pt1, pt2);  // add pair to Verlet List
+    addPair(pt1, pt2);  // add pair to Verlet List
 }
 
 /*-------------------------------------------------------------*/
@@ -309,28 +471,87 @@ int VerletList::totalSize() const
     return allsize;
 }
 
-int VerletList::localSize() const { return vlPairs.size(); }
+int VerletList::localSize() const { return useCSR ? csrNeighbors.size() : vlPairs.size(); }
 
 python::tuple VerletList::getPair(int i)
 {
-    if (i <= 0 || i > int_c(vlPairs.size()))
+    PairList& pairs = getPairs();
+    if (i <= 0 || i > int_c(pairs.size()))
     {
         std::cout << "ERROR VerletList pair " << i << " does not exists" << std::endl;
         return python::make_tuple();
     }
     else
     {
-        return python::make_tuple(vlPairs[i - 1].first->id(), vlPairs[i - 1].second->id());
+        return python::make_tuple(pairs[i - 1].first->id(), pairs[i - 1].second->id());
     }
 }
 
 bool VerletList::exclude(longint pid1, longint pid2)
 {
+    if (pid1 < 0 || pid2 < 0)
+    {
+        throw std::invalid_argument("VerletList: cannot exclude negative particle ids");
+    }
     exList.insert(std::make_pair(pid1, pid2));
+    exclusionsValid = false;
 
     return true;
 }
 
+void VerletList::buildExclusions()
+{
+    exOffsets.clear();
+    exIds.clear();
+    exKeys.clear();
+    if (!exList.empty())
+    {
+        std::vector<longint> keys;
+        keys.reserve(2 * exList.size());
+        for (const std::pair<longint, longint>& ex : exList)
+        {
+            keys.push_back(ex.first);
+            keys.push_back(ex.second);
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        // one row per id up to the largest one as long as that wastes little memory
+        bool dense = static_cast<size_t>(keys.back()) < 4 * keys.size();
+        auto row = [&](longint id)
+        {
+            return dense ? size_t(id)
+                         : size_t(std::lower_bound(keys.begin(), keys.end(), id) - keys.begin());
+        };
+        size_t numRows = dense ? size_t(keys.back()) + 1 : keys.size();
+
+        // count the partners of every id, both directions
+        exOffsets.assign(numRows + 1, 0);
+        for (const std::pair<longint, longint>& ex : exList)
+        {
+            exOffsets[row(ex.first) + 1]++;
+            exOffsets[row(ex.second) + 1]++;
+        }
+        for (size_t i = 1; i < exOffsets.size(); i++) exOffsets[i] += exOffsets[i - 1];
+
+        exIds.resize(exOffsets.back());
+        std::vector<size_t> fill(exOffsets.begin(), exOffsets.end() - 1);
+        for (const std::pair<longint, longint>& ex : exList)
+        {
+            exIds[fill[row(ex.first)]++] = ex.second;
+            exIds[fill[row(ex.second)]++] = ex.first;
+        }
+        // duplicates from (a, b) and (b, a) in the set do not hurt the scan
+        for (size_t i = 0; i + 1 < exOffsets.size(); i++)
+        {
+            std::sort(exIds.begin() + exOffsets[i], exIds.begin() + exOffsets[i + 1]);
+        }
+
+        if (!dense) exKeys.swap(keys);
+    }
+    exclusionsValid = true;
+}
+
 /*-------------------------------------------------------------*/
 
 VerletList::~VerletList()
@@ -368,13 +589,20 @@ void VerletList::registerPython()
 
     class_<VerletList, std::shared_ptr<VerletList> >(
         "VerletList", init<std::shared_ptr<System>, real, bool, bool, bool>())
+        .def(init<std::shared_ptr<System>, real, bool, bool, bool, bool>())
         .add_property("system", &SystemAccess::getSystem)
+        .add_property("useCSR", &VerletList::getUseCSR, &VerletList::setUseCSR)
         .add_property("builds", &VerletList::getBuilds, &VerletList::setBuilds)
+        .add_property("pruneBuffer", &VerletList::getPruneBuffer, &VerletList::setPruneBuffer)
+        .add_property("prunes", &VerletList::getPrunes)
         .def("totalSize", &VerletList::totalSize)
         .def("localSize", &VerletList::localSize)
+        .def("localOuterSize", &VerletList::localOuterSize)
         .def("getPair", &VerletList::getPair)
         .def("exclude", pyExclude)
         .def("rebuild", &VerletList::rebuild)
+        .def("prune", &VerletList::prune)
+        .def("checkPrune", &VerletList::checkPrune)
         .def("connect", &VerletList::connect)
         .def("disconnect", &VerletList::disconnect)
 
@@ -35,6 +35,7 @@
 #include "boost/signals2.hpp"
 #include "boost/unordered_set.hpp"
 #include "esutil/Array2D.hpp"
+#include <algorithm>
 
 namespace espressopp
 {
@@ -59,11 +60,28 @@ public:
                real cut,
                bool rebuildVL,
                bool useBuffers = true,
-               bool useSOA = false);
+               bool useSOA = false,
+               bool useCSR = false);
 
     ~VerletList();
 
-    PairList& getPairs() { return vlPairs; }
+    /** Get the list of pairs. With the CSR layout the pair list is only
+        expanded on demand here, after each rebuild, for code that still
+        iterates over pairs. */
+    PairList& getPairs()
+    {
+        if (useCSR && !csrPairsValid) expandCSR();
+        return vlPairs;
+    }
+
+    /** CSR layout: row i holds the neighbors csrNeighbors[csrOffsets[i]] ..
+        csrNeighbors[csrOffsets[i+1]-1] of particle csrParticles[i]. The same
+        particle may own more than one row. Only filled if getUseCSR(). */
+    bool getUseCSR() const { return useCSR; }
+    void setUseCSR(bool _useCSR);
+    const std::vector<Particle*>& getCSRParticles() const { return csrParticles; }
+    const std::vector<size_t>& getCSROffsets() const { return csrOffsets; }
+    const std::vector<Particle*>& getCSRNeighbors() const { return csrNeighbors; }
 
     python::tuple getPair(int i);
 
@@ -92,6 +110,38 @@ public:
     /** Set the number of times the Verlet list has been rebuilt */
     void setBuilds(int _builds) { builds = _builds; }
 
+    /** Dual pair list. With a prune buffer between 0 and the skin, rebuild()
+        keeps the pairs within cut + skin as the outer list and the force loops
+        only see the inner list of pairs within cut + pruneBuffer, which prune()
+        filters from the outer list. The inner list stays valid as long as no
+        local particle, real or ghost, moved more than pruneBuffer / 2 since the
+        last prune, see checkPrune(). 0 (default) disables the inner list.
+
+        The inner list is only used while an integrator::VerletListPruning
+        extension is connected, which calls checkPrune() every step; otherwise
+        the force loops see all pairs within cut + skin as usual. */
+    real getPruneBuffer() const { return pruneBuffer; }
+    void setPruneBuffer(real _pruneBuffer);
+
+    /** Called by integrator::VerletListPruning on connect and disconnect. */
+    void attachPruning();
+    void detachPruning();
+
+    /** Fill the inner list from the outer list. Only valid between two
+        rebuilds, i.e. as long as the particle pointers do not change. */
+    void prune();
+
+    /** Prune if a local particle moved more than pruneBuffer / 2 since the
+        last prune, called by integrator::VerletListPruning once the ghosts are
+        up to date. Returns true if the list was pruned. */
+    bool checkPrune();
+
+    /** Get the number of times the inner list has been pruned */
+    int getPrunes() const { return prunes; }
+
+    /** Get the number of pairs of the local outer list */
+    int localOuterSize() const { return outerNeighbors.size(); }
+
     void resetTimers();
 
     void loadTimers(real* t);
@@ -128,10 +178,96 @@ protected:
 
     bool useBuffers = false;
     bool useSOA = false;
+    bool useCSR = false;
 
     void checkPair(Particle& pt1, Particle& pt2);
+
+    /** Exclusions per particle id in the CSR layout: the partners of the id in
+        row r are exIds[exOffsets[r]] .. exIds[exOffsets[r+1]-1], sorted, in both
+        directions. The row is the id itself if the excluded ids are dense,
+        otherwise the index of the id in the sorted exKeys, so that a few large
+        ids do not cost memory up to the largest one. Rebuilt from exList before
+        the next pair search after exclude(), so that the search does a short
+        scan instead of two hash probes per pair inside the cutoff. */
+    void buildExclusions();
+
+    inline void exclusionRange(longint id, const longint*& begin, const longint*& end) const
+    {
+        size_t row = static_cast<size_t>(id);
+        if (!exKeys.empty())
+        {
+            // once per particle in the pair search, not per pair
+            auto it = std::lower_bound(exKeys.begin(), exKeys.end(), id);
+            row = (it != exKeys.end() && *it == id) ? size_t(it - exKeys.begin()) : exKeys.size();
+        }
+        if (row + 1 < exOffsets.size())
+        {
+            begin = exIds.data() + exOffsets[row];
+            end = exIds.data() + exOffsets[row + 1];
+        }
+        else
+        {
+            begin = end = nullptr;
+        }
+    }
+
+    /// a few bonded partners at most, a linear scan beats a binary search
+    static inline bool isExcluded(const longint* begin, const longint* end, longint id)
+    {
+        bool found = false;
+        for (const longint* it = begin; it != end; ++it) found |= (*it == id);
+        return found;
+    }
+
+    /// the inner list is in use
+    bool pruning() const
+    {
+        return pruners > 0 && pruneBuffer > 0.0 && cut + pruneBuffer < cutVerlet;
+    }
+
+    /// the outer list is collected in the CSR arrays and moved out after the build
+    inline void addPair(Particle& pt1, Particle& pt2)
+    {
+        if (useCSR || buildingOuter)
+        {
+            if (csrParticles.empty() || csrParticles.back() != &pt1)
+            {
+                csrParticles.push_back(&pt1);
+                csrOffsets.push_back(csrNeighbors.size());
+            }
+            csrNeighbors.push_back(&pt2);
+        }
+        else
+        {
+            vlPairs.add(&pt1, &pt2);
+        }
+    }
+
+    /// fill vlPairs from the CSR arrays
+    void expandCSR();
+
     PairList vlPairs;
+    std::vector<Particle*> csrParticles;
+    std::vector<size_t> csrOffsets;
+    std::vector<Particle*> csrNeighbors;
+    bool csrPairsValid = false;
+
+    // outer list of the dual pair list, in the CSR layout
+    std::vector<Particle*> outerParticles;
+    std::vector<size_t> outerOffsets;
+    std::vector<Particle*> outerNeighbors;
+    bool buildingOuter = false;
+    real pruneBuffer = 0.0;
+    int prunes = 0;
+    int pruners = 0;  // connected VerletListPruning extensions
+    // positions of the local cells at the last prune
+    std::vector<Real3D> prunePositions;
+
     boost::unordered_set<std::pair<longint, longint> > exList;  // exclusion list
+    std::vector<size_t> exOffsets;
+    std::vector<longint> exIds;
+    std::vector<longint> exKeys;  // sorted excluded ids, empty for the dense rows
+    bool exclusionsValid = true;
 
     size_t max_type;
     real cutsq;
@@ -142,7 +278,7 @@ protected:
     boost::signals2::connection connectionResort;
 
     esutil::WallTimer timer;
-    real timeRebuild;
+    real timeRebuild;  // includes the prunes
 
     static LOG4ESPP_DECL_LOGGER(theLogger);
 };
@@ -27,18 +27,57 @@ espressopp.VerletList
 *********************
 
 
-.. function:: espressopp.VerletList(system, cutoff, exclusionlist, useBuffers, useSOA)
+.. function:: espressopp.VerletList(system, cutoff, exclusionlist, useBuffers, useSOA, useCSR)
 
                 :param system:
                 :param cutoff:
                 :param exclusionlist: (default: [])
                 :param useBuffers: Whether particle neighbors are buffered to improve rebuild times. (default: True)
                 :param useSOA: Whether the alternative structure of arrays form is used for buffers. (default: False)
+                :param useCSR: Whether the list is stored as per-particle neighbor rows (compressed sparse rows) instead of a list of pairs. This halves the memory of the list; pairs are expanded on demand for code that still needs them. (default: False)
                 :type system:
                 :type cutoff:
                 :type exclusionlist:
                 :type useBuffers:
                 :type useSOA:
+                :type useCSR:
+
+.. attribute:: espressopp.VerletList.pruneBuffer
+
+                Dual pair list. With a value between 0 and the skin, the pairs within
+                cutoff + skin are kept as an outer list, which is only rebuilt on a resort,
+                and the interactions see an inner list of the pairs within cutoff +
+                pruneBuffer. The inner list is pruned from the outer list again whenever a
+                particle moved more than pruneBuffer / 2, see
+                :class:`espressopp.integrator.VerletListPruning`. The inner list is
+                only used while such an extension is connected. This pays off with a
+                skin larger than usual. Must be smaller than the skin, 0 (default)
+                disables the inner list.
+
+.. attribute:: espressopp.VerletList.prunes
+
+                Number of times the inner list has been pruned (read only).
+
+.. function:: espressopp.VerletList.shared(system, cutoff, exclusionlist, useBuffers, useSOA, useCSR, pruneBuffer)
+
+                Returns the Verlet list of *system* with the given *cutoff* and
+                *exclusionlist*, and creates it on the first call. Interactions that
+                take their list from here share one pair search, one rebuild per resort
+                and one pair storage per distinct (cutoff, exclusions). The layout
+                arguments and *pruneBuffer* only apply when the list is created. The
+                list lives as long as the system. A shared list cannot be changed
+                afterwards: exclude() and setting useCSR or pruneBuffer raise a
+                RuntimeError.
+
+                >>> vlLJ = espressopp.VerletList.shared(system, cutoff=rc)
+                >>> vlCoulomb = espressopp.VerletList.shared(system, cutoff=rc)
+                >>> vlLJ is vlCoulomb
+                True
+
+                Pairs of interactions on the same list can also be merged into one
+                traversal, see e.g. espressopp.interaction.VerletListLennardJonesCoulombRSpace.
+
+                :rtype: espressopp.VerletList
 
 .. function:: espressopp.VerletList.exclude(exclusionlist)
 
@@ -66,15 +105,15 @@ from espressopp.esutil import cxxinit
 class VerletListLocal(_espressopp.VerletList):
 
 
-    def __init__(self, system, cutoff, exclusionlist=[], useBuffers=True, useSOA=False):
+    def __init__(self, system, cutoff, exclusionlist=[], useBuffers=True, useSOA=False, useCSR=False):
 
         if pmi.workerIsActive():
             if (exclusionlist == []):
                 # rebuild list in constructor
-                cxxinit(self, _espressopp.VerletList, system, cutoff, True, useBuffers, useSOA)
+                cxxinit(self, _espressopp.VerletList, system, cutoff, True, useBuffers, useSOA, useCSR)
             else:
                 # do not rebuild list in constructor
-                cxxinit(self, _espressopp.VerletList, system, cutoff, False, useBuffers, useSOA)
+                cxxinit(self, _espressopp.VerletList, system, cutoff, False, useBuffers, useSOA, useCSR)
                 # add exclusions
                 for pair in exclusionlist:
                     pid1, pid2 = pair
@@ -120,7 +159,52 @@ if pmi.isController:
     class VerletList(metaclass=pmi.Proxy):
         pmiproxydefs = dict(
           cls = 'espressopp.VerletListLocal',
-          pmiproperty = [ 'builds' ],
-          pmicall = [ 'totalSize', 'exclude', 'connect', 'disconnect', 'getVerletCutoff', 'resetTimers' ],
+          pmiproperty = [ 'builds', 'prunes' ],
+          pmicall = [ 'totalSize', 'connect', 'disconnect', 'getVerletCutoff', 'resetTimers' ],
           pmiinvoke = [ 'getAllPairs','getTimers' ]
         )
+
+        # set on the lists handed out by shared(), which others may use as well
+        _shared = False
+
+        @staticmethod
+        def shared(system, cutoff, exclusionlist=[], useBuffers=True, useSOA=False, useCSR=False, pruneBuffer=0.0):
+            # kept on the system, keyed on (cutoff, exclusions)
+            lists = getattr(system, '_sharedVerletLists', None)
+            if lists is None:
+                lists = system._sharedVerletLists = {}
+            key = (float(cutoff), frozenset(frozenset(pair) for pair in exclusionlist))
+            if key not in lists:
+                vl = VerletList(system, cutoff, exclusionlist, useBuffers, useSOA, useCSR)
+                if pruneBuffer > 0.0:
+                    vl.pruneBuffer = pruneBuffer
+                vl._shared = True
+                lists[key] = vl
+            return lists[key]
+
+        def _checkNotShared(self, what):
+            if self._shared:
+                raise RuntimeError('VerletList: {} would change a shared verlet list for all its '
+                                   'users, create a separate VerletList instead'.format(what))
+
+        def exclude(self, exclusionlist):
+            self._checkNotShared('exclude')
+            return pmi.call(self.pmiobject.exclude, exclusionlist)
+
+        @property
+        def useCSR(self):
+            return self.pmiobject.useCSR
+
+        @useCSR.setter
+        def useCSR(self, value):
+            self._checkNotShared('useCSR')
+            pmi.call('espressopp.VerletListLocal.useCSR.fset', self, value)
+
+        @property
+        def pruneBuffer(self):
+            return self.pmiobject.pruneBuffer
+
+        @pruneBuffer.setter
+        def pruneBuffer(self, value):
+            self._checkNotShared('pruneBuffer')
+            pmi.call('espressopp.VerletListLocal.pruneBuffer.fset', self, value)
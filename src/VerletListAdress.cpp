@@ -31,6 +31,8 @@
 #include "iterator/CellListAllPairsIterator.hpp"
 #include "iterator/CellListIterator.hpp"
 
+#include <limits>
+
 namespace espressopp
 {
 using namespace espressopp::iterator;
@@ -56,6 +58,7 @@ VerletListAdress::VerletListAdress(
     dEx = _dEx;
     dHy = _dHy;
     adrCenterSet = false;
+    sphereAdr = false;
     real adressSize = dEx + dHy + skin;  // adress region size
     if (dEx + dHy == 0) adressSize = 0;  // 0 should be 0
     adrsq = adressSize * adressSize;
@@ -81,6 +84,7 @@ void VerletListAdress::rebuild()
 
     // get local cells
     CellList localcells = getSystem()->storage->getLocalCells();
+    indexAdrPositions();  // the box may have changed since the last update
 
     // if adrCenter is not set, the center of adress zone moves along with some particles
     if (!adrCenterSet)
@@ -88,32 +92,15 @@ void VerletListAdress::rebuild()
         // loop over all VP particles (reals and ghosts) on node
         for (CellListIterator it(localcells); it.isValid(); ++it)
         {
-            // loop over positions
-            for (std::vector<Real3D*>::iterator it2 = adrPositions.begin();
-                 it2 != adrPositions.end(); ++it2)
+            it->inAdrZone() = minAdrDistanceSqr(it->getPos()) <= adrsq;
+            // if not near enough to any adrPositions, put in cgZone
+            if (it->inAdrZone())
             {
-                Real3D dist;
-                real distsq;
-                bc.getMinimumImageVectorBox(dist, it->getPos(), **it2);
-
-                if (getAdrRegionType())
-                {  // spherical adress region
-                    distsq = dist.sqr();
-                }
-                else
-                {  // slab-type adress region
-                    distsq = dist[0] * dist[0];
-                }
-                if (distsq <= adrsq)
-                {
-                    adrZone.insert(&(*it));
-                    break;  // do not need to loop further
-                }
+                adrZone.push_back(&(*it));
             }
-            // if not near enough to any adrPositions, put in cgZone
-            if (adrZone.count(&(*it)) == 0)
+            else
             {
-                cgZone.insert(&(*it));
+                cgZone.push_back(&(*it));
             }
         }
     }
@@ -137,17 +124,25 @@ void VerletListAdress::rebuild()
             {  // slab-type adress region
                 distsq = dist[0] * dist[0];
             }
-            if (distsq <= adrsq)
+            it->inAdrZone() = distsq <= adrsq;
+            if (it->inAdrZone())
             {
-                adrZone.insert(&(*it));
+                adrZone.push_back(&(*it));
             }
             else
             {
-                cgZone.insert(&(*it));
+                cgZone.push_back(&(*it));
             }
         }
     }
 
+    // the AdResS zones and the pair split assume the full ghost frame
+    if (getSystem()->storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "VerletListAdress: not available with eighth-shell ghost communication");
+    }
+
     // add particles to adress pairs and VL
     CellList cl = getSystem()->storage->getRealCells();
     int count = 0;
@@ -177,7 +172,7 @@ void VerletListAdress::checkPair(Particle& pt1, Particle& pt2)
     if (exList.count(std::make_pair(pt1.id(), pt2.id())) == 1) return;
     if (exList.count(std::make_pair(pt2.id(), pt1.id())) == 1) return;
     // see if it's in the adress zone
-    if (adrZone.count(&pt1) == 1 || adrZone.count(&pt2) == 1)
+    if (pt1.inAdrZone() || pt2.inAdrZone())
     {
         if (distsq > adrcutsq) return;
         adrPairs.add(pt1, pt2);  // add to adress pairs
@@ -207,18 +202,119 @@ bool VerletListAdress::exclude(longint pid1, longint pid2)
     return true;
 }
 
-void VerletListAdress::addAdrParticle(longint pid) { adrList.insert(pid); }
+void VerletListAdress::addAdrParticle(longint pid)
+{
+    std::vector<longint>::iterator it = std::lower_bound(adrList.begin(), adrList.end(), pid);
+    if (it == adrList.end() || *it != pid) adrList.insert(it, pid);
+}
 
 void VerletListAdress::setAdrCenter(real x, real y, real z)
 {
     adrCenter = Real3D(x, y, z);
     adrCenterSet = true;
     adrPositions.push_back(&adrCenter);
+    indexAdrPositions();
 }
 
 Real3D VerletListAdress::getAdrCenter() { return adrCenter; }
 
-void VerletListAdress::setAdrRegionType(bool _sphereAdr) { sphereAdr = _sphereAdr; }
+/*-------------------------------------------------------------*/
+
+int VerletListAdress::adrBinIndex(const Real3D& pos, Int3D& bin) const
+{
+    Real3D boxL = getSystemRef().bc->getBoxL();
+    for (int d = 0; d < 3; d++)
+    {
+        real x = pos[d] - floor(pos[d] / boxL[d]) * boxL[d];
+        bin[d] = std::min(static_cast<int>(x * adrBinInvSize[d]), adrBins[d] - 1);
+    }
+    return bin[0] + adrBins[0] * (bin[1] + adrBins[1] * bin[2]);
+}
+
+void VerletListAdress::indexAdrPositions()
+{
+    // at most 32 bins per direction, so that rebinning stays cheap for large boxes
+    static const int maxAdrBins = 32;
+    Real3D boxL = getSystemRef().bc->getBoxL();
+    real range = getAdrRange();
+
+    for (int d = 0; d < 3; d++)
+    {
+        if (d > 0 && !getAdrRegionType())
+        {  // slab-type adress region, only x matters
+            adrBins[d] = 1;
+            adrBinInvSize[d] = 0.0;
+            continue;
+        }
+        adrBins[d] = 1;
+        if (range > 0.0) adrBins[d] = std::max(1, static_cast<int>(boxL[d] / range));
+        adrBins[d] = std::min(adrBins[d], maxAdrBins);
+        adrBinInvSize[d] = adrBins[d] / boxL[d];
+    }
+
+    adrBinStart.assign(adrBins[0] * adrBins[1] * adrBins[2] + 1, 0);
+    std::vector<int> binOf(adrPositions.size());
+    Int3D bin;
+    for (size_t i = 0; i < adrPositions.size(); i++)
+    {
+        binOf[i] = adrBinIndex(*adrPositions[i], bin);
+        adrBinStart[binOf[i] + 1]++;
+    }
+    for (size_t b = 1; b < adrBinStart.size(); b++) adrBinStart[b] += adrBinStart[b - 1];
+
+    adrBinPositions.resize(adrPositions.size());
+    std::vector<int> fill(adrBinStart.begin(), adrBinStart.end() - 1);
+    for (size_t i = 0; i < adrPositions.size(); i++)
+    {
+        adrBinPositions[fill[binOf[i]]++] = adrPositions[i];
+    }
+}
+
+real VerletListAdress::minAdrDistanceSqr(const Real3D& pos) const
+{
+    real min1sq = std::numeric_limits<real>::max();
+    if (adrBinStart.empty()) return min1sq;
+
+    const bc::BC& bc = *getSystemRef().bc;
+    Int3D bin;
+    adrBinIndex(pos, bin);
+
+    // centres within the range are in the neighbouring bins; with less than
+    // three bins along an axis all of them are neighbours
+    int lo[3], hi[3];
+    for (int d = 0; d < 3; d++)
+    {
+        lo[d] = adrBins[d] < 3 ? 0 : bin[d] - 1;
+        hi[d] = adrBins[d] < 3 ? adrBins[d] - 1 : bin[d] + 1;
+    }
+
+    for (int k = lo[2]; k <= hi[2]; k++)
+    {
+        int bz = (k + adrBins[2]) % adrBins[2];
+        for (int j = lo[1]; j <= hi[1]; j++)
+        {
+            int by = (j + adrBins[1]) % adrBins[1];
+            for (int i = lo[0]; i <= hi[0]; i++)
+            {
+                int b = (i + adrBins[0]) % adrBins[0] + adrBins[0] * (by + adrBins[1] * bz);
+                for (int n = adrBinStart[b]; n < adrBinStart[b + 1]; n++)
+                {
+                    Real3D dist;
+                    bc.getMinimumImageVectorBox(dist, pos, *adrBinPositions[n]);
+                    real distsq = sphereAdr ? dist.sqr() : dist[0] * dist[0];
+                    if (distsq < min1sq) min1sq = distsq;
+                }
+            }
+        }
+    }
+    return min1sq;
+}
+
+void VerletListAdress::setAdrRegionType(bool _sphereAdr)
+{
+    sphereAdr = _sphereAdr;
+    indexAdrPositions();
+}
 
 bool VerletListAdress::getAdrRegionType() { return sphereAdr; }
 
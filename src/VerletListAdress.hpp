@@ -24,6 +24,8 @@
 #ifndef _VERLETLISTADRESS_HPP
 #define _VERLETLISTADRESS_HPP
 
+#include <algorithm>
+#include <vector>
 #include "log4espp.hpp"
 #include "types.hpp"
 #include "Particle.hpp"
@@ -31,6 +33,7 @@
 #include "boost/signals2.hpp"
 #include "boost/unordered_set.hpp"
 #include "Real3D.hpp"
+#include "Int3D.hpp"
 
 namespace espressopp
 {
@@ -58,9 +61,14 @@ public:
 
     PairList& getPairs() { return vlPairs; }
     PairList& getAdrPairs() { return adrPairs; }
-    std::set<longint>& getAdrList() { return adrList; }
-    std::set<Particle*>& getAdrZone() { return adrZone; }
-    std::set<Particle*>& getCGZone() { return cgZone; }
+    const std::vector<longint>& getAdrList() const { return adrList; }
+    /** true if pid is one of the particles defining the center of the adress zone */
+    bool isAdrParticle(longint pid) const
+    {
+        return std::binary_search(adrList.begin(), adrList.end(), pid);
+    }
+    const std::vector<Particle*>& getAdrZone() const { return adrZone; }
+    const std::vector<Particle*>& getCGZone() const { return cgZone; }
     std::vector<Real3D*>& getAdrPositions() { return adrPositions; }
     real getHy() { return dHy; }
     real getEx() { return dEx; }
@@ -79,6 +87,14 @@ public:
     std::vector<Real3D*>
         adrPositions;  // positions of centres of adress zone (either from adrCenter in
                        // VerletListAdress.cpp or at each step from adrList in integrator/Adress.cpp
+    /** distance up to which a centre of the adress zone affects particles (dEx + dHy + skin) */
+    real getAdrRange() const { return sqrt(adrsq); }
+    /** Sort adrPositions into bins of at least getAdrRange(); has to be called
+        whenever adrPositions changed */
+    void indexAdrPositions();
+    /** squared distance from pos to the nearest centre (only x for slab-type regions),
+        or the largest real if no centre is within getAdrRange() */
+    real minAdrDistanceSqr(const Real3D& pos) const;
     void rebuild();
 
     /** Get the total number of pairs for the Verlet list */
@@ -97,9 +113,9 @@ public:
     static void registerPython();
 
 private:
-    std::set<longint> adrList;    // pids of particles defining center of adress zone, if set
-    std::set<Particle*> adrZone;  // particles that are in the AdResS zone
-    std::set<Particle*> cgZone;   // particles not in adress zone (same as in vlPairs)
+    std::vector<longint> adrList;    // sorted pids of particles defining center of adress zone
+    std::vector<Particle*> adrZone;  // particles that are in the AdResS zone, in cell order
+    std::vector<Particle*> cgZone;   // particles not in adress zone (same as in vlPairs)
     PairList adrPairs;            // pairs that are in AdResS zone
     real dEx, dHy;                // size of the expicit and hybrid zone
     real adrsq, adrcutsq, adrCutverlet, cutverlet;
@@ -109,6 +125,14 @@ private:
     bool sphereAdr;     // true: adress region is spherical centered on point x,y,z or particle pid;
                         // false: adress region is slab centered on point x or particle pid
 
+    // adrPositions binned by folded position, CSR layout
+    Int3D adrBins;                         // number of bins, 1 in y and z for slab regions
+    Real3D adrBinInvSize;                  // inverse bin size
+    std::vector<int> adrBinStart;          // first entry of every bin in adrBinPositions
+    std::vector<Real3D*> adrBinPositions;  // adrPositions ordered by bin
+
+    int adrBinIndex(const Real3D& pos, Int3D& bin) const;
+
     // size_t atType; // types above this number are considered atomistic
     // void isPairInAdrZone(Particle &pt1, Particle &pt2); // not used anymore
 
@@ -83,6 +83,13 @@ void VerletListTriple::rebuild()
 
     vlTriples.clear();
 
+    // a triple around a real particle may need ghosts from below
+    if (getSystem()->storage->getEighthShell())
+    {
+        throw std::runtime_error(
+            "VerletListTriple: not available with eighth-shell ghost communication");
+    }
+
     // add particles to adress zone
     CellList cl = getSystem()->storage->getRealCells();
     LOG4ESPP_DEBUG(theLogger, "local cell list size = " << cl.size());
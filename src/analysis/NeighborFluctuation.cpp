@@ -57,7 +57,8 @@ python::list NeighborFluctuation::computeValues() const
     myN = system.storage->getNRealParticles();
     mpi::all_reduce(*getSystem()->comm, myN, systemN, std::plus<int>());
 
-    for (CellListAllPairsIterator it(cl); it.isValid(); ++it)
+    for (CellListAllPairsIterator it(cl, getSystem()->storage->getGhostPairCells()); it.isValid();
+         ++it)
     {
         Real3D d = it->first->position() - it->second->position();
         real distsq = d.sqr();
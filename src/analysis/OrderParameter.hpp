@@ -299,7 +299,8 @@ public:
         // ------------------------------------------------------------------------------
         // create pairs
         CellList cells_real = stor->getRealCells();
-        for (CellListAllPairsIterator it(cells_real); it.isValid(); ++it)
+        for (CellListAllPairsIterator it(cells_real, stor->getGhostPairCells()); it.isValid();
+             ++it)
         {
             Real3D r = it->first->position() - it->second->position();
             real dist_sq = r.sqr();
@@ -28,6 +28,7 @@
 #include "Cell.hpp"
 #include "System.hpp"
 #include "storage/Storage.hpp"
+#include "esutil/Grid.hpp"
 #include "boost/serialization/vector.hpp"
 #include "bc/BC.hpp"
 #include "FixedTupleListAdress.hpp"
@@ -134,90 +135,69 @@ void Adress::connect()
         integrator->befIntV.connect(std::bind(&Adress::aftCalcF, this), boost::signals2::at_front);
 }
 
-void Adress::SetPosVel()
+const FixedTupleListAdress::FlatTuples& Adress::localTuples()
 {
-    System& system = getSystemRef();
+    const FixedTupleListAdress::FlatTuples& tuples = fixedtupleList->getFlatTuples();
+    if (tuples.missing)
+    {  // this should not happen
+        Particle& vp = *tuples.missing;
+        std::cout << " VP particle " << vp.id() << "-" << vp.ghost() << " not found in tuples ";
+        std::cout << " (" << vp.position() << ")\n";
+        exit(1);
+    }
+    return tuples;
+}
 
-    // Set the positions and velocity of CG particles & update weights.
-    CellList localCells = system.storage->getLocalCells();
-    for (CellListIterator cit(localCells); !cit.isDone(); ++cit)
+void Adress::setVPs(bool positions)
+{
+    // the AT particles of every VP follow it as one block
+    const FixedTupleListAdress::FlatTuples& tuples = localTuples();
+    for (size_t i = 0; i < tuples.vps.size(); i++)
     {
-        Particle& vp = *cit;
-
-        FixedTupleListAdress::iterator it3;
-        it3 = fixedtupleList->find(&vp);
+        Particle& vp = *tuples.vps[i];
 
-        if (it3 != fixedtupleList->end())
+        // Compute center of mass
+        Real3D cmp(0.0, 0.0, 0.0);  // center of mass position
+        Real3D cmv(0.0, 0.0, 0.0);  // center of mass velocity
+        for (int k = tuples.offsets[i]; k < tuples.offsets[i + 1]; k++)
         {
-            std::vector<Particle*> atList;
-            atList = it3->second;
-
-            // Compute center of mass
-            Real3D cmp(0.0, 0.0, 0.0);  // center of mass position
-            Real3D cmv(0.0, 0.0, 0.0);  // center of mass velocity
-            for (std::vector<Particle*>::iterator it2 = atList.begin(); it2 != atList.end(); ++it2)
-            {
-                Particle& at = **it2;
-                cmp += at.mass() * at.position();
-                cmv += at.mass() * at.velocity();
-            }
-            cmp /= vp.getMass();
-            cmv /= vp.getMass();
-
-            // update (overwrite) the position and velocity of the VP
-            vp.position() = cmp;
-            vp.velocity() = cmv;
-
-            if (KTI == false)
-            {
-                // calculate distance to nearest adress particle or center
-                std::vector<Real3D*>::iterator it2 = verletList->getAdrPositions().begin();
-                Real3D pa = **it2;  // position of adress particle
-                Real3D d1(0.0, 0.0, 0.0);
-                verletList->getSystem()->bc->getMinimumImageVector(d1, vp.position(), pa);
-                real min1sq;
-                if (verletList->getAdrRegionType())
-                {                       // spherical adress region
-                    min1sq = d1.sqr();  // set min1sq before loop
-                    ++it2;
-                    for (; it2 != verletList->getAdrPositions().end(); ++it2)
-                    {
-                        pa = **it2;
-                        verletList->getSystem()->bc->getMinimumImageVector(d1, vp.position(), pa);
-                        real distsq1 = d1.sqr();
-                        if (distsq1 < min1sq) min1sq = distsq1;
-                    }
-                }
-                else
-                {                            // slab-type adress region
-                    min1sq = d1[0] * d1[0];  // set min1sq before loop
-                    ++it2;
-                    for (; it2 != verletList->getAdrPositions().end(); ++it2)
-                    {
-                        pa = **it2;
-                        verletList->getSystem()->bc->getMinimumImageVector(d1, vp.position(), pa);
-                        real distsq1 = d1[0] * d1[0];
-                        if (distsq1 < min1sq) min1sq = distsq1;
-                    }
-                }
+            Particle& at = *tuples.ats[k];
+            if (positions) cmp += at.mass() * at.position();
+            cmv += at.mass() * at.velocity();
+        }
 
-                real w = weight(min1sq);
-                vp.lambda() = w;
+        // update (overwrite) the position and velocity of the VP
+        if (positions) vp.position() = cmp / vp.getMass();
+        vp.velocity() = cmv / vp.getMass();
+    }
+}
 
-                real wDeriv = weightderivative(min1sq);
-                vp.lambdaDeriv() = wDeriv;
-            }
-        }
-        else
-        {  // this should not happen
-            std::cout << " VP particle " << vp.id() << "-" << vp.ghost() << " not found in tuples ";
-            std::cout << " (" << vp.position() << ")\n";
-            exit(1);
-            return;
-        }
+void Adress::setWeights()
+{
+    const FixedTupleListAdress::FlatTuples& tuples = localTuples();
+    for (size_t i = 0; i < tuples.vps.size(); i++)
+    {
+        Particle& vp = *tuples.vps[i];
+        real min1sq = verletList->minAdrDistanceSqr(vp.position());
+        vp.lambda() = weight(min1sq);
+        vp.lambdaDeriv() = weightderivative(min1sq);
+
+        // This loop is required when applying routines which use atomistic lambdas.
+        /*for (int k = tuples.offsets[i]; k < tuples.offsets[i + 1]; k++) {
+            Particle &at = *tuples.ats[k];
+            at.lambda() = vp.lambda();
+            at.lambdaDeriv() = vp.lambdaDeriv();
+        }*/
     }
 }
 
+void Adress::SetPosVel()
+{
+    // Set the positions and velocity of CG particles & update weights.
+    setVPs(true);
+    if (KTI == false) setWeights();
+}
+
 void Adress::initForces()
 {
     System& system = getSystemRef();
@@ -267,115 +247,13 @@ void Adress::integrate1(real& maxSqDist)
     }
 
     // Set the positions and velocity of CG particles
-    CellList localCells = system.storage->getLocalCells();
-    for (CellListIterator cit(localCells); !cit.isDone(); ++cit)
-    {
-        Particle& vp = *cit;
-
-        FixedTupleListAdress::iterator it3;
-        it3 = fixedtupleList->find(&vp);
-
-        if (it3 != fixedtupleList->end())
-        {
-            std::vector<Particle*> atList;
-            atList = it3->second;
-
-            // Compute center of mass
-            Real3D cmp(0.0, 0.0, 0.0);  // center of mass position
-            Real3D cmv(0.0, 0.0, 0.0);  // center of mass velocity
-            for (std::vector<Particle*>::iterator it2 = atList.begin(); it2 != atList.end(); ++it2)
-            {
-                Particle& at = **it2;
-                cmp += at.mass() * at.position();
-                cmv += at.mass() * at.velocity();
-            }
-            cmp /= vp.getMass();
-            cmv /= vp.getMass();
-
-            // update (overwrite) the position and velocity of the VP
-            vp.position() = cmp;
-            vp.velocity() = cmv;
-        }
-        else
-        {  // this should not happen
-            std::cout << " VP particle " << vp.id() << "-" << vp.ghost() << " not found in tuples ";
-            std::cout << " (" << vp.position() << ")\n";
-            exit(1);
-            return;
-        }
-    }
+    setVPs(true);
 
     // Communicate new position of region defining particles
     communicateAdrPositions();
 
     // Update resolution values if KTI == false
-    if (KTI == false)
-    {
-        CellList localCells2 = system.storage->getLocalCells();
-        for (CellListIterator cit(localCells); !cit.isDone(); ++cit)
-        {
-            Particle& vp = *cit;
-
-            FixedTupleListAdress::iterator it3;
-            it3 = fixedtupleList->find(&vp);
-
-            if (it3 != fixedtupleList->end())
-            {
-                // calculate distance to nearest adress particle or center
-                std::vector<Real3D*>::iterator it2 = verletList->getAdrPositions().begin();
-                Real3D pa = **it2;  // position of adress particle
-                Real3D d1(0.0, 0.0, 0.0);
-                real min1sq;
-                verletList->getSystem()->bc->getMinimumImageVector(d1, vp.position(), pa);
-                if (verletList->getAdrRegionType())
-                {                       // spherical adress region
-                    min1sq = d1.sqr();  // set min1sq before loop
-                    ++it2;
-                    for (; it2 != verletList->getAdrPositions().end(); ++it2)
-                    {
-                        pa = **it2;
-                        verletList->getSystem()->bc->getMinimumImageVector(d1, vp.position(), pa);
-                        real distsq1 = d1.sqr();
-                        if (distsq1 < min1sq) min1sq = distsq1;
-                    }
-                }
-                else
-                {                            // slab-type adress region
-                    min1sq = d1[0] * d1[0];  // set min1sq before loop
-                    ++it2;
-                    for (; it2 != verletList->getAdrPositions().end(); ++it2)
-                    {
-                        pa = **it2;
-                        verletList->getSystem()->bc->getMinimumImageVector(d1, vp.position(), pa);
-                        real distsq1 = d1[0] * d1[0];
-                        if (distsq1 < min1sq) min1sq = distsq1;
-                    }
-                }
-
-                real w = weight(min1sq);
-                vp.lambda() = w;
-
-                real wDeriv = weightderivative(min1sq);
-                vp.lambdaDeriv() = wDeriv;
-
-                // This loop is required when applying routines which use atomistic lambdas.
-                /*for (std::vector<Particle*>::iterator it2 = atList.begin();
-                                 it2 != atList.end(); ++it2) {
-                    Particle &at = **it2;
-                    at.lambda() = vp.lambda();
-                    at.lambdaDeriv() = vp.lambdaDeriv();
-                }*/
-            }
-            else
-            {  // this should not happen
-                std::cout << " VP particle " << vp.id() << "-" << vp.ghost()
-                          << " not found in tuples ";
-                std::cout << " (" << vp.position() << ")\n";
-                exit(1);
-                return;
-            }
-        }
-    }
+    if (KTI == false) setWeights();
 }
 
 void Adress::integrate2()
@@ -395,38 +273,8 @@ void Adress::integrate2()
     }
 
     // Update CG velocities
-    CellList localCells = system.storage->getLocalCells();
-    for (CellListIterator cit(localCells); !cit.isDone(); ++cit)
-    {
-        Particle& vp = *cit;
-
-        FixedTupleListAdress::iterator it3;
-        it3 = fixedtupleList->find(&vp);
-
-        if (it3 != fixedtupleList->end())
-        {
-            std::vector<Particle*> atList;
-            atList = it3->second;
-
-            Real3D cmv(0.0, 0.0, 0.0);  // center of mass velocity
-            for (std::vector<Particle*>::iterator it2 = atList.begin(); it2 != atList.end(); ++it2)
-            {
-                Particle& at = **it2;
-                cmv += at.mass() * at.velocity();
-            }
-            cmv /= vp.getMass();
-            vp.velocity() = cmv;
-        }
-        else
-        {  // this should not happen
-            std::cout << " VP particle " << vp.id() << "-" << vp.ghost() << " not found in tuples ";
-            std::cout << " (" << vp.position() << ")\n";
-            exit(1);
-            return;
-        }
-    }
+    setVPs(false);
 }
-
 void Adress::integrateSlow()
 {
     System& system = getSystemRef();
@@ -444,42 +292,13 @@ void Adress::integrateSlow()
     }
 
     // Update CG velocities
-    CellList localCells = system.storage->getLocalCells();
-    for (CellListIterator cit(localCells); !cit.isDone(); ++cit)
-    {
-        Particle& vp = *cit;
-
-        FixedTupleListAdress::iterator it3;
-        it3 = fixedtupleList->find(&vp);
-
-        if (it3 != fixedtupleList->end())
-        {
-            std::vector<Particle*> atList;
-            atList = it3->second;
-
-            Real3D cmv(0.0, 0.0, 0.0);  // center of mass velocity
-            for (std::vector<Particle*>::iterator it2 = atList.begin(); it2 != atList.end(); ++it2)
-            {
-                Particle& at = **it2;
-                cmv += at.mass() * at.velocity();
-            }
-            cmv /= vp.getMass();
-            vp.velocity() = cmv;
-        }
-        else
-        {  // this should not happen
-            std::cout << " VP particle " << vp.id() << "-" << vp.ghost() << " not found in tuples ";
-            std::cout << " (" << vp.position() << ")\n";
-            exit(1);
-            return;
-        }
-    }
+    setVPs(false);
 }
-
 void Adress::communicateAdrPositions()
 {
     // if adrCenter is not set, the center of adress zone moves along with some particles
     // the coordinates of the center(s) (adrPositions) must be communicated to all nodes
+    // that have particles within reach of them
 
     // As this is a bit complicated: When upating only every other step, it's important to use and
     // communicate not the pointer to the actual region defining particle's position, but to a copy
@@ -516,7 +335,7 @@ void Adress::communicateAdrPositions()
                 verletList->adrPositions.clear();
                 for (CellListIterator it(realcells); it.isValid(); ++it)
                 {
-                    if (verletList->getAdrList().count(it->id()) == 1)
+                    if (verletList->isAdrParticle(it->id()))
                     {
                         // Update the copy and append address to adrPositions
                         adrposlist.push_back(it->position());
@@ -534,36 +353,28 @@ void Adress::communicateAdrPositions()
             }
             else if (verletList->getAdrList().size() > 1)
             {
-                // New version (works also for many moving regions but is slower)
-                System& system = getSystemRef();
-                std::vector<Real3D*> procAdrPositions;
+                // Several moving regions: a CPU only needs the centers whose regions reach into
+                // its domain or ghost layer, so they are sent to the neighbouring CPUs only
+                std::vector<Real3D> procAdrPositions;
                 CellList realcells = getSystem()->storage->getRealCells();
 
-                verletList->adrPositions.clear();
                 for (CellListIterator it(realcells); it.isValid(); ++it)
                 {
-                    if (verletList->getAdrList().count(it->id()) == 1)
+                    if (verletList->isAdrParticle(it->id()))
                     {
-                        // Update the copy and append address to adrPositions
-                        adrposlist.push_back(it->position());
-                        procAdrPositions.push_back(&(adrposlist.back()));
-
-                        // procAdrPositions.push_back(&(it->position())); // without the additional
-                        // copy, old version
+                        procAdrPositions.push_back(it->position());
                     }
                 }
 
-                std::vector<std::vector<Real3D*> > procAdrPositionsAll;
-                boost::mpi::all_gather(*system.comm, procAdrPositions, procAdrPositionsAll);
+                exchangeAdrPositions(procAdrPositions);
 
-                for (std::vector<std::vector<Real3D*> >::iterator itr = procAdrPositionsAll.begin();
-                     itr != procAdrPositionsAll.end(); ++itr)
+                // Update the copies and append their addresses to adrPositions
+                verletList->adrPositions.clear();
+                for (std::vector<Real3D>::iterator itr = procAdrPositions.begin();
+                     itr != procAdrPositions.end(); ++itr)
                 {
-                    for (std::vector<Real3D*>::iterator itr2 = (*itr).begin(); itr2 != (*itr).end();
-                         ++itr2)
-                    {
-                        verletList->adrPositions.push_back(*itr2);
-                    }
+                    adrposlist.push_back(*itr);
+                    verletList->adrPositions.push_back(&(adrposlist.back()));
                 }
             }
             else
@@ -574,6 +385,8 @@ void Adress::communicateAdrPositions()
                 exit(1);
                 return;
             }
+
+            verletList->indexAdrPositions();
         }
 
         updatecount += 1;
@@ -584,6 +397,98 @@ void Adress::communicateAdrPositions()
     }
 }
 
+namespace
+{
+// tag of the messages with the centers of moving adress regions
+const int adrPositionsTag = 0x41d;
+
+// periodic distance of x from the interval [lo, lo + len] on an axis of length L
+real periodicGap(real x, real lo, real len, real L)
+{
+    if (len >= L) return 0.0;
+    x -= lo;
+    x -= floor(x / L) * L;
+    return x <= len ? 0.0 : std::min(x - len, L - x);
+}
+}  // namespace
+
+void Adress::exchangeAdrPositions(std::vector<Real3D>& positions)
+{
+    System& system = getSystemRef();
+    const mpi::communicator& comm = *system.comm;
+    const Int3D& nodeGrid = system.NGridSize;
+    esutil::Grid grid(nodeGrid);
+    Int3D myPos;
+    grid.mapIndexToPosition(myPos, comm.rank());
+
+    // a center affects particles up to range, a CPU holds particles up to halo
+    // (ghost layer plus the drift allowed by the skin) outside of its domain
+    Real3D boxL = system.bc->getBoxL();
+    Int3D cellGrid = system.storage->getInt3DCellGrid();
+    bool sphere = verletList->getAdrRegionType();
+    real range = verletList->getAdrRange();
+    Real3D domain, halo;
+    for (int d = 0; d < 3; d++)
+    {
+        domain[d] = boxL[d] / nodeGrid[d];
+        halo[d] = domain[d] / cellGrid[d] + system.getSkin();
+    }
+
+    // Neighbours are the CPUs whose domains are close enough to ours that one of our centers can
+    // reach them. The relation is symmetric, so every CPU knows whom to expect messages from.
+    std::vector<int> neighbours;
+    std::vector<Int3D> neighbourPos;
+    for (int rank = 0; rank < grid.getNumberOfCells(); rank++)
+    {
+        if (rank == comm.rank()) continue;
+        Int3D pos;
+        grid.mapIndexToPosition(pos, rank);
+        real gapsq = 0.0;
+        for (int d = 0; d < (sphere ? 3 : 1); d++)
+        {
+            int k = abs(pos[d] - myPos[d]);
+            k = std::min(k, nodeGrid[d] - k);
+            real gap = std::max(real(0.0), (k - 1) * domain[d] - halo[d]);
+            gapsq += gap * gap;
+        }
+        if (gapsq <= range * range)
+        {
+            neighbours.push_back(rank);
+            neighbourPos.push_back(pos);
+        }
+    }
+
+    // send every center only to the neighbours it actually reaches
+    std::vector<std::vector<Real3D> > sendBuf(neighbours.size()), recvBuf(neighbours.size());
+    for (size_t i = 0; i < neighbours.size(); i++)
+    {
+        for (std::vector<Real3D>::iterator it = positions.begin(); it != positions.end(); ++it)
+        {
+            real gapsq = 0.0;
+            for (int d = 0; d < (sphere ? 3 : 1); d++)
+            {
+                real gap = periodicGap((*it)[d], neighbourPos[i][d] * domain[d] - halo[d],
+                                       domain[d] + 2.0 * halo[d], boxL[d]);
+                gapsq += gap * gap;
+            }
+            if (gapsq <= range * range) sendBuf[i].push_back(*it);
+        }
+    }
+
+    std::vector<mpi::request> reqs;
+    for (size_t i = 0; i < neighbours.size(); i++)
+    {
+        reqs.push_back(comm.irecv(neighbours[i], adrPositionsTag, recvBuf[i]));
+        reqs.push_back(comm.isend(neighbours[i], adrPositionsTag, sendBuf[i]));
+    }
+    mpi::wait_all(reqs.begin(), reqs.end());
+
+    for (size_t i = 0; i < neighbours.size(); i++)
+    {
+        positions.insert(positions.end(), recvBuf[i].begin(), recvBuf[i].end());
+    }
+}
+
 // AdResS Weighting function
 real Adress::weight(real distanceSqr)
 {
@@ -617,43 +522,20 @@ real Adress::weightderivative(real distanceSqr)
 
 void Adress::aftCalcF()
 {
-    System& system = getSystemRef();
-    CellList localCells = system.storage->getLocalCells();
-    for (CellListIterator cit(localCells); !cit.isDone(); ++cit)
+    // update force of AT particles belonging to a VP
+    const FixedTupleListAdress::FlatTuples& tuples = localTuples();
+    for (size_t i = 0; i < tuples.vps.size(); i++)
     {
-        Particle& vp = *cit;
-
-        FixedTupleListAdress::iterator it3;
-        it3 = fixedtupleList->find(&vp);
-
-        if (it3 != fixedtupleList->end())
+        Particle& vp = *tuples.vps[i];
+        Real3D vpfm = vp.force() / vp.getMass();
+        for (int k = tuples.offsets[i]; k < tuples.offsets[i + 1]; k++)
         {
-            std::vector<Particle*> atList;
-            atList = it3->second;
-
-            // update force of AT particles belonging to a VP
-            Real3D vpfm = vp.force() / vp.getMass();
-            for (std::vector<Particle*>::iterator it2 = atList.begin(); it2 != atList.end(); ++it2)
-            {
-                Particle& at = **it2;
-
-                at.force() += at.mass() * vpfm;
-            }
-        }
-        else
-        {  // this should not happen
-            std::cout << " particle " << vp.id() << "-" << vp.ghost() << " not found in tuples ";
-            std::cout << " (" << vp.position() << ")\n";
-            exit(1);
-            return;
+            Particle& at = *tuples.ats[k];
+            at.force() += at.mass() * vpfm;
         }
     }
 }
 
-/****************************************************
-** REGISTRATION WITH PYTHON
-****************************************************/
-
 void Adress::registerPython()
 {
     using namespace espressopp::python;
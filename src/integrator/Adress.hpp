@@ -78,6 +78,15 @@ private:
     void integrateSlow();
     void aftCalcF();
     void communicateAdrPositions();
+    /** add the centers of the neighbouring CPUs that reach into our domain to positions */
+    void exchangeAdrPositions(std::vector<Real3D>& positions);
+
+    /** tuples of the local VPs, exits if a local VP has none */
+    const FixedTupleListAdress::FlatTuples& localTuples();
+    /** set VP velocities (and positions) to the center of mass of their AT particles */
+    void setVPs(bool positions);
+    /** set lambda and its derivative of the VPs */
+    void setWeights();
 
     void connect();
     void disconnect();
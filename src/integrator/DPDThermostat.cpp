@@ -41,11 +41,12 @@ using namespace espressopp::iterator;
 
 DPDThermostat::DPDThermostat(std::shared_ptr<System> system,
                              std::shared_ptr<VerletList> _verletList)
-    : Extension(system), verletList(_verletList)
+    : Extension(system), fused(false), verletList(_verletList)
 {
     type = Extension::Thermostat;
 
     gamma = 0.0;
+    tgamma = 0.0;
     temperature = 0.0;
 
     current_cutoff = verletList->getVerletCutoff() - system->getSkin();
@@ -75,8 +76,37 @@ real DPDThermostat::getTemperature() { return temperature; }
 
 DPDThermostat::~DPDThermostat() { disconnect(); }
 
+void DPDThermostat::attachFused()
+{
+    if (fused)
+    {
+        throw std::runtime_error(
+            "DPDThermostat: the thermostat is already fused with another interaction of the "
+            "system, the DPD pair forces would be applied twice");
+    }
+    setFused(true);
+}
+
+void DPDThermostat::detachFused() { setFused(false); }
+
+void DPDThermostat::setFused(bool _fused)
+{
+    if (_fused == fused) return;
+
+    // re-establish the connections, only the aftInitF pass depends on the mode
+    bool connected = _initialize.connected();
+    if (connected) disconnect();
+    fused = _fused;
+    if (connected) connect();
+}
+
 void DPDThermostat::disconnect()
 {
+    if (fused && _initialize.connected())
+    {
+        getSystemRef().storage->requestGhostVelocities(false);
+    }
+
     _initialize.disconnect();
     _heatUp.disconnect();
     _coolDown.disconnect();
@@ -92,7 +122,15 @@ void DPDThermostat::connect()
 
     _coolDown = integrator->recalc2.connect(std::bind(&DPDThermostat::coolDown, this));
 
-    _thermalize = integrator->aftInitF.connect(std::bind(&DPDThermostat::thermalize, this));
+    if (fused)
+    {
+        // pair forces come from the interaction, velocities with the position update
+        getSystemRef().storage->requestGhostVelocities(true);
+    }
+    else
+    {
+        _thermalize = integrator->aftInitF.connect(std::bind(&DPDThermostat::thermalize, this));
+    }
 }
 
 void DPDThermostat::thermalize()
@@ -108,140 +146,86 @@ void DPDThermostat::thermalize()
         Particle& p1 = *it->first;
         Particle& p2 = *it->second;
 
-        if (gamma > 0.0) frictionThermoDPD(p1, p2);
-        if (tgamma > 0.0) frictionThermoTDPD(p1, p2);
+        Real3D r = p1.position() - p2.position();
+        thermalizePair(p1, p2, r, r.sqr());
     }
 }
 
-void DPDThermostat::frictionThermoDPD(Particle& p1, Particle& p2)
+void DPDThermostat::thermalizePair(Particle& p1, Particle& p2, const Real3D& r, real dist2)
 {
-    // Implements the standard DPD thermostat
-    Real3D r = p1.position() - p2.position();
-    real dist2 = r.sqr();
-    System& system = getSystemRef();
+    if (dist2 >= current_cutoff_sqr) return;
+
+    real dist = sqrt(dist2);
+    real omega = 1 - dist / current_cutoff;
+    Real3D rhat = r / dist;
+
+    if (gamma > 0.0) frictionThermoDPD(p1, p2, rhat, omega);
+    if (tgamma > 0.0) frictionThermoTDPD(p1, p2, rhat, omega);
+}
+
+void DPDThermostat::frictionThermoDPD(Particle& p1, Particle& p2, const Real3D& r, real omega)
+{
+    // Implements the standard DPD thermostat, r is the unit vector p1 - p2
+    real omega2 = omega * omega;
 
-    if (system.shearRate==.0){
-      if(dist2 < current_cutoff_sqr){
-        
-        real dist = sqrt(dist2);
-        real omega = 1-dist/current_cutoff;
-        real omega2 = omega*omega;
-	
-        r /= dist;
-	
-        real veldiff = (p1.velocity() - p2.velocity()) * r;
-        real friction = pref1 * omega2 * veldiff;
-        real r0 = ((*rng)() - 0.5);
-        real noise = pref2 * omega * r0;//(*rng)() - 0.5);
-	
-        Real3D f = (noise - friction) * r;
-        p1.force() += f;
-        p2.force() -= f;
-      }
-    }else{
-      if(dist2 < current_cutoff_sqr){
-        
-        real dist = sqrt(dist2);
-        real omega = 1-dist/current_cutoff;
-        real omega2 = omega*omega;
-        
-        real halfL= system.bc->getBoxL()[2]/2.0;
-        Real3D vsdiff={system.shearRate*(p1.position()[2]-p2.position()[2]),.0,.0};
-	
-        r /= dist;
-	
-        real veldiff = (p1.velocity()+vsdiff - p2.velocity()) * r;
-        real friction = pref1 * omega2 * veldiff;
-        real r0 = ((*rng)() - 0.5);
-        real noise = pref2 * omega * r0;//(*rng)() - 0.5);
-	
-        Real3D f = (noise - friction) * r;
-        p1.force() += f;
-        p2.force() -= f;
-      }
+    Real3D vdiff = p1.velocity() - p2.velocity();
+    real shearRate = getSystemRef().shearRate;
+    if (shearRate != .0)
+    {
+        vdiff[0] += shearRate * (p1.position()[2] - p2.position()[2]);
     }
+
+    real veldiff = vdiff * r;
+    real friction = pref1 * omega2 * veldiff;
+    real r0 = ((*rng)() - 0.5);
+    real noise = pref2 * omega * r0;
+
+    Real3D f = (noise - friction) * r;
+    p1.force() += f;
+    p2.force() -= f;
 }
 
-void DPDThermostat::frictionThermoTDPD(Particle& p1, Particle& p2)
+void DPDThermostat::frictionThermoTDPD(Particle& p1, Particle& p2, const Real3D& r, real omega)
 {
     // Implements a transverse DPD thermostat with the canonical functional form of omega
-    Real3D r = p1.position() - p2.position();
-    real dist2 = r.sqr();
-    System& system = getSystemRef();
+    real omega2 = omega * omega;
 
-    if (system.shearRate==.0){
-        if(dist2 < current_cutoff_sqr){
-          
-            real dist = sqrt(dist2);
-            real omega = 1-dist/current_cutoff;
-            real omega2 = omega*omega;
-      
-            r /= dist;
-              
-            Real3D noisevec(0.0);
-            noisevec[0] = (*rng)() - 0.5;
-            noisevec[1] = (*rng)() - 0.5;
-            noisevec[2] = (*rng)() - 0.5;
-            
-            Real3D veldiff = p1.velocity() - p2.velocity();
-      
-            Real3D f_damp,f_rand;
-            
-            //Calculate matrix product of projector and veldiff vector:
-            //P dv = (I - r r_T) dv 
-            f_damp[0] = (1.0 - r[0]*r[0])*veldiff[0] - r[0]*r[1]*veldiff[1] - r[0]*r[2]*veldiff[2];
-            f_damp[1] = (1.0 - r[1]*r[1])*veldiff[1] - r[1]*r[0]*veldiff[0] - r[1]*r[2]*veldiff[2];
-            f_damp[2] = (1.0 - r[2]*r[2])*veldiff[2] - r[2]*r[0]*veldiff[0] - r[2]*r[1]*veldiff[1];
-           
-            //Same with random vector
-            f_rand[0] = (1.0 - r[0]*r[0])*noisevec[0] - r[0]*r[1]*noisevec[1] - r[0]*r[2]*noisevec[2];
-            f_rand[1] = (1.0 - r[1]*r[1])*noisevec[1] - r[1]*r[0]*noisevec[0] - r[1]*r[2]*noisevec[2];
-            f_rand[2] = (1.0 - r[2]*r[2])*noisevec[2] - r[2]*r[0]*noisevec[0] - r[2]*r[1]*noisevec[1];
-            
-            f_damp *= pref3 * omega2;
-            f_rand *= pref4 * omega;
-    
-            p1.force() += f_rand - f_damp;
-            p2.force() -= f_rand - f_damp;
-        }
-    }else{
-        if(dist2 < current_cutoff_sqr){
-            real dist = sqrt(dist2);
-            real omega = 1-dist/current_cutoff;
-            real omega2 = omega*omega;
-      
-            real halfL= system.bc->getBoxL()[2]/2.0;
-            Real3D vsdiff={system.shearRate*(p1.position()[2]-p2.position()[2]),.0,.0};
-      
-            r /= dist;
-              
-            Real3D noisevec(0.0);
-            noisevec[0] = (*rng)() - 0.5;
-            noisevec[1] = (*rng)() - 0.5;
-            noisevec[2] = (*rng)() - 0.5;
-            
-            Real3D veldiff = p1.velocity() - p2.velocity() + vsdiff;
-      
-            Real3D f_damp,f_rand;
-            
-            //Calculate matrix product of projector and veldiff vector:
-            //P dv = (I - r r_T) dv 
-            f_damp[0] = (1.0 - r[0]*r[0])*veldiff[0] - r[0]*r[1]*veldiff[1] - r[0]*r[2]*veldiff[2];
-            f_damp[1] = (1.0 - r[1]*r[1])*veldiff[1] - r[1]*r[0]*veldiff[0] - r[1]*r[2]*veldiff[2];
-            f_damp[2] = (1.0 - r[2]*r[2])*veldiff[2] - r[2]*r[0]*veldiff[0] - r[2]*r[1]*veldiff[1];
-           
-            //Same with random vector
-            f_rand[0] = (1.0 - r[0]*r[0])*noisevec[0] - r[0]*r[1]*noisevec[1] - r[0]*r[2]*noisevec[2];
-            f_rand[1] = (1.0 - r[1]*r[1])*noisevec[1] - r[1]*r[0]*noisevec[0] - r[1]*r[2]*noisevec[2];
-            f_rand[2] = (1.0 - r[2]*r[2])*noisevec[2] - r[2]*r[0]*noisevec[0] - r[2]*r[1]*noisevec[1];
-            
-            f_damp *= pref3 * omega2;
-            f_rand *= pref4 * omega;
-      
-            p1.force() += f_rand - f_damp;
-            p2.force() -= f_rand - f_damp;
-        }
+    Real3D noisevec(0.0);
+    noisevec[0] = (*rng)() - 0.5;
+    noisevec[1] = (*rng)() - 0.5;
+    noisevec[2] = (*rng)() - 0.5;
+
+    Real3D veldiff = p1.velocity() - p2.velocity();
+    real shearRate = getSystemRef().shearRate;
+    if (shearRate != .0)
+    {
+        veldiff[0] += shearRate * (p1.position()[2] - p2.position()[2]);
     }
+
+    Real3D f_damp, f_rand;
+
+    // Calculate matrix product of projector and veldiff vector:
+    // P dv = (I - r r_T) dv
+    f_damp[0] = (1.0 - r[0] * r[0]) * veldiff[0] - r[0] * r[1] * veldiff[1] -
+                r[0] * r[2] * veldiff[2];
+    f_damp[1] = (1.0 - r[1] * r[1]) * veldiff[1] - r[1] * r[0] * veldiff[0] -
+                r[1] * r[2] * veldiff[2];
+    f_damp[2] = (1.0 - r[2] * r[2]) * veldiff[2] - r[2] * r[0] * veldiff[0] -
+                r[2] * r[1] * veldiff[1];
+
+    // Same with random vector
+    f_rand[0] = (1.0 - r[0] * r[0]) * noisevec[0] - r[0] * r[1] * noisevec[1] -
+                r[0] * r[2] * noisevec[2];
+    f_rand[1] = (1.0 - r[1] * r[1]) * noisevec[1] - r[1] * r[0] * noisevec[0] -
+                r[1] * r[2] * noisevec[2];
+    f_rand[2] = (1.0 - r[2] * r[2]) * noisevec[2] - r[2] * r[0] * noisevec[0] -
+                r[2] * r[1] * noisevec[1];
+
+    f_damp *= pref3 * omega2;
+    f_rand *= pref4 * omega;
+
+    p1.force() += f_rand - f_damp;
+    p2.force() -= f_rand - f_damp;
 }
 
 void DPDThermostat::initialize()
@@ -305,7 +289,8 @@ void DPDThermostat::registerPython()
         .add_property("gamma", &DPDThermostat::getGamma, &DPDThermostat::setGamma)
         .add_property("tgamma", &DPDThermostat::getTGamma, &DPDThermostat::setTGamma)
         .add_property("temperature", &DPDThermostat::getTemperature,
-                      &DPDThermostat::setTemperature);
+                      &DPDThermostat::setTemperature)
+        .add_property("fused", &DPDThermostat::getFused);
 }
 }  // namespace integrator
 }  // namespace espressopp
@@ -56,11 +56,27 @@ public:
     void setTemperature(real temperature);
     real getTemperature();
 
+    std::shared_ptr<VerletList> getVerletList() { return verletList; }
+
+    /** If fused, the pair forces are not computed in a separate pass at
+        aftInitF but by the VerletListDPDInteractionTemplate during its
+        conservative pair loop; ghost velocities then come with updateGhosts().
+        The thermostat is fused while such an interaction is part of the system:
+        attachFused() when it is added, detachFused() when it is removed. Only
+        one interaction at a time may apply the pair forces, a second one
+        attaching throws. */
+    void attachFused();
+    void detachFused();
+    bool getFused() { return fused; }
+
     void initialize();
 
     /** update of forces to thermalize the system */
     void thermalize();
 
+    /** dissipative and random force for one pair, r = p1 - p2 and dist2 = r*r */
+    void thermalizePair(Particle& p1, Particle& p2, const Real3D& r, real dist2);
+
     /** very nasty: if we recalculate force when leaving/reentering the integrator,
         a(t) and a((t-dt)+dt) are NOT equal in the vv algorithm. The random
         numbers are drawn twice, resulting in a different variance of the random force.
@@ -79,12 +95,14 @@ public:
 private:
     boost::signals2::connection _initialize, _heatUp, _coolDown, _thermalize;
 
-    void frictionThermoDPD(Particle& p1, Particle& p2);
-    void frictionThermoTDPD(Particle& p1, Particle& p2);
+    void frictionThermoDPD(Particle& p1, Particle& p2, const Real3D& r, real omega);
+    void frictionThermoTDPD(Particle& p1, Particle& p2, const Real3D& r, real omega);
 
     void connect();
     void disconnect();
 
+    void setFused(bool _fused);
+
     real temperature;                 //!< desired user temperature
     real gamma;                       //!< friction coefficient
     real tgamma;                      //!<  transversal friction coefficient
@@ -93,6 +111,7 @@ private:
 
     real current_cutoff;
     real current_cutoff_sqr;
+    bool fused;
     std::shared_ptr<VerletList> verletList;
     std::shared_ptr<esutil::RNG> rng;  //!< random number generator used for friction term
 };
@@ -31,6 +31,13 @@ espressopp.integrator.DPDThermostat
                 :param vl:
                 :type system:
                 :type vl:
+
+.. attribute:: espressopp.integrator.DPDThermostat.fused
+
+                (read-only) True while a VerletListDPD interaction using this
+                thermostat is part of the system and applies the DPD pair forces
+                in its own pair loop. Removing that interaction from the system
+                makes the thermostat do its own pass again.
 """
 from espressopp.esutil import cxxinit
 from espressopp import pmi
@@ -52,5 +59,5 @@ if pmi.isController :
     class DPDThermostat(Extension, metaclass=pmi.Proxy):
         pmiproxydefs = dict(
             cls =  'espressopp.integrator.DPDThermostatLocal',
-            pmiproperty = [ 'gamma', 'tgamma', 'temperature' ]
+            pmiproperty = [ 'gamma', 'tgamma', 'temperature', 'fused' ]
             )
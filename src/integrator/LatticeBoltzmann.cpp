@@ -22,7 +22,8 @@
 
 #include "LatticeBoltzmann.hpp"
 #include <iomanip>  // for setprecision output in std
-#include <fstream>
+#include <numeric>
+#include <algorithm>
 #include <boost/filesystem.hpp>
 
 #include "storage/Storage.hpp"
@@ -30,6 +31,7 @@
 #include "esutil/RNG.hpp"
 #include "esutil/Grid.hpp"
 #include "bc/BC.hpp"
+#include "io/hdf5.hpp"
 
 #define REQ_HALO_SPREAD 501
 #define COMM_DIR_0 700
@@ -140,7 +142,6 @@ void LatticeBoltzmann::disconnect()
 
     delete (lbfluid);
     delete (ghostlat);
-    delete (lbmom);
     delete (lbfor);
 }
 
@@ -314,25 +315,25 @@ void LatticeBoltzmann::keepLBDump() { setPrevDumpStep(0); }
 /* Setter and getter for access to population values */
 void LatticeBoltzmann::setPops(Int3D _Ni, int _l, real _value)
 {
-    (*lbfluid)[_Ni[0]][_Ni[1]][_Ni[2]].setF_i(_l, _value);
+    lbfluid->setF_i(_Ni[0], _Ni[1], _Ni[2], _l, _value);
 }
 real LatticeBoltzmann::getPops(Int3D _Ni, int _l)
 {
-    return (*lbfluid)[_Ni[0]][_Ni[1]][_Ni[2]].getF_i(_l);
+    return lbfluid->getF_i(_Ni[0], _Ni[1], _Ni[2], _l);
 }
 
 void LatticeBoltzmann::setGhostFluid(Int3D _Ni, int _l, real _value)
 {
-    (*ghostlat)[_Ni[0]][_Ni[1]][_Ni[2]].setF_i(_l, _value);
+    ghostlat->setF_i(_Ni[0], _Ni[1], _Ni[2], _l, _value);
 }
 
 void LatticeBoltzmann::setLBMom(Int3D _Ni, int _l, real _value)
 {
-    (*lbmom)[_Ni[0]][_Ni[1]][_Ni[2]].setMom_i(_l, _value);
+    lbfluid->setMom_i(_Ni[0], _Ni[1], _Ni[2], _l, _value);
 }
 real LatticeBoltzmann::getLBMom(Int3D _Ni, int _l)
 {
-    return (*lbmom)[_Ni[0]][_Ni[1]][_Ni[2]].getMom_i(_l);
+    return lbfluid->getMom_i(_Ni[0], _Ni[1], _Ni[2], _l);
 }
 
 /* Helpers for MD to LB (and vice versa) unit conversion */
@@ -366,28 +367,22 @@ void LatticeBoltzmann::initLatticeSize()
 {
     Int3D _numSites = getMyNi();
 
+    /* populations live in flat arrays */
+    lbfluid = new LBLattice;
+    ghostlat = new LBLattice;
+    lbfluid->resize(_numSites);
+    ghostlat->resize(_numSites);
+
     /* stretch lattices resizing them in 3 dimensions */
-    lbfluid = new lblattice;
-    ghostlat = new lblattice;
-    lbmom = new lbmoments;
     lbfor = new lbforces;
 
-    (*lbfluid).resize(_numSites[0]);
-    (*ghostlat).resize(_numSites[0]);
-    (*lbmom).resize(_numSites[0]);
     (*lbfor).resize(_numSites[0]);
 
     for (int i = 0; i < _numSites[0]; i++)
     {
-        (*lbfluid)[i].resize(_numSites[1]);
-        (*ghostlat)[i].resize(_numSites[1]);
-        (*lbmom)[i].resize(_numSites[1]);
         (*lbfor)[i].resize(_numSites[1]);
         for (int j = 0; j < _numSites[1]; j++)
         {
-            (*lbfluid)[i][j].resize(_numSites[2]);
-            (*ghostlat)[i][j].resize(_numSites[2]);
-            (*lbmom)[i][j].resize(_numSites[2]);
             (*lbfor)[i][j].resize(_numSites[2]);
         }
     }
@@ -512,20 +507,10 @@ void LatticeBoltzmann::initFluctuations()
             setPhi(l, sqrt(mu / getInvB(l)));
         }
 
-        // set phi on every lattice site
-        Int3D _Ni = getMyNi();
-        for (int i = 0; i < _Ni[0]; i++)
+        // set phi for the lattice sites
+        for (int l = 0; l < getNumVels(); l++)
         {
-            for (int j = 0; j < _Ni[1]; j++)
-            {
-                for (int k = 0; k < _Ni[2]; k++)
-                {
-                    for (int l = 0; l < getNumVels(); l++)
-                    {
-                        (*lbfluid)[i][j][k].setPhiLoc(l, getPhi(l));
-                    }
-                }
-            }
+            LBLattice::setPhiLoc(l, getPhi(l));
         }
 
         if (_myRank == 0)
@@ -617,8 +602,6 @@ void LatticeBoltzmann::makeDecompose()
 void LatticeBoltzmann::collideStream()
 {
     int _offset = getHaloSkin();
-    bool _extForce = doExtForce();
-    bool _fluct = doFluct();
     bool _coupling = doCoupling();
     Int3D _myNi = getMyNi();
 
@@ -628,32 +611,62 @@ void LatticeBoltzmann::collideStream()
         copyForcesFromHalo();
     }
 
-    // collision-streaming //
-    real timer = colstream.getElapsedTime();
-    for (int i = _offset; i < _myNi[0] - _offset; i++)
+    // real sites are [r0, r1), the ones streaming into the halo are outside [in0, in1) //
+    Int3D r0, r1, in0, in1;
+    for (int _dim = 0; _dim < 3; _dim++)
     {
-        for (int j = _offset; j < _myNi[1] - _offset; j++)
-        {
-            for (int k = _offset; k < _myNi[2] - _offset; k++)
-            {
-                Real3D _f =
-                    (*lbfor)[i][j][k].getExtForceLoc() + (*lbfor)[i][j][k].getCouplForceLoc();
-
-                (*lbfluid)[i][j][k].collision(_fluct, _extForce, _coupling, _f, gamma);
-                streaming(i, j, k);
-            }
-        }
+        r0[_dim] = _offset;
+        r1[_dim] = _myNi[_dim] - _offset;
+        in0[_dim] = std::min(r0[_dim] + 1, r1[_dim]);
+        in1[_dim] = std::max(in0[_dim], r1[_dim] - 1);
     }
+
+    // the push accumulates the new density and mass flux into the ghost lattice //
+    real timer = colstream.getElapsedTime();
+    ghostlat->clearMoments();
+    if (doFluct()) drawFluctuations();
+
+    // collision-streaming of the boundary slabs first //
+    collideSites(Int3D(r0[0], r0[1], r0[2]), Int3D(in0[0], r1[1], r1[2]));
+    collideSites(Int3D(in1[0], r0[1], r0[2]), Int3D(r1[0], r1[1], r1[2]));
+    collideSites(Int3D(in0[0], r0[1], r0[2]), Int3D(in1[0], in0[1], r1[2]));
+    collideSites(Int3D(in0[0], in1[1], r0[2]), Int3D(in1[0], r1[1], r1[2]));
+    collideSites(Int3D(in0[0], in0[1], r0[2]), Int3D(in1[0], in1[1], in0[2]));
+    collideSites(Int3D(in0[0], in0[1], in1[2]), Int3D(in1[0], in1[1], r1[2]));
+    time_colstr += (colstream.getElapsedTime() - timer);
+
+    // the halo planes are complete, exchange them while the interior is collided //
+    timer = comm.getElapsedTime();
+    startHaloComm(0);
+    time_comm += (comm.getElapsedTime() - timer);
+
+    // the interior writes none of the halo sites and none of the populations unpacked //
+    timer = colstream.getElapsedTime();
+    collideSites(in0, in1);
     time_colstr += (colstream.getElapsedTime() - timer);
 
-    // halo communication //
+    // edges and corners travel on in y and z, so these exchanges wait for the previous one //
     timer = comm.getElapsedTime();
-    commHalo();
+    finishHaloComm(0);
+    startHaloComm(1);
+    finishHaloComm(1);
+    startHaloComm(2);
+    finishHaloComm(2);
     time_comm += (comm.getElapsedTime() - timer);
 
+    // the outermost real layer got populations unpacked after the push, redo its moments //
+    timer = colstream.getElapsedTime();
+    ghostlat->calcMoments(Int3D(r0[0], r0[1], r0[2]), Int3D(in0[0], r1[1], r1[2]));
+    ghostlat->calcMoments(Int3D(in1[0], r0[1], r0[2]), Int3D(r1[0], r1[1], r1[2]));
+    ghostlat->calcMoments(Int3D(in0[0], r0[1], r0[2]), Int3D(in1[0], in0[1], r1[2]));
+    ghostlat->calcMoments(Int3D(in0[0], in1[1], r0[2]), Int3D(in1[0], r1[1], r1[2]));
+    ghostlat->calcMoments(Int3D(in0[0], in0[1], r0[2]), Int3D(in1[0], in1[1], in0[2]));
+    ghostlat->calcMoments(Int3D(in0[0], in0[1], in1[2]), Int3D(in1[0], in1[1], r1[2]));
+    time_colstr += (colstream.getElapsedTime() - timer);
+
     /* swapping of the pointers to the lattices */
     timer = swapping.getElapsedTime();
-    lblattice* tmp = lbfluid;
+    LBLattice* tmp = lbfluid;
     lbfluid = ghostlat;
     ghostlat = tmp;
     time_sw += (swapping.getElapsedTime() - timer);
@@ -675,49 +688,54 @@ void LatticeBoltzmann::collideStream()
         }
     }
 
-    calcDenMom();
-
     copyDenMomToHalo();
 }
 
 /*******************************************************************************************/
 
-/* STREAMING ALONG THE VELOCITY VECTORS. SERIAL */
-// periodic boundaries are handled separately in commHalo() //
-void LatticeBoltzmann::streaming(int _i, int _j, int _k)
-{
-    // assign iterations
-    int _ip = _i + 1;
-    int _im = _i - 1;
-    int _jp = _j + 1;
-    int _jm = _j - 1;
-    int _kp = _k + 1;
-    int _km = _k - 1;
-
-    // do not move the staying populations
-    (*ghostlat)[_i][_j][_k].setF_i(0, (*lbfluid)[_i][_j][_k].getF_i(0));
-
-    // move populations to the nearest neighbors
-    (*ghostlat)[_ip][_j][_k].setF_i(1, (*lbfluid)[_i][_j][_k].getF_i(1));
-    (*ghostlat)[_im][_j][_k].setF_i(2, (*lbfluid)[_i][_j][_k].getF_i(2));
-    (*ghostlat)[_i][_jp][_k].setF_i(3, (*lbfluid)[_i][_j][_k].getF_i(3));
-    (*ghostlat)[_i][_jm][_k].setF_i(4, (*lbfluid)[_i][_j][_k].getF_i(4));
-    (*ghostlat)[_i][_j][_kp].setF_i(5, (*lbfluid)[_i][_j][_k].getF_i(5));
-    (*ghostlat)[_i][_j][_km].setF_i(6, (*lbfluid)[_i][_j][_k].getF_i(6));
-
-    // move populations to the next-to-the-nearest neighbors
-    (*ghostlat)[_ip][_jp][_k].setF_i(7, (*lbfluid)[_i][_j][_k].getF_i(7));
-    (*ghostlat)[_im][_jm][_k].setF_i(8, (*lbfluid)[_i][_j][_k].getF_i(8));
-    (*ghostlat)[_ip][_jm][_k].setF_i(9, (*lbfluid)[_i][_j][_k].getF_i(9));
-    (*ghostlat)[_im][_jp][_k].setF_i(10, (*lbfluid)[_i][_j][_k].getF_i(10));
-    (*ghostlat)[_ip][_j][_kp].setF_i(11, (*lbfluid)[_i][_j][_k].getF_i(11));
-    (*ghostlat)[_im][_j][_km].setF_i(12, (*lbfluid)[_i][_j][_k].getF_i(12));
-    (*ghostlat)[_ip][_j][_km].setF_i(13, (*lbfluid)[_i][_j][_k].getF_i(13));
-    (*ghostlat)[_im][_j][_kp].setF_i(14, (*lbfluid)[_i][_j][_k].getF_i(14));
-    (*ghostlat)[_i][_jp][_kp].setF_i(15, (*lbfluid)[_i][_j][_k].getF_i(15));
-    (*ghostlat)[_i][_jm][_km].setF_i(16, (*lbfluid)[_i][_j][_k].getF_i(16));
-    (*ghostlat)[_i][_jp][_km].setF_i(17, (*lbfluid)[_i][_j][_k].getF_i(17));
-    (*ghostlat)[_i][_jm][_kp].setF_i(18, (*lbfluid)[_i][_j][_k].getF_i(18));
+/* COLLIDE AND STREAM THE REAL SITES IN [_lo, _hi), A ROW ALONG Z AT A TIME */
+void LatticeBoltzmann::collideSites(Int3D _lo, Int3D _hi)
+{
+    bool _extForce = doExtForce();
+    bool _fluct = doFluct();
+    int _offset = getHaloSkin();
+    int _numRand = getNumVels() - 4;
+    Int3D _myNi = getMyNi();
+
+    int _rowLen = _hi[2] - _lo[2];
+    if (_rowLen <= 0) return;
+
+    std::vector<real> _fx(_rowLen), _fy(_rowLen), _fz(_rowLen);
+    for (int i = _lo[0]; i < _hi[0]; i++)
+    {
+        for (int j = _lo[1]; j < _hi[1]; j++)
+        {
+            if (_extForce)
+            {
+                for (int k = 0; k < _rowLen; k++)
+                {
+                    LBForce& _lbf = (*lbfor)[i][j][k + _lo[2]];
+                    Real3D _f = _lbf.getExtForceLoc() + _lbf.getCouplForceLoc();
+                    _fx[k] = _f[0];
+                    _fy[k] = _f[1];
+                    _fz[k] = _f[2];
+                }
+            }
+
+            // random numbers of the row, laid out in the order drawFluctuations() drew them
+            const real* _rand = 0;
+            if (_fluct)
+            {
+                int _site = ((i - _offset) * (_myNi[1] - 2 * _offset) + (j - _offset)) *
+                                (_myNi[2] - 2 * _offset) +
+                            (_lo[2] - _offset);
+                _rand = &fluctRand[_site * _numRand];
+            }
+
+            lbfluid->collideStream(*ghostlat, i, j, _lo[2], _rowLen, _rand, _extForce,
+                                   _fx.data(), _fy.data(), _fz.data(), gamma);
+        }
+    }
 }
 
 /*******************************************************************************************/
@@ -801,10 +819,10 @@ void LatticeBoltzmann::calcViscForce(Particle& p)
                 // force acting onto the fluid node at the moment (midpoint scheme)
                 Real3D _f = (*lbfor)[_ip][_jp][_kp].getExtForceLoc() +
                             (*lbfor)[_ip][_jp][_kp].getCouplForceLoc();
-                Real3D _jLoc = Real3D((*lbmom)[_ip][_jp][_kp].getMom_i(1) + _f[0],
-                                      (*lbmom)[_ip][_jp][_kp].getMom_i(2) + _f[1],
-                                      (*lbmom)[_ip][_jp][_kp].getMom_i(3) + _f[2]);
-                real _invDenLoc = 1. / (*lbmom)[_ip][_jp][_kp].getMom_i(0);
+                Real3D _jLoc = Real3D(lbfluid->getMom_i(_ip, _jp, _kp, 1) + _f[0],
+                                      lbfluid->getMom_i(_ip, _jp, _kp, 2) + _f[1],
+                                      lbfluid->getMom_i(_ip, _jp, _kp, 3) + _f[2]);
+                real _invDenLoc = 1. / lbfluid->getMom_i(_ip, _jp, _kp, 0);
 
                 Real3D _u = _jLoc * _invDenLoc * _convCoeff;
                 interpVel += _u * delta[3 * _i] * delta[3 * _j + 1] * delta[3 * _k + 2];
@@ -812,8 +830,16 @@ void LatticeBoltzmann::calcViscForce(Particle& p)
         }
     }
 
+    // under Lees-Edwards the particle velocity is relative to the shear profile
+    Real3D _vel = p.velocity();
+    if (doLeesEdwards())
+    {
+        System& system = getSystemRef();
+        _vel[0] += system.shearRate * (p.position()[2] - 0.5 * system.bc->getBoxL()[2]);
+    }
+
     // add visc force to the buffered rand force acting onto particle p.id()
-    addFOnPart(p.id(), -_fricCoeff * (p.velocity() - interpVel));
+    addFOnPart(p.id(), -_fricCoeff * (_vel - interpVel));
 
     // apply buffered force to the MD-particle p.id()
     p.force() += getFOnPart(p.id());
@@ -849,32 +875,20 @@ void LatticeBoltzmann::calcViscForce(Particle& p)
 
 /*******************************************************************************************/
 
-/* CALCULATE DENSITY AND J AT THE LATTICE SITES IN REAL REGION */
-void LatticeBoltzmann::calcDenMom()
+/* DRAW THE RANDOM NUMBERS OF THE FLUCTUATING MODES FOR ALL REAL SITES */
+// the sites are collided slab by slab, so the numbers are drawn up front in i, j, k order //
+void LatticeBoltzmann::drawFluctuations()
 {
     Int3D _myNi = getMyNi();
-    int _numVels = getNumVels();
     int _offset = getHaloSkin();
+    int _numRand = getNumVels() - 4;
 
-    for (int i = _offset; i < _myNi[0] - _offset; ++i)
+    int _numReal = (_myNi[0] - 2 * _offset) * (_myNi[1] - 2 * _offset) * (_myNi[2] - 2 * _offset);
+    fluctRand.resize(_numReal * _numRand);
+
+    for (int n = 0; n < _numReal * _numRand; n++)
     {
-        for (int j = _offset; j < _myNi[1] - _offset; ++j)
-        {
-            for (int k = _offset; k < _myNi[2] - _offset; ++k)
-            {
-                real denLoc = 0.;
-                Real3D jLoc = Real3D(0.);
-                for (int l = 0; l < _numVels; l++)
-                {
-                    denLoc += (*lbfluid)[i][j][k].getF_i(l);
-                    jLoc += (*lbfluid)[i][j][k].getF_i(l) * getCi(l);
-                }
-                (*lbmom)[i][j][k].setMom_i(0, denLoc);
-                (*lbmom)[i][j][k].setMom_i(1, jLoc[0]);
-                (*lbmom)[i][j][k].setMom_i(2, jLoc[1]);
-                (*lbmom)[i][j][k].setMom_i(3, jLoc[2]);
-            }
-        }
+        fluctRand[n] = (*rng)() - 0.5;
     }
 }
 
@@ -977,198 +991,362 @@ void LatticeBoltzmann::galileanTransf(Real3D _specCmVel)
 
 /*******************************************************************************************/
 
-void LatticeBoltzmann::readLBConf(int _mode)
+/* the checkpoint of a step is a single HDF5 file shared by all CPUs. lattice fields are
+   stored for the real sites of the whole lattice as [Nx][Ny][Nz][values], the coupling forces
+   on MD particles as [id][3]. a restart may therefore use a different number of CPUs. */
+namespace
 {
-    if (_mode == 0)
-    {
-        // reloading values from memory
-        System& system = getSystemRef();
-        CellList realCells = system.storage->getRealCells();
+std::string lbConfFilename(int _step)
+{
+    std::ostringstream filename;
+    filename << "dump/lbConf." << _step << ".h5";
+    return filename.str();
+}
 
-        for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
-        {
-            // add the forces to the integrator
-            cit->force() += getFOnPart(cit->id());
-        }
+hid_t openLBConf(const std::string& _filename, MPI_Comm _comm, bool _create)
+{
+    auto plist = io::CHECK_HDF5(H5Pcreate(H5P_FILE_ACCESS));
+    io::CHECK_HDF5(H5Pset_fapl_mpio(plist, _comm, MPI_INFO_NULL));
+
+    hid_t fileId = _create ? H5Fcreate(_filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, plist)
+                           : H5Fopen(_filename.c_str(), H5F_ACC_RDONLY, plist);
+    io::CHECK_HDF5(fileId);
+    io::CHECK_HDF5(H5Pclose(plist));
+
+    return fileId;
+}
+
+/* selects the block [_offset, _offset + _localDims) of the file and a flat buffer for it */
+hsize_t selectBlock(hid_t _fileSpace,
+                    hid_t& _memSpace,
+                    const std::vector<hsize_t>& _offset,
+                    const std::vector<hsize_t>& _localDims)
+{
+    hsize_t numLocal =
+        std::accumulate(_localDims.begin(), _localDims.end(), hsize_t(1), std::multiplies<>());
+    hsize_t memDims = std::max(numLocal, hsize_t(1));
+    _memSpace = io::CHECK_HDF5(H5Screate_simple(1, &memDims, nullptr));
+
+    if (numLocal == 0)
+    {
+        // CPUs without data still take part in the collective call
+        io::CHECK_HDF5(H5Sselect_none(_fileSpace));
+        io::CHECK_HDF5(H5Sselect_none(_memSpace));
     }
     else
     {
-        timeReadLBConf.reset();
-        real timeStart = timeReadLBConf.getElapsedTime();
+        io::CHECK_HDF5(H5Sselect_hyperslab(_fileSpace, H5S_SELECT_SET, _offset.data(), nullptr,
+                                           _localDims.data(), nullptr));
+    }
 
-        // set restart folder and check its existence
-        std::string dirRestart = "dump";
+    return numLocal;
+}
 
-        if (getStepNum() != 0 && boost::filesystem::is_directory(dirRestart) == false)
-        {
-            std::cout << "Sorry, the restart directory is missing! "
-                      << "Something is wrong!!!" << std::endl;
-        }
+/* selects the rows _ids (sorted, unique) of a [rows][3] dataset and a flat buffer for them,
+   every run of consecutive ids is one block */
+hsize_t selectRows(hid_t _fileSpace, hid_t& _memSpace, const std::vector<hsize_t>& _ids)
+{
+    hsize_t numLocal = 3 * _ids.size();
+    hsize_t memDims = std::max(numLocal, hsize_t(1));
+    _memSpace = io::CHECK_HDF5(H5Screate_simple(1, &memDims, nullptr));
 
-        // make prefix and suffix //
-        std::string prefix = dirRestart;
-        prefix.append("/");
+    if (numLocal == 0)
+    {
+        io::CHECK_HDF5(H5Sselect_none(_fileSpace));
+        io::CHECK_HDF5(H5Sselect_none(_memSpace));
+        return 0;
+    }
 
-        std::ostringstream convert, _myRank;
-        convert << getStepNum();
-        _myRank << getSystem()->comm->rank();
+    H5S_seloper_t op = H5S_SELECT_SET;
+    for (size_t first = 0; first < _ids.size();)
+    {
+        size_t last = first + 1;
+        while (last < _ids.size() && _ids[last] == _ids[last - 1] + 1) last++;
 
-        std::string suffix = ".dat";
-        suffix.insert(0, _myRank.str());
-        suffix.insert(0, ".");
-        suffix.insert(0, convert.str());
+        hsize_t offset[2] = {_ids[first], 0};
+        hsize_t count[2] = {hsize_t(last - first), 3};
+        io::CHECK_HDF5(
+            H5Sselect_hyperslab(_fileSpace, op, offset, nullptr, count, nullptr));
+        op = H5S_SELECT_OR;
+        first = last;
+    }
 
-        /*  COUPLING FORCES */
-        // create filenames for the input files //
-        std::string filenameForces = "couplForces";
-        filenameForces.insert(0, prefix);
-        filenameForces.append(suffix);
+    return numLocal;
+}
 
-        // fill in the coupling forces acting on MD-particles with zeros //
-        int _totNPart = getTotNPart();
-        for (int _id = 0; _id <= _totNPart; _id++)
-        {
-            setFOnPart(_id, Real3D(0.));
-        }
+/* creates the dataset and writes the part of it chosen by _select on this CPU, sites or
+   particles that are not written by any CPU are 0 */
+template <class Select>
+void writeDataset(hid_t _fileId,
+                  const std::string& _name,
+                  const std::vector<hsize_t>& _globalDims,
+                  Select _select,
+                  const std::vector<real>& _data)
+{
+    auto fileSpace =
+        io::CHECK_HDF5(H5Screate_simple(int(_globalDims.size()), _globalDims.data(), nullptr));
+    auto dcpl = io::CHECK_HDF5(H5Pcreate(H5P_DATASET_CREATE));
+    real zero = 0.;
+    io::CHECK_HDF5(H5Pset_fill_value(dcpl, io::typeToHDF5<real>(), &zero));
+    auto dataset = io::CHECK_HDF5(H5Dcreate(_fileId, _name.c_str(), io::typeToHDF5<real>(),
+                                            fileSpace, H5P_DEFAULT, dcpl, H5P_DEFAULT));
+    hid_t memSpace;
+    _select(fileSpace, memSpace);
+
+    auto datawrite = io::CHECK_HDF5(H5Pcreate(H5P_DATASET_XFER));
+    io::CHECK_HDF5(H5Pset_dxpl_mpio(datawrite, H5FD_MPIO_COLLECTIVE));
+    io::CHECK_HDF5(H5Dwrite(dataset, io::typeToHDF5<real>(), memSpace, fileSpace, datawrite,
+                            _data.data()));
+
+    io::CHECK_HDF5(H5Pclose(datawrite));
+    io::CHECK_HDF5(H5Sclose(memSpace));
+    io::CHECK_HDF5(H5Dclose(dataset));
+    io::CHECK_HDF5(H5Pclose(dcpl));
+    io::CHECK_HDF5(H5Sclose(fileSpace));
+}
 
-        // access particles' data and open a file to read couplForces from //
-        long int _id;
-        Int3D _myNi = getMyNi();
-        real _fx, _fy, _fz;
+template <class Select>
+void readDataset(hid_t _fileId,
+                 const std::string& _name,
+                 const std::vector<hsize_t>& _globalDims,
+                 Select _select,
+                 std::vector<real>& _data)
+{
+    auto dataset = io::CHECK_HDF5(H5Dopen(_fileId, _name.c_str(), H5P_DEFAULT));
+    auto fileSpace = io::CHECK_HDF5(H5Dget_space(dataset));
 
-        System& system = getSystemRef();
-        CellList realCells = system.storage->getRealCells();
+    std::vector<hsize_t> fileDims(_globalDims.size());
+    if (H5Sget_simple_extent_ndims(fileSpace) != int(_globalDims.size()) ||
+        io::CHECK_HDF5(H5Sget_simple_extent_dims(fileSpace, fileDims.data(), nullptr)) < 0 ||
+        fileDims != _globalDims)
+    {
+        throw std::runtime_error("LB checkpoint: dataset " + _name +
+                                 " does not match the current lattice");
+    }
 
-        std::ifstream couplForcesFile;
-        couplForcesFile.open(filenameForces.c_str(), std::ifstream::in);
+    hid_t memSpace;
+    _data.resize(_select(fileSpace, memSpace));
 
-        if (couplForcesFile.is_open())
-        {
-            // MD-part //
-            for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
-            {
-                couplForcesFile >> _id >> _fx >> _fy >> _fz;
+    auto dataread = io::CHECK_HDF5(H5Pcreate(H5P_DATASET_XFER));
+    io::CHECK_HDF5(H5Pset_dxpl_mpio(dataread, H5FD_MPIO_COLLECTIVE));
+    io::CHECK_HDF5(H5Dread(dataset, io::typeToHDF5<real>(), memSpace, fileSpace, dataread,
+                           _data.data()));
 
-                setFOnPart(_id, Real3D(_fx, _fy, _fz));
-                // add the forces to the integrator
-                cit->force() += getFOnPart(cit->id());
-            }
+    io::CHECK_HDF5(H5Pclose(dataread));
+    io::CHECK_HDF5(H5Sclose(memSpace));
+    io::CHECK_HDF5(H5Sclose(fileSpace));
+    io::CHECK_HDF5(H5Dclose(dataset));
+}
 
-            // LB-part //
-            // initialize with zeros //
-            for (int _i = 0; _i < _myNi[0]; _i++)
-            {
-                for (int _j = 0; _j < _myNi[1]; _j++)
-                {
-                    for (int _k = 0; _k < _myNi[2]; _k++)
-                    {
-                        (*lbfor)[_i][_j][_k].setCouplForceLoc(Real3D(0.));
-                    }
-                }
-            }
+void writeBlock(hid_t _fileId,
+                const std::string& _name,
+                const std::vector<hsize_t>& _globalDims,
+                const std::vector<hsize_t>& _offset,
+                const std::vector<hsize_t>& _localDims,
+                const std::vector<real>& _data)
+{
+    writeDataset(
+        _fileId, _name, _globalDims,
+        [&](hid_t _fileSpace, hid_t& _memSpace)
+        { return selectBlock(_fileSpace, _memSpace, _offset, _localDims); },
+        _data);
+}
+
+void readBlock(hid_t _fileId,
+               const std::string& _name,
+               const std::vector<hsize_t>& _globalDims,
+               const std::vector<hsize_t>& _offset,
+               const std::vector<hsize_t>& _localDims,
+               std::vector<real>& _data)
+{
+    readDataset(
+        _fileId, _name, _globalDims,
+        [&](hid_t _fileSpace, hid_t& _memSpace)
+        { return selectBlock(_fileSpace, _memSpace, _offset, _localDims); },
+        _data);
+}
 
-            int _i, _j, _k;
+/* rows of a [_numRows][3] dataset, one per id */
+void writeRows(hid_t _fileId,
+               const std::string& _name,
+               hsize_t _numRows,
+               const std::vector<hsize_t>& _ids,
+               const std::vector<real>& _data)
+{
+    writeDataset(
+        _fileId, _name, {_numRows, 3},
+        [&](hid_t _fileSpace, hid_t& _memSpace)
+        { return selectRows(_fileSpace, _memSpace, _ids); },
+        _data);
+}
 
-            while (couplForcesFile >> _i >> _j >> _k >> _fx >> _fy >> _fz)
-            {
-                (*lbfor)[_i][_j][_k].setCouplForceLoc(Real3D(_fx, _fy, _fz));
-            }
+void readRows(hid_t _fileId,
+              const std::string& _name,
+              hsize_t _numRows,
+              const std::vector<hsize_t>& _ids,
+              std::vector<real>& _data)
+{
+    readDataset(
+        _fileId, _name, {_numRows, 3},
+        [&](hid_t _fileSpace, hid_t& _memSpace)
+        { return selectRows(_fileSpace, _memSpace, _ids); },
+        _data);
+}
 
-            couplForcesFile.close();
-        }
-        else
-        {
-            if (getStepNum() != 0)
-            {
-                std::cout << "!!! Attention !!! no file with coupling forces"
-                          << "acting onto MD particles found for step " << convert.str()
-                          << std::endl;
-            }
-        }
+/* sorted ids of the real particles of this CPU */
+std::vector<hsize_t> realParticleIds(System& _system)
+{
+    std::vector<hsize_t> ids;
+    CellList realCells = _system.storage->getRealCells();
+    for (CellListIterator cit(realCells); !cit.isDone(); ++cit) ids.push_back(cit->id());
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
 
-        /*  LB-FLUID MOMENTS */
-        // create filenames for the input files //
-        std::string filenameFluid = "fluid";
-        filenameFluid.insert(0, prefix);
-        filenameFluid.append(suffix);
+/* dimensions and offset of the real sites of this CPU in the global lattice */
+void confBlock(LatticeBoltzmann& _lb,
+               int _numVals,
+               std::vector<hsize_t>& _globalDims,
+               std::vector<hsize_t>& _offset,
+               std::vector<hsize_t>& _localDims)
+{
+    int _haloSkin = _lb.getHaloSkin();
+    Int3D _Ni = _lb.getNi();
+    Int3D _myNi = _lb.getMyNi();
+    Real3D _myLeft = _lb.getMyLeft();
+
+    _globalDims.assign(4, _numVals);
+    _offset.assign(4, 0);
+    _localDims.assign(4, _numVals);
+    for (int _dim = 0; _dim < 3; _dim++)
+    {
+        _globalDims[_dim] = _Ni[_dim];
+        _offset[_dim] = (int)_myLeft[_dim];
+        _localDims[_dim] = _myNi[_dim] - 2 * _haloSkin;
+    }
+}
+}  // namespace
 
-        // read density and velocity of the fluid (excl. ghost region) //
-        int _offset = getHaloSkin();
-        Int3D _myPos = getMyPos();
+/*******************************************************************************************/
 
-        std::ifstream fluidFile;
-        fluidFile.open(filenameFluid.c_str(), std::ifstream::in);
+void LatticeBoltzmann::readLBConf(int _mode)
+{
+    System& system = getSystemRef();
+    CellList realCells = system.storage->getRealCells();
 
-        if (fluidFile.is_open())
+    if (_mode == 0)
+    {
+        // reloading values from memory
+        for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
         {
-            int _x, _y, _z, _i, _j, _k;
-            real _rho, _vx, _vy, _vz;
+            // add the forces to the integrator
+            cit->force() += getFOnPart(cit->id());
+        }
+        return;
+    }
 
-            while (fluidFile >> _x >> _y >> _z >> _rho >> _vx >> _vy >> _vz)
-            {
-                _i = _x + 1 - _myPos[0] * (_myNi[0] - 2 * _offset);
-                _j = _y + 1 - _myPos[1] * (_myNi[1] - 2 * _offset);
-                _k = _z + 1 - _myPos[2] * (_myNi[2] - 2 * _offset);
-
-                (*lbmom)[_i][_j][_k].setMom_i(0, _rho);
-                (*lbmom)[_i][_j][_k].setMom_i(1, _vx * _rho);
-                (*lbmom)[_i][_j][_k].setMom_i(2, _vy * _rho);
-                (*lbmom)[_i][_j][_k].setMom_i(3, _vz * _rho);
-            }
+    timeReadLBConf.reset();
+    real timeStart = timeReadLBConf.getElapsedTime();
 
-            fluidFile.close();
-        }
-        else
+    // fill in the coupling forces acting on MD-particles with zeros //
+    int _totNPart = getTotNPart();
+    for (int _id = 0; _id <= _totNPart; _id++)
+    {
+        setFOnPart(_id, Real3D(0.));
+    }
+
+    std::string filename = lbConfFilename(getStepNum());
+    if (!boost::filesystem::exists(filename))
+    {
+        if (getStepNum() != 0 && system.comm->rank() == 0)
         {
-            if (getStepNum() != 0)
-            {
-                std::cout << "!!! Attention !!! no file with fluid moments "
-                          << "found for step " << convert.str() << std::endl;
-            }
+            std::cout << "!!! Attention !!! no LB checkpoint " << filename << " found"
+                      << std::endl;
         }
+        return;
+    }
 
-        /*  POPULATIONS */
-        // create filenames for the input files //
-        std::string filenamePops = "pops";
-        filenamePops.insert(0, prefix);
-        filenamePops.append(suffix);
+    int _offset = getHaloSkin();
+    int _numVels = getNumVels();
+    Int3D _myNi = getMyNi();
+    std::vector<hsize_t> globalDims, offset, localDims;
+    std::vector<real> data;
 
-        // open a file to read populations from //
-        std::ifstream popsFile;
-        popsFile.open(filenamePops.c_str(), std::ifstream::in);
+    hid_t fileId = openLBConf(filename, *system.comm, false);
 
-        if (popsFile.is_open())
-        {
-            int _numVels = getNumVels();
-            int _i, _j, _k;
-            real _fi[_numVels];
+    /*  POPULATIONS */
+    confBlock(*this, _numVels, globalDims, offset, localDims);
+    readBlock(fileId, "/populations", globalDims, offset, localDims, data);
 
-            while (popsFile >> _i >> _j >> _k >> _fi[0] >> _fi[1] >> _fi[2] >> _fi[3] >> _fi[4] >>
-                   _fi[5] >> _fi[6] >> _fi[7] >> _fi[8] >> _fi[9] >> _fi[10] >> _fi[11] >>
-                   _fi[12] >> _fi[13] >> _fi[14] >> _fi[15] >> _fi[16] >> _fi[17] >> _fi[18])
-            {
-                // read in the populations on the site _i, _j, _k
+    size_t idx = 0;
+    for (int _i = _offset; _i < _myNi[0] - _offset; _i++)
+        for (int _j = _offset; _j < _myNi[1] - _offset; _j++)
+            for (int _k = _offset; _k < _myNi[2] - _offset; _k++)
                 for (int _l = 0; _l < _numVels; _l++)
                 {
-                    setPops(Int3D(_i, _j, _k), _l, _fi[_l]);
+                    setPops(Int3D(_i, _j, _k), _l, data[idx++]);
+                }
+
+    /*  LB-FLUID MOMENTS (density and momentum, halo is filled by copyDenMomToHalo) */
+    confBlock(*this, 4, globalDims, offset, localDims);
+    readBlock(fileId, "/moments", globalDims, offset, localDims, data);
+
+    idx = 0;
+    for (int _i = _offset; _i < _myNi[0] - _offset; _i++)
+        for (int _j = _offset; _j < _myNi[1] - _offset; _j++)
+            for (int _k = _offset; _k < _myNi[2] - _offset; _k++)
+                for (int _l = 0; _l < 4; _l++)
+                {
+                    lbfluid->setMom_i(_i, _j, _k, _l, data[idx++]);
                 }
+
+    /*  COUPLING FORCES ON LB-SITES (halo contributions were folded in when saving) */
+    confBlock(*this, 3, globalDims, offset, localDims);
+    readBlock(fileId, "/couplForces", globalDims, offset, localDims, data);
+
+    for (int _i = 0; _i < _myNi[0]; _i++)
+        for (int _j = 0; _j < _myNi[1]; _j++)
+            for (int _k = 0; _k < _myNi[2]; _k++)
+            {
+                (*lbfor)[_i][_j][_k].setCouplForceLoc(Real3D(0.));
             }
 
-            popsFile.close();
-        }
-        else
-        {
-            if (getStepNum() != 0)
+    idx = 0;
+    for (int _i = _offset; _i < _myNi[0] - _offset; _i++)
+        for (int _j = _offset; _j < _myNi[1] - _offset; _j++)
+            for (int _k = _offset; _k < _myNi[2] - _offset; _k++)
             {
-                std::cout << "!!! Attention !!! no file with LB populations "
-                          << "found for step " << convert.str() << std::endl;
+                (*lbfor)[_i][_j][_k].setCouplForceLoc(
+                    Real3D(data[idx], data[idx + 1], data[idx + 2]));
+                idx += 3;
             }
+
+    /*  COUPLING FORCES ON MD-PARTICLES (every CPU reads the rows of its real particles) */
+    if (H5Lexists(fileId, "/particleForces", H5P_DEFAULT) > 0)
+    {
+        std::vector<hsize_t> ids = realParticleIds(system);
+        readRows(fileId, "/particleForces", _totNPart + 1, ids, data);
+
+        for (size_t _n = 0; _n < ids.size(); _n++)
+        {
+            setFOnPart(ids[_n], Real3D(data[3 * _n], data[3 * _n + 1], data[3 * _n + 2]));
         }
+    }
+
+    io::CHECK_HDF5(H5Fclose(fileId));
 
-        // timer //
-        real timeEnd = timeReadLBConf.getElapsedTime() - timeStart;
-        printf("step %lld, CPU %d: read LB-conf and MD forces in %f seconds\n",
-               integrator->getStep(), getSystem()->comm->rank(), timeEnd);
+    for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
+    {
+        // add the forces to the integrator
+        cit->force() += getFOnPart(cit->id());
+    }
+
+    // timer //
+    real timeEnd = timeReadLBConf.getElapsedTime() - timeStart;
+    if (system.comm->rank() == 0)
+    {
+        printf("step %lld: read LB-conf and MD forces in %f seconds\n", integrator->getStep(),
+               timeEnd);
     }
 }
 
@@ -1180,167 +1358,120 @@ void LatticeBoltzmann::saveLBConf()
     timeSaveLBConf.reset();
     real timeStart = timeSaveLBConf.getElapsedTime();
 
+    System& system = getSystemRef();
+
     // check if folder exists, if not - create it //
     std::string dirRestart = "dump";
-    if (boost::filesystem::is_directory(dirRestart) == false)
+    if (system.comm->rank() == 0 && boost::filesystem::is_directory(dirRestart) == false)
     {
         boost::filesystem::create_directory(dirRestart);
     }
+    system.comm->barrier();
 
     int currDumpStep = getStepNum() + 1;
     // or you should take it directly from the integrator
     // reason: LB couples to the signal befIntV and when the integrator is
     // done with the step it is incremented, while stepNum in LB is not.
 
-    // make prefix, suffix and suffix for deletion //
-    std::string prefix = dirRestart;
-    prefix.append("/");
-
-    std::ostringstream convert, convDel, _myRank;
-    convert << currDumpStep;
-    convDel << getPrevDumpStep();
-    _myRank << getSystem()->comm->rank();
-
-    std::string suffix = ".dat";
-    suffix.insert(0, _myRank.str());
-    suffix.insert(0, ".");
-    std::string suffixDel = suffix;
-    suffix.insert(0, convert.str());
-    suffixDel.insert(0, convDel.str());
-
-    /*  COUPLING FORCES */
-    // create filenames for the input and to be removed files //
-    std::string filenameForces = "couplForces";
-    std::string filenameForcesDel = filenameForces;
-
-    filenameForces.insert(0, prefix);
-    filenameForces.append(suffix);
-    filenameForcesDel.insert(0, prefix);
-    filenameForcesDel.append(suffixDel);
-
-    // access particles' data and open a file to write coupling forces to //
-    System& system = getSystemRef();
-    CellList realCells = system.storage->getRealCells();
-
-    // write forces acting onto MD-particles //
-    FILE* couplForcesFile = fopen(filenameForces.c_str(), "w");
-
-    for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
-    {
-        long int _id = cit->id();
-        fprintf(couplForcesFile, "%ld %15.10f %15.10f %15.10f \n", _id, getFOnPart(_id).getItem(0),
-                getFOnPart(_id).getItem(1), getFOnPart(_id).getItem(2));
-    }
-
-    // write forces acting onto LB-sites (incl. ghost region) //
+    int _offset = getHaloSkin();
+    int _numVels = getNumVels();
     Int3D _myNi = getMyNi();
 
-    for (int _i = 0; _i < _myNi[0]; _i++)
+    // coupling forces in the halo belong to the neighbours' sites. fold them in now and clear
+    // the halo, the next collision then has nothing left to add
+    if (doCoupling())
     {
-        for (int _j = 0; _j < _myNi[1]; _j++)
-        {
-            for (int _k = 0; _k < _myNi[2]; _k++)
-            {
-                Real3D _couplForceLoc = (*lbfor)[_i][_j][_k].getCouplForceLoc();
-                if (_couplForceLoc.sqr() < ROUND_ERROR_PREC)
-                {
-                    // see definition of ROUND ERROR in src/include/esconfig.hpp
-                }
-                else
+        copyForcesFromHalo();
+
+        for (int _i = 0; _i < _myNi[0]; _i++)
+            for (int _j = 0; _j < _myNi[1]; _j++)
+                for (int _k = 0; _k < _myNi[2]; _k++)
                 {
-                    fprintf(couplForcesFile, "%d %d %d %15.10f %15.10f %15.10f \n", _i, _j, _k,
-                            _couplForceLoc[0], _couplForceLoc[1], _couplForceLoc[2]);
+                    if (_i < _offset || _i >= _myNi[0] - _offset || _j < _offset ||
+                        _j >= _myNi[1] - _offset || _k < _offset || _k >= _myNi[2] - _offset)
+                    {
+                        (*lbfor)[_i][_j][_k].setCouplForceLoc(Real3D(0.));
+                    }
                 }
-            }
-        }
     }
-    fclose(couplForcesFile);
 
-    /*  LB-FLUID MOMENTS */
-    // create filenames for the input and to be removed files //
-    std::string filenameFluid = "fluid";
-    std::string filenameFluidDel = filenameFluid;
+    std::vector<hsize_t> globalDims, offset, localDims;
+    std::vector<real> data;
 
-    filenameFluid.insert(0, prefix);
-    filenameFluid.append(suffix);
-    filenameFluidDel.insert(0, prefix);
-    filenameFluidDel.append(suffixDel);
+    hid_t fileId = openLBConf(lbConfFilename(currDumpStep), *system.comm, true);
 
-    // write down density and velocity of the fluid (excl. ghost region) //
-    int _offset = getHaloSkin();
-    Int3D _myPos = getMyPos();
+    /*  POPULATIONS */
+    confBlock(*this, _numVels, globalDims, offset, localDims);
+    data.clear();
+    for (int _i = _offset; _i < _myNi[0] - _offset; _i++)
+        for (int _j = _offset; _j < _myNi[1] - _offset; _j++)
+            for (int _k = _offset; _k < _myNi[2] - _offset; _k++)
+                for (int _l = 0; _l < _numVels; _l++)
+                {
+                    data.push_back(getPops(Int3D(_i, _j, _k), _l));
+                }
+    writeBlock(fileId, "/populations", globalDims, offset, localDims, data);
 
-    FILE* fluidFile = fopen(filenameFluid.c_str(), "w");
+    /*  LB-FLUID MOMENTS */
+    confBlock(*this, 4, globalDims, offset, localDims);
+    data.clear();
+    for (int _i = _offset; _i < _myNi[0] - _offset; _i++)
+        for (int _j = _offset; _j < _myNi[1] - _offset; _j++)
+            for (int _k = _offset; _k < _myNi[2] - _offset; _k++)
+                for (int _l = 0; _l < 4; _l++)
+                {
+                    data.push_back(lbfluid->getMom_i(_i, _j, _k, _l));
+                }
+    writeBlock(fileId, "/moments", globalDims, offset, localDims, data);
 
+    /*  COUPLING FORCES ON LB-SITES */
+    confBlock(*this, 3, globalDims, offset, localDims);
+    data.clear();
     for (int _i = _offset; _i < _myNi[0] - _offset; _i++)
-    {
         for (int _j = _offset; _j < _myNi[1] - _offset; _j++)
-        {
             for (int _k = _offset; _k < _myNi[2] - _offset; _k++)
             {
-                real _rho = (*lbmom)[_i][_j][_k].getMom_i(0);
-                real _jx, _jy, _jz;
-                _jx = (*lbmom)[_i][_j][_k].getMom_i(1);
-                _jy = (*lbmom)[_i][_j][_k].getMom_i(2);
-                _jz = (*lbmom)[_i][_j][_k].getMom_i(3);
-
-                // -1 comes from the offset. we have to output the first real node as 0
-                fprintf(fluidFile, "%d %d %d %15.10f %15.10f %15.10f %15.10f\n",
-                        _myPos[0] * (_myNi[0] - 2 * _offset) + _i - 1,
-                        _myPos[1] * (_myNi[1] - 2 * _offset) + _j - 1,
-                        _myPos[2] * (_myNi[2] - 2 * _offset) + _k - 1, _rho, _jx / _rho, _jy / _rho,
-                        _jz / _rho);
+                Real3D _couplForceLoc = (*lbfor)[_i][_j][_k].getCouplForceLoc();
+                data.push_back(_couplForceLoc[0]);
+                data.push_back(_couplForceLoc[1]);
+                data.push_back(_couplForceLoc[2]);
             }
-        }
-    }
-    fclose(fluidFile);
-
-    /*  POPULATIONS */
-    // create filenames for the input and to be removed files //
-    std::string filenamePops = "pops";
-    std::string filenamePopsDel = filenamePops;
+    writeBlock(fileId, "/couplForces", globalDims, offset, localDims, data);
 
-    filenamePops.insert(0, prefix);
-    filenamePops.append(suffix);
-    filenamePopsDel.insert(0, prefix);
-    filenamePopsDel.append(suffixDel);
-
-    // write populations at LB-sites (incl. ghost region) //
-    FILE* popsFile = fopen(filenamePops.c_str(), "w");
-
-    int _numVels = getNumVels();
-    for (int _i = 0; _i < _myNi[0]; _i++)
+    /*  COUPLING FORCES ON MD-PARTICLES */
+    if (doCoupling())
     {
-        for (int _j = 0; _j < _myNi[1]; _j++)
+        // every CPU writes the rows of its real particles, fOnPart also holds stale entries
+        // of particles that left the CPU
+        std::vector<hsize_t> ids = realParticleIds(system);
+        data.clear();
+        for (hsize_t _id : ids)
         {
-            for (int _k = 0; _k < _myNi[2]; _k++)
-            {
-                fprintf(popsFile, "%d %d %d ", _i, _j, _k);
-                for (int _l = 0; _l < _numVels; _l++)
-                {
-                    fprintf(popsFile, "%15.10f ", getPops(Int3D(_i, _j, _k), _l));
-                }
-                fprintf(popsFile, "\n ");
-            }
+            Real3D _fOnPart = getFOnPart(_id);
+            data.push_back(_fOnPart[0]);
+            data.push_back(_fOnPart[1]);
+            data.push_back(_fOnPart[2]);
         }
+        writeRows(fileId, "/particleForces", getTotNPart() + 1, ids, data);
     }
 
-    fclose(popsFile);
+    io::CHECK_HDF5(H5Fclose(fileId));
 
-    // delete previous dumps //
-    if (getPrevDumpStep() != 0)
+    // delete previous dump //
+    if (getPrevDumpStep() != 0 && system.comm->rank() == 0)
     {
-        boost::filesystem::remove(filenameForcesDel);
-        boost::filesystem::remove(filenameFluidDel);
-        boost::filesystem::remove(filenamePopsDel);
+        boost::filesystem::remove(lbConfFilename(getPrevDumpStep()));
     }
 
     setPrevDumpStep(currDumpStep);
 
     // timer //
     real timeEnd = timeSaveLBConf.getElapsedTime() - timeStart;
-    printf("step %lld, CPU %d: saved LB-conf and MD forces in %f seconds\n", integrator->getStep(),
-           system.comm->rank(), timeEnd);
+    if (system.comm->rank() == 0)
+    {
+        printf("step %lld: saved LB-conf and MD forces in %f seconds\n", integrator->getStep(),
+               timeEnd);
+    }
 }
 
 /*******************************************************************************************/
@@ -1438,361 +1569,260 @@ Int3D LatticeBoltzmann::findGlobIdx()
 /*******************************************************************************************/
 
 /* COMMUNICATE POPULATIONS IN HALO REGIONS TO THE NEIGHBOURING CPUs */
+// populations leaving the CPU through its left (even _dir) or right (odd _dir) face
+namespace
+{
+const int numPopTransf = 5;  // num of popul to be sent through a face
+const int haloPops[6][numPopTransf] = {{2, 8, 10, 12, 14}, {1, 7, 9, 11, 13},
+                                       {4, 8, 9, 16, 18},  {3, 7, 10, 15, 17},
+                                       {6, 12, 13, 16, 17}, {5, 11, 14, 15, 18}};
+}  // namespace
+
 void LatticeBoltzmann::commHalo()
 {
-    int i, j, k, idx;            // running indices
-    int const numPopTransf = 5;  // num of popul and hydro moms to be sent
-    int rnode, snode;            // CPU ranks to receive from and to send to
-    std::vector<real> bufToSend, bufToRecv;
+    for (int _dim = 0; _dim < 3; _dim++)
+    {
+        startHaloComm(_dim);
+        finishHaloComm(_dim);
+    }
+}
+
+/*******************************************************************************************/
 
+/* PACK POPULATIONS STREAMED INTO THE HALO PLANE OF FACE _dir */
+// with _numVals > numPopTransf the density and mass flux of the adjacent real site follow
+void LatticeBoltzmann::packHalo(int _dir, std::vector<real>& _buf, int _numVals)
+{
+    int _dim = _dir / 2;
+    int _d1 = (_dim + 1) % 3;
+    int _d2 = (_dim + 2) % 3;
     int _offset = getHaloSkin();
     Int3D _myNi = getMyNi();
-    Int3D _myPos = getMyPos();
-
-    mpi::communicator world;
 
-    //////////////////////
-    //// X-direction /////
-    //////////////////////
-    int numDataTransf = numPopTransf * _myNi[1] * _myNi[2];
-    bufToSend.resize(numDataTransf);
-    bufToRecv.resize(numDataTransf);
+    _buf.resize(_numVals * _myNi[_d1] * _myNi[_d2]);
 
-    /* send to right, recv from left i = 1, 7, 9, 11, 13 */
-    snode = getMyNeigh(1);
-    rnode = getMyNeigh(0);
+    Int3D _site;
+    _site[_dim] = (_dir % 2 == 0) ? 0 : _myNi[_dim] - _offset;
+    int _realLayer = (_dir % 2 == 0) ? _offset : _myNi[_dim] - 2 * _offset;
 
-    // prepare message for sending
-    i = _myNi[0] - _offset;
-    idx = 0;
-    for (k = 0; k < _myNi[2]; k++)
+    int idx = 0;
+    for (_site[_d2] = 0; _site[_d2] < _myNi[_d2]; _site[_d2]++)
     {
-        for (j = 0; j < _myNi[1]; j++, idx += numPopTransf)
+        for (_site[_d1] = 0; _site[_d1] < _myNi[_d1]; _site[_d1]++, idx += _numVals)
         {
-            bufToSend[idx] = (*ghostlat)[i][j][k].getF_i(1);
-            bufToSend[idx + 1] = (*ghostlat)[i][j][k].getF_i(7);
-            bufToSend[idx + 2] = (*ghostlat)[i][j][k].getF_i(9);
-            bufToSend[idx + 3] = (*ghostlat)[i][j][k].getF_i(11);
-            bufToSend[idx + 4] = (*ghostlat)[i][j][k].getF_i(13);
-        }
-    }
+            int _s = ghostlat->index(_site[0], _site[1], _site[2]);
+            for (int l = 0; l < numPopTransf; l++)
+            {
+                _buf[idx + l] = ghostlat->pop(haloPops[_dir][l])[_s];
+            }
 
-    // send and receive data or use memcpy if number of CPU in x-dir is 1
-    if (getNodeGrid().getItem(0) > 1)
-    {
-        if (_myPos[0] % 2 == 0)
-        {
-            world.send(snode, COMM_DIR_0, bufToSend);
-            world.recv(rnode, COMM_DIR_0, bufToRecv);
-        }
-        else
-        {
-            world.recv(rnode, COMM_DIR_0, bufToRecv);
-            world.send(snode, COMM_DIR_0, bufToSend);
+            if (_numVals > numPopTransf)
+            {
+                Int3D _real = _site;
+                _real[_dim] = _realLayer;
+                for (int l = 0; l < 4; l++)
+                {
+                    _buf[idx + numPopTransf + l] = lbfluid->getMom_i(_real[0], _real[1], _real[2], l);
+                }
+            }
         }
     }
-    else
-    {
-        bufToRecv = bufToSend;
-    }
+}
 
-    // unpack message
-    i = _offset;
-    idx = 0;
-    for (k = 0; k < _myNi[2]; k++)
-    {
-        for (j = 0; j < _myNi[1]; j++, idx += numPopTransf)
-        {
-            (*ghostlat)[i][j][k].setF_i(1, bufToRecv[idx]);
-            (*ghostlat)[i][j][k].setF_i(7, bufToRecv[idx + 1]);
-            (*ghostlat)[i][j][k].setF_i(9, bufToRecv[idx + 2]);
-            (*ghostlat)[i][j][k].setF_i(11, bufToRecv[idx + 3]);
-            (*ghostlat)[i][j][k].setF_i(13, bufToRecv[idx + 4]);
-        }
-    }
+/*******************************************************************************************/
 
-    /* send to left, recv from right i = 2, 8, 10, 12, 14 */
-    snode = getMyNeigh(0);
-    rnode = getMyNeigh(1);
+/* UNPACK POPULATIONS THAT ENTERED THROUGH THE OPPOSITE FACE OF _dir */
+void LatticeBoltzmann::unpackHalo(int _dir, std::vector<real>& _buf, int _numVals)
+{
+    int _dim = _dir / 2;
+    int _d1 = (_dim + 1) % 3;
+    int _d2 = (_dim + 2) % 3;
+    int _offset = getHaloSkin();
+    Int3D _myNi = getMyNi();
 
-    // prepare message for sending
-    i = 0;
-    idx = 0;
-    for (k = 0; k < _myNi[2]; k++)
-    {
-        for (j = 0; j < _myNi[1]; j++, idx += numPopTransf)
-        {
-            bufToSend[idx] = (*ghostlat)[i][j][k].getF_i(2);
-            bufToSend[idx + 1] = (*ghostlat)[i][j][k].getF_i(8);
-            bufToSend[idx + 2] = (*ghostlat)[i][j][k].getF_i(10);
-            bufToSend[idx + 3] = (*ghostlat)[i][j][k].getF_i(12);
-            bufToSend[idx + 4] = (*ghostlat)[i][j][k].getF_i(14);
-        }
-    }
+    // populations moving right arrive at the first real layer, moving left at the last one
+    Int3D _site;
+    _site[_dim] = (_dir % 2 == 0) ? _myNi[_dim] - 2 * _offset : _offset;
 
-    // send and receive data or use memcpy if number of CPU in x-dir is 1
-    if (getNodeGrid().getItem(0) > 1)
+    int idx = 0;
+    for (_site[_d2] = 0; _site[_d2] < _myNi[_d2]; _site[_d2]++)
     {
-        if (_myPos[0] % 2 == 0)
-        {
-            world.send(snode, COMM_DIR_1, bufToSend);
-            world.recv(rnode, COMM_DIR_1, bufToRecv);
-        }
-        else
+        for (_site[_d1] = 0; _site[_d1] < _myNi[_d1]; _site[_d1]++, idx += _numVals)
         {
-            world.recv(rnode, COMM_DIR_1, bufToRecv);
-            world.send(snode, COMM_DIR_1, bufToSend);
+            int _s = ghostlat->index(_site[0], _site[1], _site[2]);
+            for (int l = 0; l < numPopTransf; l++)
+            {
+                ghostlat->pop(haloPops[_dir][l])[_s] = _buf[idx + l];
+            }
         }
     }
-    else
-    {
-        bufToRecv = bufToSend;
-    }
+}
 
-    // unpack message
-    i = _myNi[0] - 2 * _offset;
-    idx = 0;
-    for (k = 0; k < _myNi[2]; k++)
-    {
-        for (j = 0; j < _myNi[1]; j++, idx += numPopTransf)
-        {
-            (*ghostlat)[i][j][k].setF_i(2, bufToRecv[idx]);
-            (*ghostlat)[i][j][k].setF_i(8, bufToRecv[idx + 1]);
-            (*ghostlat)[i][j][k].setF_i(10, bufToRecv[idx + 2]);
-            (*ghostlat)[i][j][k].setF_i(12, bufToRecv[idx + 3]);
-            (*ghostlat)[i][j][k].setF_i(14, bufToRecv[idx + 4]);
-        }
-    }
+/*******************************************************************************************/
 
-    //////////////////////
-    //// Y-direction /////
-    //////////////////////
-    numDataTransf = numPopTransf * _myNi[0] * _myNi[2];
-    bufToSend.resize(numDataTransf);  // resize bufToSend
-    bufToRecv.resize(numDataTransf);  // resize bufToRecv
+/* POST NON-BLOCKING HALO EXCHANGE IN DIMENSION _dim (BOTH DIRECTIONS AT ONCE) */
+void LatticeBoltzmann::startHaloComm(int _dim)
+{
+    // across sliding boundaries the populations need the local fluid velocity as well
+    int _numVals = (_dim == 2 && doLeesEdwards()) ? numPopTransf + 4 : numPopTransf;
 
-    /* send to right, recv from left i = 3, 7, 10, 15, 17 */
-    snode = getMyNeigh(3);
-    rnode = getMyNeigh(2);
+    packHalo(2 * _dim, haloSend[0], _numVals);
+    packHalo(2 * _dim + 1, haloSend[1], _numVals);
+    haloRecv[0].resize(haloSend[0].size());
+    haloRecv[1].resize(haloSend[1].size());
 
-    // prepare message for sending
-    j = _myNi[1] - _offset;
-    idx = 0;
-    for (k = 0; k < _myNi[2]; k++)
+    if (getNodeGrid().getItem(_dim) > 1)
     {
-        for (i = 0; i < _myNi[0]; i++, idx += numPopTransf)
-        {
-            bufToSend[idx] = (*ghostlat)[i][j][k].getF_i(3);
-            bufToSend[idx + 1] = (*ghostlat)[i][j][k].getF_i(7);
-            bufToSend[idx + 2] = (*ghostlat)[i][j][k].getF_i(10);
-            bufToSend[idx + 3] = (*ghostlat)[i][j][k].getF_i(15);
-            bufToSend[idx + 4] = (*ghostlat)[i][j][k].getF_i(17);
-        }
-    }
+        mpi::communicator world;
+        int _n = haloSend[0].size();
+        int _left = getMyNeigh(2 * _dim);
+        int _right = getMyNeigh(2 * _dim + 1);
 
-    // send and receive data or use memcpy if number of CPU in y-dir is 1
-    if (getNodeGrid().getItem(1) > 1)
-    {
-        if (_myPos[1] % 2 == 0)
-        {
-            world.send(snode, COMM_DIR_0, bufToSend);
-            world.recv(rnode, COMM_DIR_0, bufToRecv);
-        }
-        else
-        {
-            world.recv(rnode, COMM_DIR_0, bufToRecv);
-            world.send(snode, COMM_DIR_0, bufToSend);
-        }
+        // the tags tell the directions apart if left and right neighbour are the same CPU
+        haloReqs[0] = world.irecv(_left, COMM_DIR_0, haloRecv[1].data(), _n);
+        haloReqs[1] = world.irecv(_right, COMM_DIR_1, haloRecv[0].data(), _n);
+        haloReqs[2] = world.isend(_right, COMM_DIR_0, haloSend[1].data(), _n);
+        haloReqs[3] = world.isend(_left, COMM_DIR_1, haloSend[0].data(), _n);
     }
     else
     {
-        bufToRecv = bufToSend;
-    }
-
-    // unpack message
-    j = _offset;
-    idx = 0;
-    for (k = 0; k < _myNi[2]; k++)
-    {
-        for (i = 0; i < _myNi[0]; i++, idx += numPopTransf)
-        {
-            (*ghostlat)[i][j][k].setF_i(3, bufToRecv[idx]);
-            (*ghostlat)[i][j][k].setF_i(7, bufToRecv[idx + 1]);
-            (*ghostlat)[i][j][k].setF_i(10, bufToRecv[idx + 2]);
-            (*ghostlat)[i][j][k].setF_i(15, bufToRecv[idx + 3]);
-            (*ghostlat)[i][j][k].setF_i(17, bufToRecv[idx + 4]);
-        }
+        haloRecv[0].swap(haloSend[0]);
+        haloRecv[1].swap(haloSend[1]);
     }
+}
 
-    /* send to left, recv from right i = 4, 8, 9, 16, 18 */
-    snode = getMyNeigh(2);
-    rnode = getMyNeigh(3);
+/*******************************************************************************************/
 
-    // prepare message for sending
-    j = 0;
-    idx = 0;
-    for (k = 0; k < _myNi[2]; k++)
+/* WAIT FOR THE HALO EXCHANGE IN DIMENSION _dim AND UNPACK IT */
+void LatticeBoltzmann::finishHaloComm(int _dim)
+{
+    if (getNodeGrid().getItem(_dim) > 1)
     {
-        for (i = 0; i < _myNi[0]; i++, idx += numPopTransf)
-        {
-            bufToSend[idx] = (*ghostlat)[i][j][k].getF_i(4);
-            bufToSend[idx + 1] = (*ghostlat)[i][j][k].getF_i(8);
-            bufToSend[idx + 2] = (*ghostlat)[i][j][k].getF_i(9);
-            bufToSend[idx + 3] = (*ghostlat)[i][j][k].getF_i(16);
-            bufToSend[idx + 4] = (*ghostlat)[i][j][k].getF_i(18);
-        }
+        mpi::wait_all(haloReqs, haloReqs + 4);
     }
 
-    // send and receive data or use memcpy if number of CPU in y-dir is 1
-    if (getNodeGrid().getItem(1) > 1)
-    {
-        if (_myPos[1] % 2 == 0)
-        {
-            world.send(snode, COMM_DIR_1, bufToSend);
-            world.recv(rnode, COMM_DIR_1, bufToRecv);
-        }
-        else
-        {
-            world.recv(rnode, COMM_DIR_1, bufToRecv);
-            world.send(snode, COMM_DIR_1, bufToSend);
-        }
-    }
-    else
+    int _numVals = numPopTransf;
+    if (_dim == 2 && doLeesEdwards())
     {
-        bufToRecv = bufToSend;
+        _numVals += 4;
+        // populations that crossed the bottom or top of the box enter the sheared image
+        if (getMyPos()[2] == getNodeGrid()[2] - 1) shearHaloPops(4, haloRecv[0]);
+        if (getMyPos()[2] == 0) shearHaloPops(5, haloRecv[1]);
     }
 
-    // unpack message
-    j = _myNi[1] - 2 * _offset;
-    idx = 0;
-    for (k = 0; k < _myNi[2]; k++)
-    {
-        for (i = 0; i < _myNi[0]; i++, idx += numPopTransf)
-        {
-            (*ghostlat)[i][j][k].setF_i(4, bufToRecv[idx]);
-            (*ghostlat)[i][j][k].setF_i(8, bufToRecv[idx + 1]);
-            (*ghostlat)[i][j][k].setF_i(9, bufToRecv[idx + 2]);
-            (*ghostlat)[i][j][k].setF_i(16, bufToRecv[idx + 3]);
-            (*ghostlat)[i][j][k].setF_i(18, bufToRecv[idx + 4]);
-        }
-    }
+    unpackHalo(2 * _dim, haloRecv[0], _numVals);
+    unpackHalo(2 * _dim + 1, haloRecv[1], _numVals);
+}
 
-    //////////////////////
-    //// Z-direction /////
-    //////////////////////
-    numDataTransf = numPopTransf * _myNi[0] * _myNi[1];
-    bufToSend.resize(numDataTransf);  // resize bufToSend
-    bufToRecv.resize(numDataTransf);  // resize bufToRecv
+/*******************************************************************************************/
 
-    /* send to right, recv from left i = 5, 11, 14, 15, 18 */
-    snode = getMyNeigh(5);
-    rnode = getMyNeigh(4);
+/* LEES-EDWARDS SLIDING BOUNDARIES */
+// shear flow along x with gradient along z as for VelocityVerletLE; the image above the
+// box is displaced by system.shearOffset and moves with shearRate * Lz
+bool LatticeBoltzmann::doLeesEdwards()
+{
+    if (getSystemRef().shearRate == 0.) return false;
 
-    // prepare message for sending
-    k = _myNi[2] - _offset;
-    idx = 0;
-    for (j = 0; j < _myNi[1]; j++)
+    if (getNodeGrid()[0] > 1)
     {
-        for (i = 0; i < _myNi[0]; i++, idx += numPopTransf)
-        {
-            bufToSend[idx] = (*ghostlat)[i][j][k].getF_i(5);
-            bufToSend[idx + 1] = (*ghostlat)[i][j][k].getF_i(11);
-            bufToSend[idx + 2] = (*ghostlat)[i][j][k].getF_i(14);
-            bufToSend[idx + 3] = (*ghostlat)[i][j][k].getF_i(15);
-            bufToSend[idx + 4] = (*ghostlat)[i][j][k].getF_i(18);
-        }
+        throw std::runtime_error(
+            "LatticeBoltzmann: Lees-Edwards boundaries need nodeGrid[0] = 1 (no split along x)");
     }
+    return true;
+}
 
-    // send and receive data or use memcpy if number of CPU in z-dir is 1
-    if (getNodeGrid().getItem(2) > 1)
-    {
-        if (_myPos[2] % 2 == 0)
-        {
-            world.send(snode, COMM_DIR_0, bufToSend);
-            world.recv(rnode, COMM_DIR_0, bufToRecv);
-        }
-        else
-        {
-            world.recv(rnode, COMM_DIR_0, bufToRecv);
-            world.send(snode, COMM_DIR_0, bufToSend);
-        }
-    }
-    else
-    {
-        bufToRecv = bufToSend;
-    }
+/* velocity jump across the sliding boundary (in lattice units) */
+real LatticeBoltzmann::getShearJump()
+{
+    System& system = getSystemRef();
+    return system.shearRate * system.bc->getBoxL()[2] * convLenMDtoLB() / convTimeMDtoLB();
+}
 
-    // unpack message
-    k = _offset;
-    idx = 0;
-    for (j = 0; j < _myNi[1]; j++)
-    {
-        for (i = 0; i < _myNi[0]; i++, idx += numPopTransf)
-        {
-            (*ghostlat)[i][j][k].setF_i(5, bufToRecv[idx]);
-            (*ghostlat)[i][j][k].setF_i(11, bufToRecv[idx + 1]);
-            (*ghostlat)[i][j][k].setF_i(14, bufToRecv[idx + 2]);
-            (*ghostlat)[i][j][k].setF_i(15, bufToRecv[idx + 3]);
-            (*ghostlat)[i][j][k].setF_i(18, bufToRecv[idx + 4]);
-        }
-    }
+/* SHIFT A Z-PLANE OF _numVals VALUES PER SITE THAT CROSSED THE BOX BORDER IN _zDir */
+// what arrives at x came from x + _zDir * shearOffset, linear interpolation between the
+// two nearest sites conserves the sum over the plane. The halo columns are filled periodically.
+void LatticeBoltzmann::shiftHaloPlane(std::vector<real>& _buf, int _numVals, int _zDir)
+{
+    int _offset = getHaloSkin();
+    Int3D _myNi = getMyNi();
+    int _nx = _myNi[0] - 2 * _offset;  // all sites along x, as nodeGrid[0] = 1
 
-    /* send to left, recv from right i = 6, 12, 13, 16, 17 */
-    snode = getMyNeigh(4);
-    rnode = getMyNeigh(5);
+    real _shift = _zDir * getSystemRef().shearOffset / getA();
+    int _n = static_cast<int>(floor(_shift));
+    real _frac = _shift - _n;
 
-    // prepare message for sending
-    k = 0;
-    idx = 0;
-    for (j = 0; j < _myNi[1]; j++)
+    std::vector<real> _row(_numVals * _nx);
+    for (int j = 0; j < _myNi[1]; j++)
     {
-        for (i = 0; i < _myNi[0]; i++, idx += numPopTransf)
-        {
-            bufToSend[idx] = (*ghostlat)[i][j][k].getF_i(6);
-            bufToSend[idx + 1] = (*ghostlat)[i][j][k].getF_i(12);
-            bufToSend[idx + 2] = (*ghostlat)[i][j][k].getF_i(13);
-            bufToSend[idx + 3] = (*ghostlat)[i][j][k].getF_i(16);
-            bufToSend[idx + 4] = (*ghostlat)[i][j][k].getF_i(17);
-        }
-    }
+        real* _line = &_buf[_numVals * _myNi[0] * j];
 
-    // send and receive data or use memcpy if number of CPU in z-dir is 1
-    if (getNodeGrid().getItem(2) > 1)
-    {
-        if (_myPos[2] % 2 == 0)
+        for (int i = 0; i < _nx; i++)
         {
-            world.send(snode, COMM_DIR_1, bufToSend);
-            world.recv(rnode, COMM_DIR_1, bufToRecv);
+            int _i0 = ((i + _n) % _nx + _nx) % _nx + _offset;
+            int _i1 = (_i0 - _offset + 1) % _nx + _offset;
+            for (int v = 0; v < _numVals; v++)
+            {
+                _row[_numVals * i + v] =
+                    (1. - _frac) * _line[_numVals * _i0 + v] + _frac * _line[_numVals * _i1 + v];
+            }
         }
-        else
+
+        for (int i = 0; i < _myNi[0]; i++)
         {
-            world.recv(rnode, COMM_DIR_1, bufToRecv);
-            world.send(snode, COMM_DIR_1, bufToSend);
+            int _ir = ((i - _offset) % _nx + _nx) % _nx;
+            for (int v = 0; v < _numVals; v++)
+            {
+                _line[_numVals * i + v] = _row[_numVals * _ir + v];
+            }
         }
     }
-    else
+}
+
+/* SHIFT DENSITY AND MASS FLUX THAT CROSSED THE BOX BORDER IN _zDir INTO THE SHEARED IMAGE */
+void LatticeBoltzmann::shearHaloMoms(std::vector<real>& _buf, int _zDir)
+{
+    shiftHaloPlane(_buf, 4, _zDir);
+
+    real _du = -_zDir * getShearJump();
+    for (size_t idx = 0; idx < _buf.size(); idx += 4)
     {
-        bufToRecv = bufToSend;
+        _buf[idx + 1] += _buf[idx] * _du;
     }
+}
 
-    // unpack message
-    k = _myNi[2] - 2 * _offset;
-    idx = 0;
-    for (j = 0; j < _myNi[1]; j++)
+/* SHIFT POPULATIONS LEAVING THROUGH FACE _dir INTO THE SHEARED IMAGE */
+// the x velocity changes by the velocity jump, the populations by the corresponding change of
+// their equilibrium at the local density and velocity (Wagner & Pagonabarraga, 2002)
+void LatticeBoltzmann::shearHaloPops(int _dir, std::vector<real>& _buf)
+{
+    int _zDir = (_dir % 2 == 0) ? -1 : 1;
+    int _numVals = numPopTransf + 4;
+    real _invCs2 = 3.;  // lattice units, |c_i| = 1
+
+    shiftHaloPlane(_buf, _numVals, _zDir);
+
+    // moving up the fluid enters the image that moves by -shearRate * Lz relative to it
+    real _du = -_zDir * getShearJump();
+
+    for (size_t idx = 0; idx < _buf.size(); idx += _numVals)
     {
-        for (i = 0; i < _myNi[0]; i++, idx += numPopTransf)
+        real _rho = _buf[idx + numPopTransf];
+        if (_rho <= 0.) continue;
+        Real3D _u = Real3D(_buf[idx + numPopTransf + 1], _buf[idx + numPopTransf + 2],
+                           _buf[idx + numPopTransf + 3]) /
+                    _rho;
+
+        for (int l = 0; l < numPopTransf; l++)
         {
-            (*ghostlat)[i][j][k].setF_i(6, bufToRecv[idx]);
-            (*ghostlat)[i][j][k].setF_i(12, bufToRecv[idx + 1]);
-            (*ghostlat)[i][j][k].setF_i(13, bufToRecv[idx + 2]);
-            (*ghostlat)[i][j][k].setF_i(16, bufToRecv[idx + 3]);
-            (*ghostlat)[i][j][k].setF_i(17, bufToRecv[idx + 4]);
+            int _l = haloPops[_dir][l];
+            Real3D _c = getCi(_l);
+            real _cu = _c * _u;
+            real _cd = _c[0] * _du;
+            _buf[idx + l] += getEqWeight(_l) * _rho *
+                             (_invCs2 * _cd + 0.5 * _invCs2 * _invCs2 * (2. * _cu * _cd + _cd * _cd) -
+                              0.5 * _invCs2 * (2. * _u[0] * _du + _du * _du));
         }
     }
-
-    // release buffers
-    bufToSend.resize(0);
-    bufToRecv.resize(0);
 }
 
 /*******************************************************************************************/
@@ -2072,6 +2102,9 @@ void LatticeBoltzmann::copyForcesFromHalo()
         bufToRecv = bufToSend;
     }
 
+    // forces deposited above the top slide with the sheared image
+    if (_myPos[2] == 0 && doLeesEdwards()) shiftHaloPlane(bufToRecv, numForceComp, 1);
+
     // unpack message
     k = _offset;
     for (j = 0; j < _myNi[1]; j++)
@@ -2122,6 +2155,9 @@ void LatticeBoltzmann::copyForcesFromHalo()
         bufToRecv = bufToSend;
     }
 
+    if (_myPos[2] == getNodeGrid()[2] - 1 && doLeesEdwards())
+        shiftHaloPlane(bufToRecv, numForceComp, -1);
+
     // unpack message
     k = _myNi[2] - 2 * _offset;
     for (j = 0; j < _myNi[1]; j++)
@@ -2175,7 +2211,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[1] * k + j * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                bufToSend[idx + l] = (*lbmom)[i][j][k].getMom_i(l);
+                bufToSend[idx + l] = lbfluid->getMom_i(i, j, k, l);
             }
         }
     }
@@ -2208,7 +2244,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[1] * k + j * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                (*lbmom)[i][j][k].setMom_i(l, bufToRecv[idx + l]);
+                lbfluid->setMom_i(i, j, k, l, bufToRecv[idx + l]);
             }
         }
     }
@@ -2226,7 +2262,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[1] * k + j * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                bufToSend[idx + l] = (*lbmom)[i][j][k].getMom_i(l);
+                bufToSend[idx + l] = lbfluid->getMom_i(i, j, k, l);
             }
         }
     }
@@ -2259,7 +2295,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[1] * k + j * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                (*lbmom)[i][j][k].setMom_i(l, bufToRecv[idx + l]);
+                lbfluid->setMom_i(i, j, k, l, bufToRecv[idx + l]);
             }
         }
     }
@@ -2284,7 +2320,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[0] * k + i * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                bufToSend[idx + l] = (*lbmom)[i][j][k].getMom_i(l);
+                bufToSend[idx + l] = lbfluid->getMom_i(i, j, k, l);
             }
         }
     }
@@ -2317,7 +2353,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[0] * k + i * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                (*lbmom)[i][j][k].setMom_i(l, bufToRecv[idx + l]);
+                lbfluid->setMom_i(i, j, k, l, bufToRecv[idx + l]);
             }
         }
     }
@@ -2335,7 +2371,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[0] * k + i * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                bufToSend[idx + l] = (*lbmom)[i][j][k].getMom_i(l);
+                bufToSend[idx + l] = lbfluid->getMom_i(i, j, k, l);
             }
         }
     }
@@ -2368,7 +2404,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[0] * k + i * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                (*lbmom)[i][j][k].setMom_i(l, bufToRecv[idx + l]);
+                lbfluid->setMom_i(i, j, k, l, bufToRecv[idx + l]);
             }
         }
     }
@@ -2393,7 +2429,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[0] * j + i * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                bufToSend[idx + l] = (*lbmom)[i][j][k].getMom_i(l);
+                bufToSend[idx + l] = lbfluid->getMom_i(i, j, k, l);
             }
         }
     }
@@ -2417,6 +2453,9 @@ void LatticeBoltzmann::copyDenMomToHalo()
         bufToRecv = bufToSend;
     }
 
+    // the halo below the box holds the sheared image of the top layer
+    if (_myPos[2] == 0 && doLeesEdwards()) shearHaloMoms(bufToRecv, 1);
+
     // unpack message
     k = 0;
     for (j = 0; j < _myNi[1]; j++)
@@ -2426,7 +2465,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[0] * j + i * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                (*lbmom)[i][j][k].setMom_i(l, bufToRecv[idx + l]);
+                lbfluid->setMom_i(i, j, k, l, bufToRecv[idx + l]);
             }
         }
     }
@@ -2444,7 +2483,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[0] * j + i * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                bufToSend[idx + l] = (*lbmom)[i][j][k].getMom_i(l);
+                bufToSend[idx + l] = lbfluid->getMom_i(i, j, k, l);
             }
         }
     }
@@ -2468,6 +2507,8 @@ void LatticeBoltzmann::copyDenMomToHalo()
         bufToRecv = bufToSend;
     }
 
+    if (_myPos[2] == getNodeGrid()[2] - 1 && doLeesEdwards()) shearHaloMoms(bufToRecv, -1);
+
     // unpack message
     k = _myNi[2] - _offset;
     for (j = 0; j < _myNi[1]; j++)
@@ -2477,7 +2518,7 @@ void LatticeBoltzmann::copyDenMomToHalo()
             idx = numPopTransf * _myNi[0] * j + i * numPopTransf;
             for (int l = 0; l < numPopTransf; ++l)
             {
-                (*lbmom)[i][j][k].setMom_i(l, bufToRecv[idx + l]);
+                lbfluid->setMom_i(i, j, k, l, bufToRecv[idx + l]);
             }
         }
     }
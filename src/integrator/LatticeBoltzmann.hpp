@@ -31,9 +31,8 @@
 #include "Real3D.hpp"
 #include "Int3D.hpp"
 #include "LatticeSite.hpp"
+#include "mpi.hpp"
 
-typedef std::vector<std::vector<std::vector<espressopp::integrator::LBSite> > > lblattice;
-typedef std::vector<std::vector<std::vector<espressopp::integrator::LBMom> > > lbmoments;
 typedef std::vector<std::vector<std::vector<espressopp::integrator::LBForce> > > lbforces;
 
 namespace espressopp
@@ -228,22 +227,33 @@ public:
     void coupleLBtoMD();                   //
     void calcRandForce(class Particle &);  // calc random force
     void calcViscForce(class Particle &);
-    void calcDenMom();
     real convMDtoLB(int _opCode);
 
-    void collideStream();  // use collide-stream scheme
+    void collideStream();  // use fused collide-stream scheme
 
-    void streaming(int _i, int _j, int _k);  // streaming along velocities
+    void collideSites(Int3D _lo, Int3D _hi);  // collide-stream sites in [_lo, _hi)
+    void drawFluctuations();                  // random numbers for all real sites
 
     /* MPI FUNCTIONS */
     void findMyNeighbours();
     void assignMyLattice();
     Int3D findGlobIdx();        // find global index of first lb site of cpu
     void commHalo();            // communicate populations in halo
+    void startHaloComm(int _dim);   // post non-blocking halo exchange in _dim
+    void finishHaloComm(int _dim);  // wait for it and unpack populations
+    void packHalo(int _dir, std::vector<real> &_buf, int _numVals);
+    void unpackHalo(int _dir, std::vector<real> &_buf, int _numVals);
     void copyForcesFromHalo();  // copy coupling forces from halo regions to the real lattice sites
     void copyDenMomToHalo();    // copy den and j from real lattice sites to halo
     void makeDecompose();  // decompose storage to put escaped real particles into neighbouring CPU
 
+    /* LEES-EDWARDS SLIDING BOUNDARIES */
+    bool doLeesEdwards();  // true if the system is sheared (VelocityVerletLE)
+    real getShearJump();   // velocity jump across the z-border in lattice units
+    void shiftHaloPlane(std::vector<real> &_buf, int _numVals, int _zDir);
+    void shearHaloPops(int _dir, std::vector<real> &_buf);
+    void shearHaloMoms(std::vector<real> &_buf, int _zDir);
+
     /* control functions */
     void computeDensity(int _i, int _j, int _k);
     void computeMomentum(int _i, int _j, int _k);
@@ -277,14 +287,14 @@ private:
     real copyTimestep;  // copy of the integrator timestep
     bool restart;
     std::shared_ptr<esutil::RNG> rng;  //!< random number generator used for fluctuations
+    std::vector<real> fluctRand;       // per site random numbers of the fluctuating modes
 
     // EXTERNAL FORCES
     bool extForce;  // flag for an external force
 
     // LATTICES
-    lblattice *lbfluid;
-    lblattice *ghostlat;
-    lbmoments *lbmom;
+    LBLattice *lbfluid;   // populations and moments, flat SoA arrays
+    LBLattice *ghostlat;
     lbforces *lbfor;
 
     // COUPLING
@@ -302,6 +312,8 @@ private:
     Int3D myNi;
     Int3D nodeGrid;  // 3D-array of processors
     Real3D myLeft;   // left border of a physical ("real") domain for a CPU
+    std::vector<real> haloSend[2], haloRecv[2];  // halo buffers, [0] left, [1] right
+    mpi::request haloReqs[4];                    // pending halo exchange
 
     // SIGNALS
     boost::signals2::connection _befIntV;
@@ -58,6 +58,17 @@ LB/MD simulations. It is implemented as :py:class:`espressopp.integrator.Extensi
         :math:`T \\sim 1 [\\epsilon]`, and
         :math:`\\eta \\sim 5 [\\epsilon \\tau / \\sigma^3]`
 
+    .. note::
+
+        Lees-Edwards boundaries are supported together with
+        :py:class:`espressopp.integrator.VelocityVerletLE`. The shear is along
+        x with the gradient along z, as for the particles. Populations crossing
+        the z boundary are shifted in x by the current shear offset and their
+        momentum is corrected by the velocity jump between the periodic images.
+        The fluid velocity is the laboratory-frame one, so a fluid at rest builds
+        up the linear profile from the boundaries. The fluid must not be split
+        along x (``nodeGrid[0] = 1``).
+
 
     Example
 
@@ -101,10 +112,11 @@ LB/MD simulations. It is implemented as :py:class:`espressopp.integrator.Extensi
 
     .. py:method:: saveLBConf()
 
-        Dumps LB configuration with separate files for coupling forces, \
-        LB-fluid moments and populations (the last one is a bit overkill). \
-        The dump files are written for every CPU separately and \
-        are put in the *dump* folder
+        Dumps LB configuration (populations, LB-fluid moments and coupling \
+        forces on LB sites and MD particles) into the binary HDF5 file \
+        *dump/lbConf.<step>.h5*. All CPUs write to this file collectively. \
+        The lattice fields are stored for the whole lattice, so a restart \
+        may use a different number of CPUs.
 
     .. py:method:: keepLBDump()
 
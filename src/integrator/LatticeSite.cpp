@@ -22,6 +22,7 @@
 
 #include "python.hpp"
 #include "LatticeSite.hpp"
+#include <algorithm>
 #include <iomanip>
 
 #include "types.hpp"
@@ -35,280 +36,397 @@ namespace espressopp
 using namespace iterator;
 namespace integrator
 {
-LBSite::LBSite() { f = std::vector<real>(LatticePar::getNumVelsLoc(), 0.); }
+namespace
+{
+/* D3Q19 velocity vectors in the order of the populations */
+const int ci[19][3] = {{0, 0, 0},  {1, 0, 0},  {-1, 0, 0}, {0, 1, 0},   {0, -1, 0},
+                       {0, 0, 1},  {0, 0, -1}, {1, 1, 0},  {-1, -1, 0}, {1, -1, 0},
+                       {-1, 1, 0}, {1, 0, 1},  {-1, 0, -1}, {1, 0, -1}, {-1, 0, 1},
+                       {0, 1, 1},  {0, -1, -1}, {0, 1, -1}, {0, -1, 1}};
+}  // namespace
 
-/*******************************************************************************************/
+LBLattice::LBLattice() : size(0, 0, 0), stride(0) {}
 
-/* SET AND GET PART */
-void LBSite::setF_i(int _i, real _f) { f[_i] = _f; }
-real LBSite::getF_i(int _i) { return f[_i]; }
+void LBLattice::resize(Int3D _size)
+{
+    size = _size;
+    // pad every population array to full vectors, so all of them start aligned
+    stride = ESPP_FIT_TO_VECTOR_WIDTH(size[0] * size[1] * size[2]);
+    f.assign(static_cast<size_t>(LatticePar::getNumVelsLoc()) * stride, 0.);
+    moms.assign(static_cast<size_t>(numMoms) * stride, 0.);
+}
 
-void LBSite::setPhiLoc(int _i, real _phi) { phiLoc[_i] = _phi; }
-real LBSite::getPhiLoc(int _i) { return phiLoc[_i]; }
+void LBLattice::clearMoments() { std::fill(moms.begin(), moms.end(), 0.); }
+
+/* DENSITY AND MASS FLUX FROM THE POPULATIONS, FOR SITES NOT COMPLETE AFTER THE PUSH */
+void LBLattice::calcMoments(Int3D _lo, Int3D _hi)
+{
+    int _numVelsLoc = LatticePar::getNumVelsLoc();
+
+    for (int i = _lo[0]; i < _hi[0]; i++)
+    {
+        for (int j = _lo[1]; j < _hi[1]; j++)
+        {
+            int _s0 = index(i, j, 0);
+            for (int k = _lo[2]; k < _hi[2]; k++)
+            {
+                real _m[numMoms] = {0., 0., 0., 0.};
+                for (int l = 0; l < _numVelsLoc; l++)
+                {
+                    real _f = pop(l)[_s0 + k];
+                    _m[0] += _f;
+                    for (int d = 0; d < 3; d++) _m[d + 1] += ci[l][d] * _f;
+                }
+                for (int l = 0; l < numMoms; l++) mom(l)[_s0 + k] = _m[l];
+            }
+        }
+    }
+}
 
 /*******************************************************************************************/
 
-/* HELPFUL OPERATIONS WITH POPULATIONS AND MOMENTS */
-void LBSite::scaleF_i(int _i, real _value) { f[_i] *= _value; }
+/* SET AND GET PART */
+void LBLattice::setPhiLoc(int _i, real _phi) { phiLoc[_i] = _phi; }
+real LBLattice::getPhiLoc(int _i) { return phiLoc[_i]; }
 
 /*******************************************************************************************/
 
 /* MANAGING STATIC VARIABLES */
 /* create storage for static variables */
-std::vector<real> LBSite::phiLoc(19, 0.);
+std::vector<real> LBLattice::phiLoc(19, 0.);
 
 /*******************************************************************************************/
 
-void LBSite::collision(
-    bool _fluct, bool _extForce, bool _coupling, Real3D _force, std::vector<real> &_gamma)
+/* FUSED COLLISION AND STREAMING OF A ROW OF SITES */
+// the sites (_i,_j,_k0) ... (_i,_j,_k0+_n-1) are collided and their populations are pushed
+// to the neighbouring sites of _dest, whose density and mass flux are accumulated on the way.
+// The forces _fx, _fy, _fz (of length _n) are only read if _extForce is set, the random numbers
+// _rand (numVels - 4 per site) are only read if it is not null.
+void LBLattice::collideStream(LBLattice &_dest,
+                              int _i,
+                              int _j,
+                              int _k0,
+                              int _n,
+                              const real *_rand,
+                              bool _extForce,
+                              const real *_fx,
+                              const real *_fy,
+                              const real *_fz,
+                              std::vector<real> &_gamma)
 {
-    real m[19];
-
-    calcLocalMoments(m);
-
-    relaxMoments(m, _extForce, _force, _gamma);
+    real fb[19][blockSize];
+    real m[19][blockSize];
+    real zero[blockSize] = {0.};
 
-    if (_fluct) thermalFluct(m);
-
-    // coupling counts as an external force as well
-    if (_extForce) applyForces(m, _force, _gamma);
+    int _numVelsLoc = LatticePar::getNumVelsLoc();
+    int _src = index(_i, _j, _k0);
 
-    btranMomToPop(m);
+    for (int k = 0; k < _n; k += blockSize)
+    {
+        int _nb = std::min(blockSize, _n - k);
+
+        // load populations of the chunk, one contiguous run per direction
+        for (int l = 0; l < _numVelsLoc; l++)
+        {
+            const real *src = pop(l) + _src + k;
+            for (int s = 0; s < _nb; s++) fb[l][s] = src[s];
+        }
+
+        calcLocalMoments(fb, m, _nb);
+
+        if (_extForce)
+            relaxMoments(m, _nb, _fx + k, _fy + k, _fz + k, _gamma);
+        else
+            relaxMoments(m, _nb, zero, zero, zero, _gamma);
+
+        if (_rand) thermalFluct(m, _nb, _rand + k * (_numVelsLoc - 4));
+
+        // coupling counts as an external force as well
+        if (_extForce) applyForces(m, _nb, _fx + k, _fy + k, _fz + k, _gamma);
+
+        btranMomToPop(m, fb, _nb);
+
+        // streaming: push the populations to the nearest and next-to-nearest neighbours and
+        // add them to the moments there, the few destination rows stay in cache
+        for (int l = 0; l < _numVelsLoc; l++)
+        {
+            int _d = _dest.index(_i + ci[l][0], _j + ci[l][1], _k0 + ci[l][2]) + k;
+            real *dst = _dest.pop(l) + _d;
+            real *den = _dest.mom(0) + _d;
+            for (int s = 0; s < _nb; s++)
+            {
+                dst[s] = fb[l][s];
+                den[s] += fb[l][s];
+            }
+            for (int d = 0; d < 3; d++)
+            {
+                if (ci[l][d] == 0) continue;
+                real *j = _dest.mom(d + 1) + _d;
+                for (int s = 0; s < _nb; s++) j[s] += ci[l][d] * fb[l][s];
+            }
+        }
+    }
 }
 
 /*******************************************************************************************/
 
 /* CALCULATION OF THE LOCAL MOMENTS */
-void LBSite::calcLocalMoments(real *m)
+void LBLattice::calcLocalMoments(real (*_f)[blockSize], real (*m)[blockSize], int _n)
 {
-    real f0, f1p2, f1m2, f3p4, f3m4, f5p6, f5m6, f7p8, f7m8, f9p10, f9m10, f11p12, f11m12, f13p14,
-        f13m14, f15p16, f15m16, f17p18, f17m18;
-
-    /* shorthand functions for "simplified" notation */
-    f0 = getF_i(0);
-    f1p2 = getF_i(1) + getF_i(2);
-    f1m2 = getF_i(1) - getF_i(2);
-    f3p4 = getF_i(3) + getF_i(4);
-    f3m4 = getF_i(3) - getF_i(4);
-    f5p6 = getF_i(5) + getF_i(6);
-    f5m6 = getF_i(5) - getF_i(6);
-    f7p8 = getF_i(7) + getF_i(8);
-    f7m8 = getF_i(7) - getF_i(8);
-    f9p10 = getF_i(9) + getF_i(10);
-    f9m10 = getF_i(9) - getF_i(10);
-    f11p12 = getF_i(11) + getF_i(12);
-    f11m12 = getF_i(11) - getF_i(12);
-    f13p14 = getF_i(13) + getF_i(14);
-    f13m14 = getF_i(13) - getF_i(14);
-    f15p16 = getF_i(15) + getF_i(16);
-    f15m16 = getF_i(15) - getF_i(16);
-    f17p18 = getF_i(17) + getF_i(18);
-    f17m18 = getF_i(17) - getF_i(18);
-
-    /* mass mode */
-    m[0] = f0 + f1p2 + f3p4 + f5p6 + f7p8 + f9p10 + f11p12 + f13p14 + f15p16 + f17p18;
-
-    /* momentum modes */
-    m[1] = f1m2 + f7m8 + f9m10 + f11m12 + f13m14;
-    m[2] = f3m4 + f7m8 - f9m10 + f15m16 + f17m18;
-    m[3] = f5m6 + f11m12 - f13m14 + f15m16 - f17m18;
-
-    /* stress modes */
-    m[4] = -f0 + f7p8 + f9p10 + f11p12 + f13p14 + f15p16 + f17p18;
-    m[5] = 2. * f1p2 - f3p4 - f5p6 + f7p8 + f9p10 + f11p12 + f13p14 - 2. * (f15p16 + f17p18);
-    m[6] = f3p4 - f5p6 + f7p8 + f9p10 - f11p12 - f13p14;
-    m[7] = f7p8 - f9p10;
-    m[8] = f11p12 - f13p14;
-    m[9] = f15p16 - f17p18;
-
-    /* kinetic (ghost) modes */
-    m[10] = -2. * f1m2 + f7m8 + f9m10 + f11m12 + f13m14;
-    m[11] = -2. * f3m4 + f7m8 - f9m10 + f15m16 + f17m18;
-    m[12] = -2. * f5m6 + f11m12 - f13m14 + f15m16 - f17m18;
-    m[13] = f7m8 + f9m10 - f11m12 - f13m14;
-    m[14] = -f7m8 + f9m10 + f15m16 + f17m18;
-    m[15] = f11m12 - f13m14 - f15m16 + f17m18;
-    m[16] = f0 - 2. * (f1p2 + f3p4 + f5p6) + f7p8 + f9p10 + f11p12 + f13p14 + f15p16 + f17p18;
-    m[17] = -2. * f1p2 + f3p4 + f5p6 + f7p8 + f9p10 + f11p12 + f13p14 - 2. * (f15p16 + f17p18);
-    m[18] = -f3p4 + f5p6 + f7p8 + f9p10 - f11p12 - f13p14;
+    for (int s = 0; s < _n; s++)
+    {
+        real f0, f1p2, f1m2, f3p4, f3m4, f5p6, f5m6, f7p8, f7m8, f9p10, f9m10, f11p12, f11m12,
+            f13p14, f13m14, f15p16, f15m16, f17p18, f17m18;
+
+        /* shorthand functions for "simplified" notation */
+        f0 = _f[0][s];
+        f1p2 = _f[1][s] + _f[2][s];
+        f1m2 = _f[1][s] - _f[2][s];
+        f3p4 = _f[3][s] + _f[4][s];
+        f3m4 = _f[3][s] - _f[4][s];
+        f5p6 = _f[5][s] + _f[6][s];
+        f5m6 = _f[5][s] - _f[6][s];
+        f7p8 = _f[7][s] + _f[8][s];
+        f7m8 = _f[7][s] - _f[8][s];
+        f9p10 = _f[9][s] + _f[10][s];
+        f9m10 = _f[9][s] - _f[10][s];
+        f11p12 = _f[11][s] + _f[12][s];
+        f11m12 = _f[11][s] - _f[12][s];
+        f13p14 = _f[13][s] + _f[14][s];
+        f13m14 = _f[13][s] - _f[14][s];
+        f15p16 = _f[15][s] + _f[16][s];
+        f15m16 = _f[15][s] - _f[16][s];
+        f17p18 = _f[17][s] + _f[18][s];
+        f17m18 = _f[17][s] - _f[18][s];
+
+        /* mass mode */
+        m[0][s] = f0 + f1p2 + f3p4 + f5p6 + f7p8 + f9p10 + f11p12 + f13p14 + f15p16 + f17p18;
+
+        /* momentum modes */
+        m[1][s] = f1m2 + f7m8 + f9m10 + f11m12 + f13m14;
+        m[2][s] = f3m4 + f7m8 - f9m10 + f15m16 + f17m18;
+        m[3][s] = f5m6 + f11m12 - f13m14 + f15m16 - f17m18;
+
+        /* stress modes */
+        m[4][s] = -f0 + f7p8 + f9p10 + f11p12 + f13p14 + f15p16 + f17p18;
+        m[5][s] = 2. * f1p2 - f3p4 - f5p6 + f7p8 + f9p10 + f11p12 + f13p14 - 2. * (f15p16 + f17p18);
+        m[6][s] = f3p4 - f5p6 + f7p8 + f9p10 - f11p12 - f13p14;
+        m[7][s] = f7p8 - f9p10;
+        m[8][s] = f11p12 - f13p14;
+        m[9][s] = f15p16 - f17p18;
+
+        /* kinetic (ghost) modes */
+        m[10][s] = -2. * f1m2 + f7m8 + f9m10 + f11m12 + f13m14;
+        m[11][s] = -2. * f3m4 + f7m8 - f9m10 + f15m16 + f17m18;
+        m[12][s] = -2. * f5m6 + f11m12 - f13m14 + f15m16 - f17m18;
+        m[13][s] = f7m8 + f9m10 - f11m12 - f13m14;
+        m[14][s] = -f7m8 + f9m10 + f15m16 + f17m18;
+        m[15][s] = f11m12 - f13m14 - f15m16 + f17m18;
+        m[16][s] = f0 - 2. * (f1p2 + f3p4 + f5p6) + f7p8 + f9p10 + f11p12 + f13p14 + f15p16 + f17p18;
+        m[17][s] = -2. * f1p2 + f3p4 + f5p6 + f7p8 + f9p10 + f11p12 + f13p14 - 2. * (f15p16 + f17p18);
+        m[18][s] = -f3p4 + f5p6 + f7p8 + f9p10 - f11p12 - f13p14;
+    }
 }
 
 /*******************************************************************************************/
 
 /* RELAXATION OF THE MOMENTS TO THEIR EQUILIBRIUM VALUES */
-void LBSite::relaxMoments(real *m, bool _extForce, Real3D _f, std::vector<real> &_gamma)
+void LBLattice::relaxMoments(real (*m)[blockSize],
+                             int _n,
+                             const real *_fx,
+                             const real *_fy,
+                             const real *_fz,
+                             std::vector<real> &_gamma)
 {
     // moments on the site //
+    real _aLoc = LatticePar::getALoc();
     real _invTauLoc = 1. / LatticePar::getTauLoc();
-    Real3D jLoc(m[1], m[2], m[3]);
-    jLoc *= LatticePar::getALoc();
-    jLoc *= _invTauLoc;
-
-    // if we have external forces then modify the eq.fluxes //
-    if (_extForce) jLoc += 0.5 * _f;  // when doing coupling, the flag is set to 1!
-
-    real _invRhoLoc = 1. / m[0];
-    real pi_eq[6];
-
-    pi_eq[0] = jLoc.sqr() * _invRhoLoc;
-    pi_eq[1] = (jLoc[0] * jLoc[0] - jLoc[1] * jLoc[1]) * _invRhoLoc;
-    pi_eq[2] = (3. * jLoc[0] * jLoc[0] - jLoc.sqr()) * _invRhoLoc;
-    pi_eq[3] = jLoc[0] * jLoc[1] * _invRhoLoc;
-    pi_eq[4] = jLoc[0] * jLoc[2] * _invRhoLoc;
-    pi_eq[5] = jLoc[1] * jLoc[2] * _invRhoLoc;
-
-    /* relax bulk mode */
-    m[4] = pi_eq[0] + _gamma[0] * (m[4] - pi_eq[0]);
-
-    /* relax shear modes */
-    m[5] = pi_eq[1] + _gamma[1] * (m[5] - pi_eq[1]);
-    m[6] = pi_eq[2] + _gamma[1] * (m[6] - pi_eq[2]);
-    m[7] = pi_eq[3] + _gamma[1] * (m[7] - pi_eq[3]);
-    m[8] = pi_eq[4] + _gamma[1] * (m[8] - pi_eq[4]);
-    m[9] = pi_eq[5] + _gamma[1] * (m[9] - pi_eq[5]);
-
-    /* relax odd modes */
-    m[10] *= _gamma[2];
-    m[11] *= _gamma[2];
-    m[12] *= _gamma[2];
-    m[13] *= _gamma[2];
-    m[14] *= _gamma[2];
-    m[15] *= _gamma[2];
-
-    /* relax even modes */
-    m[16] *= _gamma[3];
-    m[17] *= _gamma[3];
-    m[18] *= _gamma[3];
+    real _gb = _gamma[0], _gs = _gamma[1], _godd = _gamma[2], _geven = _gamma[3];
+
+    for (int s = 0; s < _n; s++)
+    {
+        // if we have external forces then modify the eq.fluxes, zero forces otherwise //
+        real jx = m[1][s] * _aLoc * _invTauLoc + 0.5 * _fx[s];
+        real jy = m[2][s] * _aLoc * _invTauLoc + 0.5 * _fy[s];
+        real jz = m[3][s] * _aLoc * _invTauLoc + 0.5 * _fz[s];
+        real j2 = jx * jx + jy * jy + jz * jz;
+
+        real _invRhoLoc = 1. / m[0][s];
+        real pi_eq[6];
+
+        pi_eq[0] = j2 * _invRhoLoc;
+        pi_eq[1] = (jx * jx - jy * jy) * _invRhoLoc;
+        pi_eq[2] = (3. * jx * jx - j2) * _invRhoLoc;
+        pi_eq[3] = jx * jy * _invRhoLoc;
+        pi_eq[4] = jx * jz * _invRhoLoc;
+        pi_eq[5] = jy * jz * _invRhoLoc;
+
+        /* relax bulk mode */
+        m[4][s] = pi_eq[0] + _gb * (m[4][s] - pi_eq[0]);
+
+        /* relax shear modes */
+        m[5][s] = pi_eq[1] + _gs * (m[5][s] - pi_eq[1]);
+        m[6][s] = pi_eq[2] + _gs * (m[6][s] - pi_eq[2]);
+        m[7][s] = pi_eq[3] + _gs * (m[7][s] - pi_eq[3]);
+        m[8][s] = pi_eq[4] + _gs * (m[8][s] - pi_eq[4]);
+        m[9][s] = pi_eq[5] + _gs * (m[9][s] - pi_eq[5]);
+
+        /* relax odd modes */
+        m[10][s] *= _godd;
+        m[11][s] *= _godd;
+        m[12][s] *= _godd;
+        m[13][s] *= _godd;
+        m[14][s] *= _godd;
+        m[15][s] *= _godd;
+
+        /* relax even modes */
+        m[16][s] *= _geven;
+        m[17][s] *= _geven;
+        m[18][s] *= _geven;
+    }
 }
 
 /*******************************************************************************************/
 
 /* ADDING THERMAL FLUCTUATIONS */
-void LBSite::thermalFluct(real *m)
+void LBLattice::thermalFluct(real (*m)[blockSize], int _n, const real *_rand)
 {
     /* values of PhiLoc were already set in LatticeBoltzmann.cpp */
     int _numVelsLoc = LatticePar::getNumVelsLoc();
-    real rootRhoLoc = sqrt(12. * m[0]);  // factor 12. comes from usage of
-    // not gaussian but uniformly distributed random numbers
 
-    //			real rootRhoLoc = sqrt(m[0]); // Gaussian version
-
-    for (int l = 4; l < _numVelsLoc; l++)
+    // the uniform random numbers in [-0.5, 0.5) were drawn site by site, see
+    // LatticeBoltzmann::drawFluctuations()
+    for (int s = 0; s < _n; s++)
     {
-        m[l] += rootRhoLoc * getPhiLoc(l) * ((*LatticePar::rng)() - 0.5);
-        //				m[l] +=
-        // rootRhoLoc*getPhiLoc(l)*((LatticePar::rng)->normal());
-        ////Gaussian
+        real rootRhoLoc = sqrt(12. * m[0][s]);  // factor 12. comes from usage of
+        // not gaussian but uniformly distributed random numbers
+
+        const real *_r = _rand + s * (_numVelsLoc - 4);
+        for (int l = 4; l < _numVelsLoc; l++)
+        {
+            m[l][s] += rootRhoLoc * getPhiLoc(l) * _r[l - 4];
+        }
     }
 }
 
 /*******************************************************************************************/
 
-void LBSite::applyForces(real *m, Real3D _f, std::vector<real> &_gamma)
+void LBLattice::applyForces(real (*m)[blockSize],
+                            int _n,
+                            const real *_fx,
+                            const real *_fy,
+                            const real *_fz,
+                            std::vector<real> &_gamma)
 {
-    // set velocity _u
-    Real3D _u = 0.5 * _f;
-    _u[0] += m[1];
-    _u[1] += m[2];
-    _u[2] += m[3];
-    _u /= m[0];
-
-    /* update momentum modes */
-    m[1] += _f[0];
-    m[2] += _f[1];
-    m[3] += _f[2];
-
-    /* update stress modes */
     // See def. of _sigma (Eq.198) in B.Dünweg & A.J.C.Ladd in Adv.Poly.Sci. 221, 89-166 (2009)
-    real _sigma[6];
     real _gamma_sp = _gamma[1] + 1.;
     real _gamma_sph = 0.5 * _gamma_sp;
+    real _thirdGammaDiff = (1. / 3.) * (_gamma[0] - _gamma[1]);
 
-    real _scalp = _u * _f;
-    real _secTerm = (1. / 3.) * (_gamma[0] - _gamma[1]) * _scalp;
-
-    _sigma[0] = _gamma_sp * _u[0] * _f[0] + _secTerm;
-    _sigma[1] = _gamma_sp * _u[1] * _f[1] + _secTerm;
-    _sigma[2] = _gamma_sp * _u[2] * _f[2] + _secTerm;
-    _sigma[3] = _gamma_sph * (_u[0] * _f[1] + _u[1] * _f[0]);
-    _sigma[4] = _gamma_sph * (_u[0] * _f[2] + _u[2] * _f[0]);
-    _sigma[5] = _gamma_sph * (_u[1] * _f[2] + _u[2] * _f[1]);
-
-    m[4] += _sigma[0] + _sigma[1] + _sigma[2];
-    m[5] += 2. * _sigma[0] - _sigma[1] - _sigma[2];
-    m[6] += _sigma[1] - _sigma[2];
-    m[7] += _sigma[3];
-    m[8] += _sigma[4];
-    m[9] += _sigma[5];
+    for (int s = 0; s < _n; s++)
+    {
+        // set velocity _u
+        real _invRho = 1. / m[0][s];
+        real ux = (0.5 * _fx[s] + m[1][s]) * _invRho;
+        real uy = (0.5 * _fy[s] + m[2][s]) * _invRho;
+        real uz = (0.5 * _fz[s] + m[3][s]) * _invRho;
+
+        /* update momentum modes */
+        m[1][s] += _fx[s];
+        m[2][s] += _fy[s];
+        m[3][s] += _fz[s];
+
+        /* update stress modes */
+        real _sigma[6];
+        real _scalp = ux * _fx[s] + uy * _fy[s] + uz * _fz[s];
+        real _secTerm = _thirdGammaDiff * _scalp;
+
+        _sigma[0] = _gamma_sp * ux * _fx[s] + _secTerm;
+        _sigma[1] = _gamma_sp * uy * _fy[s] + _secTerm;
+        _sigma[2] = _gamma_sp * uz * _fz[s] + _secTerm;
+        _sigma[3] = _gamma_sph * (ux * _fy[s] + uy * _fx[s]);
+        _sigma[4] = _gamma_sph * (ux * _fz[s] + uz * _fx[s]);
+        _sigma[5] = _gamma_sph * (uy * _fz[s] + uz * _fy[s]);
+
+        m[4][s] += _sigma[0] + _sigma[1] + _sigma[2];
+        m[5][s] += 2. * _sigma[0] - _sigma[1] - _sigma[2];
+        m[6][s] += _sigma[1] - _sigma[2];
+        m[7][s] += _sigma[3];
+        m[8][s] += _sigma[4];
+        m[9][s] += _sigma[5];
+    }
 }
 
 /*******************************************************************************************/
 
-void LBSite::btranMomToPop(real *m)
+void LBLattice::btranMomToPop(real (*m)[blockSize], real (*_f)[blockSize], int _n)
 {
     int _numVelsLoc = LatticePar::getNumVelsLoc();
+    real w[19], invB[19];
+    for (int l = 0; l < _numVelsLoc; l++)
+    {
+        w[l] = LatticePar::getEqWeightLoc(l);
+        invB[l] = LatticePar::getInvBLoc(l);
+    }
 
     // scale modes with inversed coefficients
-    for (int i = 0; i < _numVelsLoc; i++)
+    for (int l = 0; l < _numVelsLoc; l++)
     {
-        m[i] *= LatticePar::getInvBLoc(i);
+        for (int s = 0; s < _n; s++) m[l][s] *= invB[l];
     }
 
-    setF_i(0, m[0] - m[4] + m[16]);
-    setF_i(1, m[0] + m[1] + 2. * (m[5] - m[10] - m[16] - m[17]));
-    setF_i(2, m[0] - m[1] + 2. * (m[5] + m[10] - m[16] - m[17]));
-    setF_i(3, m[0] + m[2] - m[5] + m[6] - 2. * (m[11] + m[16]) + m[17] - m[18]);
-    setF_i(4, m[0] - m[2] - m[5] + m[6] + 2. * (m[11] - m[16]) + m[17] - m[18]);
-    setF_i(5, m[0] + m[3] - m[5] - m[6] - 2. * (m[12] + m[16]) + m[17] + m[18]);
-    setF_i(6, m[0] - m[3] - m[5] - m[6] + 2. * (m[12] - m[16]) + m[17] + m[18]);
-
-    setF_i(7, m[0] + m[1] + m[2] + m[4] + m[5] + m[6] + m[7] + m[10] + m[11] + m[13] - m[14] +
-                  m[16] + m[17] + m[18]);
-    setF_i(8, m[0] - m[1] - m[2] + m[4] + m[5] + m[6] + m[7] - m[10] - m[11] - m[13] + m[14] +
-                  m[16] + m[17] + m[18]);
-    setF_i(9, m[0] + m[1] - m[2] + m[4] + m[5] + m[6] - m[7] + m[10] - m[11] + m[13] + m[14] +
-                  m[16] + m[17] + m[18]);
-    setF_i(10, m[0] - m[1] + m[2] + m[4] + m[5] + m[6] - m[7] - m[10] + m[11] - m[13] - m[14] +
-                   m[16] + m[17] + m[18]);
-
-    setF_i(11, m[0] + m[1] + m[3] + m[4] + m[5] - m[6] + m[8] + m[10] + m[12] - m[13] + m[15] +
-                   m[16] + m[17] - m[18]);
-    setF_i(12, m[0] - m[1] - m[3] + m[4] + m[5] - m[6] + m[8] - m[10] - m[12] + m[13] - m[15] +
-                   m[16] + m[17] - m[18]);
-    setF_i(13, m[0] + m[1] - m[3] + m[4] + m[5] - m[6] - m[8] + m[10] - m[12] - m[13] - m[15] +
-                   m[16] + m[17] - m[18]);
-    setF_i(14, m[0] - m[1] + m[3] + m[4] + m[5] - m[6] - m[8] - m[10] + m[12] + m[13] + m[15] +
-                   m[16] + m[17] - m[18]);
-
-    setF_i(15, m[0] + m[2] + m[3] + m[4] - 2. * m[5] + m[9] + m[11] + m[12] + m[14] - m[15] +
-                   m[16] - 2. * m[17]);
-    setF_i(16, m[0] - m[2] - m[3] + m[4] - 2. * m[5] + m[9] - m[11] - m[12] - m[14] + m[15] +
-                   m[16] - 2. * m[17]);
-    setF_i(17, m[0] + m[2] - m[3] + m[4] - 2. * m[5] - m[9] + m[11] - m[12] + m[14] + m[15] +
-                   m[16] - 2. * m[17]);
-    setF_i(18, m[0] - m[2] + m[3] + m[4] - 2. * m[5] - m[9] - m[11] + m[12] - m[14] - m[15] +
-                   m[16] - 2. * m[17]);
+    for (int s = 0; s < _n; s++)
+    {
+        _f[0][s] = m[0][s] - m[4][s] + m[16][s];
+        _f[1][s] = m[0][s] + m[1][s] + 2. * (m[5][s] - m[10][s] - m[16][s] - m[17][s]);
+        _f[2][s] = m[0][s] - m[1][s] + 2. * (m[5][s] + m[10][s] - m[16][s] - m[17][s]);
+        _f[3][s] = m[0][s] + m[2][s] - m[5][s] + m[6][s] - 2. * (m[11][s] + m[16][s]) + m[17][s] -
+                   m[18][s];
+        _f[4][s] = m[0][s] - m[2][s] - m[5][s] + m[6][s] + 2. * (m[11][s] - m[16][s]) + m[17][s] -
+                   m[18][s];
+        _f[5][s] = m[0][s] + m[3][s] - m[5][s] - m[6][s] - 2. * (m[12][s] + m[16][s]) + m[17][s] +
+                   m[18][s];
+        _f[6][s] = m[0][s] - m[3][s] - m[5][s] - m[6][s] + 2. * (m[12][s] - m[16][s]) + m[17][s] +
+                   m[18][s];
+
+        _f[7][s] = m[0][s] + m[1][s] + m[2][s] + m[4][s] + m[5][s] + m[6][s] + m[7][s] + m[10][s] +
+                   m[11][s] + m[13][s] - m[14][s] + m[16][s] + m[17][s] + m[18][s];
+        _f[8][s] = m[0][s] - m[1][s] - m[2][s] + m[4][s] + m[5][s] + m[6][s] + m[7][s] - m[10][s] -
+                   m[11][s] - m[13][s] + m[14][s] + m[16][s] + m[17][s] + m[18][s];
+        _f[9][s] = m[0][s] + m[1][s] - m[2][s] + m[4][s] + m[5][s] + m[6][s] - m[7][s] + m[10][s] -
+                   m[11][s] + m[13][s] + m[14][s] + m[16][s] + m[17][s] + m[18][s];
+        _f[10][s] = m[0][s] - m[1][s] + m[2][s] + m[4][s] + m[5][s] + m[6][s] - m[7][s] - m[10][s] +
+                    m[11][s] - m[13][s] - m[14][s] + m[16][s] + m[17][s] + m[18][s];
+
+        _f[11][s] = m[0][s] + m[1][s] + m[3][s] + m[4][s] + m[5][s] - m[6][s] + m[8][s] + m[10][s] +
+                    m[12][s] - m[13][s] + m[15][s] + m[16][s] + m[17][s] - m[18][s];
+        _f[12][s] = m[0][s] - m[1][s] - m[3][s] + m[4][s] + m[5][s] - m[6][s] + m[8][s] - m[10][s] -
+                    m[12][s] + m[13][s] - m[15][s] + m[16][s] + m[17][s] - m[18][s];
+        _f[13][s] = m[0][s] + m[1][s] - m[3][s] + m[4][s] + m[5][s] - m[6][s] - m[8][s] + m[10][s] -
+                    m[12][s] - m[13][s] - m[15][s] + m[16][s] + m[17][s] - m[18][s];
+        _f[14][s] = m[0][s] - m[1][s] + m[3][s] + m[4][s] + m[5][s] - m[6][s] - m[8][s] - m[10][s] +
+                    m[12][s] + m[13][s] + m[15][s] + m[16][s] + m[17][s] - m[18][s];
+
+        _f[15][s] = m[0][s] + m[2][s] + m[3][s] + m[4][s] - 2. * m[5][s] + m[9][s] + m[11][s] +
+                    m[12][s] + m[14][s] - m[15][s] + m[16][s] - 2. * m[17][s];
+        _f[16][s] = m[0][s] - m[2][s] - m[3][s] + m[4][s] - 2. * m[5][s] + m[9][s] - m[11][s] -
+                    m[12][s] - m[14][s] + m[15][s] + m[16][s] - 2. * m[17][s];
+        _f[17][s] = m[0][s] + m[2][s] - m[3][s] + m[4][s] - 2. * m[5][s] - m[9][s] + m[11][s] -
+                    m[12][s] + m[14][s] + m[15][s] + m[16][s] - 2. * m[17][s];
+        _f[18][s] = m[0][s] - m[2][s] + m[3][s] + m[4][s] - 2. * m[5][s] - m[9][s] - m[11][s] +
+                    m[12][s] - m[14][s] - m[15][s] + m[16][s] - 2. * m[17][s];
+    }
 
     /* scale populations with weights */
-    for (int i = 0; i < _numVelsLoc; i++)
+    for (int l = 0; l < _numVelsLoc; l++)
     {
-        scaleF_i(i, LatticePar::getEqWeightLoc(i));
+        for (int s = 0; s < _n; s++) _f[l][s] *= w[l];
     }
 }
 
 /*******************************************************************************************/
 
-LBSite::~LBSite() {}
-
-/*******************************************************************************************/
-
-LBMom::LBMom() { mom = std::vector<real>(4, 0.); }
-
-/* SET AND GET PART */
-void LBMom::setMom_i(int _i, real _mom) { mom[_i] = _mom; }
-real LBMom::getMom_i(int _i) { return mom[_i]; }
-
-LBMom::~LBMom() {}
+LBLattice::~LBLattice() {}
 
 /*******************************************************************************************/
 
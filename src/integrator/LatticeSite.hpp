@@ -24,87 +24,122 @@
 #ifndef _INTEGRATOR_LATTICEMODEL_HPP
 #define _INTEGRATOR_LATTICEMODEL_HPP
 
+#include "types.hpp"
 #include "Real3D.hpp"
+#include "Int3D.hpp"
+#include "vectorization/simdconfig.hpp"
 
 namespace espressopp
 {
 namespace integrator
 {
-class LBSite
+class LBLattice
 {
     /**
-     * \brief Description of the properties of the LBSite class
+     * \brief Description of the properties of the LBLattice class
      *
-     * This is a LBSite class for storing of the populations, ext and coupling forces on the lattice
-     * site. Through its methods this class handles everything that happens on the node during
-     * collision. It also sets the values to the D3Q19 model-related parameters on EVERY lattice
-     * site.
+     * This is a LBLattice class for storing of the populations of all lattice sites of a CPU
+     * (including the halo). The populations are kept in a structure-of-arrays layout: all
+     * populations of one velocity direction l form one contiguous array and site (i,j,k) of
+     * direction l is found at f[l * stride + (i * size[1] + j) * size[2] + k].
      *
-     * The normal lattice and its ghost counterpart are based on this LBSite class. They are defined
+     * Through its methods this class handles everything that happens on the node during
+     * collision. Collision and streaming are fused: a row of sites along z is collided in
+     * chunks of blockSize sites and the post-collisional populations are written directly to
+     * the neighbouring sites of the destination lattice. All loops of the collision run over
+     * the sites of a chunk, so the compiler can vectorize them.
+     *
+     * Each lattice also keeps the density and mass flux of its sites, in four arrays of the
+     * same layout. They are accumulated while the populations are pushed into the lattice,
+     * so no separate pass over the populations is needed after streaming.
+     *
+     * The normal lattice and its ghost counterpart are LBLattice objects. They are defined
      * in LatticeBoltzmann.*pp files.
      *
      * Please note that by default ESPResSo++ supports only D3Q19 lattice model.
      * However, you can code other lattice models, it should not be difficult.
      */
 public:
-    LBSite();
-    ~LBSite();
+    LBLattice();
+    ~LBLattice();
 
-    /* SET AND GET DECLARATION */
-    void setF_i(int _i, real _f);  // set f_i population to _f
-    real getF_i(int _i);           // get f_i population
+    static const int blockSize = 16;  // sites collided at once
+    static const int numMoms = 4;     // density and mass flux
 
-    void setPhiLoc(int _i, real _phi);  // set phi value to _phi
-    real getPhiLoc(int _i);             // get phi value
+    void resize(Int3D _size);  // allocate zeroed populations and moments for _size sites
+    Int3D getSize() { return size; }
 
-    /* HELPFUL OPERATIONS WITH POPULATIONS AND MOMENTS */
-    void scaleF_i(int _i, real _value);  // scale population i by _value
+    /* SET AND GET DECLARATION */
+    int index(int _i, int _j, int _k) { return (_i * size[1] + _j) * size[2] + _k; }
 
-    /* FUNCTIONS DECLARATION */
-    void collision(bool _fluct,
-                   bool _extForce,
-                   bool _coupling,
-                   Real3D _f,
-                   std::vector<real> &_gamma);  // perform collision step
+    void setF_i(int _i, int _j, int _k, int _l, real _f)  // set f_l population of a site to _f
+    {
+        f[_l * stride + index(_i, _j, _k)] = _f;
+    }
+    real getF_i(int _i, int _j, int _k, int _l)  // get f_l population of a site
+    {
+        return f[_l * stride + index(_i, _j, _k)];
+    }
 
-    void calcLocalMoments(real *m);  // calculate local moments
+    real *pop(int _l) { return &f[_l * stride]; }  // array of all populations f_l
 
-    void relaxMoments(real *m,
-                      bool _extForce,
-                      Real3D _f,
-                      std::vector<real> &_gamma);  // relax local moms to eq moms
+    void setMom_i(int _i, int _j, int _k, int _l, real _mom)  // set moment _l (den, j) of a site
+    {
+        moms[_l * stride + index(_i, _j, _k)] = _mom;
+    }
+    real getMom_i(int _i, int _j, int _k, int _l)  // get moment _l (den, j) of a site
+    {
+        return moms[_l * stride + index(_i, _j, _k)];
+    }
 
-    void thermalFluct(real *m);  // apply thermal fluctuations
+    real *mom(int _l) { return &moms[_l * stride]; }  // array of moment _l of all sites
 
-    void applyForces(real *m, Real3D _f,
-                     std::vector<real> &_gamma);  // apply ext and coupl forces
+    void clearMoments();                     // zero density and mass flux of all sites
+    void calcMoments(Int3D _lo, Int3D _hi);  // density and mass flux of the sites in [_lo, _hi)
+
+    static void setPhiLoc(int _i, real _phi);  // set phi value to _phi
+    static real getPhiLoc(int _i);             // get phi value
 
-    void btranMomToPop(real *m);  // back-transform moms to pops
+    /* FUNCTIONS DECLARATION */
+    void collideStream(LBLattice &_dest,
+                       int _i,
+                       int _j,
+                       int _k0,
+                       int _n,
+                       const real *_rand,
+                       bool _extForce,
+                       const real *_fx,
+                       const real *_fy,
+                       const real *_fz,
+                       std::vector<real> &_gamma);  // collide _n sites and stream them to _dest
 
 private:
-    std::vector<real> f;              // populations on a site
-    static std::vector<real> phiLoc;  // local fluct amplitudes
-};
+    /* collision of at most blockSize sites, populations and moments are [l][site] */
+    void calcLocalMoments(real (*_f)[blockSize], real (*m)[blockSize], int _n);
+
+    void relaxMoments(real (*m)[blockSize],
+                      int _n,
+                      const real *_fx,
+                      const real *_fy,
+                      const real *_fz,
+                      std::vector<real> &_gamma);  // relax local moms to eq moms
 
-/*******************************************************************************************/
+    void thermalFluct(real (*m)[blockSize], int _n, const real *_rand);  // apply thermal fluct
 
-class LBMom
-{
-    /**
-     * \brief Description of the properties of the LBMom class
-     *
-     * This is a LBMom class for storing of the hydrodynamic moments on the lattice site.
-     * These include density and 3-comp. mass flux.
-     */
-public:
-    LBMom();   // constr of the ghost lattice
-    ~LBMom();  // destr of the ghost lattice
+    void applyForces(real (*m)[blockSize],
+                     int _n,
+                     const real *_fx,
+                     const real *_fy,
+                     const real *_fz,
+                     std::vector<real> &_gamma);  // apply ext and coupl forces
 
-    void setMom_i(int _i, real _mom);  // set f_i population to _f
-    real getMom_i(int _i);             // get f_i population
+    void btranMomToPop(real (*m)[blockSize], real (*_f)[blockSize], int _n);  // back-transform
 
-private:
-    std::vector<real> mom;  // pops on the ghost lattice
+    Int3D size;                             // number of sites in 3D (including halo)
+    int stride;                             // distance between two population arrays
+    vectorization::AlignedVector<real> f;   // populations, [l * stride + site]
+    vectorization::AlignedVector<real> moms;  // density and mass flux, [l * stride + site]
+    static std::vector<real> phiLoc;  // local fluct amplitudes
 };
 
 /*******************************************************************************************/
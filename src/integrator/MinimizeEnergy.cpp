@@ -22,6 +22,8 @@
 
 #include "python.hpp"
 #include "MinimizeEnergy.hpp"
+#include <functional>
+#include "Buffer.hpp"
 
 namespace espressopp
 {
@@ -33,11 +35,23 @@ using namespace esutil;
 
 LOG4ESPP_LOGGER(MinimizeEnergy::theLogger, "MinimizeEnergy");
 
+namespace
+{
+// FIRE parameters of Bitzek et al.
+const int FIRE_NMIN = 5;
+const real FIRE_FINC = 1.1;
+const real FIRE_FDEC = 0.5;
+const real FIRE_ALPHA0 = 0.1;
+const real FIRE_FALPHA = 0.99;
+const real FIRE_DTMAX = 10.0;  // in units of the initial time step
+}  // namespace
+
 MinimizeEnergy::MinimizeEnergy(std::shared_ptr<System> system,
                                real gamma,
                                real ftol,
                                real max_displacement,
-                               bool variable_step_flag)
+                               bool variable_step_flag,
+                               std::string method)
 
     : SystemAccess(system),
       gamma_(gamma),
@@ -46,19 +60,47 @@ MinimizeEnergy::MinimizeEnergy(std::shared_ptr<System> system,
       variable_step_flag_(variable_step_flag)
 {
     LOG4ESPP_INFO(theLogger, "construct MinimizeEnergy");
+    if (method == "steepest_descent")
+        method_ = SteepestDescent;
+    else if (method == "fire")
+        method_ = FIRE;
+    else if (method == "cg")
+        method_ = ConjugateGradient;
+    else
+        throw std::invalid_argument("MinimizeEnergy: unknown method " + method +
+                                    ", use steepest_descent, fire or cg");
+    if (method_ == FIRE && gamma_ <= 0.0)
+        throw std::invalid_argument("MinimizeEnergy: FIRE needs gamma > 0 as time step");
+
     resort_flag_ = true;
     dp_MAX = 0.;
     nstep_ = 0;
+    fire_dt_ = gamma_;
+    fire_alpha_ = FIRE_ALPHA0;
+    fire_npos_ = 0;
+    cg_restart_ = true;
+
+    storage::Storage& storage = *getSystemRef().storage;
+    sigBeforeSend = storage.beforeSendParticles.connect(
+        std::bind(&MinimizeEnergy::beforeSendParticles, this, std::placeholders::_1,
+                  std::placeholders::_2));
+    sigAfterRecv = storage.afterRecvParticles.connect(
+        std::bind(&MinimizeEnergy::afterRecvParticles, this, std::placeholders::_1,
+                  std::placeholders::_2));
 }
 
-MinimizeEnergy::~MinimizeEnergy() { LOG4ESPP_INFO(theLogger, "free MinimizeEnergy"); }
+MinimizeEnergy::~MinimizeEnergy()
+{
+    LOG4ESPP_INFO(theLogger, "free MinimizeEnergy");
+    sigBeforeSend.disconnect();
+    sigAfterRecv.disconnect();
+}
 
 bool MinimizeEnergy::run(int max_steps, bool verbose)
 {
     bool retval = false;
     System& system = getSystemRef();
     storage::Storage& storage = *system.storage;
-    real skin_half = 0.5 * system.getSkin();
     dp_sqr_max_ = 0.0;
     f_max_sqr_ = std::numeric_limits<real>::max();
 
@@ -82,25 +124,32 @@ bool MinimizeEnergy::run(int max_steps, bool verbose)
         std::cout << "  max_steps = " << max_steps << std::endl;
         std::cout << "  max displacement = " << max_displacement_ << std::endl;
     }
+    if (method_ != SteepestDescent)
+    {
+        saveVelocities();
+        fire_dt_ = gamma_;
+        fire_alpha_ = FIRE_ALPHA0;
+        fire_npos_ = 0;
+        cg_restart_ = true;
+    }
+
     int iters = 0;
     for (; iters < max_steps && f_max_sqr_ > ftol_sqr_; iters++)
     {
-        steepestDescentStep();
-
-        dp_MAX += sqrt(dp_sqr_max_);
-
-        resort_flag_ = dp_MAX > skin_half;
-        LOG4ESPP_INFO(theLogger, "maxDist = " << dp_MAX << ", skin/2 = " << skin_half);
-
-        if (resort_flag_)
+        switch (method_)
         {
-            LOG4ESPP_INFO(theLogger, "Particles will be decomposed.");
-            dp_MAX = 0.;
-            storage.decompose();
-            LOG4ESPP_INFO(theLogger, "Particles have been decomposed.");
-            resort_flag_ = false;
+            case FIRE:
+                fireStep();
+                break;
+            case ConjugateGradient:
+                conjugateGradientStep();
+                break;
+            default:
+                steepestDescentStep();
         }
 
+        resortIfNeeded();
+
         updateForces();
 
         if (verbose)
@@ -126,6 +175,8 @@ bool MinimizeEnergy::run(int max_steps, bool verbose)
     }
     retval = (f_max_sqr_ < ftol_sqr_);
 
+    if (method_ != SteepestDescent) restoreVelocities();
+
     LOG4ESPP_INFO(theLogger,
                   "finished run, f_max_sqr_^2=" << f_max_sqr_ << " max_displ^2=" << dp_sqr_max_);
     return retval;
@@ -220,14 +271,257 @@ void MinimizeEnergy::steepestDescentStep()
     mpi::all_reduce(*system.comm, dp_sqr_max, dp_sqr_max_, boost::mpi::maximum<real>());
 }
 
+void MinimizeEnergy::displace(real alpha)
+{
+    System& system = getSystemRef();
+
+    real dp_sqr_max = 0.0;
+    CellList realCells = system.storage->getRealCells();
+    for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
+    {
+        Real3D dp = alpha * cit->velocity();
+        cit->position() += dp;
+        dp_sqr_max = std::max(dp_sqr_max, dp.sqr());
+    }
+    mpi::all_reduce(*system.comm, dp_sqr_max, dp_sqr_max_, boost::mpi::maximum<real>());
+}
+
+void MinimizeEnergy::resortIfNeeded()
+{
+    System& system = getSystemRef();
+    real skin_half = 0.5 * system.getSkin();
+
+    dp_MAX += sqrt(dp_sqr_max_);
+
+    resort_flag_ = dp_MAX > skin_half;
+    LOG4ESPP_INFO(theLogger, "maxDist = " << dp_MAX << ", skin/2 = " << skin_half);
+
+    if (resort_flag_)
+    {
+        LOG4ESPP_INFO(theLogger, "Particles will be decomposed.");
+        dp_MAX = 0.;
+        system.storage->decompose();
+        LOG4ESPP_INFO(theLogger, "Particles have been decomposed.");
+        resort_flag_ = false;
+        // the order of the real particles changed
+        cg_restart_ = true;
+    }
+}
+
+void MinimizeEnergy::saveVelocities()
+{
+    saved_vel_.clear();
+    CellList realCells = getSystemRef().storage->getRealCells();
+    for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
+    {
+        saved_vel_[cit->id()] = cit->velocity();
+        cit->velocity() = 0.0;
+    }
+}
+
+void MinimizeEnergy::restoreVelocities()
+{
+    CellList realCells = getSystemRef().storage->getRealCells();
+    for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
+    {
+        std::map<longint, Real3D>::const_iterator it = saved_vel_.find(cit->id());
+        cit->velocity() = (it != saved_vel_.end()) ? it->second : Real3D(0.0);
+    }
+    saved_vel_.clear();
+}
+
+void MinimizeEnergy::beforeSendParticles(ParticleList& pl, OutBuffer& buf)
+{
+    std::vector<longint> toSendId;
+    std::vector<real> toSendVel;
+    for (ParticleList::Iterator pit(pl); pit.isValid(); ++pit)
+    {
+        std::map<longint, Real3D>::iterator it = saved_vel_.find(pit->id());
+        if (it == saved_vel_.end()) continue;
+        toSendId.push_back(it->first);
+        for (int i = 0; i < 3; i++) toSendVel.push_back(it->second[i]);
+        saved_vel_.erase(it);
+    }
+    buf.write(toSendId);
+    buf.write(toSendVel);
+}
+
+void MinimizeEnergy::afterRecvParticles(ParticleList& pl, InBuffer& buf)
+{
+    std::vector<longint> receivedId;
+    std::vector<real> receivedVel;
+    buf.read(receivedId);
+    buf.read(receivedVel);
+    for (size_t i = 0; i < receivedId.size(); i++)
+    {
+        saved_vel_[receivedId[i]] =
+            Real3D(receivedVel[3 * i], receivedVel[3 * i + 1], receivedVel[3 * i + 2]);
+    }
+}
+
+void MinimizeEnergy::fireStep()
+{
+    LOG4ESPP_INFO(theLogger, "FIRE single step");
+    System& system = getSystemRef();
+    CellList realCells = system.storage->getRealCells();
+
+    // power P = F.v and the norms of v and F, one reduction
+    real local[3] = {0.0, 0.0, 0.0}, global[3];
+    for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
+    {
+        local[0] += cit->force() * cit->velocity();
+        local[1] += cit->velocity().sqr();
+        local[2] += cit->force().sqr();
+    }
+    mpi::all_reduce(*system.comm, local, 3, global, std::plus<real>());
+
+    real mixV = 1.0, mixF = 0.0;
+    if (global[0] > 0.0)
+    {
+        mixV = 1.0 - fire_alpha_;
+        if (global[2] > 0.0) mixF = fire_alpha_ * sqrt(global[1] / global[2]);
+        if (++fire_npos_ > FIRE_NMIN)
+        {
+            fire_dt_ = std::min(fire_dt_ * FIRE_FINC, FIRE_DTMAX * gamma_);
+            fire_alpha_ *= FIRE_FALPHA;
+        }
+    }
+    else
+    {
+        // uphill, stop and slow down
+        mixV = 0.0;
+        fire_dt_ *= FIRE_FDEC;
+        fire_alpha_ = FIRE_ALPHA0;
+        fire_npos_ = 0;
+    }
+
+    // mixing and semi-implicit Euler step, the displacement is limited to max_displacement_
+    real dp_sqr_max = 0.0;
+    real max_dp_sqr = max_displacement_ * max_displacement_;
+    for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
+    {
+        Real3D& v = cit->velocity();
+        v = mixV * v + mixF * cit->force();
+        v += fire_dt_ * cit->force();
+
+        Real3D dp = fire_dt_ * v;
+        real dp_sqr = dp.sqr();
+        if (dp_sqr > max_dp_sqr)
+        {
+            dp *= max_displacement_ / sqrt(dp_sqr);
+            dp_sqr = max_dp_sqr;
+        }
+        cit->position() += dp;
+        dp_sqr_max = std::max(dp_sqr_max, dp_sqr);
+    }
+    mpi::all_reduce(*system.comm, dp_sqr_max, dp_sqr_max_, boost::mpi::maximum<real>());
+}
+
+void MinimizeEnergy::conjugateGradientStep()
+{
+    LOG4ESPP_INFO(theLogger, "conjugate gradient single step");
+    System& system = getSystemRef();
+    CellList realCells = system.storage->getRealCells();
+
+    // Polak-Ribiere factor beta = F.(F - F_old) / F_old.F_old
+    real beta = 0.0;
+    if (!cg_restart_)
+    {
+        real local[2] = {0.0, 0.0}, global[2];
+        size_t i = 0;
+        for (CellListIterator cit(realCells); !cit.isDone(); ++cit, ++i)
+        {
+            local[0] += cit->force() * (cit->force() - cg_f_old_[i]);
+            local[1] += cg_f_old_[i].sqr();
+        }
+        mpi::all_reduce(*system.comm, local, 2, global, std::plus<real>());
+        if (global[1] > 0.0) beta = std::max(0.0, global[0] / global[1]);
+    }
+
+    // new search direction h = F + beta h, stored in the velocity, and slope -F.h along it
+    cg_f_old_.clear();
+    real slope0 = 0.0;
+    for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
+    {
+        Real3D& h = cit->velocity();
+        h = cit->force() + beta * h;
+        cg_f_old_.push_back(cit->force());
+        slope0 += cit->force() * h;
+    }
+    real globalSlope0;
+    mpi::all_reduce(*system.comm, slope0, globalSlope0, std::plus<real>());
+
+    if (globalSlope0 <= 0.0)
+    {
+        // no descent direction, restart along the force
+        slope0 = 0.0;
+        for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
+        {
+            cit->velocity() = cit->force();
+            slope0 += cit->force().sqr();
+        }
+        mpi::all_reduce(*system.comm, slope0, globalSlope0, std::plus<real>());
+    }
+    cg_restart_ = false;
+
+    real h_sqr_max = 0.0, global_h_sqr_max;
+    for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
+    {
+        h_sqr_max = std::max(h_sqr_max, cit->velocity().sqr());
+    }
+    mpi::all_reduce(*system.comm, h_sqr_max, global_h_sqr_max, boost::mpi::maximum<real>());
+    if (global_h_sqr_max == 0.0)
+    {
+        dp_sqr_max_ = 0.0;
+        return;
+    }
+
+    // secant line search: trial step of half the maximum displacement, then the
+    // step where the slope along h vanishes, at most max_displacement_
+    real alphaMax = max_displacement_ / sqrt(global_h_sqr_max);
+    real alphaTrial = 0.5 * alphaMax;
+    displace(alphaTrial);
+    resortIfNeeded();
+    updateForces();
+
+    real slope1 = 0.0, globalSlope1;
+    realCells = system.storage->getRealCells();
+    for (CellListIterator cit(realCells); !cit.isDone(); ++cit)
+    {
+        slope1 += cit->force() * cit->velocity();
+    }
+    mpi::all_reduce(*system.comm, slope1, globalSlope1, std::plus<real>());
+
+    real alpha = alphaMax;
+    if (globalSlope1 < globalSlope0)
+        alpha = std::min(alphaMax, alphaTrial * globalSlope0 / (globalSlope0 - globalSlope1));
+
+    displace(alpha - alphaTrial);
+}
+
+std::string MinimizeEnergy::getMethod()
+{
+    switch (method_)
+    {
+        case FIRE:
+            return "fire";
+        case ConjugateGradient:
+            return "cg";
+        default:
+            return "steepest_descent";
+    }
+}
+
 void MinimizeEnergy::registerPython()
 {
     using namespace espressopp::python;
 
     // Note: use noncopyable and no_init for abstract classes
     class_<MinimizeEnergy, boost::noncopyable>(
-        "integrator_MinimizeEnergy", init<std::shared_ptr<System>, real, real, real, bool>())
+        "integrator_MinimizeEnergy",
+        init<std::shared_ptr<System>, real, real, real, bool, std::string>())
         .add_property("f_max", &MinimizeEnergy::getFMax)
+        .add_property("method", &MinimizeEnergy::getMethod)
         .add_property("displacement", &MinimizeEnergy::getDpMax)
         .add_property("step", make_getter(&MinimizeEnergy::nstep_),
                       make_setter(&MinimizeEnergy::nstep_))
@@ -25,6 +25,10 @@
 #ifndef _INTEGRATOR_MINIMIZEENERGY_HPP
 #define _INTEGRATOR_MINIMIZEENERGY_HPP
 
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/signals2.hpp>
 #include "logging.hpp"
 #include "Real3D.hpp"
 #include "iterator/CellListIterator.hpp"
@@ -39,14 +43,32 @@ namespace integrator
 {
 // Adopted from espressomd: src/core/minimize_energy.cpp
 
+/** Energy minimization with steepest descent (method "steepest_descent"),
+    FIRE (method "fire", E. Bitzek et al., Phys. Rev. Lett. 97, 170201 (2006))
+    or Polak-Ribiere conjugate gradients (method "cg").
+
+    FIRE and CG keep their per-particle state (MD velocity resp. search
+    direction) in the particle velocity, so it moves with the particles
+    between CPUs. The velocities of the particles are saved at the begin of
+    run and restored at its end, the saved ones travel with the particles.
+    FIRE uses unit masses and gamma as the initial time step.
+*/
 class MinimizeEnergy : public SystemAccess
 {
 public:
+    enum Method
+    {
+        SteepestDescent,
+        FIRE,
+        ConjugateGradient
+    };
+
     MinimizeEnergy(std::shared_ptr<class espressopp::System> system,
                    real gamma,
                    real ftol,
                    real max_displacement,
-                   bool variable_step_flag);
+                   bool variable_step_flag,
+                   std::string method);
     virtual ~MinimizeEnergy();
 
     bool run(int max_steps, bool verbose);
@@ -56,8 +78,24 @@ public:
 
 private:
     void steepestDescentStep();
+    void fireStep();
+    void conjugateGradientStep();
     void updateForces();
 
+    /** move all particles by alpha times their velocity, sets dp_sqr_max_ */
+    void displace(real alpha);
+    /** add the last displacement and decompose if it exceeds half the skin */
+    void resortIfNeeded();
+    /** save and zero the velocities, which then hold the FIRE and CG state */
+    void saveVelocities();
+    /** give the particles back the velocities they had before run */
+    void restoreVelocities();
+
+    void beforeSendParticles(ParticleList& pl, class OutBuffer& buf);
+    void afterRecvParticles(ParticleList& pl, class InBuffer& buf);
+
+    std::string getMethod();
+
     // Getters
     real getFMax() { return sqrt(f_max_sqr_); }
 
@@ -76,6 +114,21 @@ private:
 
     bool resort_flag_;  //!< true implies need for resort of particles
 
+    Method method_;
+
+    // FIRE state
+    real fire_dt_;
+    real fire_alpha_;
+    int fire_npos_;  //!< number of steps since the power was negative
+
+    // CG state, forces of the previous step in the order of the real cells
+    std::vector<Real3D> cg_f_old_;
+    bool cg_restart_;  //!< true if the search direction has to be reset to the force
+
+    // velocities of the particles before run, by particle id
+    std::map<longint, Real3D> saved_vel_;
+    boost::signals2::connection sigBeforeSend, sigAfterRecv;
+
     longint nstep_;
 
     static LOG4ESPP_DECL_LOGGER(theLogger);
@@ -45,6 +45,17 @@ where :math:`f_{max}` is a maximum force in a single step of steepest descent me
 
 In both cases, the routine runs until the maximum force is bigger than :math:`f_{max}` or for at most *n* steps.
 
+With ``method='fire'`` the FIRE algorithm (E. Bitzek et al., Phys. Rev. Lett. 97, 170201 (2006)) is used
+instead. The particles are moved by damped molecular dynamics with unit masses, :math:`\gamma` is the initial
+time step, which grows up to :math:`10\gamma` while the power :math:`F \cdot v` stays positive.
+
+With ``method='cg'`` Polak-Ribiere conjugate gradients are used. Along every search direction a secant line
+search is done, with at most :math:`d_{max}` displacement per particle. It needs two force evaluations per step.
+
+Both methods keep their state in the particle velocities. The velocities are saved at the begin of
+:py:meth:`run` and restored at its end. They usually need far fewer force evaluations than steepest descent, e.g. for removing
+overlaps of a freshly built melt.
+
 **Please note**
 This module does not support any integrator extensions.
 
@@ -58,9 +69,14 @@ Example
 >>> em = espressopp.integrator.MinimizeEnergy(system, gamma=0.01, ftol=0.01, max_displacement=0.01, variable_step_flag=True)
 >>> em.run(10000)
 
+Example
+
+>>> em = espressopp.integrator.MinimizeEnergy(system, gamma=0.002, ftol=0.01, max_displacement=0.05, method='fire')
+>>> em.run(10000)
+
 **API**
 
-.. function:: espressopp.integrator.MinimizeEnergy(system, gamma, ftol, max_displacement, variable_step_flag)
+.. function:: espressopp.integrator.MinimizeEnergy(system, gamma, ftol, max_displacement, variable_step_flag, method)
 
                 :param system: The espressopp system object.
                 :type system: espressopp.System
@@ -72,6 +88,8 @@ Example
                 :type max_displacement: float
                 :param variable_step_flag: The flag of adjusting gamma to the force strength.
                 :type variable_step_flag: bool
+                :param method: steepest_descent (default), fire or cg
+                :type method: str
 
 .. function:: espressopp.integrator.MinimizeEnergy.run(max_steps, verbose)
 
@@ -94,6 +112,10 @@ Example
 
     The current iteration step.
 
+.. py:data:: method
+
+    The minimization method.
+
 """
 from espressopp.esutil import cxxinit
 from espressopp import pmi
@@ -101,9 +123,11 @@ from espressopp import pmi
 from _espressopp import integrator_MinimizeEnergy
 
 class MinimizeEnergyLocal(integrator_MinimizeEnergy):
-    def __init__(self, system, gamma, ftol, max_displacement, variable_step_flag=False):
+    def __init__(self, system, gamma, ftol, max_displacement, variable_step_flag=False,
+                 method='steepest_descent'):
         if pmi.workerIsActive():
-            cxxinit(self, integrator_MinimizeEnergy, system, gamma, ftol*ftol, max_displacement, variable_step_flag)
+            cxxinit(self, integrator_MinimizeEnergy, system, gamma, ftol*ftol, max_displacement, variable_step_flag,
+                    method)
 
     def run(self, niter, verbose=False):
         if pmi.workerIsActive():
@@ -113,6 +137,6 @@ if pmi.isController:
     class MinimizeEnergy(metaclass=pmi.Proxy):
         pmiproxydefs = dict(
             cls =  'espressopp.integrator.MinimizeEnergyLocal',
-            pmiproperty = ('f_max', 'displacement', 'step'),
+            pmiproperty = ('f_max', 'displacement', 'step', 'method'),
             pmicall = ('run', )
         )
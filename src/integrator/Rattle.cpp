@@ -22,7 +22,9 @@
 
 #include "Rattle.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <boost/unordered_map.hpp>
 #include "storage/Storage.hpp"
 #include "iterator/CellListIterator.hpp"
 #include "System.hpp"
@@ -41,10 +43,25 @@ namespace integrator
 {
 LOG4ESPP_LOGGER(Rattle::theLogger, "Rattle");
 
-Rattle::Rattle(std::shared_ptr<System> _system, real _maxit, real _tol, real _rptol)
-    : Extension(_system), maxit(_maxit), tol(_tol), rptol(_rptol)
+Rattle::Rattle(std::shared_ptr<System> _system,
+               real _maxit,
+               real _tol,
+               real _rptol,
+               int _lincsOrder,
+               int _lincsIter)
+    : Extension(_system),
+      localBondsValid(false),
+      lincsOrder(_lincsOrder),
+      lincsIter(_lincsIter),
+      maxit(_maxit),
+      tol(_tol),
+      rptol(_rptol)
 {
     LOG4ESPP_INFO(theLogger, "construct Rattle");
+    if (lincsOrder < 0 || lincsIter < 0)
+    {
+        throw std::runtime_error("In Rattle, the LINCS order and iterations must not be negative");
+    }
 }
 
 Rattle::~Rattle() { LOG4ESPP_INFO(theLogger, "~Rattle"); }
@@ -54,6 +71,7 @@ void Rattle::disconnect()
     _befIntP.disconnect();
     _aftIntP.disconnect();
     _aftIntV.disconnect();
+    _onParticlesChanged.disconnect();
 }
 
 void Rattle::connect()
@@ -61,6 +79,9 @@ void Rattle::connect()
     _befIntP = integrator->befIntP.connect(std::bind(&Rattle::saveOldPos, this));
     _aftIntP = integrator->aftIntP.connect(std::bind(&Rattle::applyPositionConstraints, this));
     _aftIntV = integrator->aftIntV.connect(std::bind(&Rattle::applyVelocityConstraints, this));
+    _onParticlesChanged = getSystemRef().storage->onParticlesChanged.connect(
+        std::bind(&Rattle::invalidateLocalBonds, this));
+    localBondsValid = false;
 }
 
 void Rattle::addBond(int pid1, int pid2, real constraintDist, real mass1, real mass2)
@@ -73,43 +94,220 @@ void Rattle::addBond(int pid1, int pid2, real constraintDist, real mass1, real m
             << std::endl;
         throw std::runtime_error(msg.str());
     }
+    if (!bondPids.insert(std::make_pair(std::min(pid1, pid2), std::max(pid1, pid2))).second)
+    {
+        std::ostringstream msg;
+        msg << "In Rattle, the bond " << pid1 << " - " << pid2 << " is already constrained";
+        throw std::runtime_error(msg.str());
+    }
     ConstrainedBond newbond;
     newbond.pidHeavy = pid1;
     newbond.pidHyd = pid2;
     newbond.constraintDist2 = constraintDist * constraintDist;
     newbond.invmassHeavy = 1.0 / mass1;
     newbond.invmassHyd = 1.0 / mass2;
-    constrainedBonds.insert(std::make_pair(pid2, newbond));
-    constrainedBondsKeys.push_back(pid2);
+    constrainedBonds.push_back(newbond);
+    localBondsValid = false;
 }
 
-void Rattle::saveOldPos()
+void Rattle::updateLocalBonds()
 {
-    oldPos.clear();
     System& system = getSystemRef();
-    boost::unordered_map<longint, ConstrainedBond>::iterator it;
-    // collect coordinates of bonds on this CPU
-    // loop over bonds
-    for (it = constrainedBonds.begin(); it != constrainedBonds.end(); it++)
+
+    localBonds.clear();
+    localParticles.clear();
+    // pid to index in localParticles, only needed while building the lists
+    boost::unordered_map<longint, int> localIndex;
+    auto indexOf = [&](Particle* p) {
+        auto ins = localIndex.insert(std::make_pair(p->id(), int(localParticles.size())));
+        if (ins.second) localParticles.push_back(p);
+        return ins.first->second;
+    };
+
+    // a bond is handled by the CPU of its heavy atom
+    for (const ConstrainedBond& bond : constrainedBonds)
+    {
+        Particle* hp = system.storage->lookupAdrATParticle(bond.pidHeavy);
+        if (!hp) continue;
+        Particle* lp = system.storage->lookupAdrATParticle(bond.pidHyd);
+        if (!lp)
+        {
+            std::ostringstream msg;
+            msg << "In Rattle, cannot find light particle " << bond.pidHyd
+                << ", all light and heavy particles in a group of rigid bonds must be on the "
+                   "same node"
+                << std::endl;
+            throw std::runtime_error(msg.str());
+        }
+        LocalBond lb;
+        lb.a = indexOf(lp);
+        lb.b = indexOf(hp);
+        lb.constraintDist2 = bond.constraintDist2;
+        lb.invmassHyd = bond.invmassHyd;
+        lb.invmassHeavy = bond.invmassHeavy;
+        localBonds.push_back(lb);
+    }
+
+    size_t n = localParticles.size();
+    oldPos.resize(n);
+    currPosition.resize(n);
+    currVelocity.resize(n);
+    changedLastTime.resize(n);
+    changingThisTime.resize(n);
+    if (lincsOrder > 0) updateLincsCouplings();
+    localBondsValid = true;
+}
+
+void Rattle::updateLincsCouplings()
+{
+    size_t nb = localBonds.size();
+    lincsS.resize(nb);
+    lincsRhs.resize(nb);
+    lincsSol.resize(nb);
+    lincsTmp.resize(nb);
+    lincsDir.resize(nb);
+
+    // bonds at every local particle
+    std::vector<std::vector<int> > bondsAt(localParticles.size());
+    for (size_t k = 0; k < nb; k++)
+    {
+        const LocalBond& bond = localBonds[k];
+        lincsS[k] = 1.0 / sqrt(bond.invmassHyd + bond.invmassHeavy);
+        bondsAt[bond.a].push_back(k);
+        bondsAt[bond.b].push_back(k);
+    }
+
+    // A_kl = -(+-) invmass S_k S_l for bonds sharing a particle, + if it is the same end of both
+    lincsCouplingStart.assign(1, 0);
+    lincsCouplingBond.clear();
+    lincsCouplingCoef.clear();
+    for (size_t k = 0; k < nb; k++)
+    {
+        const LocalBond& bk = localBonds[k];
+        for (int end = 0; end < 2; end++)
+        {
+            int shared = end == 0 ? bk.a : bk.b;
+            real invmass = end == 0 ? bk.invmassHyd : bk.invmassHeavy;
+            for (int l : bondsAt[shared])
+            {
+                if (l == int(k)) continue;
+                bool sameEnd = (localBonds[l].a == shared) == (end == 0);
+                lincsCouplingBond.push_back(l);
+                lincsCouplingCoef.push_back((sameEnd ? -1.0 : 1.0) * invmass * lincsS[k] *
+                                            lincsS[l]);
+            }
+        }
+        lincsCouplingStart.push_back(lincsCouplingBond.size());
+    }
+    lincsCouplingA.resize(lincsCouplingBond.size());
+}
+
+void Rattle::lincsSolve()
+{
+    size_t nb = localBonds.size();
+    for (size_t k = 0; k < nb; k++)
     {
-        longint heavyID = (it->second).pidHeavy;
-        longint lightID = (it->second).pidHyd;
-        Particle* hp = system.storage->lookupAdrATParticle(heavyID);
-        if (hp)
-        {  // heavy atom is on this node
-            Particle* lp = system.storage->lookupAdrATParticle(lightID);
-            if (!lp)
+        for (int c = lincsCouplingStart[k]; c < lincsCouplingStart[k + 1]; c++)
+        {
+            lincsCouplingA[c] = lincsCouplingCoef[c] * (lincsDir[k] * lincsDir[lincsCouplingBond[c]]);
+        }
+    }
+
+    // (1 - A)^-1 = 1 + A + A^2 + ...
+    std::copy(lincsRhs.begin(), lincsRhs.end(), lincsSol.begin());
+    for (int rec = 0; rec < lincsOrder; rec++)
+    {
+        for (size_t k = 0; k < nb; k++)
+        {
+            real sum = 0.0;
+            for (int c = lincsCouplingStart[k]; c < lincsCouplingStart[k + 1]; c++)
             {
-                std::ostringstream msg;
-                msg << "In Rattle, cannot find light particle " << lightID
-                    << ", all light and heavy particles in a group of rigid bonds must be on the "
-                       "same node"
-                    << std::endl;
-                throw std::runtime_error(msg.str());
+                sum += lincsCouplingA[c] * lincsRhs[lincsCouplingBond[c]];
             }
-            oldPos.insert(
-                std::make_pair(lightID, std::pair<Real3D, Real3D>(hp->getPos(), lp->getPos())));
+            lincsTmp[k] = sum;
         }
+        lincsRhs.swap(lincsTmp);
+        for (size_t k = 0; k < nb; k++) lincsSol[k] += lincsRhs[k];
+    }
+}
+
+void Rattle::lincsPositions()
+{
+    real dt = integrator->getTimeStep();
+    const bc::BC& bc = *getSystemRef().bc;
+    size_t nb = localBonds.size();
+
+    // constrain the projections on the bond directions at the end of the previous timestep
+    for (size_t k = 0; k < nb; k++)
+    {
+        const LocalBond& bond = localBonds[k];
+        Real3D rab, pab;
+        bc.getMinimumImageVectorBox(rab, oldPos[bond.a], oldPos[bond.b]);
+        bc.getMinimumImageVectorBox(pab, currPosition[bond.a], currPosition[bond.b]);
+        lincsDir[k] = rab / rab.abs();
+        lincsRhs[k] = lincsS[k] * (lincsDir[k] * pab - sqrt(bond.constraintDist2));
+    }
+
+    for (int iter = 0;; iter++)
+    {
+        lincsSolve();
+        for (size_t k = 0; k < nb; k++)
+        {
+            const LocalBond& bond = localBonds[k];
+            Real3D displ = (lincsS[k] * lincsSol[k]) * lincsDir[k];
+            currPosition[bond.a] -= bond.invmassHyd * displ;
+            currPosition[bond.b] += bond.invmassHeavy * displ;
+
+            displ /= dt;
+            currVelocity[bond.a] -= bond.invmassHyd * displ;
+            currVelocity[bond.b] += bond.invmassHeavy * displ;
+        }
+        if (iter == lincsIter) break;
+
+        // the bonds got longer by the rotation, shorten the projections to sqrt(2 d^2 - l^2)
+        for (size_t k = 0; k < nb; k++)
+        {
+            const LocalBond& bond = localBonds[k];
+            Real3D pab;
+            bc.getMinimumImageVectorBox(pab, currPosition[bond.a], currPosition[bond.b]);
+            real p2 = 2.0 * bond.constraintDist2 - pab.sqr();
+            lincsRhs[k] = lincsS[k] * (sqrt(bond.constraintDist2) - (p2 > 0.0 ? sqrt(p2) : 0.0));
+        }
+    }
+}
+
+void Rattle::lincsVelocities()
+{
+    const bc::BC& bc = *getSystemRef().bc;
+    size_t nb = localBonds.size();
+
+    // remove the relative velocities along the constrained bonds
+    for (size_t k = 0; k < nb; k++)
+    {
+        const LocalBond& bond = localBonds[k];
+        Real3D rab;
+        bc.getMinimumImageVectorBox(rab, currPosition[bond.a], currPosition[bond.b]);
+        lincsDir[k] = rab / rab.abs();
+        lincsRhs[k] = lincsS[k] * (lincsDir[k] * (currVelocity[bond.a] - currVelocity[bond.b]));
+    }
+    lincsSolve();
+    for (size_t k = 0; k < nb; k++)
+    {
+        const LocalBond& bond = localBonds[k];
+        Real3D deltav = (lincsS[k] * lincsSol[k]) * lincsDir[k];
+        currVelocity[bond.a] -= bond.invmassHyd * deltav;
+        currVelocity[bond.b] += bond.invmassHeavy * deltav;
+    }
+}
+
+void Rattle::saveOldPos()
+{
+    if (!localBondsValid) updateLocalBonds();
+
+    // collect coordinates of the constrained particles on this CPU
+    for (size_t i = 0; i < localParticles.size(); i++)
+    {
+        oldPos[i] = localParticles[i]->position();
     }
 }
 
@@ -118,35 +316,27 @@ void Rattle::applyPositionConstraints()
     int iteration = 0;
     bool done = false;
     real dt = integrator->getTimeStep();
-    System& system = getSystemRef();
     const bc::BC& bc = *getSystemRef().bc;  // boundary conditions
 
-    boost::unordered_map<longint, Real3D> currPosition;
-    boost::unordered_map<longint, Real3D> currVelocity;
-    boost::unordered_map<longint, bool> movedLastTime;   // was this particle moved last time?
-    boost::unordered_map<longint, bool> movingThisTime;  // is the particle being moved this time?
-
-    if (oldPos.size() == 0)
+    // the particles are only moved by the integrator since saveOldPos()
+    if (localBonds.empty())
     {
         return;
     }  // no rigid bonds on this node
 
-    // loop over bonds on this node
-    OldPos::iterator it;
-    for (it = oldPos.begin(); it != oldPos.end(); it++)
+    size_t n = localParticles.size();
+    for (size_t i = 0; i < n; i++)
+    {
+        changedLastTime[i] = true;
+        changingThisTime[i] = false;
+        currPosition[i] = localParticles[i]->position();
+        currVelocity[i] = localParticles[i]->velocity();
+    }
+
+    if (lincsOrder > 0)
     {
-        longint pidHyd = it->first;
-        longint pidHeavy = constrainedBonds[pidHyd].pidHeavy;
-        // In the maps below, the values for each key pidHeavy may be initialised more than, if
-        // pidHeavy is involved in more than one constrained bond. This is not a problem
-        movedLastTime[pidHyd] = true;
-        movedLastTime[pidHeavy] = true;
-        movingThisTime[pidHyd] = false;
-        movingThisTime[pidHeavy] = false;
-        currPosition[pidHyd] = system.storage->lookupAdrATParticle(pidHyd)->getPos();
-        currPosition[pidHeavy] = system.storage->lookupAdrATParticle(pidHeavy)->getPos();
-        currVelocity[pidHyd] = system.storage->lookupAdrATParticle(pidHyd)->getV();
-        currVelocity[pidHeavy] = system.storage->lookupAdrATParticle(pidHeavy)->getV();
+        lincsPositions();
+        done = true;
     }
 
     // constraint interations
@@ -154,12 +344,12 @@ void Rattle::applyPositionConstraints()
     {
         done = true;
         // loop over constrained bonds on this cpu
-        for (it = oldPos.begin(); it != oldPos.end(); it++)
+        for (const LocalBond& bond : localBonds)
         {
-            // get pids of the two particles in this bond
-            longint a = it->first;  // pidHyd
-            longint b = constrainedBonds[a].pidHeavy;
-            if (movedLastTime[a] || movedLastTime[b])
+            // indices of the two particles in this bond
+            int a = bond.a;  // light
+            int b = bond.b;  // heavy
+            if (changedLastTime[a] || changedLastTime[b])
             {
                 // compare current distance to desired constraint distance
                 Real3D pab;
@@ -167,15 +357,15 @@ void Rattle::applyPositionConstraints()
                     pab, currPosition[a],
                     currPosition[b]);  // a-b, current positions which change during iterations
                 real pabsq = pab.sqr();
-                real constraint_absq = constrainedBonds[a].constraintDist2;
+                real constraint_absq = bond.constraintDist2;
                 real diffsq = pabsq - constraint_absq;
                 if (fabs(diffsq) > (constraint_absq * tol))
                 {
                     // get ab vector before unconstrained position update
                     Real3D rab;
                     bc.getMinimumImageVectorBox(
-                        rab, oldPos[a].second,
-                        oldPos[a].first);          // pos at time t (end of last timestep), a-b;
+                        rab, oldPos[a],
+                        oldPos[b]);                // pos at time t (end of last timestep), a-b;
                     real rab_dot_pab = rab * pab;  // r_ab(t) * r_ab,curr(t+dt)
                     if (rab_dot_pab < (constraint_absq * rptol))
                     {  // i.e. if angle is too large
@@ -183,8 +373,8 @@ void Rattle::applyPositionConstraints()
                         msg << "Constraint failure in RATTLE" << std::endl;
                         throw std::runtime_error(msg.str());
                     }
-                    real rma = constrainedBonds[a].invmassHyd;
-                    real rmb = constrainedBonds[a].invmassHeavy;
+                    real rma = bond.invmassHyd;
+                    real rmb = bond.invmassHeavy;
                     real gab = diffsq / (2.0 * (rma + rmb) * rab_dot_pab);
                     // direct constraint along bond vector at end of previous timestep
                     Real3D displ = gab * rab;
@@ -195,19 +385,14 @@ void Rattle::applyPositionConstraints()
                     currVelocity[a] -= rma * displ;
                     currVelocity[b] += rmb * displ;
 
-                    movingThisTime[a] = true;
-                    movingThisTime[b] = true;
+                    changingThisTime[a] = true;
+                    changingThisTime[b] = true;
                     done = false;
                 }
             }
         }
-        boost::unordered_map<longint, bool>::iterator it3;
-        for (it3 = movedLastTime.begin(); it3 != movedLastTime.end(); it3++)
-        {
-            longint id = it3->first;
-            movedLastTime[id] = movingThisTime[id];
-            movingThisTime[id] = false;
-        }
+        changedLastTime.swap(changingThisTime);
+        std::fill(changingThisTime.begin(), changingThisTime.end(), false);
 
         iteration += 1;
     }
@@ -220,13 +405,10 @@ void Rattle::applyPositionConstraints()
     }
 
     // store new values for positions
-    boost::unordered_map<longint, Real3D>::iterator it2;
-    for (it2 = currPosition.begin(); it2 != currPosition.end(); it2++)
+    for (size_t i = 0; i < n; i++)
     {
-        longint id = it2->first;
-        Particle* p = system.storage->lookupAdrATParticle(id);
-        p->position() = currPosition[id];
-        p->velocity() = currVelocity[id];
+        localParticles[i]->position() = currPosition[i];
+        localParticles[i]->velocity() = currVelocity[i];
     }
 }
 
@@ -234,47 +416,24 @@ void Rattle::applyVelocityConstraints()
 {
     int iteration = 0;
     bool done = false;
-    System& system = getSystemRef();
     const bc::BC& bc = *getSystemRef().bc;  // boundary conditions
 
-    boost::unordered_map<longint, Real3D> currPosition;
-    boost::unordered_map<longint, Real3D> currVelocity;
-    boost::unordered_map<longint, bool>
-        changedLastTime;  // was this particle velocity changed last time?
-    boost::unordered_map<longint, bool>
-        changingThisTime;  // is the particle velocity being changed this time?
-
-    // get all constrained bonds (light particles) on this CPU
-    // can't use contents of oldPos to identify which constrained bonds are on this CPU because
     // particles may have changed CPU since applyPositionConstraints()
-    lightPart.clear();
-    boost::unordered_map<longint, ConstrainedBond>::iterator it3;
-    for (it3 = constrainedBonds.begin(); it3 != constrainedBonds.end(); it3++)
+    if (!localBondsValid) updateLocalBonds();
+
+    size_t n = localParticles.size();
+    for (size_t i = 0; i < n; i++)
     {
-        longint lightID = (it3->second).pidHyd;
-        Particle* lp = system.storage->lookupAdrATParticle(lightID);
-        if (lp)
-        {  // light atom is on this node
-            lightPart.push_back(lightID);
-        }
+        changedLastTime[i] = true;
+        changingThisTime[i] = false;
+        currPosition[i] = localParticles[i]->position();
+        currVelocity[i] = localParticles[i]->velocity();
     }
 
-    // loop over constrained bonds on this node
-    std::vector<int>::iterator it;
-    for (it = lightPart.begin(); it != lightPart.end(); it++)
+    if (lincsOrder > 0)
     {
-        longint pidHyd = *it;
-        longint pidHeavy = constrainedBonds[pidHyd].pidHeavy;
-        // In the maps below, the values for each key pidHeavy may be initialised more than, if
-        // pidHeavy is involved in more than one constrained bond. This is not a problem
-        changedLastTime[pidHyd] = true;
-        changedLastTime[pidHeavy] = true;
-        changingThisTime[pidHyd] = false;
-        changingThisTime[pidHeavy] = false;
-        currPosition[pidHyd] = system.storage->lookupAdrATParticle(pidHyd)->getPos();
-        currPosition[pidHeavy] = system.storage->lookupAdrATParticle(pidHeavy)->getPos();
-        currVelocity[pidHyd] = system.storage->lookupAdrATParticle(pidHyd)->getV();
-        currVelocity[pidHeavy] = system.storage->lookupAdrATParticle(pidHeavy)->getV();
+        lincsVelocities();
+        done = true;
     }
 
     // constraint interations
@@ -282,20 +441,19 @@ void Rattle::applyVelocityConstraints()
     {
         done = true;
         // loop over constrained bonds on this cpu
-        for (it = lightPart.begin(); it != lightPart.end(); it++)
+        for (const LocalBond& bond : localBonds)
         {
-            // get pids of the two particles in this bond
-            longint a = *it;  // pidHyd
-            longint b = constrainedBonds[a].pidHeavy;
+            int a = bond.a;  // light
+            int b = bond.b;  // heavy
             if (changedLastTime[a] || changedLastTime[b])
             {
                 Real3D vab = currVelocity[a] - currVelocity[b];
                 Real3D rab;
                 bc.getMinimumImageVectorBox(rab, currPosition[a], currPosition[b]);
                 real rab_dot_vab = rab * vab;
-                real rma = constrainedBonds[a].invmassHyd;
-                real rmb = constrainedBonds[a].invmassHeavy;
-                real constraint_absq = constrainedBonds[a].constraintDist2;
+                real rma = bond.invmassHyd;
+                real rmb = bond.invmassHeavy;
+                real constraint_absq = bond.constraintDist2;
                 real gab = -1.0 * rab_dot_vab / ((rma + rmb) * constraint_absq);
                 if (fabs(gab) > tol)
                 {
@@ -309,14 +467,8 @@ void Rattle::applyVelocityConstraints()
                 }
             }
         }
-
-        boost::unordered_map<longint, bool>::iterator it3;
-        for (it3 = changedLastTime.begin(); it3 != changedLastTime.end(); it3++)
-        {
-            longint id = it3->first;
-            changedLastTime[id] = changingThisTime[id];
-            changingThisTime[id] = false;
-        }
+        changedLastTime.swap(changingThisTime);
+        std::fill(changingThisTime.begin(), changingThisTime.end(), false);
 
         iteration += 1;
     }
@@ -329,12 +481,9 @@ void Rattle::applyVelocityConstraints()
     }
 
     // store new values for velocities
-    boost::unordered_map<longint, Real3D>::iterator it2;
-    for (it2 = currVelocity.begin(); it2 != currVelocity.end(); it2++)
+    for (size_t i = 0; i < n; i++)
     {
-        longint id = it2->first;
-        Particle* p = system.storage->lookupAdrATParticle(id);
-        p->velocity() = currVelocity[id];
+        localParticles[i]->velocity() = currVelocity[i];
     }
 }
 
@@ -348,6 +497,7 @@ void Rattle::registerPython()
 
     class_<Rattle, std::shared_ptr<Rattle>, bases<Extension> >(
         "integrator_Rattle", init<std::shared_ptr<System>, real, real, real>())
+        .def(init<std::shared_ptr<System>, real, real, real, int, int>())
         .def("addBond", &Rattle::addBond);
 }
 }  // namespace integrator
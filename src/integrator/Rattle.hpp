@@ -25,7 +25,9 @@
 #include "types.hpp"
 #include "logging.hpp"
 #include "Extension.hpp"
-#include <boost/unordered_map.hpp>
+#include <set>
+#include <utility>
+#include <vector>
 #include <boost/signals2.hpp>
 #include "boost/signals2.hpp"
 
@@ -33,10 +35,24 @@ namespace espressopp
 {
 namespace integrator
 {
+/** RATTLE for groups of bond constraints that are all on one CPU.
+
+    With lincsOrder > 0 the constraints are solved with LINCS (B. Hess et al.,
+    J. Comput. Chem. 18, 1463 (1997)) instead of the SHAKE-like iterations:
+    the coupled constraints are inverted by a series expansion of that order
+    followed by lincsIter corrections for the rotational lengthening. As the
+    groups never span CPUs, this is the parallel variant P-LINCS without
+    communication of the coupling.
+*/
 class Rattle : public Extension
 {
 public:
-    Rattle(std::shared_ptr<System> _system, real _maxit, real _tol, real _rptol);
+    Rattle(std::shared_ptr<System> _system,
+           real _maxit,
+           real _tol,
+           real _rptol,
+           int _lincsOrder = 0,
+           int _lincsIter = 1);
     ~Rattle();
 
     void addBond(int pid1, int pid2, real constraintDist, real mass1, real mass2);
@@ -48,18 +64,10 @@ public:
     static void registerPython();
 
 private:
-    boost::signals2::connection _befIntP, _aftIntP, _aftIntV;
+    boost::signals2::connection _befIntP, _aftIntP, _aftIntV, _onParticlesChanged;
     void connect();
     void disconnect();
 
-    // positions in previous timestep
-    // key is pid of light atom in bond, value is heavy atom and light atom coordinates
-    typedef boost::unordered_map<longint, std::pair<Real3D, Real3D> > OldPos;
-    OldPos oldPos;
-
-    std::vector<longint> lightPart;  // list of light particles in constrained bonds on the CPU, for
-                                     // use in applyVelocityConstraints
-
     struct ConstrainedBond
     {
         longint pidHeavy;
@@ -68,9 +76,47 @@ private:
         real invmassHeavy;
         real invmassHyd;
     };
-    boost::unordered_map<longint, ConstrainedBond> constrainedBonds;  // key: light atom pid
-    std::vector<longint>
-        constrainedBondsKeys;  // list of keys (light atom pids) in constrainedBonds map
+    std::vector<ConstrainedBond> constrainedBonds;  // all constrained bonds
+    std::set<std::pair<longint, longint> > bondPids;  // (smaller, larger) pid of every bond
+
+    // constrained bonds on this CPU, a (light) and b (heavy) index localParticles
+    struct LocalBond
+    {
+        int a, b;
+        real constraintDist2;
+        real invmassHyd;
+        real invmassHeavy;
+    };
+    std::vector<LocalBond> localBonds;
+    std::vector<Particle*> localParticles;
+    bool localBondsValid;  // false after the particle pointers have changed
+
+    /** rebuild localBonds and localParticles from constrainedBonds */
+    void updateLocalBonds();
+    void invalidateLocalBonds() { localBondsValid = false; }
+
+    // per local particle: position in previous timestep and the values during the iterations
+    std::vector<Real3D> oldPos;
+    std::vector<Real3D> currPosition;
+    std::vector<Real3D> currVelocity;
+    std::vector<char> changedLastTime;   // was this particle moved last time?
+    std::vector<char> changingThisTime;  // is the particle being moved this time?
+
+    int lincsOrder;  // order of the LINCS expansion, 0 for the iterative solver
+    int lincsIter;   // LINCS corrections for the rotational lengthening
+
+    // LINCS, per local bond: 1/sqrt(invmassHyd + invmassHeavy), direction, right hand
+    // side and solution; couplings of bond k are lincsCouplingBond/Coef[lincsCouplingStart[k]
+    // .. lincsCouplingStart[k+1]) with the coefficient without the directions
+    std::vector<real> lincsS, lincsRhs, lincsSol, lincsTmp;
+    std::vector<Real3D> lincsDir;
+    std::vector<int> lincsCouplingStart, lincsCouplingBond;
+    std::vector<real> lincsCouplingCoef, lincsCouplingA;
+    void updateLincsCouplings();
+    /** solve (1 - A) lincsSol = lincsRhs, lincsDir must be set */
+    void lincsSolve();
+    void lincsPositions();
+    void lincsVelocities();
 
     real maxit;  // maximum number of iterations
     real tol;    // tolerance for deciding if constraint distance and current distance are similar
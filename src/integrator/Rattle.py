@@ -61,17 +61,25 @@ This list of lists of constrained bonds can be conveniently built using the espr
 >>> print "# found", len(constrainedBondsDict)," heavy atoms involved in bonds to hydrogen"
 >>> print "# will constrain", len(constrainedBondsList)," bonds using RATTLE"
 
-.. function:: espressopppp.integrator.Rattle(system, maxit = 1000, tol = 1e-6, rptol = 1e-6)
+With lincsOrder > 0 the constraints are solved with LINCS (Hess et al., J. Comput. Chem. 18, 1463 (1997)) instead of the iterations: the coupling of the bonds at a heavy atom is inverted by a series expansion of order lincsOrder, and lincsIter corrections remove the lengthening of rotated bonds. maxit, tol and rptol are not used then. Since every group of rigid bonds is on one CPU, no coupling has to be communicated as in P-LINCS.
+
+>>> rattle = espressopp.integrator.Rattle(system, lincsOrder = 4, lincsIter = 1)
+
+.. function:: espressopppp.integrator.Rattle(system, maxit = 1000, tol = 1e-6, rptol = 1e-6, lincsOrder = 0, lincsIter = 1)
 
                 :param espressopp.System system: espressopp system
                 :param int maxit: maximum number of iterations
                 :param real tol: tolerance for deciding if constraint distance and current distance are similar enough
                 :param real rptol: tolerance for deciding if the angle between the bond vector at end of previous timestep and current vector has become too large
+                :param int lincsOrder: order of the LINCS expansion, 0 for the iterative RATTLE
+                :param int lincsIter: number of LINCS corrections for the rotational lengthening
 
 .. function:: espressopppp.integrator.Rattle.addConstrainedBonds(bondDetailsLists)
 
                 :param bondDetailsLists: list of lists, each list contains pid of heavy atom, pid of light atom, constraint distance, mass of heavy atom, mass of light atom
                 :type bondDetailsLists: list of [int, int, real, real, real]
+
+                A bond that is already constrained raises an error.
 """
 
 from espressopp.esutil import cxxinit
@@ -81,9 +89,9 @@ from _espressopp import integrator_Rattle
 
 class RattleLocal(ExtensionLocal, integrator_Rattle):
 
-    def __init__(self, system, maxit = 1000, tol = 1e-6, rptol = 1e-6):
+    def __init__(self, system, maxit = 1000, tol = 1e-6, rptol = 1e-6, lincsOrder = 0, lincsIter = 1):
         if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
-            cxxinit(self, integrator_Rattle, system, maxit, tol, rptol)
+            cxxinit(self, integrator_Rattle, system, maxit, tol, rptol, lincsOrder, lincsIter)
 
     def addConstrainedBonds(self, bondDetailsLists):
         """
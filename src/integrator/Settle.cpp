@@ -25,6 +25,8 @@
 #include "Settle.hpp"
 
 #include <functional>
+#include <sstream>
+#include <stdexcept>
 #include "storage/Storage.hpp"
 #include "iterator/CellListIterator.hpp"
 #include "System.hpp"
@@ -50,6 +52,8 @@ Settle::Settle(std::shared_ptr<System> _system,
       distOH(_distOH),
       fixedTupleList(_fixedTupleList)
 {
+    localMolsValid = false;
+
     LOG4ESPP_INFO(theLogger, "construct Settle");
 
     /*
@@ -94,6 +98,7 @@ void Settle::disconnect()
     _aftIntP.disconnect();
     _aftIntV.disconnect();  // OUT AGAIN?
     _aftIntSlow.disconnect();
+    _onParticlesChanged.disconnect();
 }
 
 void Settle::connect()
@@ -104,11 +109,25 @@ void Settle::connect()
     _aftIntV =
         integrator->aftIntV.connect(std::bind(&Settle::correctVelocities, this));  // OUT AGAIN?
     _aftIntSlow = integrator->aftIntSlow.connect(std::bind(&Settle::correctVelocities, this));
+    _onParticlesChanged = getSystemRef().storage->onParticlesChanged.connect(
+        std::bind(&Settle::invalidateLocalMolecules, this));
+    localMolsValid = false;
 }
 
-void Settle::saveOldPos()
+void Settle::add(longint pid)
 {
-    oldPos.clear();
+    if (!molIDs.insert(pid).second)
+    {
+        std::ostringstream msg;
+        msg << "In Settle, molecule " << pid << " has already been added";
+        throw std::runtime_error(msg.str());
+    }
+    localMolsValid = false;
+}
+
+void Settle::updateLocalMolecules()
+{
+    localMols.clear();
     System& system = getSystemRef();
     // loop over all local molecules
     CellList realCells = system.storage->getRealCells();
@@ -117,45 +136,86 @@ void Settle::saveOldPos()
         // check if molecule is HHO
         if (molIDs.count(cit->id()) > 0)
         {
-            // lookup cit in tuples, and save AT positions
+            // lookup cit in tuples, and save the AT particles
             FixedTupleListAdress::iterator it;
             it = fixedTupleList->find(&(*cit));
 
-            oldPos.insert(std::make_pair(
-                cit->id(), Triple<Real3D, Real3D, Real3D>((it->second.at(0))->getPos(),
-                                                          (it->second.at(1))->getPos(),
-                                                          (it->second.at(2))->getPos())));
+            LocalMolecule mol;
+            mol.O = it->second.at(0);
+            mol.H1 = it->second.at(1);
+            mol.H2 = it->second.at(2);
+            localMols.push_back(mol);
+        }
+    }
+    for (int c = 0; c < 9; c++)
+    {
+        oldPos[c].resize(localMols.size());
+        newPos[c].resize(localMols.size());
+    }
+    localMolsValid = true;
+}
+
+void Settle::saveOldPos()
+{
+    if (!localMolsValid) updateLocalMolecules();
+
+    for (size_t i = 0; i < localMols.size(); i++)
+    {
+        const LocalMolecule& mol = localMols[i];
+        const Particle* atoms[3] = {mol.O, mol.H1, mol.H2};
+        for (int a = 0; a < 3; a++)
+        {
+            const Real3D& pos = atoms[a]->position();
+            for (int d = 0; d < 3; d++) oldPos[3 * a + d][i] = pos[d];
         }
     }
 }
 
 void Settle::applyConstraints()
 {
-    // call settlep() for every water molecule on node
-    // System& system = getSystemRef();
-    OldPos::iterator it;
-    for (it = oldPos.begin(); it != oldPos.end(); it++)
+    // the particles have not changed since saveOldPos()
+    size_t n = localMols.size();
+    for (size_t i = 0; i < n; i++)
     {
-        // std::cout << "in applyConstraints " << system.comm->rank() << " molID " << it->first <<
-        // std::endl;
-        settlep(it->first);
+        const LocalMolecule& mol = localMols[i];
+        const Particle* atoms[3] = {mol.O, mol.H1, mol.H2};
+        for (int a = 0; a < 3; a++)
+        {
+            const Real3D& pos = atoms[a]->position();
+            for (int d = 0; d < 3; d++) newPos[3 * a + d][i] = pos[d];
+        }
+    }
+
+    settlep();
+
+    // write back and get the unconstrained velocities at v(t+dt)
+    const bc::BC& bc = *getSystemRef().bc;
+    real invdt = 1.0 / integrator->getTimeStep();
+    for (size_t i = 0; i < n; i++)
+    {
+        const LocalMolecule& mol = localMols[i];
+        Particle* atoms[3] = {mol.O, mol.H1, mol.H2};
+        for (int a = 0; a < 3; a++)
+        {
+            Real3D pos(newPos[3 * a][i], newPos[3 * a + 1][i], newPos[3 * a + 2][i]);
+            Real3D old(oldPos[3 * a][i], oldPos[3 * a + 1][i], oldPos[3 * a + 2][i]);
+            atoms[a]->position() = pos;
+
+            Real3D displ;
+            bc.getMinimumImageVectorBox(displ, pos, old);
+            atoms[a]->setV(displ * invdt);
+        }
     }
 }
 
 void Settle::correctVelocities()
 {
     // call settlev() for every water molecule on node
+    if (!localMolsValid) updateLocalMolecules();
 
-    System& system = getSystemRef();
-    // loop over all local molecules
-    CellList realCells = system.storage->getRealCells();
-    for (iterator::CellListIterator cit(realCells); !cit.isDone(); ++cit)
+    for (size_t i = 0; i < localMols.size(); i++)
     {
-        // check if molecule is HHO
-        if (molIDs.count(cit->id()) > 0)
-        {
-            settlev(cit->id());
-        }
+        settlev(i);
     }
 }
 
@@ -170,145 +230,152 @@ void Settle::correctVelocities()
  * J. Comp. Chem., 13, 952 (1992).
  *
  */
-void Settle::settlep(longint molID)
+void Settle::settlep()
 {
-    System& system = getSystemRef();
-    const bc::BC& bc = *getSystemRef().bc;  // boundary conditions
-    real dt = integrator->getTimeStep();
-    real invdt = 1.0 / dt;
-
-    // std::cout << "\nsettling " << molID << "\n";
-
-    // positions in previous time step
-    OldPos::const_iterator pos = oldPos.find(molID);
-    if (pos == oldPos.end())
+    size_t n = localMols.size();
+    const real* oOx = oldPos[0].data();
+    const real* oOy = oldPos[1].data();
+    const real* oOz = oldPos[2].data();
+    const real* oH1x = oldPos[3].data();
+    const real* oH1y = oldPos[4].data();
+    const real* oH1z = oldPos[5].data();
+    const real* oH2x = oldPos[6].data();
+    const real* oH2y = oldPos[7].data();
+    const real* oH2z = oldPos[8].data();
+    real* Ox = newPos[0].data();
+    real* Oy = newPos[1].data();
+    real* Oz = newPos[2].data();
+    real* H1x = newPos[3].data();
+    real* H1y = newPos[4].data();
+    real* H1z = newPos[5].data();
+    real* H2x = newPos[6].data();
+    real* H2y = newPos[7].data();
+    real* H2z = newPos[8].data();
+
+    const real mOrmT = this->mOrmT, mHrmT = this->mHrmT;
+    const real ra = this->ra, rb = this->rb, rc = this->rc, rra = this->rra;
+
+    // one molecule per lane, no branches and no particle access in the loop;
+    // the arrays never overlap, GCC needs ivdep to vectorize with 18 pointers
+#pragma vector always
+#pragma GCC ivdep
+    for (size_t i = 0; i < n; i++)
     {
-        std::cout << "WARNING: oldPos not found! Skipping settlep().\n";
-        return;
+        // --- Step1 A1' ---
+        // vectors in the plane of the original positions
+        real b0x = oH1x[i] - oOx[i], b0y = oH1y[i] - oOy[i], b0z = oH1z[i] - oOz[i];
+        real c0x = oH2x[i] - oOx[i], c0y = oH2y[i] - oOy[i], c0z = oH2z[i] - oOz[i];
+
+        // new center of mass
+        real d0x = Ox[i] * mOrmT + (H1x[i] + H2x[i]) * mHrmT;
+        real d0y = Oy[i] * mOrmT + (H1y[i] + H2y[i]) * mHrmT;
+        real d0z = Oz[i] * mOrmT + (H1z[i] + H2z[i]) * mHrmT;
+
+        real a1x = Ox[i] - d0x, a1y = Oy[i] - d0y, a1z = Oz[i] - d0z;
+        real b1x = H1x[i] - d0x, b1y = H1y[i] - d0y, b1z = H1z[i] - d0z;
+        real c1x = H2x[i] - d0x, c1y = H2y[i] - d0y, c1z = H2z[i] - d0z;
+
+        // Vectors describing transformation from original coordinate system to
+        // the 'primed' coordinate system, n0 = b0 x c0, n1 = a1 x n0, n2 = n0 x n1
+        real n0x = b0y * c0z - b0z * c0y;
+        real n0y = b0z * c0x - b0x * c0z;
+        real n0z = b0x * c0y - b0y * c0x;
+        real n1x = a1y * n0z - a1z * n0y;
+        real n1y = a1z * n0x - a1x * n0z;
+        real n1z = a1x * n0y - a1y * n0x;
+        real n2x = n0y * n1z - n0z * n1y;
+        real n2y = n0z * n1x - n0x * n1z;
+        real n2z = n0x * n1y - n0y * n1x;
+
+        // unit vectors
+        real inv = 1.0 / sqrt(n0x * n0x + n0y * n0y + n0z * n0z);
+        n0x *= inv;
+        n0y *= inv;
+        n0z *= inv;
+        inv = 1.0 / sqrt(n1x * n1x + n1y * n1y + n1z * n1z);
+        n1x *= inv;
+        n1y *= inv;
+        n1z *= inv;
+        inv = 1.0 / sqrt(n2x * n2x + n2y * n2y + n2z * n2z);
+        n2x *= inv;
+        n2y *= inv;
+        n2z *= inv;
+
+        // old and new vectors in the primed system, the z components of b0 and c0
+        // are never referenced
+        real B0x = n1x * b0x + n1y * b0y + n1z * b0z;
+        real B0y = n2x * b0x + n2y * b0y + n2z * b0z;
+        real C0x = n1x * c0x + n1y * c0y + n1z * c0z;
+        real C0y = n2x * c0x + n2y * c0y + n2z * c0z;
+
+        real A1Z = n0x * a1x + n0y * a1y + n0z * a1z;
+        real B1x = n1x * b1x + n1y * b1y + n1z * b1z;
+        real B1y = n2x * b1x + n2y * b1y + n2z * b1z;
+        real B1Z = n0x * b1x + n0y * b1y + n0z * b1z;
+        real C1x = n1x * c1x + n1y * c1y + n1z * c1z;
+        real C1y = n2x * c1x + n2y * c1y + n2z * c1z;
+        real C1Z = n0x * c1x + n0y * c1y + n0z * c1z;
+
+        // --- Step2 A2' ---
+        // now we can compute positions of canonical water
+        real sinphi = A1Z * rra;
+        real cosphi = sqrt(1.0 - sinphi * sinphi);
+        real sinpsi = (B1Z - C1Z) / (2.0 * rc * cosphi);
+        real cospsi = sqrt(1.0 - sinpsi * sinpsi);
+
+        real rbphi = -rb * cosphi;
+        real tmp1 = rc * sinpsi * sinphi;
+
+        real a2y = ra * cosphi;
+        real b2x = -rc * cospsi;
+        real b2y = rbphi - tmp1;
+        real c2y = rbphi + tmp1;
+
+        // --- Step3 al, be, ga ---
+        // there are no a0 terms because we've already subtracted the term off
+        // when we first defined b0 and c0.
+        real alpha = b2x * (B0x - C0x) + B0y * b2y + C0y * c2y;
+        real beta = b2x * (C0y - B0y) + B0x * b2y + C0x * c2y;
+        real gama = B0x * B1y - B1x * B0y + C0x * C1y - C1x * C0y;
+
+        real a2b2 = alpha * alpha + beta * beta;
+        real sintheta = (alpha * gama - beta * sqrt(a2b2 - gama * gama)) / a2b2;
+
+        // --- Step4 A3' ---
+        real costheta = sqrt(1.0 - sintheta * sintheta);
+
+        real a3x = -a2y * sintheta;
+        real a3y = a2y * costheta;
+        real b3x = b2x * costheta - b2y * sintheta;
+        real b3y = b2x * sintheta + b2y * costheta;
+        real c3x = -b2x * costheta - c2y * sintheta;
+        real c3y = -b2x * sintheta + c2y * costheta;
+
+        // --- Step5 A3 ---
+        // undo the transformation with the transposed basis (n1, n2, n0)
+        Ox[i] = a3x * n1x + a3y * n2x + A1Z * n0x + d0x;
+        Oy[i] = a3x * n1y + a3y * n2y + A1Z * n0y + d0y;
+        Oz[i] = a3x * n1z + a3y * n2z + A1Z * n0z + d0z;
+        H1x[i] = b3x * n1x + b3y * n2x + B1Z * n0x + d0x;
+        H1y[i] = b3x * n1y + b3y * n2y + B1Z * n0y + d0y;
+        H1z[i] = b3x * n1z + b3y * n2z + B1Z * n0z + d0z;
+        H2x[i] = c3x * n1x + c3y * n2x + C1Z * n0x + d0x;
+        H2y[i] = c3x * n1y + c3y * n2y + C1Z * n0y + d0y;
+        H2z[i] = c3x * n1z + c3y * n2z + C1Z * n0z + d0z;
     }
-
-    // retrieve particles from tuples
-    Particle* vp = system.storage->lookupRealParticle(molID);
-    FixedTupleListAdress::iterator it;
-    it = fixedTupleList->find(&(*vp));
-
-    Particle* O = it->second.at(0);
-    Particle* H1 = it->second.at(1);
-    Particle* H2 = it->second.at(2);
-
-    // --- Step1 A1' ---
-    // vectors in the plane of the original positions
-    // previous positions OHH
-    Real3D b0 = pos->second.second - pos->second.first;  // H1.pos - O.pos
-    Real3D c0 = pos->second.third - pos->second.first;   // H2.pos - O.pos
-
-    // new center of mass
-    // present positions OHH
-    Real3D d0 = O->position() * mOrmT + ((H1->position() + H2->position()) * mHrmT);
-
-    Real3D a1 = O->position() - d0;
-    Real3D b1 = H1->position() - d0;
-    Real3D c1 = H2->position() - d0;
-
-    // Vectors describing transformation from original coordinate system to
-    // the 'primed' coordinate system
-    Real3D n0 = b0.cross(c0);
-    Real3D n1 = a1.cross(n0);
-    Real3D n2 = n0.cross(n1);
-
-    // unit vectors
-    n0 = n0 / n0.abs();
-    n1 = n1 / n1.abs();
-    n2 = n2 / n2.abs();
-
-    b0 = Real3D(n1 * b0, n2 * b0, n0 * b0);  // note: b0.z is never referenced again
-    c0 = Real3D(n1 * c0, n2 * c0, n0 * c0);  // note: c0.z is never referenced again
-
-    // shuffle the order of operations around from the normal algorithm so
-    // that we can double pump sqrt() with n2 and cosphi at the same time
-    // these components are usually computed down in the canonical water block
-    real A1Z = n0 * a1;
-    b1 = Real3D(n1 * b1, n2 * b1, n0 * b1);
-    c1 = Real3D(n1 * c1, n2 * c1, n0 * c1);
-
-    // --- Step2 A2' ---
-    // now we can compute positions of canonical water
-    real sinphi = A1Z * rra;
-    real tmp = 1.0 - sinphi * sinphi;
-    real cosphi = sqrt(tmp);
-    real sinpsi = (b1[2] - c1[2]) / (2.0 * rc * cosphi);
-    tmp = 1.0 - sinpsi * sinpsi;
-    real cospsi = sqrt(tmp);
-
-    real rbphi = -rb * cosphi;
-    real tmp1 = rc * sinpsi * sinphi;
-    real tmp2 = rc * sinpsi * cosphi;
-
-    Real3D a2(0, ra * cosphi, ra * sinphi);
-    Real3D b2(-rc * cospsi, rbphi - tmp1, -rb * sinphi + tmp2);
-    Real3D c2(rc * cosphi, rbphi + tmp1, -rb * sinphi - tmp2);
-
-    // --- Step3 al, be, ga ---
-    // there are no a0 terms because we've already subtracted the term off
-    // when we first defined b0 and c0.
-    real alpha = b2[0] * (b0[0] - c0[0]) + b0[1] * b2[1] + c0[1] * c2[1];
-    real beta = b2[0] * (c0[1] - b0[1]) + b0[0] * b2[1] + c0[0] * c2[1];
-    real gama = b0[0] * b1[1] - b1[0] * b0[1] + c0[0] * c1[1] - c1[0] * c0[1];
-
-    real a2b2 = alpha * alpha + beta * beta;
-    real sintheta = (alpha * gama - beta * sqrt(a2b2 - gama * gama)) / a2b2;
-
-    // --- Step4 A3' ---
-    real costheta = sqrt(1.0 - sintheta * sintheta);
-
-    Real3D a3(-a2[1] * sintheta, a2[1] * costheta, A1Z);
-
-    Real3D b3(b2[0] * costheta - b2[1] * sintheta, b2[0] * sintheta + b2[1] * costheta, b1[2]);
-
-    Real3D c3(-b2[0] * costheta - c2[1] * sintheta, -b2[0] * sintheta + c2[1] * costheta, c1[2]);
-
-    // --- Step5 A3 ---
-    // undo the transformation; generate new normal vectors from the transpose.
-    Real3D m1(n1[0], n2[0], n0[0]);
-    Real3D m2(n1[1], n2[1], n0[1]);
-    Real3D m0(n1[2], n2[2], n0[2]);
-
-    // new positions
-    O->position() = Real3D(a3 * m1, a3 * m2, a3 * m0) + d0;
-    H1->position() = Real3D(b3 * m1, b3 * m2, b3 * m0) + d0;
-    H2->position() = Real3D(c3 * m1, c3 * m2, c3 * m0) + d0;
-
-    // get unconstrained velocities at v(t+dt)
-    Real3D displ1, displ2, displ3;
-    bc.getMinimumImageVectorBox(displ1, O->getPos(),
-                                pos->second.first);  // pos after settle - pos at prev timestep
-    Real3D vO = displ1 * invdt;
-    bc.getMinimumImageVectorBox(displ2, H1->getPos(), pos->second.second);
-    Real3D vH1 = displ2 * invdt;
-    bc.getMinimumImageVectorBox(displ3, H2->getPos(), pos->second.third);
-    Real3D vH2 = displ3 * invdt;
-    O->setV(vO);
-    H1->setV(vH1);
-    H2->setV(vH2);
 }
 
-void Settle::settlev(longint molID)
+void Settle::settlev(size_t i)
 {
     // settlev never called, not necessarily debugged
 
     real dt = integrator->getTimeStep();
 
-    System& system = getSystemRef();
     const bc::BC& bc = *getSystemRef().bc;  // boundary conditions
 
-    // retrieve particles from tuples
-    Particle* vp = system.storage->lookupRealParticle(molID);
-    FixedTupleListAdress::iterator it;
-    it = fixedTupleList->find(&(*vp));
-
-    Particle* O = it->second.at(0);
-    Particle* H1 = it->second.at(1);
-    Particle* H2 = it->second.at(2);
+    Particle* O = localMols[i].O;
+    Particle* H1 = localMols[i].H1;
+    Particle* H2 = localMols[i].H2;
 
     Real3D vO = O->getV();
     Real3D vH1 = H1->getV();
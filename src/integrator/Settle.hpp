@@ -28,7 +28,8 @@
 #include "logging.hpp"
 #include "Extension.hpp"
 //#include "iterator/CellListIterator.hpp"
-#include <boost/unordered_map.hpp>
+#include <set>
+#include <vector>
 #include <boost/signals2.hpp>
 //#include "integrator/VelocityVerlet.hpp"
 //#include "Triple.hpp"
@@ -51,19 +52,30 @@ public:
            real distOH);
     ~Settle();
 
-    void add(longint pid) { molIDs.insert(pid); }  // add molecule id (called from python)
+    void add(longint pid);  // add molecule id (called from python)
     void saveOldPos();
     void applyConstraints();
     void correctVelocities();
-    void settlep(longint molID);
-    void settlev(longint molID);
+    void settlev(size_t i);  // i is the index in localMols
 
     static void registerPython();
 
 private:
-    boost::signals2::connection _befIntP, _aftIntP, _aftIntV, _aftIntSlow;
+    boost::signals2::connection _befIntP, _aftIntP, _aftIntV, _aftIntSlow, _onParticlesChanged;
     std::set<longint> molIDs;  // IDs of water molecules
 
+    // water molecules on this CPU, rebuilt after the particle pointers have changed
+    struct LocalMolecule
+    {
+        Particle* O;
+        Particle* H1;
+        Particle* H2;
+    };
+    std::vector<LocalMolecule> localMols;
+    bool localMolsValid;
+    void updateLocalMolecules();
+    void invalidateLocalMolecules() { localMolsValid = false; }
+
     real mO, mH, distHH, distOH;
     real mOrmT, mHrmT;
     real rc, ra, rb;
@@ -71,10 +83,13 @@ private:
     real mOmH, mOmH2;
     real twicemO, twicemH, mH2;
 
-    // positions in previous timestep
-    // key is molecule ID (first member of fixedtuplelist), value is OHH coordinates
-    typedef boost::unordered_map<longint, Triple<Real3D, Real3D, Real3D> > OldPos;
-    OldPos oldPos;
+    // coordinates of localMols in previous timestep and during settlep, one array per
+    // coordinate so that settlep runs over the molecules in SIMD lanes;
+    // the index of O x, y, z is 0, 1, 2, of H1 3, 4, 5 and of H2 6, 7, 8
+    std::vector<real> oldPos[9];
+    std::vector<real> newPos[9];
+    /** constrain newPos of all local molecules */
+    void settlep();
 
     std::shared_ptr<FixedTupleListAdress> fixedTupleList;
     void connect();
@@ -42,9 +42,11 @@ espressopp.integrator.Settle
 
 .. function:: espressopp.integrator.Settle.addMolecules(moleculelist)
 
-                :param moleculelist:
+                :param moleculelist: pids of the coarse-grained water particles
                 :type moleculelist:
                 :rtype:
+
+                A molecule that has already been added raises an error.
 """
 from espressopp.esutil import cxxinit
 from espressopp import pmi
@@ -0,0 +1,223 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "python.hpp"
+#include "SkinTuner.hpp"
+#include "System.hpp"
+#include "storage/Storage.hpp"
+#include "mpi.hpp"
+
+#include <limits>
+
+namespace espressopp
+{
+namespace integrator
+{
+LOG4ESPP_LOGGER(SkinTuner::theLogger, "SkinTuner");
+
+SkinTuner::SkinTuner(std::shared_ptr<System> system) : Extension(system)
+{
+    interval = 100;
+    minSkin = 0.05;
+    maxSkin = 0.0;
+    tolerance = 0.02;
+    adjustCells = false;
+    pendingSkin = 0.0;
+
+    reset();
+
+    LOG4ESPP_INFO(theLogger, "SkinTuner constructed");
+}
+
+SkinTuner::~SkinTuner()
+{
+    LOG4ESPP_INFO(theLogger, "~SkinTuner");
+    disconnect();
+}
+
+void SkinTuner::disconnect()
+{
+    _runInit.disconnect();
+    _aftIntV.disconnect();
+    _onParticlesChanged.disconnect();
+}
+
+void SkinTuner::connect()
+{
+    _runInit = integrator->runInit.connect(std::bind(&SkinTuner::initialize, this));
+    _aftIntV = integrator->aftIntV.connect(std::bind(&SkinTuner::measure, this));
+    // before the lists rebuild with the skin
+    _onParticlesChanged = getSystemRef().storage->onParticlesChanged.connect(
+        std::bind(&SkinTuner::applySkin, this), boost::signals2::at_front);
+}
+
+void SkinTuner::reset()
+{
+    converged = false;
+    relStep = 0.2;
+    direction = 1;
+    bestSkin = 0.0;
+    bestTime = -1.0;
+    steps = -1;
+}
+
+void SkinTuner::initialize()
+{
+    // the first step of a run includes the initial force calculation
+    steps = -1;
+
+    // a skin that needs a new cell grid is set between two runs, cellAdjust()
+    // then rebuilds the lists
+    System& system = getSystemRef();
+    if (pendingSkin > 0.0 && system.maxCutoff + pendingSkin > system.storage->getMaxCellCutoff())
+    {
+        real skin = pendingSkin;
+        pendingSkin = 0.0;
+        system.setSkin(skin);
+    }
+}
+
+void SkinTuner::applySkin()
+{
+    if (pendingSkin <= 0.0) return;
+
+    System& system = getSystemRef();
+    if (system.maxCutoff + pendingSkin > system.storage->getMaxCellCutoff()) return;
+
+    real skin = pendingSkin;
+    pendingSkin = 0.0;
+    system.setSkin(skin);
+    LOG4ESPP_DEBUG(theLogger, "skin " << skin << " set on resort");
+}
+
+real SkinTuner::getCellSkinLimit()
+{
+    System& system = getSystemRef();
+    real limit = system.storage->getMaxCellCutoff() - system.maxCutoff;
+    // never force the skin below the value the current cells were made for
+    return std::max(limit, system.getSkin());
+}
+
+bool SkinTuner::trySkin(real skin)
+{
+    System& system = getSystemRef();
+    real current = system.getSkin();
+
+    real upper = maxSkin > 0.0 ? maxSkin : std::numeric_limits<real>::max();
+    // the cell grid is tied to the Lees-Edwards cell shifts
+    if (!adjustCells || system.shearRate != 0.0) upper = std::min(upper, getCellSkinLimit());
+
+    skin = std::min(std::max(skin, minSkin), upper);
+    if (std::abs(skin - current) <= 1e-3 * current) return false;
+
+    LOG4ESPP_INFO(theLogger, "skin " << current << " -> " << skin);
+
+    // the lists were built for the current skin and stay valid until the
+    // integrator resorts, the new skin is set right before they are rebuilt
+    pendingSkin = skin;
+    steps = -1;
+
+    return true;
+}
+
+void SkinTuner::finish()
+{
+    System& system = getSystemRef();
+    if (system.getSkin() != bestSkin) trySkin(bestSkin);
+    converged = true;
+
+    LOG4ESPP_INFO(theLogger, "tuned skin = " << bestSkin << " (" << bestTime << " s per step)");
+}
+
+void SkinTuner::measure()
+{
+    // nothing to measure until the trial skin is in use
+    if (converged || pendingSkin > 0.0) return;
+
+    if (steps < 0)
+    {
+        steps = 0;
+        timer.reset();
+        return;
+    }
+    if (++steps < interval) return;
+
+    System& system = getSystemRef();
+    real localTime = timer.getElapsedTime() / steps;
+    real time;
+    boost::mpi::all_reduce(*system.comm, localTime, time, boost::mpi::maximum<real>());
+
+    real skin = system.getSkin();
+    LOG4ESPP_DEBUG(theLogger, "skin " << skin << ": " << time << " s per step");
+
+    if (bestTime < 0.0 || time < bestTime)
+    {
+        bestTime = time;
+        bestSkin = skin;
+    }
+    else
+    {
+        // worse than the best one, search on the other side with a smaller step
+        direction = -direction;
+        relStep *= 0.5;
+    }
+
+    // at a bound turn around once before giving up
+    bool moved = false;
+    for (int attempt = 0; attempt < 2 && !moved && relStep >= tolerance; ++attempt)
+    {
+        moved = trySkin(bestSkin * (1.0 + direction * relStep));
+        if (!moved)
+        {
+            direction = -direction;
+            relStep *= 0.5;
+        }
+    }
+    // the next window starts once the trial skin is in use
+    if (!moved) finish();
+}
+
+/****************************************************
+** REGISTRATION WITH PYTHON
+****************************************************/
+
+void SkinTuner::registerPython()
+{
+    using namespace espressopp::python;
+
+    class_<SkinTuner, std::shared_ptr<SkinTuner>, bases<Extension> >(
+        "integrator_SkinTuner", init<std::shared_ptr<System> >())
+        .add_property("interval", &SkinTuner::getInterval, &SkinTuner::setInterval)
+        .add_property("minSkin", &SkinTuner::getMinSkin, &SkinTuner::setMinSkin)
+        .add_property("maxSkin", &SkinTuner::getMaxSkin, &SkinTuner::setMaxSkin)
+        .add_property("tolerance", &SkinTuner::getTolerance, &SkinTuner::setTolerance)
+        .add_property("adjustCells", &SkinTuner::getAdjustCells, &SkinTuner::setAdjustCells)
+        .add_property("converged", &SkinTuner::getConverged)
+        .add_property("bestTime", &SkinTuner::getBestTime)
+        .add_property("bestSkin", &SkinTuner::getBestSkin)
+        .def("reset", &SkinTuner::reset)
+        .def("connect", &SkinTuner::connect)
+        .def("disconnect", &SkinTuner::disconnect);
+}
+
+}  // namespace integrator
+}  // namespace espressopp
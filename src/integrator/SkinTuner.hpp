@@ -0,0 +1,129 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ESPP_CLASS
+#ifndef _INTEGRATOR_SKINTUNER_HPP
+#define _INTEGRATOR_SKINTUNER_HPP
+
+#include "types.hpp"
+#include "logging.hpp"
+#include "Extension.hpp"
+#include "esutil/Timer.hpp"
+
+#include "boost/signals2.hpp"
+
+namespace espressopp
+{
+namespace integrator
+{
+/** Run-time tuning of the Verlet list skin.
+
+    The wall time per step is measured over windows of `interval` steps,
+    which includes the force loops as well as the Verlet list rebuilds
+    they trigger. After every window the skin is moved by a relative
+    step; if the time per step got worse the previous skin is restored,
+    the direction reversed and the step halved. Tuning stops once the
+    relative step drops below `tolerance`, the chosen skin is then
+    logged.
+
+    A new skin is not set right away, as the current lists were built for
+    the old one. It is set when the storage signals the next resort of the
+    integrator, right before the lists are rebuilt, and the next window
+    starts after that.
+
+    The measured time is the maximum over all ranks, so every rank takes
+    the same decision. Unless adjustCells is set, the skin is limited to
+    the current cell size, i.e. the cell grid is never changed. Otherwise a
+    skin that needs larger cells is set at the start of the next run. Under
+    Lees-Edwards shear the cell grid is never changed.
+*/
+class SkinTuner : public Extension
+{
+public:
+    SkinTuner(std::shared_ptr<System> system);
+    ~SkinTuner();
+
+    void setInterval(int _interval) { interval = _interval; }
+    int getInterval() { return interval; }
+    void setMinSkin(real _minSkin) { minSkin = _minSkin; }
+    real getMinSkin() { return minSkin; }
+    void setMaxSkin(real _maxSkin) { maxSkin = _maxSkin; }
+    real getMaxSkin() { return maxSkin; }
+    void setTolerance(real _tolerance) { tolerance = _tolerance; }
+    real getTolerance() { return tolerance; }
+    void setAdjustCells(bool _adjustCells) { adjustCells = _adjustCells; }
+    bool getAdjustCells() { return adjustCells; }
+
+    /// true once the skin has been fixed
+    bool getConverged() { return converged; }
+    /// time per step measured for the current best skin
+    real getBestTime() { return bestTime; }
+    /// fastest skin so far, the tuned skin once converged
+    real getBestSkin() { return bestSkin; }
+
+    /// start tuning again from the current skin
+    void reset();
+
+    /** Register this class so it can be used from Python. */
+    static void registerPython();
+
+private:
+    boost::signals2::connection _runInit, _aftIntV, _onParticlesChanged;
+
+    int interval;     // steps per measurement window
+    real minSkin;     // lower bound for the skin
+    real maxSkin;     // upper bound for the skin, 0 means no explicit bound
+    real tolerance;   // relative skin step at which tuning stops
+    bool adjustCells;  // allow skins that need a new cell grid
+
+    bool converged;
+    real relStep;   // current relative change of the skin
+    int direction;  // +1 grow, -1 shrink
+    real bestSkin;
+    real bestTime;
+
+    int steps;  // steps in the current window, -1 before the first one
+    esutil::WallTimer timer;
+
+    real pendingSkin;  // skin to set on the next resort, 0 if none
+
+    void initialize();
+    void measure();
+    void applySkin();
+
+    /// choose the next trial skin, returns false if no move is possible
+    bool trySkin(real skin);
+    void finish();
+
+    /// largest skin that fits into the current cells
+    real getCellSkinLimit();
+
+    void connect();
+    void disconnect();
+
+    /* Logger */
+    static LOG4ESPP_DECL_LOGGER(theLogger);
+};
+}  // namespace integrator
+}  // namespace espressopp
+
+#endif
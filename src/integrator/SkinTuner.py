@@ -0,0 +1,111 @@
+#  Copyright (C) 2012,2013
+#      Max Planck Institute for Polymer Research
+#  Copyright (C) 2008,2009,2010,2011
+#      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+r"""
+*******************************
+espressopp.integrator.SkinTuner
+*******************************
+
+Tunes the Verlet list skin (``system.skin``) while the simulation runs.
+
+The wall time per step is measured over windows of *interval* steps. It
+includes the force calculation as well as the Verlet list rebuilds the
+current skin leads to. After every window the skin is changed by a relative
+step (starting at 20%). If the time per step got worse, the best skin so far
+is restored, the search direction reversed and the step halved. Once the
+step is below *tolerance* the skin is kept fixed and logged.
+
+A new skin is set when the integrator resorts the particles next, right
+before the Verlet lists are rebuilt, as the current lists are only valid for
+the skin they were built with.
+
+Example:
+
+    >>> tuner = espressopp.integrator.SkinTuner(system)
+    >>> tuner.interval = 200
+    >>> integrator.addExtension(tuner)
+    >>> integrator.run(20000)
+    >>> print(system.skin, tuner.converged)
+
+Properties:
+
+*   *tuner.interval*
+
+    Number of steps per measurement (default 100).
+
+*   *tuner.minSkin*, *tuner.maxSkin*
+
+    Bounds for the skin. A maxSkin of 0 (default) means no explicit upper bound.
+
+*   *tuner.tolerance*
+
+    Relative skin step at which the tuning stops (default 0.02).
+
+*   *tuner.adjustCells*
+
+    If False (default) the skin is limited such that the current cell grid
+    stays valid. If True, larger skins are allowed; they are set at the start
+    of the next run, where the cell grid is adjusted by ``cellAdjust()``.
+    Ignored under Lees-Edwards shear, where the cell grid is never changed.
+
+*   *tuner.converged* (read only)
+
+    True once the skin has been fixed. ``tuner.reset()`` starts again.
+
+*   *tuner.bestTime* (read only)
+
+    Time per step in seconds measured for the chosen skin.
+
+*   *tuner.bestSkin* (read only)
+
+    Fastest skin so far, the tuned skin once converged.
+
+The integrator has to pick up the skin in every step, which VelocityVerlet,
+VelocityVerletLE and VelocityVerletRESPALE do.
+
+.. function:: espressopp.integrator.SkinTuner(system)
+
+                :param system:
+                :type system:
+"""
+
+
+from espressopp.esutil import cxxinit
+from espressopp import pmi
+
+from espressopp.integrator.Extension import *
+from _espressopp import integrator_SkinTuner
+
+class SkinTunerLocal(ExtensionLocal, integrator_SkinTuner):
+    def __init__(self, system):
+
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or \
+                pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            cxxinit(self, integrator_SkinTuner, system)
+
+if pmi.isController:
+    class SkinTuner(Extension, metaclass=pmi.Proxy):
+        pmiproxydefs = dict(
+          cls =  'espressopp.integrator.SkinTunerLocal',
+          pmiproperty = [ 'interval', 'minSkin', 'maxSkin', 'tolerance', 'adjustCells',
+                          'converged', 'bestTime', 'bestSkin' ],
+          pmicall = [ 'reset' ]
+        )
@@ -166,6 +166,8 @@ void TDforce::applyForce()
                 {
                     if (verletList->getAdrList().size() > 1)
                     {
+                        // only centers whose regions reach this CPU are known here
+                        if (verletList->getAdrPositions().empty()) continue;
                         if ((startdist == 0.0) && (enddist == 0.0))
                         {
                             std::cout
@@ -340,6 +342,8 @@ real TDforce::computeTDEnergy()
                 {
                     if (verletList->getAdrList().size() > 1)
                     {
+                        // only centers whose regions reach this CPU are known here
+                        if (verletList->getAdrPositions().empty()) continue;
                         std::vector<Real3D*>::iterator it2 = verletList->getAdrPositions().begin();
                         Real3D pa = **it2;
                         Real3D dist3D;
@@ -133,6 +133,8 @@ void VelocityVerlet::run(int nsteps)
 
         LOG4ESPP_INFO(theLogger, "maxDist = " << maxDist << ", skin/2 = " << skinHalf);
 
+        // the skin may be changed during a run (SkinTuner)
+        skinHalf = 0.5 * system.getSkin();
         if (maxDist > skinHalf) resortFlag = true;
 
         if (resortFlag)
@@ -150,26 +150,11 @@ namespace espressopp {
 
         LOG4ESPP_INFO(theLogger, "maxDist = " << maxDist << ", skin/2 = " << skinHalf);
         
-        int ctmp=static_cast<int>(floor(shearRate*static_cast<real>(getStep())*getTimeStep()*ngrid*Lz/Lx+0.5));
-        int cshift=static_cast<int>(floor(shearRate*static_cast<real>(getStep()+1)*getTimeStep()*ngrid*Lz/Lx+0.5));
-
-        if (cshift>ctmp) {
-          shift_count++;storage.remapNeighbourCells(shift_count);
-          system.ghostShift=shift_count;
-          resortFlag = true;
-        }else if (cshift<ctmp) {
-          shift_count++;storage.remapNeighbourCells(-shift_count);
-          system.ghostShift=-shift_count;
-          resortFlag = true;
-        }
-        
-        //resortFlag = true;                                                                     
-        if (ctmp>shift_count){                                                                   
-        std::cout<<" ERR> SHIFT: "<<ctmp<<" / "<<shift_count<<" \n";                             
-        throw std::runtime_error("cellShift error: numeric error leading to no cell shifts \n"); 
-        }                                                                                        
+        if (remapCells(ngrid, Lx, Lz)) resortFlag = true;
 
 
+        // the skin may be changed during a run (SkinTuner)
+        skinHalf = 0.5 * system.getSkin();
         if (maxDist > skinHalf) resortFlag = true;
 
         if (resortFlag) {
@@ -221,6 +206,32 @@ namespace espressopp {
       LOG4ESPP_INFO(theLogger, "finished run");
     }
 
+    bool VelocityVerletLE::remapCells(int ngrid, real Lx, real Lz)
+    {
+      storage::Storage& storage = *getSystemRef().storage;
+      System& system = getSystemRef();
+      bool shifted = false;
+
+      int ctmp=static_cast<int>(floor(shearRate*static_cast<real>(getStep())*getTimeStep()*ngrid*Lz/Lx+0.5));
+      int cshift=static_cast<int>(floor(shearRate*static_cast<real>(getStep()+1)*getTimeStep()*ngrid*Lz/Lx+0.5));
+
+      if (cshift>ctmp) {
+        shift_count++;storage.remapNeighbourCells(shift_count);
+        system.ghostShift=shift_count;
+        shifted = true;
+      }else if (cshift<ctmp) {
+        shift_count++;storage.remapNeighbourCells(-shift_count);
+        system.ghostShift=-shift_count;
+        shifted = true;
+      }
+
+      if (ctmp>shift_count){
+        std::cout<<" ERR> SHIFT: "<<ctmp<<" / "<<shift_count<<" \n";
+        throw std::runtime_error("cellShift error: numeric error leading to no cell shifts \n");
+      }
+      return shifted;
+    }
+
     void VelocityVerletLE::resetTimers() {
       timeForce  = 0.0;
       for(int i = 0; i < 100; i++)
@@ -84,6 +84,12 @@ namespace espressopp {
 
         void integrate2_extra();
 
+        /** Shift the neighbour cells across the sheared boundary if the
+            shear offset passes a cell boundary during the coming step.
+            \return true if the cells were remapped and a resort is needed.
+        */
+        bool remapCells(int ngrid, real Lx, real Lz);
+
         void initForces();
 
         void updateForces();
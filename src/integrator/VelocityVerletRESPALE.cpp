@@ -0,0 +1,239 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "python.hpp"
+#include "VelocityVerletRESPALE.hpp"
+#include "iterator/CellListIterator.hpp"
+#include "interaction/Interaction.hpp"
+#include "System.hpp"
+#include "bc/BC.hpp"
+#include "storage/Storage.hpp"
+#include "mpi.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace espressopp {
+
+  using namespace std;
+  namespace integrator {
+    using namespace interaction;
+    using namespace iterator;
+
+    LOG4ESPP_LOGGER(VelocityVerletRESPALE::theLogger, "VelocityVerletRESPALE");
+
+    VelocityVerletRESPALE::VelocityVerletRESPALE(shared_ptr< System > system, real _shearRate)
+     : VelocityVerletLE(system, _shearRate), multistep(1), splitNonbonded(true)
+    {
+      // the stress tensor of VelocityVerletLE assumes all forces at the same time step
+      if (system->ifViscosity)
+        throw std::runtime_error("VelocityVerletRESPALE does not support the shear viscosity (FLAG_VIS)");
+
+      LOG4ESPP_INFO(theLogger, "construct VelocityVerletRESPALE");
+    }
+
+    VelocityVerletRESPALE::~VelocityVerletRESPALE()
+    {
+      LOG4ESPP_INFO(theLogger, "free VelocityVerletRESPALE");
+    }
+
+    void VelocityVerletRESPALE::run(int nsteps)
+    {
+      nResorts = 0;
+      real time;
+      timeIntegrate.reset();
+      resetTimers();
+      System& system = getSystemRef();
+      storage::Storage& storage = *system.storage;
+      real skinHalf = 0.5 * system.getSkin();
+      real Lx = system.bc->getBoxL()[0];
+      real Lz = system.bc->getBoxL()[2];
+      int ngrid=storage.getInt3DCellGrid()[0]*system.NGridSize[0];
+      system.shearRate=getShearRate();
+
+      // signal
+      runInit();
+
+      if (resortFlag) {
+        LOG4ESPP_INFO(theLogger, "resort particles");
+        storage.decompose();
+        maxDist = 0.0;
+        resortFlag = false;
+      }
+
+      if (getenv("LMODE")!=NULL) system.lebcMode=atoi(getenv("LMODE"));
+
+      // slow forces for the first half kick
+      updateForces(true);
+      aftCalcSlow();  // signal
+
+      for (int i = 0; i < nsteps; i++) {
+        LOG4ESPP_INFO(theLogger, "Next step " << i << " of " << nsteps << " starts");
+
+        // half kick with the slow forces
+        integrate2(true);
+        aftIntSlow();  // signal
+
+        // fast forces at the current positions
+        recalc1();  // signal
+        updateForces(false);
+        recalc2();  // signal
+
+        for (int j = 0; j < multistep; j++) {
+          befIntP();  // signal
+
+          time = timeIntegrate.getElapsedTime();
+          maxDist += integrate1();
+          timeInt1 += timeIntegrate.getElapsedTime() - time;
+
+          aftIntP();  // signal
+
+          // shear offset and cell shifts advance with every short step
+          if (remapCells(ngrid, Lx, Lz)) resortFlag = true;
+
+          skinHalf = 0.5 * system.getSkin();
+          if (maxDist > skinHalf) resortFlag = true;
+
+          if (resortFlag) {
+            time = timeIntegrate.getElapsedTime();
+            storage.decompose();
+            maxDist = 0.0;
+            resortFlag = false;
+            nResorts++;
+            timeResort += timeIntegrate.getElapsedTime() - time;
+          }
+
+          updateForces(false);
+          befIntV();  // signal
+
+          time = timeIntegrate.getElapsedTime();
+          integrate2(false);
+          timeInt2 += timeIntegrate.getElapsedTime() - time;
+          aftIntV();  // signal
+        }
+
+        // second half kick with the slow forces at the new positions
+        updateForces(true);
+        aftCalcSlow();  // signal
+
+        integrate2(true);
+        aftIntSlow();  // signal
+      }
+
+      timeRun = timeIntegrate.getElapsedTime();
+      timeLost = timeRun - (timeForceComp[0] + timeForceComp[1] + timeForceComp[2] +
+                 timeComm1 + timeComm2 + timeInt1 + timeInt2 + timeResort);
+
+      LOG4ESPP_INFO(theLogger, "finished run");
+    }
+
+    bool VelocityVerletRESPALE::isSlow(int bondType)
+    {
+      if (bondType == NonbondedSlow) return true;
+      return splitNonbonded && bondType == Nonbonded;
+    }
+
+    void VelocityVerletRESPALE::integrate2(bool slow)
+    {
+      System& system = getSystemRef();
+      CellList realCells = system.storage->getRealCells();
+
+      real half_dt = slow ? 0.5 * dt * multistep : 0.5 * dt;
+
+      for(CellListIterator cit(realCells); !cit.isDone(); ++cit) {
+        real dtfm = half_dt / cit->mass();
+        cit->velocity() += dtfm * cit->force();
+      }
+
+      // the step counts short time steps, the shear offset depends on it
+      if (!slow) step++;
+    }
+
+    void VelocityVerletRESPALE::calcForces(bool slow)
+    {
+      initForces();
+
+      // signal
+      aftInitF();
+
+      System& sys = getSystemRef();
+      const InteractionList& srIL = sys.shortRangeInteractions;
+
+      for (size_t i = 0; i < srIL.size(); i++) {
+        if (isSlow(srIL[i]->bondType()) != slow) continue;
+        real time = timeIntegrate.getElapsedTime();
+        srIL[i]->addForces();
+        timeForceComp[i] += timeIntegrate.getElapsedTime() - time;
+      }
+    }
+
+    void VelocityVerletRESPALE::updateForces(bool slow)
+    {
+      real time;
+      storage::Storage& storage = *getSystemRef().storage;
+
+      time = timeIntegrate.getElapsedTime();
+      storage.updateGhosts();
+      timeComm1 += timeIntegrate.getElapsedTime() - time;
+
+      time = timeIntegrate.getElapsedTime();
+      calcForces(slow);
+      timeForce += timeIntegrate.getElapsedTime() - time;
+
+      time = timeIntegrate.getElapsedTime();
+      storage.collectGhostForces();
+      timeComm2 += timeIntegrate.getElapsedTime() - time;
+
+      if (!slow) {
+        // signal
+        aftCalcF();
+      }
+    }
+
+    void VelocityVerletRESPALE::setmultistep(int _multistep)
+    {
+      if (_multistep <= 0) {
+        throw std::invalid_argument("multistep must be larger than zero!");
+      }
+      multistep = _multistep;
+    }
+
+    /****************************************************
+    ** REGISTRATION WITH PYTHON
+    ****************************************************/
+
+    void VelocityVerletRESPALE::registerPython() {
+
+      using namespace espressopp::python;
+
+      class_<VelocityVerletRESPALE, bases<VelocityVerletLE>, boost::noncopyable >
+        ("integrator_VelocityVerletRESPALE", init< shared_ptr<System>, real >())
+        .def("setmultistep", &VelocityVerletRESPALE::setmultistep)
+        .def("getmultistep", &VelocityVerletRESPALE::getmultistep)
+        .add_property("multistep", &VelocityVerletRESPALE::getmultistep,
+                      &VelocityVerletRESPALE::setmultistep)
+        .add_property("splitNonbonded", &VelocityVerletRESPALE::getSplitNonbonded,
+                      &VelocityVerletRESPALE::setSplitNonbonded)
+        ;
+    }
+  }
+}
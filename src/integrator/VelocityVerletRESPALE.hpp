@@ -0,0 +1,82 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ESPP_CLASS
+#ifndef _INTEGRATOR_VELOCITYVERLETRESPALE_HPP
+#define _INTEGRATOR_VELOCITYVERLETRESPALE_HPP
+
+#include "types.hpp"
+#include "VelocityVerletLE.hpp"
+
+namespace espressopp {
+  namespace integrator {
+
+    /** RESPA multiple time step integrator with Lees-Edwards boundaries.
+
+        Bonded interactions (and everything else that is not a nonbonded
+        interaction) are integrated with the short time step dt, nonbonded
+        interactions with the long time step multistep*dt. With
+        splitNonbonded=false only interactions of type NonbondedSlow go to
+        the outer loop, as in VelocityVerletRESPA.
+
+        The position update, the shear offset and the cell remapping are
+        those of VelocityVerletLE and are done on every inner step, so the
+        step counter counts short time steps.
+    */
+    class VelocityVerletRESPALE : public VelocityVerletLE {
+
+      public:
+
+        VelocityVerletRESPALE(shared_ptr<class espressopp::System> system, real _shearRate);
+
+        virtual ~VelocityVerletRESPALE();
+
+        void run(int nsteps);
+
+        void setmultistep(int _multistep);
+        int getmultistep() { return multistep; }
+
+        void setSplitNonbonded(bool _splitNonbonded) { splitNonbonded = _splitNonbonded; }
+        bool getSplitNonbonded() { return splitNonbonded; }
+
+        /** Register this class so it can be used from Python. */
+        static void registerPython();
+
+      protected:
+        int multistep;
+        bool splitNonbonded;
+
+        /// true if the interaction is evaluated with the long time step
+        bool isSlow(int bondType);
+
+        void integrate2(bool slow);
+
+        void updateForces(bool slow);
+
+        void calcForces(bool slow);
+
+        static LOG4ESPP_DECL_LOGGER(theLogger);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,96 @@
+#  Copyright (C) 2012,2013
+#      Max Planck Institute for Polymer Research
+#  Copyright (C) 2008,2009,2010,2011
+#      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+r"""
+*******************************************
+espressopp.integrator.VelocityVerletRESPALE
+*******************************************
+
+Multiple time step (RESPA) integrator with Lees-Edwards boundary conditions.
+
+Bonded interactions are integrated with the short time step *dt*, nonbonded
+interactions with the long time step *multistep* * *dt*. Positions, the shear
+offset and the Lees-Edwards cell remapping are updated on every short step as
+in VelocityVerletLE, so *integrator.step* counts short time steps.
+
+With *splitNonbonded* = False only interactions of type NonbondedSlow are put
+on the long time step, the same split as in VelocityVerletRESPA.
+
+The shear viscosity output of VelocityVerletLE (FLAG_VIS) is not supported,
+constructing the integrator for such a system raises an error.
+
+Example:
+
+>>> integrator = espressopp.integrator.VelocityVerletRESPALE(system, shear=shear_rate)
+>>> integrator.dt = 0.002
+>>> integrator.multistep = 4
+>>> integrator.run(nsteps)
+
+.. function:: espressopp.integrator.VelocityVerletRESPALE(system, shear)
+
+        :param system: system object
+        :param shear: shear rate (default: 0.0)
+        :type system: std::shared_ptr<System>
+        :type shear: real
+
+.. py:data:: int espressopp.integrator.VelocityVerletRESPALE.multistep
+
+        Multiplier for the long time step, long_timestep = multistep * dt
+
+.. py:data:: bool espressopp.integrator.VelocityVerletRESPALE.splitNonbonded
+
+        Put all nonbonded interactions on the long time step (default: True)
+
+.. py:data:: real espressopp.integrator.VelocityVerletRESPALE.shear
+
+        The shear rate
+"""
+
+from espressopp.esutil import cxxinit
+from espressopp import pmi
+
+from espressopp.integrator.MDIntegrator import *
+from _espressopp import integrator_VelocityVerletRESPALE
+
+class VelocityVerletRESPALELocal(MDIntegratorLocal, integrator_VelocityVerletRESPALE):
+
+    def __init__(self, system, shear=0.0):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            cxxinit(self, integrator_VelocityVerletRESPALE, system, shear)
+
+    def setmultistep(self, multistep):
+        if multistep <= 0:
+            raise ValueError('multistep must be larger than zero. Your input: {}'.format(multistep))
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            self.cxxclass.setmultistep(self, multistep)
+
+    def getmultistep(self):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.getmultistep(self)
+
+if pmi.isController :
+    class VelocityVerletRESPALE(MDIntegrator, metaclass=pmi.Proxy):
+        pmiproxydefs = dict(
+          cls =  'espressopp.integrator.VelocityVerletRESPALELocal',
+          pmiproperty = ['multistep', 'splitNonbonded', 'shear'],
+          pmicall = ['setmultistep', 'getmultistep', 'resetTimers', 'getNumResorts'],
+          pmiinvoke = ['getTimers']
+        )
@@ -0,0 +1,78 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "python.hpp"
+#include "VerletListPruning.hpp"
+#include "System.hpp"
+
+namespace espressopp
+{
+namespace integrator
+{
+LOG4ESPP_LOGGER(VerletListPruning::theLogger, "VerletListPruning");
+
+VerletListPruning::VerletListPruning(std::shared_ptr<System> system,
+                                     std::shared_ptr<VerletList> _verletList)
+    : Extension(system), verletList(_verletList)
+{
+    LOG4ESPP_INFO(theLogger, "VerletListPruning constructed");
+}
+
+VerletListPruning::~VerletListPruning()
+{
+    LOG4ESPP_INFO(theLogger, "~VerletListPruning");
+    disconnect();
+}
+
+void VerletListPruning::disconnect()
+{
+    if (!_aftInitF.connected()) return;
+    _aftInitF.disconnect();
+    verletList->detachPruning();
+}
+
+void VerletListPruning::connect()
+{
+    if (_aftInitF.connected()) return;
+    _aftInitF = integrator->aftInitF.connect(std::bind(&VerletListPruning::checkPrune, this));
+    verletList->attachPruning();
+}
+
+void VerletListPruning::checkPrune() { verletList->checkPrune(); }
+
+/****************************************************
+** REGISTRATION WITH PYTHON
+****************************************************/
+
+void VerletListPruning::registerPython()
+{
+    using namespace espressopp::python;
+
+    class_<VerletListPruning, std::shared_ptr<VerletListPruning>, bases<Extension> >(
+        "integrator_VerletListPruning",
+        init<std::shared_ptr<System>, std::shared_ptr<VerletList> >())
+        .def("connect", &VerletListPruning::connect)
+        .def("disconnect", &VerletListPruning::disconnect);
+}
+
+}  // namespace integrator
+}  // namespace espressopp
@@ -0,0 +1,69 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ESPP_CLASS
+#ifndef _INTEGRATOR_VERLETLISTPRUNING_HPP
+#define _INTEGRATOR_VERLETLISTPRUNING_HPP
+
+#include "types.hpp"
+#include "logging.hpp"
+#include "Extension.hpp"
+#include "VerletList.hpp"
+
+#include "boost/signals2.hpp"
+
+namespace espressopp
+{
+namespace integrator
+{
+/** Dynamic pruning of the inner list of a VerletList with a prune buffer.
+
+    After the ghosts are updated (aftInitF), the inner list is pruned from
+    the outer list if a local particle moved more than pruneBuffer / 2 since
+    the last prune. Each rank decides on its own, no communication is needed.
+    The VerletList only uses its inner list while this extension is connected.
+*/
+class VerletListPruning : public Extension
+{
+public:
+    VerletListPruning(std::shared_ptr<System> system, std::shared_ptr<VerletList> _verletList);
+    ~VerletListPruning();
+
+    /** Register this class so it can be used from Python. */
+    static void registerPython();
+
+private:
+    boost::signals2::connection _aftInitF;
+    std::shared_ptr<VerletList> verletList;
+
+    void checkPrune();
+
+    void connect();
+    void disconnect();
+
+    /* Logger */
+    static LOG4ESPP_DECL_LOGGER(theLogger);
+};
+}  // namespace integrator
+}  // namespace espressopp
+
+#endif
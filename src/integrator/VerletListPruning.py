@@ -0,0 +1,77 @@
+#  Copyright (C) 2012,2013
+#      Max Planck Institute for Polymer Research
+#  Copyright (C) 2008,2009,2010,2011
+#      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+r"""
+***************************************
+espressopp.integrator.VerletListPruning
+***************************************
+
+Keeps the inner list of a Verlet list with a prune buffer up to date.
+
+With ``vl.pruneBuffer`` between 0 and the skin, the Verlet list keeps all
+pairs within *cutoff + skin* as an outer list, which is only rebuilt on a
+resort, and hands the interactions an inner list of the pairs within
+*cutoff + pruneBuffer*. Once the ghosts are updated in a step, this extension
+prunes the inner list from the outer list again if any local particle moved
+more than *pruneBuffer / 2* since the last prune. A larger skin then means
+fewer resorts and cell searches, while the force loops still only see the
+pairs close to the cutoff.
+
+Example:
+
+    >>> system.skin = 0.8
+    >>> vl = espressopp.VerletList(system, cutoff=rc)
+    >>> vl.pruneBuffer = 0.2
+    >>> integrator.addExtension(espressopp.integrator.VerletListPruning(system, vl))
+    >>> integrator.run(10000)
+    >>> print(vl.builds, vl.prunes)
+
+Without this extension connected, the Verlet list does not use an inner list
+and the interactions see all pairs within *cutoff + skin*.
+
+.. function:: espressopp.integrator.VerletListPruning(system, verletlist)
+
+                :param system:
+                :param verletlist:
+                :type system:
+                :type verletlist:
+"""
+
+
+from espressopp.esutil import cxxinit
+from espressopp import pmi
+
+from espressopp.integrator.Extension import *
+from _espressopp import integrator_VerletListPruning
+
+class VerletListPruningLocal(ExtensionLocal, integrator_VerletListPruning):
+    def __init__(self, system, verletlist):
+
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or \
+                pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            cxxinit(self, integrator_VerletListPruning, system, verletlist)
+
+if pmi.isController:
+    class VerletListPruning(Extension, metaclass=pmi.Proxy):
+        pmiproxydefs = dict(
+          cls =  'espressopp.integrator.VerletListPruningLocal'
+        )
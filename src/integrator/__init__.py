@@ -31,6 +31,7 @@ except:
 from espressopp.integrator.VelocityVerletLE import *
 from espressopp.integrator.VelocityVerletOnGroup import *
 from espressopp.integrator.VelocityVerletRESPA import *
+from espressopp.integrator.VelocityVerletRESPALE import *
 from espressopp.integrator.Isokinetic import *
 from espressopp.integrator.StochasticVelocityRescaling import *
 from espressopp.integrator.TDforce import *
@@ -49,6 +50,8 @@ from espressopp.integrator.GeneralizedLangevinThermostat import *
 from espressopp.integrator.LangevinThermostatOnGroup import *
 from espressopp.integrator.LangevinThermostatOnRadius import *
 from espressopp.integrator.DPDThermostat import *
+from espressopp.integrator.SkinTuner import *
+from espressopp.integrator.VerletListPruning import *
 from espressopp.integrator.LangevinBarostat import *
 from espressopp.integrator.FixPositions import *
 from espressopp.integrator.LatticeBoltzmann import *
@@ -27,6 +27,7 @@
 #include "VelocityVerletLE.hpp"
 #include "VelocityVerletOnGroup.hpp"
 #include "VelocityVerletRESPA.hpp"
+#include "VelocityVerletRESPALE.hpp"
 
 #include "Extension.hpp"
 #include "TDforce.hpp"
@@ -62,6 +63,8 @@
 #include "VelocityVerletOnRadius.hpp"
 #include "AssociationReaction.hpp"
 #include "MinimizeEnergy.hpp"
+#include "SkinTuner.hpp"
+#include "VerletListPruning.hpp"
 
 #include "EmptyExtension.hpp"
 
@@ -77,6 +80,7 @@ void registerPython()
     VelocityVerletLE::registerPython();
     VelocityVerletOnGroup::registerPython();
     VelocityVerletRESPA::registerPython();
+    VelocityVerletRESPALE::registerPython();
     Extension::registerPython();
     Adress::registerPython();
     BerendsenBarostat::registerPython();
@@ -95,6 +99,8 @@ void registerPython()
     LangevinThermostatOnGroup::registerPython();
     LangevinThermostatOnRadius::registerPython();
     DPDThermostat::registerPython();
+    SkinTuner::registerPython();
+    VerletListPruning::registerPython();
     FixPositions::registerPython();
     LatticeBoltzmann::registerPython();
     LBInit::registerPython();
@@ -93,7 +93,9 @@ inline void CellListAllPairsInteractionTemplate<_Potential>::addForces()
 {
     LOG4ESPP_INFO(theLogger, "add forces computed for all pairs in the cell lists");
 
-    for (iterator::CellListAllPairsIterator it(storage->getRealCells()); it.isValid(); ++it)
+    for (iterator::CellListAllPairsIterator it(storage->getRealCells(),
+                                               storage->getGhostPairCells());
+         it.isValid(); ++it)
     {
         Particle &p1 = *it->first;
         Particle &p2 = *it->second;
@@ -114,7 +116,9 @@ inline real CellListAllPairsInteractionTemplate<_Potential>::computeEnergy()
     LOG4ESPP_INFO(theLogger, "compute energy by the Verlet List");
 
     real e = 0.0;
-    for (iterator::CellListAllPairsIterator it(storage->getRealCells()); it.isValid(); ++it)
+    for (iterator::CellListAllPairsIterator it(storage->getRealCells(),
+                                               storage->getGhostPairCells());
+         it.isValid(); ++it)
     {
         const Particle &p1 = *it->first;
         const Particle &p2 = *it->second;
@@ -190,7 +194,9 @@ inline real CellListAllPairsInteractionTemplate<_Potential>::computeVirial()
     LOG4ESPP_INFO(theLogger, "computed virial for all pairs in the cell lists");
 
     real w = 0.0;
-    for (iterator::CellListAllPairsIterator it(storage->getRealCells()); it.isValid(); ++it)
+    for (iterator::CellListAllPairsIterator it(storage->getRealCells(),
+                                               storage->getGhostPairCells());
+         it.isValid(); ++it)
     {
         Particle &p1 = *it->first;
         Particle &p2 = *it->second;
@@ -218,7 +224,9 @@ inline void CellListAllPairsInteractionTemplate<_Potential>::computeVirialTensor
     LOG4ESPP_INFO(theLogger, "computed virial tensor for all pairs in the cell lists");
 
     Tensor wlocal(0.0);
-    for (iterator::CellListAllPairsIterator it(storage->getRealCells()); it.isValid(); ++it)
+    for (iterator::CellListAllPairsIterator it(storage->getRealCells(),
+                                               storage->getGhostPairCells());
+         it.isValid(); ++it)
     {
         const Particle &p1 = *it->first;
         const Particle &p2 = *it->second;
@@ -246,7 +254,9 @@ inline void CellListAllPairsInteractionTemplate<_Potential>::computeVirialTensor
 
     Tensor wlocal(0.0);
     const bc::BC &bc = *storage->getSystemRef().bc;  // boundary conditions
-    for (iterator::CellListAllPairsIterator it(storage->getRealCells()); it.isValid(); ++it)
+    for (iterator::CellListAllPairsIterator it(storage->getRealCells(),
+                                               storage->getGhostPairCells());
+         it.isValid(); ++it)
     {
         const Particle &p1 = *it->first;
         const Particle &p2 = *it->second;
@@ -282,7 +292,9 @@ inline void CellListAllPairsInteractionTemplate<_Potential>::computeVirialTensor
     Real3D Li = bc.getBoxL();
     Tensor *wlocal = new Tensor[n];
     for (int i = 0; i < n; i++) wlocal[i] = Tensor(0.0);
-    for (iterator::CellListAllPairsIterator it(storage->getRealCells()); it.isValid(); ++it)
+    for (iterator::CellListAllPairsIterator it(storage->getRealCells(),
+                                               storage->getGhostPairCells());
+         it.isValid(); ++it)
     {
         const Particle &p1 = *it->first;
         const Particle &p2 = *it->second;
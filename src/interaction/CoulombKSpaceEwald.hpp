@@ -66,6 +66,9 @@ namespace interaction
 /** This class provides methods to compute forces and energies of the
  *  CoulombKSpaceEwald part. Currently it works with cubes and rectangular cuboids.
  *  Does not work for triclinic box, slab geometry.
+ *
+ *  The exponents exp(i k r) are not cached per particle. Structure factors and forces are
+ *  accumulated tile by tile, so the memory does not grow with N times the number of k vectors.
  */
 
 // TODO should be optimized (force energy and virial calculate the same stuff)
@@ -104,12 +107,15 @@ private:
     vector<Tensor> virialTensorPref;
     Tensor I;
 
-    // exponent array
-    vector<vector<dcomplex> > eikx;
-    vector<vector<dcomplex> > eiky;
-    vector<vector<dcomplex> > eikz;
-
-    vector<vector<dcomplex> > eik;
+    // The exponents are calculated for tiles of tileSize charged particles at a time and
+    // not stored for the whole system. Real and imaginary parts are kept apart, index
+    // [k * tileSize + j] for particle j of the tile.
+    static const int tileSize = 32;
+    vector<Particle*> tileParticles;
+    vector<real> tileQ;
+    vector<real> eikxRe, eikxIm;  // kx = 0..kmax
+    vector<real> eikyRe, eikyIm;  // ky = -kmax..kmax
+    vector<real> eikzRe, eikzIm;  // kz = -kmax..kmax
 
     real sum_q2;
 
@@ -245,16 +251,19 @@ public:
     }
 
     // here we get the current particle number on the current node
-    // and set the auxiliary arrays eikx, eiky, eikz
+    // and set the auxiliary arrays for one tile of particles
     void getParticleNumber()
     {
         nParticles = system->storage->getNRealParticles();
 
-        eikx = vector<vector<dcomplex> >(kmax + 1, vector<dcomplex>(nParticles, 0));
-        eiky = vector<vector<dcomplex> >(2 * kmax + 1, vector<dcomplex>(nParticles, 0));
-        eikz = vector<vector<dcomplex> >(2 * kmax + 1, vector<dcomplex>(nParticles, 0));
-
-        eik = vector<vector<dcomplex> >(kVectorLength, vector<dcomplex>(nParticles, 0));
+        tileParticles.resize(tileSize);
+        tileQ.resize(tileSize);
+        eikxRe.resize((kmax + 1) * tileSize);
+        eikxIm.resize((kmax + 1) * tileSize);
+        eikyRe.resize((2 * kmax + 1) * tileSize);
+        eikyIm.resize((2 * kmax + 1) * tileSize);
+        eikzRe.resize((2 * kmax + 1) * tileSize);
+        eikzIm.resize((2 * kmax + 1) * tileSize);
     }
 
     // it counts the squared charges over all system. It is used for self energy calculations
@@ -290,89 +299,139 @@ public:
     }
     int getKMax() const { return kmax; }
 
-    // compute force and energy
-    void exponentPrecalculation(CellList realcells)
+    // calls tileFunction(n) for every tile of n charged particles, stored in tileParticles
+    // and tileQ
+    template <class TileFunction>
+    void forEachTile(CellList realcells, TileFunction tileFunction)
     {
-        /* Calculation of k space sums */
-        // -1, 0, 1
-        int j = 0;  // auxiliary variable, particle counter
-        if (ifshear){
-          // calculate ksum for ewald under shear flow
-          for (iterator::CellListIterator it(realcells); !it.isDone(); ++it) {
-            Particle &p = *it;
-            
-            real intc=Lx/cottheta;
-            real zshift=-p.position()[0]/cottheta;
-            int nshift=static_cast<int>(floor((p.position()[2]+zshift)/intc)+1.0);
-            real px=p.position()[0]+(nshift+.0)*Lx;
-            
-            eikx[     0][j] = dcomplex(1.0, 0.0);
-            eiky[kmax+0][j] = dcomplex(1.0, 0.0);
-            eikz[kmax+0][j] = dcomplex(1.0, 0.0);
-  
-            eikx[     1][j] = dcomplex( cos( rclx * (px-cottheta*p.position()[2]) ), sin( rclx * (px-cottheta*p.position()[2]) ));
-            eiky[kmax+1][j] = dcomplex( cos( rcly * p.position()[1] ), sin( rcly * p.position()[1] ) );
-            eikz[kmax+1][j] = dcomplex( cos( rclz * p.position()[2] ), sin( rclz * p.position()[2] ) );
-  
-            eiky[kmax-1][j] = conj( eiky[kmax+1][j] );
-            eikz[kmax-1][j] = conj( eikz[kmax+1][j] );
-           
-            j++;
-          }
-        }else{
-          for (iterator::CellListIterator it(realcells); !it.isDone(); ++it) {
-            Particle &p = *it;
-            
-            eikx[     0][j] = dcomplex(1.0, 0.0);
-            eiky[kmax+0][j] = dcomplex(1.0, 0.0);
-            eikz[kmax+0][j] = dcomplex(1.0, 0.0);
-  
-            eikx[     1][j] = dcomplex( cos( rclx * p.position()[0] ), sin( rclx * p.position()[0] ) );
-            eiky[kmax+1][j] = dcomplex( cos( rcly * p.position()[1] ), sin( rcly * p.position()[1] ) );
-            eikz[kmax+1][j] = dcomplex( cos( rclz * p.position()[2] ), sin( rclz * p.position()[2] ) );
-  
-            eiky[kmax-1][j] = conj( eiky[kmax+1][j] );
-            eikz[kmax-1][j] = conj( eikz[kmax+1][j] );
-           
-            j++;
-          }
+        int n = 0;
+        for (iterator::CellListIterator it(realcells); !it.isDone(); ++it)
+        {
+            Particle& p = *it;
+            if (p.q() == 0) continue;
+            tileParticles[n] = &p;
+            tileQ[n] = p.q();
+            if (++n == tileSize)
+            {
+                tileFunction(n);
+                n = 0;
+            }
         }
+        if (n > 0) tileFunction(n);
+    }
 
-        // calculation of the rest terms
-        for (int k = 2; k <= kmax; k++)
+    // exponents exp(i k r) of the n particles of the current tile
+    void tileExponents(int n)
+    {
+        const int T = tileSize;
+        for (int j = 0; j < n; j++)
         {
-            j = 0;
-            for (iterator::CellListIterator it(realcells); !it.isDone(); ++it)
+            const Real3D& pos = tileParticles[j]->position();
+            real px = pos[0];
+            if (ifshear)
             {
-                eikx[k][j] = eikx[k - 1][j] * eikx[1][j];
+                // fractional x coordinate in the sheared cell
+                real intc = Lx / cottheta;
+                real zshift = -pos[0] / cottheta;
+                int nshift = static_cast<int>(floor((pos[2] + zshift) / intc) + 1.0);
+                px = pos[0] + (nshift + .0) * Lx - cottheta * pos[2];
+            }
 
-                eiky[kmax + k][j] = eiky[kmax + k - 1][j] * eiky[kmax + 1][j];
-                eiky[kmax - k][j] = conj(eiky[kmax + k][j]);
+            eikxRe[j] = 1.0;
+            eikxIm[j] = 0.0;
+            eikyRe[kmax * T + j] = 1.0;
+            eikyIm[kmax * T + j] = 0.0;
+            eikzRe[kmax * T + j] = 1.0;
+            eikzIm[kmax * T + j] = 0.0;
+
+            eikxRe[T + j] = cos(rclx * px);
+            eikxIm[T + j] = sin(rclx * px);
+            eikyRe[(kmax + 1) * T + j] = cos(rcly * pos[1]);
+            eikyIm[(kmax + 1) * T + j] = sin(rcly * pos[1]);
+            eikzRe[(kmax + 1) * T + j] = cos(rclz * pos[2]);
+            eikzIm[(kmax + 1) * T + j] = sin(rclz * pos[2]);
+
+            eikyRe[(kmax - 1) * T + j] = eikyRe[(kmax + 1) * T + j];
+            eikyIm[(kmax - 1) * T + j] = -eikyIm[(kmax + 1) * T + j];
+            eikzRe[(kmax - 1) * T + j] = eikzRe[(kmax + 1) * T + j];
+            eikzIm[(kmax - 1) * T + j] = -eikzIm[(kmax + 1) * T + j];
+        }
 
-                eikz[kmax + k][j] = eikz[kmax + k - 1][j] * eikz[kmax + 1][j];
-                eikz[kmax - k][j] = conj(eikz[kmax + k][j]);
+        // calculation of the rest terms, the inner loops run over the particles of the tile
+        for (int k = 2; k <= kmax; k++)
+        {
+            real* xr = &eikxRe[k * T];
+            real* xi = &eikxIm[k * T];
+            const real* xr1 = &eikxRe[(k - 1) * T];
+            const real* xi1 = &eikxIm[(k - 1) * T];
+            for (int j = 0; j < n; j++)
+            {
+                xr[j] = xr1[j] * eikxRe[T + j] - xi1[j] * eikxIm[T + j];
+                xi[j] = xr1[j] * eikxIm[T + j] + xi1[j] * eikxRe[T + j];
+            }
 
-                j++;
+            vector<real>* re[2] = {&eikyRe, &eikzRe};
+            vector<real>* im[2] = {&eikyIm, &eikzIm};
+            for (int d = 0; d < 2; d++)
+            {
+                real* r = &(*re[d])[(kmax + k) * T];
+                real* i = &(*im[d])[(kmax + k) * T];
+                real* rc = &(*re[d])[(kmax - k) * T];
+                real* ic = &(*im[d])[(kmax - k) * T];
+                const real* r0 = &(*re[d])[(kmax + k - 1) * T];
+                const real* i0 = &(*im[d])[(kmax + k - 1) * T];
+                const real* r1 = &(*re[d])[(kmax + 1) * T];
+                const real* i1 = &(*im[d])[(kmax + 1) * T];
+                for (int j = 0; j < n; j++)
+                {
+                    r[j] = r0[j] * r1[j] - i0[j] * i1[j];
+                    i[j] = r0[j] * i1[j] + i0[j] * r1[j];
+                    rc[j] = r[j];
+                    ic[j] = -i[j];
+                }
             }
         }
+    }
 
-        real q;  // particle charge, auxiliary
-        for (int k = 0; k < kVectorLength; k++)
+    // q exp(i k r) of the n particles of the current tile for k vector k
+    void tileChargeExponents(int k, int n, real* re, real* im) const
+    {
+        const int T = tileSize;
+        const real* xr = &eikxRe[kx_ind[k] * T];
+        const real* xi = &eikxIm[kx_ind[k] * T];
+        const real* yr = &eikyRe[ky_ind[k] * T];
+        const real* yi = &eikyIm[ky_ind[k] * T];
+        const real* zr = &eikzRe[kz_ind[k] * T];
+        const real* zi = &eikzIm[kz_ind[k] * T];
+        for (int j = 0; j < n; j++)
         {
-            sum[k] = dcomplex(0.0, 0.0);
-            totsum[k] = dcomplex(0.0, 0.0);
-            j = 0;
-            for (iterator::CellListIterator it(realcells); !it.isDone(); ++it)
+            real xyr = xr[j] * yr[j] - xi[j] * yi[j];
+            real xyi = xr[j] * yi[j] + xi[j] * yr[j];
+            re[j] = tileQ[j] * (xyr * zr[j] - xyi * zi[j]);
+            im[j] = tileQ[j] * (xyr * zi[j] + xyi * zr[j]);
+        }
+    }
+
+    // compute the structure factors totsum[k], summed over all CPUs
+    void exponentPrecalculation(CellList realcells)
+    {
+        for (int k = 0; k < kVectorLength; k++) sum[k] = dcomplex(0.0, 0.0);
+
+        real re[tileSize], im[tileSize];
+        forEachTile(realcells, [&](int n) {
+            tileExponents(n);
+            for (int k = 0; k < kVectorLength; k++)
             {
-                Particle& p = *it;
-                if ((q = p.q()) != 0)
+                tileChargeExponents(k, n, re, im);
+                real sr = 0.0, si = 0.0;
+                for (int j = 0; j < n; j++)
                 {
-                    eik[k][j] = q * (eikx[kx_ind[k]][j] * eiky[ky_ind[k]][j] * eikz[kz_ind[k]][j]);
-                    sum[k] += eik[k][j];
+                    sr += re[j];
+                    si += im[j];
                 }
-                j++;
+                sum[k] += dcomplex(sr, si);
             }
-        }
+        });
 
         mpi::all_reduce(*system->comm, sum, kVectorLength, totsum, plus<dcomplex>());
     }
@@ -422,46 +481,44 @@ public:
         // exponent array
         exponentPrecalculation(realcells);
 
-        real fact;  // factor due to the symmetry
+        // complex factor per k vector, factor 2 due to the symmetry
+        vector<dcomplex> tff(kVectorLength);
         for (int k = 0; k < kVectorLength; k++)
         {
-            if (kxfield[k] == 0)
-                fact = 1.0;
-            else
-                fact = 2.0;
+            real fact = (kxfield[k] == 0) ? 1.0 : 2.0;
+            tff[k] = fact * kvector[k] * totsum[k];
+        }
 
-            dcomplex tff = fact * kvector[k] * totsum[k];  // auxiliary complex factor
-            int j = 0;
-          if (ifshear)
-            for (iterator::CellListIterator it(realcells); !it.isDone(); ++it) {
-              Particle& p = *it;
-              
-              real tf = 0.0;
-              if( p.q()!=0 ){
-                tf= imag( tff  *  conj( eik[k][j] ) );
-              
-                p.force()[0] += force_prefac[0] * tf * kxfield[k];
-                p.force()[1] += force_prefac[1] * tf * kyfield[k];
-                p.force()[2] += force_prefac[2] * tf * kzfield[k] - force_prefac[0]*cottheta * tf * kxfield[k];
-              }
-              j++;
-            }
-          else
-            for (iterator::CellListIterator it(realcells); !it.isDone(); ++it) {
-              Particle& p = *it;
-              
-              real tf = 0.0;
-              if( p.q()!=0 ){
-                tf= imag( tff  *  conj( eik[k][j] ) );
-
-                    p.force()[0] += force_prefac[0] * tf * kxfield[k];
-                    p.force()[1] += force_prefac[1] * tf * kyfield[k];
-                    p.force()[2] += force_prefac[2] * tf * kzfield[k];
+        real re[tileSize], im[tileSize];
+        real tx[tileSize], ty[tileSize], tz[tileSize];
+        forEachTile(realcells, [&](int n) {
+            tileExponents(n);
+            for (int j = 0; j < n; j++) tx[j] = ty[j] = tz[j] = 0.0;
+
+            for (int k = 0; k < kVectorLength; k++)
+            {
+                tileChargeExponents(k, n, re, im);
+                real tr = std::real(tff[k]), ti = std::imag(tff[k]);
+                real kx = kxfield[k], ky = kyfield[k], kz = kzfield[k];
+                for (int j = 0; j < n; j++)
+                {
+                    // imag(tff * conj(q exp(i k r)))
+                    real tf = ti * re[j] - tr * im[j];
+                    tx[j] += tf * kx;
+                    ty[j] += tf * ky;
+                    tz[j] += tf * kz;
                 }
-                j++;
             }
-          
-        }
+
+            for (int j = 0; j < n; j++)
+            {
+                Real3D& f = tileParticles[j]->force();
+                f[0] += force_prefac[0] * tx[j];
+                f[1] += force_prefac[1] * ty[j];
+                f[2] += force_prefac[2] * tz[j];
+                if (ifshear) f[2] -= force_prefac[0] * cottheta * tx[j];
+            }
+        });
 
         return true;
     }
@@ -38,6 +38,10 @@ This is the `K` space part of potential of Coulomb long range interaction accord
 summation technique. Good explanation of Ewald summation could be found here [Allen89]_,
 [Deserno98]_.
 
+The cost grows with the number of particles times the number of k-vectors. For
+larger systems, also under Lees-Edwards shear, CoulombKSpaceSPME
+(espressopp.interaction.CoulombKSpaceSPME.html) scales as :math:`N \log N`.
+
 Example:
 
     >>> ewaldK_pot = espressopp.interaction.CoulombKSpaceEwald(system, coulomb_prefactor, alpha, kspacecutoff)
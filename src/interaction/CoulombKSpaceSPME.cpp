@@ -0,0 +1,631 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "python.hpp"
+#include "CoulombKSpaceSPME.hpp"
+#include "CellListAllParticlesInteractionTemplate.hpp"
+#include "iterator/CellListIterator.hpp"
+#include "esutil/Error.hpp"
+#include "bc/BC.hpp"
+#include "System.hpp"
+#include "mpi.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace espressopp
+{
+namespace interaction
+{
+namespace
+{
+const int maxOrder = 12;
+const int transposeTag = 0x5be;
+
+// split n planes as evenly as possible over size CPUs
+void splitSlabs(int n, int size, std::vector<int>& start, std::vector<int>& count)
+{
+    start.resize(size);
+    count.resize(size);
+    for (int r = 0; r < size; r++)
+    {
+        count[r] = n / size + (r < n % size ? 1 : 0);
+        start[r] = r * (n / size) + std::min(r, n % size);
+    }
+}
+}  // namespace
+
+typedef class CellListAllParticlesInteractionTemplate<CoulombKSpaceSPME> CellListCoulombKSpaceSPME;
+
+CoulombKSpaceSPME::CoulombKSpaceSPME(std::shared_ptr<System> _system,
+                                     real _prefactor,
+                                     real _alpha,
+                                     Int3D _M,
+                                     int _P)
+    : system(_system),
+      prefactor(_prefactor),
+      alpha(_alpha),
+      M(_M),
+      P(_P),
+      offset(0.0),
+      boxChanged(true)
+{
+    if (P < 2 || P > maxOrder)
+    {
+        std::stringstream msg;
+        msg << "CoulombKSpaceSPME: order P must be between 2 and " << maxOrder;
+        throw std::runtime_error(msg.str());
+    }
+    for (int d = 0; d < 3; d++)
+    {
+        if (M[d] < P)
+        {
+            throw std::runtime_error("CoulombKSpaceSPME: mesh must have at least P points");
+        }
+    }
+
+    meshSize = M[0] * M[1] * M[2];
+    nkz = M[2] / 2 + 1;
+
+    rank = system->comm->rank();
+    splitSlabs(M[0], system->comm->size(), xStart, xCount);
+    splitSlabs(M[1], system->comm->size(), yStart, yCount);
+    int nx = xCount[rank];
+    int ny = yCount[rank];
+    pencilSize = ny * nkz * M[0];
+
+    // CPUs without planes or rows keep a dummy buffer and no plans
+    slabReal = (real*)fftw_malloc(std::max(nx * M[1] * M[2], 1) * sizeof(real));
+    slabK = (fftw_complex*)fftw_malloc(std::max(nx * M[1] * nkz, 1) * sizeof(fftw_complex));
+    pencilK = (fftw_complex*)fftw_malloc(std::max(pencilSize, 1) * sizeof(fftw_complex));
+    planForwardYZ = planBackwardYZ = planForwardX = planBackwardX = nullptr;
+    if (nx > 0)
+    {
+        int nyz[2] = {M[1], M[2]};
+        planForwardYZ = fftw_plan_many_dft_r2c(2, nyz, nx, slabReal, nullptr, 1, M[1] * M[2],
+                                               slabK, nullptr, 1, M[1] * nkz, FFTW_ESTIMATE);
+        planBackwardYZ = fftw_plan_many_dft_c2r(2, nyz, nx, slabK, nullptr, 1, M[1] * nkz,
+                                                slabReal, nullptr, 1, M[1] * M[2], FFTW_ESTIMATE);
+    }
+    if (ny > 0)
+    {
+        planForwardX = fftw_plan_many_dft(1, &M[0], ny * nkz, pencilK, nullptr, 1, M[0], pencilK,
+                                          nullptr, 1, M[0], FFTW_FORWARD, FFTW_ESTIMATE);
+        planBackwardX = fftw_plan_many_dft(1, &M[0], ny * nkz, pencilK, nullptr, 1, M[0], pencilK,
+                                           nullptr, 1, M[0], FFTW_BACKWARD, FFTW_ESTIMATE);
+    }
+
+    calcBSplineModuli();
+
+    connectionBoxChanged =
+        system->bc->onBoxDimensionsChanged.connect([this]() { boxChanged = true; });
+}
+
+CoulombKSpaceSPME::~CoulombKSpaceSPME()
+{
+    connectionBoxChanged.disconnect();
+    if (planForwardYZ)
+    {
+        fftw_destroy_plan(planForwardYZ);
+        fftw_destroy_plan(planBackwardYZ);
+    }
+    if (planForwardX)
+    {
+        fftw_destroy_plan(planForwardX);
+        fftw_destroy_plan(planBackwardX);
+    }
+    fftw_free(slabReal);
+    fftw_free(slabK);
+    fftw_free(pencilK);
+}
+
+void CoulombKSpaceSPME::bspline(real w, real* theta, real* dtheta) const
+{
+    // theta[j] = M_n(w + n - 1 - j) is the weight of mesh point floor(u) - n + 1 + j,
+    // raised from order 1 with M_n(x) = (x M_n-1(x) + (n - x) M_n-1(x - 1)) / (n - 1)
+    theta[0] = 1.0;
+    for (int n = 2; n <= P; n++)
+    {
+        if (n == P)
+        {
+            // derivative from order P - 1: M_P'(x) = M_P-1(x) - M_P-1(x - 1)
+            dtheta[0] = -theta[0];
+            for (int j = 1; j < P - 1; j++) dtheta[j] = theta[j - 1] - theta[j];
+            dtheta[P - 1] = theta[P - 2];
+        }
+
+        real div = 1.0 / (n - 1);
+        theta[n - 1] = div * w * theta[n - 2];
+        for (int j = n - 2; j >= 1; j--)
+        {
+            theta[j] = div * ((w + n - 1 - j) * theta[j - 1] + (1.0 - w + j) * theta[j]);
+        }
+        theta[0] = div * (1.0 - w) * theta[0];
+    }
+}
+
+void CoulombKSpaceSPME::calcBSplineModuli()
+{
+    // M_P(k + 1) at the integers
+    real theta[maxOrder], dtheta[maxOrder];
+    bspline(0.0, theta, dtheta);
+
+    for (int d = 0; d < 3; d++)
+    {
+        std::vector<real> denom(M[d]);
+        for (int m = 0; m < M[d]; m++)
+        {
+            real re = 0.0, im = 0.0;
+            for (int k = 0; k < P - 1; k++)
+            {
+                real arg = 2.0 * M_PI * m * k / M[d];
+                re += theta[P - 2 - k] * cos(arg);
+                im += theta[P - 2 - k] * sin(arg);
+            }
+            denom[m] = re * re + im * im;
+        }
+
+        // odd orders vanish at the Nyquist frequency, take the neighbours instead
+        for (int m = 0; m < M[d]; m++)
+        {
+            if (denom[m] < 1e-7)
+            {
+                denom[m] = 0.5 * (denom[(m + M[d] - 1) % M[d]] + denom[(m + 1) % M[d]]);
+            }
+        }
+
+        bsplineModuli[d].resize(M[d]);
+        for (int m = 0; m < M[d]; m++) bsplineModuli[d][m] = 1.0 / denom[m];
+    }
+}
+
+void CoulombKSpaceSPME::checkBox()
+{
+    // any image of the sheared cell gives the same lattice, take the least deformed one
+    real Lx = system->bc->getBoxL()[0];
+    real offs = system->shearOffset;
+    offs -= Lx * floor(offs / Lx + 0.5);
+
+    if (boxChanged || offs != offset)
+    {
+        L = system->bc->getBoxL();
+        offset = offs;
+        calcInfluenceFunction();
+        boxChanged = false;
+    }
+}
+
+Real3D CoulombKSpaceSPME::reciprocalVector(int i, int j, int k) const
+{
+    int mi = (2 * i <= M[0]) ? i : i - M[0];
+    int mj = (2 * j <= M[1]) ? j : j - M[1];
+    return real(mi) * b[0] + real(mj) * b[1] + real(k) * b[2];
+}
+
+void CoulombKSpaceSPME::calcInfluenceFunction()
+{
+    // cell (Lx,0,0), (0,Ly,0), (offset,0,Lz) and its reciprocal basis
+    volume = L[0] * L[1] * L[2];
+    b[0] = Real3D(1.0 / L[0], 0.0, -offset / (L[0] * L[2]));
+    b[1] = Real3D(0.0, 1.0 / L[1], 0.0);
+    b[2] = Real3D(0.0, 0.0, 1.0 / L[2]);
+
+    real fac = M_PI * M_PI / (alpha * alpha);
+    real pref = prefactor / (2.0 * M_PI * volume);
+
+    influence.resize(pencilSize);
+    for (int jl = 0; jl < yCount[rank]; jl++)
+    {
+        int j = yStart[rank] + jl;
+        for (int k = 0; k < nkz; k++)
+        {
+            for (int i = 0; i < M[0]; i++)
+            {
+                int indx = (jl * nkz + k) * M[0] + i;
+                if (i == 0 && j == 0 && k == 0)
+                {
+                    influence[indx] = 0.0;
+                    continue;
+                }
+                real m2 = reciprocalVector(i, j, k).sqr();
+                influence[indx] = pref * exp(-fac * m2) / m2 * bsplineModuli[0][i] *
+                                  bsplineModuli[1][j] * bsplineModuli[2][k];
+            }
+        }
+    }
+
+    LOG4ESPP_INFO(theLogger, "influence function for box " << L << " and shear offset " << offset);
+}
+
+Real3D CoulombKSpaceSPME::meshPosition(const Real3D& pos) const
+{
+    Real3D s;
+    s[2] = pos[2] / L[2];
+    s[1] = pos[1] / L[1];
+    s[0] = (pos[0] - offset * s[2]) / L[0];
+
+    Real3D u;
+    for (int d = 0; d < 3; d++)
+    {
+        u[d] = (s[d] - floor(s[d])) * M[d];
+        if (u[d] >= M[d]) u[d] -= M[d];
+    }
+    return u;
+}
+
+void CoulombKSpaceSPME::calcStructureFactor(CellList realcells)
+{
+    checkBox();
+
+    real theta[3][maxOrder], dtheta[3][maxOrder];
+    int base[3];
+
+    localMesh.assign(meshSize + 2, 0.0);
+    for (iterator::CellListIterator it(realcells); !it.isDone(); ++it)
+    {
+        Particle& p = *it;
+        real q = p.q();
+        if (q == 0.0) continue;
+
+        Real3D u = meshPosition(p.position());
+        for (int d = 0; d < 3; d++)
+        {
+            int iu = static_cast<int>(u[d]);
+            bspline(u[d] - iu, theta[d], dtheta[d]);
+            base[d] = iu - P + 1 + M[d];
+        }
+
+        for (int a = 0; a < P; a++)
+        {
+            int ia = (base[0] + a) % M[0];
+            for (int b1 = 0; b1 < P; b1++)
+            {
+                int ib = (base[1] + b1) % M[1];
+                real qab = q * theta[0][a] * theta[1][b1];
+                real* row = &localMesh[(ia * M[1] + ib) * M[2]];
+                for (int c = 0; c < P; c++) row[(base[2] + c) % M[2]] += qab * theta[2][c];
+            }
+        }
+
+        localMesh[meshSize] += q;
+        localMesh[meshSize + 1] += q * q;
+    }
+
+    // sum up the planes on the CPUs owning them
+    mpi::communicator& comm = *system->comm;
+    int planeSize = M[1] * M[2];
+    for (int r = 0; r < comm.size(); r++)
+    {
+        if (xCount[r] == 0) continue;
+        real* slab = &localMesh[xStart[r] * planeSize];
+        if (r == rank)
+            mpi::reduce(comm, slab, xCount[r] * planeSize, slabReal, std::plus<real>(), r);
+        else
+            mpi::reduce(comm, slab, xCount[r] * planeSize, std::plus<real>(), r);
+    }
+    real sums[2];
+    mpi::all_reduce(comm, &localMesh[meshSize], 2, sums, std::plus<real>());
+    sumQ = sums[0];
+    sumQ2 = sums[1];
+
+    if (planForwardYZ) fftw_execute(planForwardYZ);
+    transpose(true);
+    if (planForwardX) fftw_execute(planForwardX);
+}
+
+void CoulombKSpaceSPME::transpose(bool toPencils)
+{
+    mpi::communicator& comm = *system->comm;
+    int size = comm.size();
+    int nx = xCount[rank];
+    int ny = yCount[rank];
+
+    // blocks of (x plane, y row, kz) between every pair of CPUs, 2 reals per value
+    std::vector<std::vector<real> > slabBuf(size), pencilBuf(size);
+    for (int r = 0; r < size; r++)
+    {
+        slabBuf[r].resize(2 * nx * yCount[r] * nkz);
+        pencilBuf[r].resize(2 * xCount[r] * ny * nkz);
+    }
+
+    if (toPencils)
+    {
+        for (int r = 0; r < size; r++)
+        {
+            real* buf = slabBuf[r].data();
+            for (int il = 0; il < nx; il++)
+            {
+                for (int jl = 0; jl < yCount[r]; jl++)
+                {
+                    const fftw_complex* row = &slabK[(il * M[1] + yStart[r] + jl) * nkz];
+                    for (int k = 0; k < nkz; k++)
+                    {
+                        *buf++ = row[k][0];
+                        *buf++ = row[k][1];
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        for (int r = 0; r < size; r++)
+        {
+            real* buf = pencilBuf[r].data();
+            for (int il = 0; il < xCount[r]; il++)
+            {
+                for (int jl = 0; jl < ny; jl++)
+                {
+                    for (int k = 0; k < nkz; k++)
+                    {
+                        const fftw_complex& v = pencilK[(jl * nkz + k) * M[0] + xStart[r] + il];
+                        *buf++ = v[0];
+                        *buf++ = v[1];
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<real> >& sendBuf = toPencils ? slabBuf : pencilBuf;
+    std::vector<std::vector<real> >& recvBuf = toPencils ? pencilBuf : slabBuf;
+    std::vector<mpi::request> reqs;
+    for (int r = 0; r < size; r++)
+    {
+        if (!recvBuf[r].empty())
+            reqs.push_back(comm.irecv(r, transposeTag, recvBuf[r].data(), recvBuf[r].size()));
+        if (!sendBuf[r].empty())
+            reqs.push_back(comm.isend(r, transposeTag, sendBuf[r].data(), sendBuf[r].size()));
+    }
+    mpi::wait_all(reqs.begin(), reqs.end());
+
+    if (toPencils)
+    {
+        for (int r = 0; r < size; r++)
+        {
+            const real* buf = pencilBuf[r].data();
+            for (int il = 0; il < xCount[r]; il++)
+            {
+                for (int jl = 0; jl < ny; jl++)
+                {
+                    for (int k = 0; k < nkz; k++)
+                    {
+                        fftw_complex& v = pencilK[(jl * nkz + k) * M[0] + xStart[r] + il];
+                        v[0] = *buf++;
+                        v[1] = *buf++;
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        for (int r = 0; r < size; r++)
+        {
+            const real* buf = slabBuf[r].data();
+            for (int il = 0; il < nx; il++)
+            {
+                for (int jl = 0; jl < yCount[r]; jl++)
+                {
+                    fftw_complex* row = &slabK[(il * M[1] + yStart[r] + jl) * nkz];
+                    for (int k = 0; k < nkz; k++)
+                    {
+                        row[k][0] = *buf++;
+                        row[k][1] = *buf++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+real CoulombKSpaceSPME::_computeEnergy(CellList realcells)
+{
+    calcStructureFactor(realcells);
+
+    real localEnergy = 0.0;
+    for (int indx = 0; indx < pencilSize; indx++)
+    {
+        real s2 = pencilK[indx][0] * pencilK[indx][0] + pencilK[indx][1] * pencilK[indx][1];
+        localEnergy += halfSpectrumWeight((indx / M[0]) % nkz) * influence[indx] * s2;
+    }
+    real energy;
+    mpi::all_reduce(*system->comm, localEnergy, energy, std::plus<real>());
+
+    // self energy and net charge correction
+    energy -= prefactor * (sumQ2 * alpha / sqrt(M_PI) +
+                           sumQ * sumQ * M_PI / (2.0 * volume * alpha * alpha));
+
+    return energy;
+}
+
+bool CoulombKSpaceSPME::_computeForce(CellList realcells)
+{
+    calcStructureFactor(realcells);
+
+    // potential on the mesh, E = 1/2 sum Q psi
+    for (int indx = 0; indx < pencilSize; indx++)
+    {
+        pencilK[indx][0] *= 2.0 * influence[indx];
+        pencilK[indx][1] *= 2.0 * influence[indx];
+    }
+    if (planBackwardX) fftw_execute(planBackwardX);
+    transpose(false);
+    if (planBackwardYZ) fftw_execute(planBackwardYZ);
+
+    // every CPU interpolates its particles from the full mesh
+    mpi::communicator& comm = *system->comm;
+    int planeSize = M[1] * M[2];
+    mesh.resize(meshSize);
+    if (xCount[rank] > 0)
+    {
+        std::copy(slabReal, slabReal + xCount[rank] * planeSize, &mesh[xStart[rank] * planeSize]);
+    }
+    for (int r = 0; r < comm.size(); r++)
+    {
+        if (xCount[r] > 0) mpi::broadcast(comm, &mesh[xStart[r] * planeSize], xCount[r] * planeSize, r);
+    }
+
+    real theta[3][maxOrder], dtheta[3][maxOrder];
+    int base[3];
+    Real3D grad[3];
+    for (int d = 0; d < 3; d++) grad[d] = real(M[d]) * b[d];
+
+    for (iterator::CellListIterator it(realcells); !it.isDone(); ++it)
+    {
+        Particle& p = *it;
+        real q = p.q();
+        if (q == 0.0) continue;
+
+        Real3D u = meshPosition(p.position());
+        for (int d = 0; d < 3; d++)
+        {
+            int iu = static_cast<int>(u[d]);
+            bspline(u[d] - iu, theta[d], dtheta[d]);
+            base[d] = iu - P + 1 + M[d];
+        }
+
+        // derivative of the energy with respect to the mesh coordinates
+        real du0 = 0.0, du1 = 0.0, du2 = 0.0;
+        for (int a = 0; a < P; a++)
+        {
+            int ia = (base[0] + a) % M[0];
+            for (int b1 = 0; b1 < P; b1++)
+            {
+                int ib = (base[1] + b1) % M[1];
+                const real* row = &mesh[(ia * M[1] + ib) * M[2]];
+                real sum = 0.0, dsum = 0.0;
+                for (int c = 0; c < P; c++)
+                {
+                    real psi = row[(base[2] + c) % M[2]];
+                    sum += theta[2][c] * psi;
+                    dsum += dtheta[2][c] * psi;
+                }
+                du0 += dtheta[0][a] * theta[1][b1] * sum;
+                du1 += theta[0][a] * dtheta[1][b1] * sum;
+                du2 += theta[0][a] * theta[1][b1] * dsum;
+            }
+        }
+
+        p.force() -= q * (du0 * grad[0] + du1 * grad[1] + du2 * grad[2]);
+    }
+
+    return true;
+}
+
+real CoulombKSpaceSPME::_computeVirial(CellList realcells)
+{
+    calcStructureFactor(realcells);
+
+    real fac = 2.0 * M_PI * M_PI / (alpha * alpha);
+    real localVirial = 0.0;
+    for (int jl = 0; jl < yCount[rank]; jl++)
+    {
+        for (int k = 0; k < nkz; k++)
+        {
+            for (int i = 0; i < M[0]; i++)
+            {
+                int indx = (jl * nkz + k) * M[0] + i;
+                if (influence[indx] == 0.0) continue;
+                real s2 = pencilK[indx][0] * pencilK[indx][0] + pencilK[indx][1] * pencilK[indx][1];
+                real m2 = reciprocalVector(i, yStart[rank] + jl, k).sqr();
+                localVirial += halfSpectrumWeight(k) * influence[indx] * s2 * (1.0 - fac * m2);
+            }
+        }
+    }
+    real virial;
+    mpi::all_reduce(*system->comm, localVirial, virial, std::plus<real>());
+    return virial;
+}
+
+Tensor CoulombKSpaceSPME::_computeVirialTensor(CellList realcells)
+{
+    calcStructureFactor(realcells);
+
+    real fac = M_PI * M_PI / (alpha * alpha);
+    Tensor I(1.0, 1.0, 1.0, 0.0, 0.0, 0.0);
+    Tensor localTensor(0.0);
+    for (int jl = 0; jl < yCount[rank]; jl++)
+    {
+        for (int k = 0; k < nkz; k++)
+        {
+            for (int i = 0; i < M[0]; i++)
+            {
+                int indx = (jl * nkz + k) * M[0] + i;
+                if (influence[indx] == 0.0) continue;
+                real s2 = pencilK[indx][0] * pencilK[indx][0] + pencilK[indx][1] * pencilK[indx][1];
+                Real3D m = reciprocalVector(i, yStart[rank] + jl, k);
+                real m2 = m.sqr();
+                localTensor += halfSpectrumWeight(k) * influence[indx] * s2 *
+                               (I - 2.0 * (1.0 + fac * m2) / m2 * Tensor(m, m));
+            }
+        }
+    }
+    Tensor virialTensor(0.0);
+    mpi::all_reduce(*system->comm, localTensor.get(), 6, virialTensor.get(), std::plus<real>());
+    return virialTensor;
+}
+
+real CoulombKSpaceSPME::_computeEnergySqrRaw(real distSqr) const
+{
+    esutil::Error err(system->comm);
+    std::stringstream msg;
+    msg << "There is no sense to call this function for SPME";
+    err.setException(msg.str());
+    return 0.0;
+}
+
+bool CoulombKSpaceSPME::_computeForceRaw(Real3D& force, const Real3D& dist, real distSqr) const
+{
+    esutil::Error err(system->comm);
+    std::stringstream msg;
+    msg << "There is no sense to call this function for SPME";
+    err.setException(msg.str());
+    return false;
+}
+
+//////////////////////////////////////////////////
+// REGISTRATION WITH PYTHON
+//////////////////////////////////////////////////
+void CoulombKSpaceSPME::registerPython()
+{
+    using namespace espressopp::python;
+
+    class_<CoulombKSpaceSPME, bases<Potential>, boost::noncopyable>(
+        "interaction_CoulombKSpaceSPME",
+        init<std::shared_ptr<System>, real, real, Int3D, int>())
+        .add_property("prefactor", &CoulombKSpaceSPME::getPrefactor,
+                      &CoulombKSpaceSPME::setPrefactor)
+        .add_property("alpha", &CoulombKSpaceSPME::getAlpha, &CoulombKSpaceSPME::setAlpha)
+        .add_property("mesh", &CoulombKSpaceSPME::getMesh)
+        .add_property("P", &CoulombKSpaceSPME::getP);
+
+    class_<CellListCoulombKSpaceSPME, bases<Interaction> >(
+        "interaction_CellListCoulombKSpaceSPME",
+        init<std::shared_ptr<storage::Storage>, std::shared_ptr<CoulombKSpaceSPME> >())
+        .def("getPotential", &CellListCoulombKSpaceSPME::getPotential);
+}
+
+}  // namespace interaction
+}  // namespace espressopp
@@ -0,0 +1,159 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ESPP_CLASS
+#ifndef _INTERACTION_COULOMBKSPACESPME_HPP
+#define _INTERACTION_COULOMBKSPACESPME_HPP
+
+#include <vector>
+#include <boost/signals2.hpp>
+#include <fftw3.h>
+
+#include "types.hpp"
+#include "Potential.hpp"
+#include "Tensor.hpp"
+#include "Int3D.hpp"
+
+namespace espressopp
+{
+namespace interaction
+{
+/** This class provides methods to compute forces and energies of the
+    K space part of the Coulomb interaction with the smooth particle mesh
+    Ewald method (U. Essmann et al., J. Chem. Phys. 103, 8577 (1995)).
+
+    The charges are spread with cardinal B-splines of order P onto a mesh
+    of M[0] x M[1] x M[2] points in fractional coordinates of the periodic
+    cell. Under Lees-Edwards boundaries (shear along x, gradient along z)
+    the cell is the parallelepiped spanned by (Lx,0,0), (0,Ly,0) and
+    (shearOffset,0,Lz), so the mesh is sheared with the box and the
+    reciprocal lattice is the one of the deformed box. The influence
+    function is recalculated whenever the box or the shear offset changes.
+
+    The FFT is distributed in slabs: CPU r owns xCount[r] planes of the real
+    mesh starting at xStart[r]. Every CPU spreads its own particles onto a
+    full mesh, which is then summed up plane-wise on the owners of the slabs.
+    The owners transform their planes in y and z, the half spectrum is
+    transposed into slabs of yCount[r] rows starting at yStart[r] and
+    transformed in x there. The influence function lives in this transposed
+    layout, so energy and virial only need a scalar reduction. For the forces
+    the potential is transformed back the same way and the slabs are gathered
+    on every CPU. The cost is O(N + M log M / Ncpu) instead of O(N K) of
+    CoulombKSpaceEwald.
+*/
+class CoulombKSpaceSPME : public PotentialTemplate<CoulombKSpaceSPME>
+{
+public:
+    static void registerPython();
+
+    CoulombKSpaceSPME(std::shared_ptr<System> _system,
+                      real _prefactor,
+                      real _alpha,
+                      Int3D _M,
+                      int _P);
+
+    ~CoulombKSpaceSPME();
+
+    void setPrefactor(real _prefactor)
+    {
+        prefactor = _prefactor;
+        boxChanged = true;
+    }
+    real getPrefactor() const { return prefactor; }
+    void setAlpha(real _alpha)
+    {
+        alpha = _alpha;
+        boxChanged = true;
+    }
+    real getAlpha() const { return alpha; }
+    Int3D getMesh() const { return M; }
+    int getP() const { return P; }
+
+    real _computeEnergy(CellList realcells);
+    bool _computeForce(CellList realcells);
+    real _computeVirial(CellList realcells);
+    Tensor _computeVirialTensor(CellList realcells);
+
+    real _computeEnergySqrRaw(real distSqr) const;
+    bool _computeForceRaw(Real3D& force, const Real3D& dist, real distSqr) const;
+
+private:
+    std::shared_ptr<System> system;
+
+    real prefactor;
+    real alpha;  // Ewald parameter
+    Int3D M;     // number of mesh points
+    int P;       // order of the B-splines
+
+    int meshSize;     // M[0]*M[1]*M[2]
+    int nkz;          // M[2]/2+1, length of the half spectrum in z
+    int pencilSize;   // yCount[rank]*nkz*M[0], local part of the half spectrum
+    Real3D L;         // box size the influence function was calculated for
+    real offset;      // shear offset the influence function was calculated for
+    bool boxChanged;  // set by the box signal and the setters
+
+    // reciprocal lattice vectors (without 2 pi) and volume of the (sheared) cell
+    Real3D b[3];
+    real volume;
+
+    // |b(m)|^2 of the B-spline interpolation along every direction
+    std::vector<real> bsplineModuli[3];
+    // slabs of the CPUs, x planes of the real mesh and y rows of the spectrum
+    int rank;
+    std::vector<int> xStart, xCount, yStart, yCount;
+
+    // energy per |S(m)|^2 on the local half spectrum, 0 for m = 0
+    std::vector<real> influence;
+    // charges spread on the full mesh by this CPU, potential on the full mesh
+    std::vector<real> localMesh, mesh;
+    real sumQ, sumQ2;
+
+    // x planes of the real mesh, their 2d transforms and the transposed
+    // spectrum with x running fastest: index (y - yStart) * nkz * M[0] + kz * M[0] + x
+    real* slabReal;
+    fftw_complex* slabK;
+    fftw_complex* pencilK;
+    fftw_plan planForwardYZ, planBackwardYZ, planForwardX, planBackwardX;
+
+    boost::signals2::connection connectionBoxChanged;
+
+    void calcBSplineModuli();
+    void checkBox();
+    void calcInfluenceFunction();
+
+    /** fractional mesh coordinates of pos, in [0, M) */
+    Real3D meshPosition(const Real3D& pos) const;
+    /** weights (and their derivatives) at the P mesh points below u */
+    void bspline(real w, real* theta, real* dtheta) const;
+    /** spread the charges on the mesh, sum them up over all CPUs and transform */
+    void calcStructureFactor(CellList realcells);
+    /** exchange the half spectrum between x planes and y rows */
+    void transpose(bool toPencils);
+    /** weight of the half spectrum point with index k[2] = kz */
+    real halfSpectrumWeight(int kz) const { return (kz == 0 || 2 * kz == M[2]) ? 1.0 : 2.0; }
+    /** reciprocal vector m of the mesh point with index (i, j, k) */
+    Real3D reciprocalVector(int i, int j, int k) const;
+};
+}  // namespace interaction
+}  // namespace espressopp
+
+#endif
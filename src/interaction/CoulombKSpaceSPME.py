@@ -0,0 +1,121 @@
+#  Copyright (C) 2012,2013
+#      Max Planck Institute for Polymer Research
+#  Copyright (C) 2008,2009,2010,2011
+#      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+r"""
+****************************************
+espressopp.interaction.CoulombKSpaceSPME
+****************************************
+
+Coulomb potential and interaction Objects (`K` space part)
+
+This is the `K` space part of the Coulomb long range interaction with the
+smooth particle mesh Ewald (SPME) method [Essmann95]_. The charges are
+spread with B-splines of order *P* onto a mesh, so the cost grows as
+:math:`N \log N` instead of :math:`N^{3/2}` for CoulombKSpaceEwald_.
+
+Lees-Edwards boundaries are supported: the mesh is laid out in the
+sheared cell spanned by :math:`(L_x,0,0)`, :math:`(0,L_y,0)` and
+:math:`(\Delta x,0,L_z)`, where :math:`\Delta x` is the current shear offset,
+and the reciprocal lattice is that of the deformed box.
+
+Example:
+
+    >>> spme_pot = espressopp.interaction.CoulombKSpaceSPME(system, coulomb_prefactor, alpha, (32, 32, 32), 5)
+    >>> spme_int = espressopp.interaction.CellListCoulombKSpaceSPME(system.storage, spme_pot)
+    >>> system.addInteraction(spme_int)
+
+**!IMPORTANT** Coulomb interaction needs `R` space part as well CoulombRSpace_.
+
+.. _CoulombRSpace: espressopp.interaction.CoulombRSpace.html
+.. _CoulombKSpaceEwald: espressopp.interaction.CoulombKSpaceEwald.html
+
+The mesh is distributed over the CPUs in slabs of x planes. Every CPU
+spreads its own particles, the planes are summed up on the CPUs owning them
+and transformed in y and z there. The spectrum is then transposed into slabs
+of y rows and transformed in x. The potential for the forces is transformed
+back the same way and gathered on every CPU.
+
+.. [Essmann95] U. Essmann, L. Perera, M. L. Berkowitz, T. Darden, H. Lee,
+   L. G. Pedersen, J. Chem. Phys. 103, 8577 (1995)
+
+.. function:: espressopp.interaction.CoulombKSpaceSPME(system, prefactor, alpha, M, P)
+
+                :param system: system object
+                :param prefactor: Coulomb prefactor
+                :param alpha: Ewald splitting parameter
+                :param M: number of mesh points in each direction
+                :param P: (default: 5) order of the charge assignment B-splines, 2 to 12
+                :type system: espressopp.System
+                :type prefactor: real
+                :type alpha: real
+                :type M: Int3D
+                :type P: int
+
+.. function:: espressopp.interaction.CellListCoulombKSpaceSPME(storage, potential)
+
+                :param storage: system storage
+                :param potential: CoulombKSpaceSPME potential
+                :type storage: espressopp.storage.Storage
+                :type potential: CoulombKSpaceSPME
+
+.. function:: espressopp.interaction.CellListCoulombKSpaceSPME.getPotential()
+
+                :rtype: CoulombKSpaceSPME
+"""
+
+
+from espressopp import pmi
+from espressopp.esutil import *
+from espressopp import toInt3DFromVector
+
+from espressopp.interaction.Potential import *
+from espressopp.interaction.Interaction import *
+from _espressopp import interaction_CoulombKSpaceSPME, \
+                      interaction_CellListCoulombKSpaceSPME
+
+class CoulombKSpaceSPMELocal(PotentialLocal, interaction_CoulombKSpaceSPME):
+    def __init__(self, system, prefactor, alpha, M, P = 5):
+
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            cxxinit(self, interaction_CoulombKSpaceSPME, system, prefactor, alpha, toInt3DFromVector(M), P)
+
+class CellListCoulombKSpaceSPMELocal(InteractionLocal, interaction_CellListCoulombKSpaceSPME):
+    def __init__(self, storage, potential):
+
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            cxxinit(self, interaction_CellListCoulombKSpaceSPME, storage, potential)
+
+    def getPotential(self):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.getPotential(self)
+
+if pmi.isController:
+    class CoulombKSpaceSPME(Potential):
+        pmiproxydefs = dict(
+          cls = 'espressopp.interaction.CoulombKSpaceSPMELocal',
+          pmiproperty = ['prefactor', 'alpha', 'mesh', 'P']
+        )
+
+    class CellListCoulombKSpaceSPME(Interaction, metaclass=pmi.Proxy):
+        pmiproxydefs = dict(
+          cls =  'espressopp.interaction.CellListCoulombKSpaceSPMELocal',
+          pmicall = ['getPotential']
+        )
@@ -22,8 +22,10 @@
 
 #include "python.hpp"
 #include "CoulombRSpace.hpp"
+#include "LennardJones.hpp"
 #include "Tabulated.hpp"
 #include "VerletListInteractionTemplate.hpp"
+#include "VerletListCombinedInteractionTemplate.hpp"
 
 // currently just Verlet list
 
@@ -32,6 +34,8 @@ namespace espressopp
 namespace interaction
 {
 typedef class VerletListInteractionTemplate<CoulombRSpace> VerletListCoulombRSpace;
+typedef class VerletListCombinedInteractionTemplate<LennardJones, CoulombRSpace>
+    VerletListLennardJonesCoulombRSpace;
 
 //////////////////////////////////////////////////
 // REGISTRATION WITH PYTHON
@@ -52,6 +56,16 @@ void CoulombRSpace::registerPython()
              return_value_policy<reference_existing_object>())
         .def("getPotential", &VerletListCoulombRSpace::getPotential,
              return_value_policy<reference_existing_object>());
+
+    class_<VerletListLennardJonesCoulombRSpace, bases<Interaction> >(
+        "interaction_VerletListLennardJonesCoulombRSpace", init<std::shared_ptr<VerletList> >())
+        .def("getVerletList", &VerletListLennardJonesCoulombRSpace::getVerletList)
+        .def("setPotential1", &VerletListLennardJonesCoulombRSpace::setPotential1)
+        .def("setPotential2", &VerletListLennardJonesCoulombRSpace::setPotential2)
+        .def("getPotential1", &VerletListLennardJonesCoulombRSpace::getPotential1,
+             return_value_policy<reference_existing_object>())
+        .def("getPotential2", &VerletListLennardJonesCoulombRSpace::getPotential2,
+             return_value_policy<reference_existing_object>());
 }
 
 }  // namespace interaction
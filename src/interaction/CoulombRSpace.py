@@ -140,6 +140,46 @@ Adding the interaction to the system:
                 :type type1:
                 :type type2:
                 :type potential:
+
+.. function:: espressopp.interaction.VerletListLennardJonesCoulombRSpace(vl)
+
+                Lennard-Jones and `R` space Coulomb in one loop over the pairs of *vl*.
+                Gives the same forces as a VerletListLennardJones and a
+                VerletListCoulombRSpace on the same list, but each pair is visited once.
+                Each potential keeps its own cutoff, *vl* has to be built for the larger
+                one. Set both potentials for every pair of types in use, an unset
+                Lennard-Jones entry has an infinite cutoff.
+
+                >>> vl = espressopp.VerletList.shared(system, cutoff=rspacecutoff)
+                >>> interaction = espressopp.interaction.VerletListLennardJonesCoulombRSpace(vl)
+                >>> interaction.setPotential1(type1=0, type2=0, potential=lj_pot)
+                >>> interaction.setPotential2(type1=0, type2=0, potential=coulombR_pot)
+                >>> system.addInteraction(interaction)
+
+                :param vl:
+                :type vl:
+
+.. function:: espressopp.interaction.VerletListLennardJonesCoulombRSpace.setPotential1(type1, type2, potential)
+
+                Sets the Lennard-Jones potential.
+
+                :param type1:
+                :param type2:
+                :param potential:
+                :type type1:
+                :type type2:
+                :type potential: espressopp.interaction.LennardJones
+
+.. function:: espressopp.interaction.VerletListLennardJonesCoulombRSpace.setPotential2(type1, type2, potential)
+
+                Sets the `R` space Coulomb potential.
+
+                :param type1:
+                :param type2:
+                :param potential:
+                :type type1:
+                :type type2:
+                :type potential: espressopp.interaction.CoulombRSpace
 """
 
 from espressopp import pmi, infinity
@@ -148,7 +188,8 @@ from espressopp.esutil import *
 from espressopp.interaction.Potential import *
 from espressopp.interaction.Interaction import *
 from _espressopp import interaction_CoulombRSpace, \
-                      interaction_VerletListCoulombRSpace
+                      interaction_VerletListCoulombRSpace, \
+                      interaction_VerletListLennardJonesCoulombRSpace
 
 class CoulombRSpaceLocal(PotentialLocal, interaction_CoulombRSpace):
 
@@ -179,6 +220,36 @@ class VerletListCoulombRSpaceLocal(InteractionLocal, interaction_VerletListCoulo
         if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
             return self.cxxclass.getVerletList(self)
 
+class VerletListLennardJonesCoulombRSpaceLocal(InteractionLocal, interaction_VerletListLennardJonesCoulombRSpace):
+
+    def __init__(self, vl):
+
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            cxxinit(self, interaction_VerletListLennardJonesCoulombRSpace, vl)
+
+    def setPotential1(self, type1, type2, potential):
+
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            self.cxxclass.setPotential1(self, type1, type2, potential)
+
+    def setPotential2(self, type1, type2, potential):
+
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            self.cxxclass.setPotential2(self, type1, type2, potential)
+
+    def getPotential1(self, type1, type2):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.getPotential1(self, type1, type2)
+
+    def getPotential2(self, type1, type2):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.getPotential2(self, type1, type2)
+
+    def getVerletListLocal(self):
+
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.getVerletList(self)
+
 
 if pmi.isController:
 
@@ -188,3 +259,7 @@ if pmi.isController:
     class VerletListCoulombRSpace(Interaction, metaclass=pmi.Proxy):
         pmiproxydefs = dict( cls = 'espressopp.interaction.VerletListCoulombRSpaceLocal',
         pmicall      = ['setPotential', 'getPotential', 'getVerletList'] )
+
+    class VerletListLennardJonesCoulombRSpace(Interaction, metaclass=pmi.Proxy):
+        pmiproxydefs = dict( cls = 'espressopp.interaction.VerletListLennardJonesCoulombRSpaceLocal',
+        pmicall      = ['setPotential1', 'setPotential2', 'getPotential1', 'getPotential2', 'getVerletList'] )
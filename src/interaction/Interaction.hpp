@@ -69,6 +69,11 @@ public:
     virtual real getMaxCutoff() = 0;
     virtual int bondType() = 0;
 
+    /** Called by System::addInteraction() and System::removeInteraction(), for
+        interactions that change other objects while they are part of the system. */
+    virtual void addedToSystem() {}
+    virtual void removedFromSystem() {}
+
     static void registerPython();
 
 protected:
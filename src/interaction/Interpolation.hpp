@@ -39,6 +39,11 @@ public:
     virtual real getEnergy(real r) const = 0;
     virtual real getForce(real r) const = 0;
     virtual void read(mpi::communicator comm, const char* file) = 0;
+
+    /** Range and number of points of the table read in */
+    virtual real getInner() const = 0;
+    virtual real getOuter() const = 0;
+    virtual int getNumPoints() const = 0;
 };  // class Interpolation
 
 template <class Derived>
@@ -49,6 +54,9 @@ public:
     virtual real getEnergy(real r) const;
     virtual real getForce(real r) const;
     virtual void read(mpi::communicator comm, const char* file);
+    virtual real getInner() const { return derived_this()->getInnerRaw(); }
+    virtual real getOuter() const { return derived_this()->getOuterRaw(); }
+    virtual int getNumPoints() const { return derived_this()->getNumPointsRaw(); }
 
 protected:
     Derived* derived_this() { return static_cast<Derived*>(this); }
@@ -88,6 +88,43 @@ void InterpolationCubic::readRaw(mpi::communicator comm, const char *file)
         }
     }
 
+    prepare();
+}  // read
+
+// used for tables sampled from a function instead of read from a file
+void InterpolationCubic::setValues(real _inner,
+                                   real _outer,
+                                   const std::vector<real> &_energy,
+                                   const std::vector<real> &_force)
+{
+    N = _energy.size();
+    if (N < 2 || int(_force.size()) != N || _outer <= _inner)
+    {
+        throw std::runtime_error("illegal values for tabulated potential");
+    }
+
+    delete[] radius;
+    delete[] energy;
+    delete[] force;
+    delete[] energy2;
+    delete[] force2;
+
+    radius = new real[N];
+    energy = new real[N];
+    force = new real[N];
+    for (int i = 0; i < N; i++)
+    {
+        radius[i] = _inner + i * (_outer - _inner) / (N - 1);
+        energy[i] = _energy[i];
+        force[i] = _force[i];
+    }
+
+    prepare();
+}
+
+// spline coefficients of the values in radius, energy and force
+void InterpolationCubic::prepare()
+{
     int nbins = N - 1;  // number of intervals is number of points - 1
     inner = radius[0];
     outer = radius[nbins];
@@ -117,7 +154,7 @@ void InterpolationCubic::readRaw(mpi::communicator comm, const char *file)
     ypN = (force[N - 1] - force[N - 2]) / (radius[N - 1] - radius[N - 2]);
 
     spline(radius, force, N, yp1, ypN, force2);
-}  // read
+}
 
 // private functions
 
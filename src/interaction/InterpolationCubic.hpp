@@ -24,6 +24,7 @@
 #ifndef _INTERACTION_CUBIC_HPP
 #define _INTERACTION_CUBIC_HPP
 
+#include <vector>
 #include "Interpolation.hpp"
 
 namespace espressopp
@@ -36,8 +37,16 @@ public:
     InterpolationCubic();
     ~InterpolationCubic();
     void readRaw(mpi::communicator comm, const char* file);
+    /** Use energy and force at equidistant points from _inner to _outer as table */
+    void setValues(real _inner,
+                   real _outer,
+                   const std::vector<real>& _energy,
+                   const std::vector<real>& _force);
     real getEnergyRaw(real r) const;
     real getForceRaw(real r) const;
+    real getInnerRaw() const { return inner; }
+    real getOuterRaw() const { return outer; }
+    int getNumPointsRaw() const { return N; }
 
 protected:
     static LOG4ESPP_DECL_LOGGER(theLogger);
@@ -51,6 +60,9 @@ private:
     // If dummy is true, values will not be stored in arrays r, e, f
     int readFile(const char* file, bool dummy);
 
+    // Set range and spline coefficients of radius, energy and force
+    void prepare();
+
     // Spline read-in values
     void spline(const real* x, const real* y, int n, real yp1, real ypn, real* y2);
 
@@ -96,11 +108,15 @@ inline real InterpolationCubic::splineInterpolation(real r, const real* fn, cons
                                               << inner + (N - 1) * delta);
         index = 0;
     }
-    else if (index >= N)
+    else if (index >= N - 1)
     {
-        LOG4ESPP_ERROR(theLogger, "distance " << r << " out of range " << inner << " - "
-                                              << inner + (N - 1) * delta);
-        index = N - 1;
+        // r = outer lies in the last interval
+        if (index >= N)
+        {
+            LOG4ESPP_ERROR(theLogger, "distance " << r << " out of range " << inner << " - "
+                                                  << inner + (N - 1) * delta);
+        }
+        index = N - 2;
     }
 
     real b = (r - radius[index]) * invdelta;
@@ -38,6 +38,9 @@ public:
     void readRaw(mpi::communicator comm, const char* file);
     real getEnergyRaw(real r) const;
     real getForceRaw(real r) const;
+    real getInnerRaw() const { return inner; }
+    real getOuterRaw() const { return outer; }
+    int getNumPointsRaw() const { return N; }
 
 protected:
     static LOG4ESPP_DECL_LOGGER(theLogger);
@@ -0,0 +1,171 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "InterpolationSqr.hpp"
+#include "Potential.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace espressopp
+{
+namespace interaction
+{
+LOG4ESPP_LOGGER(InterpolationSqr::theLogger, "InterpolationSqr");
+
+namespace
+{
+// upper bound of the table size, 32768 bins take 2 MB
+const int maxNumBins = 1 << 15;
+
+// Hermite cubic on t in [0, 1] from values y and slopes m (per bin) at both ends
+void hermite(real y0, real y1, real m0, real m1, real* c)
+{
+    c[0] = y0;
+    c[1] = m0;
+    c[2] = 3.0 * (y1 - y0) - 2.0 * m0 - m1;
+    c[3] = 2.0 * (y0 - y1) + m0 + m1;
+}
+}  // namespace
+
+InterpolationSqr::InterpolationSqr(const Interpolation& table, int numBinsPerPoint)
+    : maxError(-1.0)
+{
+    real inner = table.getInner();
+    real outer = table.getOuter();
+    int numBins = std::min(std::max(numBinsPerPoint * (table.getNumPoints() - 1), 1), maxNumBins);
+
+    // the last point is taken just inside of the range, as at r = outer some interpolations
+    // already look at the bin after the last one
+    real last = std::nextafter(outer, inner);
+    sample(inner, outer, numBins, [&table, last](real r, real& energy, real& ffactor) {
+        r = std::min(r, last);
+        energy = table.getEnergy(r);
+        ffactor = r > 0.0 ? table.getForce(r) / r : 0.0;
+    });
+}
+
+InterpolationSqr::InterpolationSqr(const Potential& potential,
+                                   real rmin,
+                                   real rmax,
+                                   real tolerance)
+    : InterpolationSqr(
+          [&potential, rmin, rmax](real r, real& energy, real& ffactor) {
+              // the potential may already be cut off at rmax
+              r = std::min(r, std::nextafter(rmax, rmin));
+              energy = potential.computeEnergySqr(r * r);
+              ffactor = potential.computeForce(Real3D(r, 0.0, 0.0))[0] / r;
+          },
+          rmin,
+          rmax,
+          tolerance)
+{
+}
+
+InterpolationSqr::InterpolationSqr(const SampleFunction& eval,
+                                   real rmin,
+                                   real rmax,
+                                   real tolerance)
+{
+    if (rmin <= 0.0 || rmax <= rmin)
+    {
+        throw std::runtime_error("tabulation of a potential needs 0 < rmin < rmax");
+    }
+
+    // refine until energy and force in the middle of the bins are accurate enough
+    for (int numBins = 256;; numBins *= 2)
+    {
+        sample(rmin, rmax, numBins, eval);
+
+        maxError = 0.0;
+        for (int i = 0; i < numBins; i++)
+        {
+            real distSqr = innerSqr + (i + 0.5) / invDelta;
+            real r = std::sqrt(distSqr);
+            real energy, ffactor;
+            eval(r, energy, ffactor);
+
+            real errE = std::abs(getEnergySqr(distSqr) - energy) / std::max(std::abs(energy), 1.0);
+            real errF = std::abs(getForceFactorSqr(distSqr) - ffactor) * r /
+                        std::max(std::abs(ffactor) * r, 1.0);
+            maxError = std::max(maxError, std::max(errE, errF));
+        }
+
+        if (maxError <= tolerance || numBins >= maxNumBins) break;
+    }
+
+    if (maxError > tolerance)
+    {
+        LOG4ESPP_WARN(theLogger, "tabulation error " << maxError << " above tolerance "
+                                                     << tolerance << " with " << getNumBins()
+                                                     << " bins");
+    }
+}
+
+void InterpolationSqr::sample(real inner, real outer, int numBins, const SampleFunction& eval)
+{
+    innerSqr = inner * inner;
+    real delta = (outer * outer - innerSqr) / numBins;
+    invDelta = 1.0 / delta;
+    maxBin = numBins - 1;
+
+    // energy and force factor at the grid points
+    std::vector<real> energy(numBins + 1), ffactor(numBins + 1);
+    for (int i = 0; i <= numBins; i++)
+    {
+        real r = std::min(std::max(std::sqrt(innerSqr + i * delta), inner), outer);
+        eval(r, energy[i], ffactor[i]);
+    }
+    if (inner <= 0.0) ffactor[0] = ffactor[1];  // F(r)/r is not defined at r = 0
+
+    // dE/d(r^2) = -F/(2r) is known exactly, the slope of F/r is taken from the grid,
+    // with a fourth order stencil in the interior
+    std::vector<real> slope(numBins + 1);
+    for (int i = 0; i <= numBins; i++)
+    {
+        if (numBins < 2)
+            slope[i] = ffactor[1] - ffactor[0];
+        else if (i == 0)
+            slope[i] = 0.5 * (-3.0 * ffactor[0] + 4.0 * ffactor[1] - ffactor[2]);
+        else if (i == numBins)
+            slope[i] = 0.5 * (3.0 * ffactor[i] - 4.0 * ffactor[i - 1] + ffactor[i - 2]);
+        else if (i == 1 || i == numBins - 1)
+            slope[i] = 0.5 * (ffactor[i + 1] - ffactor[i - 1]);
+        else
+            slope[i] = (8.0 * (ffactor[i + 1] - ffactor[i - 1]) - ffactor[i + 2] + ffactor[i - 2]) /
+                       12.0;
+    }
+
+    bins.resize(numBins);
+    for (int i = 0; i < numBins; i++)
+    {
+        hermite(energy[i], energy[i + 1], -0.5 * delta * ffactor[i], -0.5 * delta * ffactor[i + 1],
+                bins[i].e);
+        hermite(ffactor[i], ffactor[i + 1], slope[i], slope[i + 1], bins[i].f);
+    }
+
+    LOG4ESPP_INFO(theLogger, "table in r^2 with " << numBins << " bins for range " << inner
+                                                  << " - " << outer);
+}
+
+}  // namespace interaction
+}  // namespace espressopp
@@ -0,0 +1,130 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ESPP_CLASS
+#ifndef _INTERACTION_INTERPOLATIONSQR_HPP
+#define _INTERACTION_INTERPOLATIONSQR_HPP
+
+#include <algorithm>
+#include <functional>
+#include "types.hpp"
+#include "Interpolation.hpp"
+#include "vectorization/simdconfig.hpp"
+
+namespace espressopp
+{
+namespace interaction
+{
+/** Lookup table of a tabulated pair potential indexed by the squared distance.
+
+    The table is sampled once from an Interpolation (linear, Akima or cubic)
+    on an equidistant grid in r^2, so the force loop needs neither sqrt nor a
+    virtual call. Every bin stores the cubic Hermite coefficients of the
+    energy and of the force factor F(r)/r in one 64 byte block, i.e. a lookup
+    touches a single cache line.
+
+    The table can also be sampled from an analytic pair potential or from
+    any radial function with its derivative, see the other constructors.
+
+    Outside of the sampled range the polynomial of the first or last bin is
+    extrapolated.
+*/
+class Potential;
+
+class InterpolationSqr
+{
+public:
+    /** Gives value and -(d value/dr)/r at r, i.e. energy and F(r)/r of a pair potential */
+    typedef std::function<void(real r, real& energy, real& ffactor)> SampleFunction;
+
+    /** Sample table with numBinsPerPoint bins per point of the file. */
+    InterpolationSqr(const Interpolation& table, int numBinsPerPoint = 8);
+
+    /** Sample potential in [rmin, rmax]. The number of bins is doubled until the
+        error of energy and force in the middle of the bins, relative to
+        max(|value|, 1), is below tolerance or the table has reached its maximal size. */
+    InterpolationSqr(const Potential& potential, real rmin, real rmax, real tolerance);
+
+    /** Sample eval in [rmin, rmax] with the same refinement, eval is not kept */
+    InterpolationSqr(const SampleFunction& eval, real rmin, real rmax, real tolerance);
+
+    real getEnergySqr(real distSqr) const;
+
+    /** F(r)/r, the factor the distance vector is multiplied with */
+    real getForceFactorSqr(real distSqr) const;
+
+    int getNumBins() const { return int(bins.size()); }
+
+    /** Error found when sampling a function, -1 for file based tables */
+    real getMaxError() const { return maxError; }
+
+protected:
+    static LOG4ESPP_DECL_LOGGER(theLogger);
+
+private:
+    struct Bin
+    {
+        real e[4];  // energy
+        real f[4];  // force factor
+    };
+
+    /** Fill numBins bins in [inner^2, outer^2] from energy and F(r)/r given by eval */
+    void sample(real inner, real outer, int numBins, const SampleFunction& eval);
+
+    int locate(real distSqr, real& t) const;
+
+    static real horner(const real* c, real t) { return ((c[3] * t + c[2]) * t + c[1]) * t + c[0]; }
+
+    vectorization::AlignedVector<Bin, 64> bins;
+
+    real innerSqr;
+    real invDelta;
+    int maxBin;
+    real maxError;
+};
+
+inline int InterpolationSqr::locate(real distSqr, real& t) const
+{
+    real x = (distSqr - innerSqr) * invDelta;
+    int index = std::min(std::max(static_cast<int>(x), 0), maxBin);
+    t = x - index;
+    return index;
+}
+
+inline real InterpolationSqr::getEnergySqr(real distSqr) const
+{
+    real t;
+    const Bin& bin = bins[locate(distSqr, t)];
+    return horner(bin.e, t);
+}
+
+inline real InterpolationSqr::getForceFactorSqr(real distSqr) const
+{
+    real t;
+    const Bin& bin = bins[locate(distSqr, t)];
+    return horner(bin.f, t);
+}
+
+}  // namespace interaction
+}  // namespace espressopp
+
+#endif
@@ -26,6 +26,7 @@
 #include "Harmonic.hpp"
 #include "ReactionFieldGeneralized.hpp"
 #include "VerletListInteractionTemplate.hpp"
+#include "VerletListDPDInteractionTemplate.hpp"
 #include "VerletListAdressInteractionTemplate.hpp"
 #include "VerletListAdressATInteractionTemplate.hpp"
 #include "VerletListAdressCGInteractionTemplate.hpp"
@@ -45,6 +46,7 @@ namespace espressopp
 namespace interaction
 {
 typedef class VerletListInteractionTemplate<LennardJones> VerletListLennardJones;
+typedef class VerletListDPDInteractionTemplate<LennardJones> VerletListDPDLennardJones;
 typedef class VerletListAdressInteractionTemplate<LennardJones, Tabulated>
     VerletListAdressLennardJones;
 typedef class VerletListAdressATInteractionTemplate<LennardJones> VerletListAdressATLennardJones;
@@ -108,6 +110,14 @@ void LennardJones::registerPython()
         .def("setPotential", &VerletListLennardJones::setPotential)
         .def("getPotential", &VerletListLennardJones::getPotentialPtr);
 
+    class_<VerletListDPDLennardJones, bases<Interaction> >(
+        "interaction_VerletListDPDLennardJones",
+        init<std::shared_ptr<VerletList>, std::shared_ptr<integrator::DPDThermostat> >())
+        .def("getVerletList", &VerletListDPDLennardJones::getVerletList)
+        .def("getThermostat", &VerletListDPDLennardJones::getThermostat)
+        .def("setPotential", &VerletListDPDLennardJones::setPotential)
+        .def("getPotential", &VerletListDPDLennardJones::getPotentialPtr);
+
     class_<VerletListAdressATLennardJones, bases<Interaction> >(
         "interaction_VerletListAdressATLennardJones",
         init<std::shared_ptr<VerletListAdress>, std::shared_ptr<FixedTupleListAdress> >())
@@ -75,6 +75,20 @@ espressopp.interaction.LennardJones
         :type type2: int
         :type potential: std::shared_ptr<LennardJones>
 
+.. function:: espressopp.interaction.VerletListDPDLennardJones(vl, dpd)
+
+        Defines a verletlist-based Lennard-Jones interaction which also evaluates
+        the pair forces of the DPD thermostat dpd in the same loop over the pairs.
+        The thermostat must use the same verletlist and still has to be added
+        to the integrator. While the interaction is part of the system the
+        thermostat does no pass of its own; a thermostat can only be shared
+        with one such interaction at a time.
+
+        :param vl: Verletlist object
+        :param dpd: DPD thermostat
+        :type vl: std::shared_ptr<VerletList>
+        :type dpd: std::shared_ptr<DPDThermostat>
+
 .. function:: espressopp.interaction.VerletListAdressLennardJones(vl, fixedtupleList)
 
         Defines a verletlist-based AdResS interaction using a LennardJones potential for the AT and a tabulated potential for the CG interaction.
@@ -698,6 +712,7 @@ from espressopp.interaction.Potential import *
 from espressopp.interaction.Interaction import *
 from _espressopp import interaction_LennardJones, \
                       interaction_VerletListLennardJones, \
+                      interaction_VerletListDPDLennardJones, \
                       interaction_VerletListAdressLennardJones, \
                       interaction_VerletListAdressATLennardJones, \
                       interaction_VerletListAdressATLenJonesReacFieldGen, \
@@ -749,6 +764,24 @@ class VerletListLennardJonesLocal(InteractionLocal, interaction_VerletListLennar
         if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
             return self.cxxclass.getVerletList(self)
 
+class VerletListDPDLennardJonesLocal(InteractionLocal, interaction_VerletListDPDLennardJones):
+
+    def __init__(self, vl, dpd):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            cxxinit(self, interaction_VerletListDPDLennardJones, vl, dpd)
+
+    def setPotential(self, type1, type2, potential):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            self.cxxclass.setPotential(self, type1, type2, potential)
+
+    def getPotential(self, type1, type2):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.getPotential(self, type1, type2)
+
+    def getVerletListLocal(self):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.getVerletList(self)
+
 class VerletListAdressATLennardJonesLocal(InteractionLocal, interaction_VerletListAdressATLennardJones):
 
     def __init__(self, vl, fixedtupleList):
@@ -1073,6 +1106,12 @@ if pmi.isController:
             pmicall = ['setPotential', 'getPotential', 'getVerletList']
             )
 
+    class VerletListDPDLennardJones(Interaction, metaclass=pmi.Proxy):
+        pmiproxydefs = dict(
+            cls =  'espressopp.interaction.VerletListDPDLennardJonesLocal',
+            pmicall = ['setPotential', 'getPotential', 'getVerletList']
+            )
+
     class VerletListAdressATLennardJones(Interaction, metaclass=pmi.Proxy):
         pmiproxydefs = dict(
             cls =  'espressopp.interaction.VerletListAdressATLennardJonesLocal',
@@ -23,6 +23,7 @@
 #include "python.hpp"
 #include "SoftCosine.hpp"
 #include "VerletListInteractionTemplate.hpp"
+#include "VerletListDPDInteractionTemplate.hpp"
 #include "CellListAllPairsInteractionTemplate.hpp"
 #include "FixedPairListInteractionTemplate.hpp"
 
@@ -31,6 +32,7 @@ namespace espressopp
 namespace interaction
 {
 typedef class VerletListInteractionTemplate<SoftCosine> VerletListSoftCosine;
+typedef class VerletListDPDInteractionTemplate<SoftCosine> VerletListDPDSoftCosine;
 typedef class CellListAllPairsInteractionTemplate<SoftCosine> CellListSoftCosine;
 typedef class FixedPairListInteractionTemplate<SoftCosine> FixedPairListSoftCosine;
 
@@ -53,6 +55,14 @@ void SoftCosine::registerPython()
         .def("getPotential", &VerletListSoftCosine::getPotential,
              return_value_policy<reference_existing_object>());
 
+    class_<VerletListDPDSoftCosine, bases<Interaction> >(
+        "interaction_VerletListDPDSoftCosine",
+        init<std::shared_ptr<VerletList>, std::shared_ptr<integrator::DPDThermostat> >())
+        .def("setPotential", &VerletListDPDSoftCosine::setPotential,
+             return_value_policy<reference_existing_object>())
+        .def("getPotential", &VerletListDPDSoftCosine::getPotential,
+             return_value_policy<reference_existing_object>());
+
     class_<CellListSoftCosine, bases<Interaction> >("interaction_CellListSoftCosine",
                                                     init<std::shared_ptr<storage::Storage> >())
         .def("setPotential", &CellListSoftCosine::setPotential);
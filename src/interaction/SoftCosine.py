@@ -54,6 +54,26 @@ This class provides methods to compute forces and energies ofthe SoftCosine pote
                 :type type2:
                 :type potential:
 
+.. function:: espressopp.interaction.VerletListDPDSoftCosine(vl, dpd)
+
+                SoftCosine interaction that also evaluates the pair forces of the
+                DPD thermostat dpd (same verletlist) in its loop over the pairs
+                while it is part of the system.
+
+                :param vl:
+                :param dpd:
+                :type vl:
+                :type dpd:
+
+.. function:: espressopp.interaction.VerletListDPDSoftCosine.setPotential(type1, type2, potential)
+
+                :param type1:
+                :param type2:
+                :param potential:
+                :type type1:
+                :type type2:
+                :type potential:
+
 .. function:: espressopp.interaction.CellListSoftCosine(stor)
 
                 :param stor:
@@ -89,6 +109,7 @@ from espressopp.interaction.Potential import *
 from espressopp.interaction.Interaction import *
 from _espressopp import interaction_SoftCosine, \
                       interaction_VerletListSoftCosine, \
+                      interaction_VerletListDPDSoftCosine, \
                       interaction_CellListSoftCosine, \
                       interaction_FixedPairListSoftCosine
 
@@ -126,6 +147,20 @@ class VerletListSoftCosineLocal(InteractionLocal, interaction_VerletListSoftCosi
         if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
             self.cxxclass.setPotential(self, type1, type2, potential)
 
+class VerletListDPDSoftCosineLocal(InteractionLocal, interaction_VerletListDPDSoftCosine):
+
+    def __init__(self, vl, dpd):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            cxxinit(self, interaction_VerletListDPDSoftCosine, vl, dpd)
+
+    def setPotential(self, type1, type2, potential):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            self.cxxclass.setPotential(self, type1, type2, potential)
+
+    def getPotential(self, type1, type2):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.getPotential(self, type1, type2)
+
 class CellListSoftCosineLocal(InteractionLocal, interaction_CellListSoftCosine):
 
     def __init__(self, stor):
@@ -158,6 +193,11 @@ if pmi.isController:
             cls =  'espressopp.interaction.VerletListSoftCosineLocal',
             pmicall = ['setPotential','getPotential']
             )
+    class VerletListDPDSoftCosine(Interaction, metaclass=pmi.Proxy):
+        pmiproxydefs = dict(
+            cls =  'espressopp.interaction.VerletListDPDSoftCosineLocal',
+            pmicall = ['setPotential','getPotential']
+            )
     class CellListSoftCosine(Interaction, metaclass=pmi.Proxy):
         pmiproxydefs = dict(
             cls =  'espressopp.interaction.CellListSoftCosineLocal',
@@ -26,10 +26,42 @@
 #include "VerletListTripleInteractionTemplate.hpp"
 #include "FixedTripleListInteractionTemplate.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
 namespace espressopp
 {
 namespace interaction
 {
+namespace
+{
+// exp(sigma gamma / (r - sigma rc)) and its -d/dr / r between rmin and the cutoff rc
+std::shared_ptr<InterpolationSqr> radialTable(
+    real sigmaGamma, real sigmarc, real rmin, real rc, real tolerance)
+{
+    if (rc == infinity)
+    {
+        throw std::runtime_error("StillingerWeberTripleTerm: tabulation needs finite cutoffs");
+    }
+    real last = std::nextafter(rc, rmin);
+    return std::make_shared<InterpolationSqr>(
+        [sigmaGamma, sigmarc, last](real r, real& g, real& gfactor) {
+            real inv = 1.0 / (std::min(r, last) - sigmarc);
+            g = exp(sigmaGamma * inv);
+            gfactor = sigmaGamma * inv * inv * g / r;
+        },
+        rmin, rc, tolerance);
+}
+}  // namespace
+
+real StillingerWeberTripleTerm::tabulate(real rmin, real tolerance)
+{
+    table1 = radialTable(sigmaGamma1, sigmarc1, rmin, rc1, tolerance);
+    table2 = radialTable(sigmaGamma2, sigmarc2, rmin, rc2, tolerance);
+    return std::max(table1->getMaxError(), table2->getMaxError());
+}
+
 //////////////////////////////////////////////////
 // REGISTRATION WITH PYTHON
 //////////////////////////////////////////////////
@@ -62,7 +94,8 @@ void StillingerWeberTripleTerm::registerPython()
         .add_property("cutoff1", &StillingerWeberTripleTerm::getCutoff1,
                       &StillingerWeberTripleTerm::setCutoff1)
         .add_property("cutoff2", &StillingerWeberTripleTerm::getCutoff2,
-                      &StillingerWeberTripleTerm::setCutoff2);
+                      &StillingerWeberTripleTerm::setCutoff2)
+        .def("tabulate", &StillingerWeberTripleTerm::tabulate);
 
     class_<VerletListStillingerWeberTripleTerm, bases<Interaction> >(
         "interaction_VerletListStillingerWeberTripleTerm",
@@ -25,6 +25,7 @@
 #define _INTERACTION_STILLINGERWEBERTRIPLETERM_HPP
 
 #include "AngularPotential.hpp"
+#include "InterpolationSqr.hpp"
 #include <cmath>
 
 #ifndef M_PIl
@@ -37,6 +38,9 @@ namespace interaction
 {
 /* This class provides methods to compute forces and energies of
    the StillingerWeberTripleTerm potential.
+
+   The radial factors exp(sigma gamma / (r - sigma rc)) of both legs can be
+   tabulated in r^2, see tabulate(). Setting a parameter drops the tables.
  */
 class StillingerWeberTripleTerm : public AngularPotentialTemplate<StillingerWeberTripleTerm>
 {
@@ -55,6 +59,9 @@ private:
     real sigmarc1, sigmarc2;
     real epsilonLambda;
 
+    // radial factors of the two legs in r^2, none if computed analytically
+    std::shared_ptr<InterpolationSqr> table1, table2;
+
 public:
     static void registerPython();
 
@@ -167,8 +174,15 @@ public:
 
         sigmarc1 = sigma1 * rc1;
         sigmarc2 = sigma2 * rc2;
+
+        table1.reset();
+        table2.reset();
     }
 
+    /** Tabulate the radial factors between rmin and the cutoffs with the given
+        relative accuracy, returns the largest error found. */
+    real tabulate(real rmin, real tolerance);
+
     real _computeEnergy(const Real3D& r12, const Real3D& r32) const
     {
         // 2 is central particle
@@ -181,14 +195,16 @@ public:
             return 0.0;
         else
         {
-            real inv_d12_a = 1.0 / (d12 - sigmarc1);
-            real inv_d32_a = 1.0 / (d32 - sigmarc2);
-
             real cosTeta123 = (r12 * r32) / (d12 * d32);
             real difCos = cosTeta123 - cosTeta0;
             real difCos2 = difCos * difCos;
 
-            real expProduct = exp(sigmaGamma1 * inv_d12_a + sigmaGamma2 * inv_d32_a);
+            real expProduct;
+            if (table1)
+                expProduct = table1->getEnergySqr(r12.sqr()) * table2->getEnergySqr(r32.sqr());
+            else
+                expProduct =
+                    exp(sigmaGamma1 / (d12 - sigmarc1) + sigmaGamma2 / (d32 - sigmarc2));
 
             real energy3 = epsilonLambda * expProduct * difCos2;
 
@@ -218,6 +234,28 @@ public:
             Real3D e12 = r12 * inv_d12;
             Real3D e32 = r32 * inv_d32;
 
+            if (table1)
+            {
+                // the tables hold g(r) and -g'(r)/r of each leg
+                real d12Sqr = d12 * d12;
+                real d32Sqr = d32 * d32;
+                real g1 = table1->getEnergySqr(d12Sqr);
+                real g2 = table2->getEnergySqr(d32Sqr);
+
+                real cosTeta123 = (r12 * r32) * (inv_d12 * inv_d32);
+                real difCos = cosTeta123 - cosTeta0;
+
+                real expProduct = epsilonLambda * g1 * g2;
+                real radial = epsilonLambda * difCos * difCos;
+                real expTerm = 2.0 * expProduct * difCos;
+
+                force12 = radial * g2 * table1->getForceFactorSqr(d12Sqr) * r12 -
+                          expTerm * (e32 - e12 * cosTeta123) * inv_d12;
+                force32 = radial * g1 * table2->getForceFactorSqr(d32Sqr) * r32 -
+                          expTerm * (e12 - e32 * cosTeta123) * inv_d32;
+                return true;
+            }
+
             real inv_d12_a = 1.0 / (d12 - sigmarc1);
             real inv_d32_a = 1.0 / (d32 - sigmarc2);
 
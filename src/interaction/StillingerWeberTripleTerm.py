@@ -62,6 +62,19 @@ else
                 :type sigma: real
                 :type cutoff:
 
+.. function:: espressopp.interaction.StillingerWeberTripleTerm.tabulate(rmin, tolerance)
+
+                Tabulates the radial factors of both legs in :math:`r^2` between
+                *rmin* and the cutoffs, refining until the relative error is below
+                *tolerance*. The angular factor stays analytic. Changing any
+                parameter afterwards drops the tables again.
+
+                :param rmin: smallest distance in the table
+                :param tolerance: (default: 1e-6)
+                :type rmin: real
+                :type tolerance: real
+                :rtype: the largest relative error found
+
 .. function:: espressopp.interaction.VerletListStillingerWeberTripleTerm(system, vl3)
 
                 :param system:
@@ -142,6 +155,10 @@ class StillingerWeberTripleTermLocal(AngularPotentialLocal, interaction_Stilling
             cxxinit(self, interaction_StillingerWeberTripleTerm, gamma, gamma,
                     theta0, lmbd, epsilon, sigma, sigma, cutoff, cutoff)
 
+    def tabulate(self, rmin, tolerance=1e-6):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.tabulate(self, rmin, tolerance)
+
 class VerletListStillingerWeberTripleTermLocal(InteractionLocal, interaction_VerletListStillingerWeberTripleTerm):
 
     def __init__(self, system, vl3):
@@ -181,7 +198,8 @@ if pmi.isController:
           cls = 'espressopp.interaction.StillingerWeberTripleTermLocal',
           pmiproperty = [ 'gamma1', 'gamma2', 'theta0',
                           'lambda', 'epsilon', 'sigma1',
-                          'sigma2', 'cutoff1', 'cutoff2']
+                          'sigma2', 'cutoff1', 'cutoff2'],
+          pmicall = ['tabulate']
         )
 
     class VerletListStillingerWeberTripleTerm(Interaction, metaclass=pmi.Proxy):
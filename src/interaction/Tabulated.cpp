@@ -68,6 +68,44 @@ void Tabulated::setFilename(int itype, const char* _filename)
         table = std::make_shared<InterpolationCubic>();
         table->read(world, _filename);
     }
+
+    else if (itype == 4)
+    {  // sampled from a potential, which is not stored
+        throw std::runtime_error(
+            "Tabulated: interpolation type 4 is only used for tables sampled from a potential");
+    }
+
+    sqrTable.reset();
+    if (table && useSqrTable) sqrTable = std::make_shared<InterpolationSqr>(*table);
+}
+
+void Tabulated::setUseSqrTable(bool _useSqrTable)
+{
+    if (interpolationType == 4)
+    {
+        if (!_useSqrTable)
+            throw std::runtime_error("Tabulated: a table sampled from a potential is always in r^2");
+        return;
+    }
+    useSqrTable = _useSqrTable;
+    sqrTable.reset();
+    if (table && useSqrTable) sqrTable = std::make_shared<InterpolationSqr>(*table);
+}
+
+Tabulated::Tabulated(std::shared_ptr<Potential> potential, real rmin, real rmax, real tolerance)
+{
+    if (rmax <= 0.0) rmax = potential->getCutoff();
+    if (rmax == infinity)
+    {
+        throw std::runtime_error("Tabulated: rmax must be given for a potential without cutoff");
+    }
+
+    // the shift is already contained in the energy of the potential
+    sqrTable = std::make_shared<InterpolationSqr>(*potential, rmin, rmax, tolerance);
+    interpolationType = 4;
+    useSqrTable = true;
+    setShift(0.0);
+    setCutoff(rmax);
 }
 
 typedef class VerletListInteractionTemplate<Tabulated> VerletListTabulated;
@@ -94,7 +132,11 @@ void Tabulated::registerPython()
     using namespace espressopp::python;
 
     class_<Tabulated, bases<Potential> >("interaction_Tabulated", init<int, const char*, real>())
+        .def(init<int, const char*, real, bool>())
+        .def(init<std::shared_ptr<Potential>, real, real, real>())
         .add_property("filename", &Tabulated::getFilename, &Tabulated::setFilename)
+        .add_property("sqrTable", &Tabulated::getUseSqrTable, &Tabulated::setUseSqrTable)
+        .add_property("maxError", &Tabulated::getMaxError)
         .def_pickle(Tabulated_pickle());
 
     class_<VerletListTabulated, bases<Interaction> >("interaction_VerletListTabulated",
@@ -27,6 +27,7 @@
 //#include <stdexcept>
 #include "Potential.hpp"
 #include "Interpolation.hpp"
+#include "InterpolationSqr.hpp"
 
 namespace espressopp
 {
@@ -35,7 +36,11 @@ namespace interaction
 /** This class provides methods to compute forces and energies of
     a tabulated potential.
 
-    The potential and forces must be provided in a file.
+    The potential and forces must be provided in a file, or are sampled
+    once from another (expensive) pair potential, see the last constructor.
+    A file table is interpolated in r as read, unless useSqrTable is set,
+    which resamples it on a grid in r^2 (InterpolationSqr). Sampled tables
+    always use the r^2 grid.
 
     Be careful: default and copy constructor of this class are used.
 */
@@ -45,7 +50,9 @@ class Tabulated : public PotentialTemplate<Tabulated>
 private:
     std::string filename;
     std::shared_ptr<Interpolation> table;
+    std::shared_ptr<InterpolationSqr> sqrTable;  // used in the force loop if useSqrTable
     int interpolationType;
+    bool useSqrTable;
 
 public:
     static void registerPython();
@@ -55,12 +62,14 @@ public:
         setShift(0.0);
         setCutoff(infinity);
         interpolationType = 0;
+        useSqrTable = false;
         // std::cout << "using default tabulated potential ...\n";
     }
 
     // used for fixedpairlist (2-body bonded interaction)
     Tabulated(int itype, const char* filename)
     {
+        useSqrTable = false;
         setInterpolationType(itype);
         setFilename(itype, filename);
         setShift(0.0);
@@ -70,6 +79,7 @@ public:
 
     Tabulated(int itype, const char* filename, real cutoff)
     {
+        useSqrTable = false;
         setInterpolationType(itype);
         setFilename(itype, filename);
         setShift(0.0);
@@ -77,6 +87,21 @@ public:
         // std::cout << "using tabulated potential " << filename << "\n";
     }
 
+    Tabulated(int itype, const char* filename, real cutoff, bool _useSqrTable)
+    {
+        useSqrTable = _useSqrTable;
+        setInterpolationType(itype);
+        setFilename(itype, filename);
+        setShift(0.0);
+        setCutoff(cutoff);
+    }
+
+    /** Tabulate potential between rmin and rmax (its cutoff if rmax <= 0) with the
+        given relative accuracy of energy and force. The table replaces the
+        potential transparently, rmax becomes the cutoff and the shift of the
+        potential is contained in the tabulated energy. */
+    Tabulated(std::shared_ptr<Potential> potential, real rmin, real rmax, real tolerance);
+
     /** Setter for the interpolation type */
     void setInterpolationType(int itype) { interpolationType = itype; }
 
@@ -89,13 +114,23 @@ public:
     /** Getter for the filename. */
     const char* getFilename() const { return filename.c_str(); }
 
+    /** Look up a file table on a grid in r^2 instead of in r */
+    void setUseSqrTable(bool _useSqrTable);
+
+    bool getUseSqrTable() const { return useSqrTable; }
+
+    /** Largest relative error found when tabulating a potential, -1 for file tables */
+    real getMaxError() const { return sqrTable ? sqrTable->getMaxError() : -1.0; }
+
     real _computeEnergySqrRaw(real distSqr) const
     {
         // make an interpolation
-        if (interpolationType != 0)
-            return table->getEnergy(sqrt(distSqr));
-        else
+        if (interpolationType == 0)
             return 0;
+        else if (useSqrTable)
+            return sqrTable->getEnergySqr(distSqr);
+        else
+            return table->getEnergy(sqrt(distSqr));
         /*else {
             throw std::runtime_error("Tabulated potential table not available.");
             //return 0.0;
@@ -105,7 +140,11 @@ public:
     bool _computeForceRaw(Real3D& force, const Real3D& dist, real distSqr) const
     {
         real ffactor;
-        if (interpolationType != 0)
+        if (interpolationType != 0 && useSqrTable)
+        {
+            ffactor = sqrTable->getForceFactorSqr(distSqr);
+        }
+        else if (interpolationType != 0)
         {
             real distrt = sqrt(distSqr);
             ffactor = table->getForce(distrt);
@@ -130,7 +169,8 @@ struct Tabulated_pickle : boost::python::pickle_suite
         int itp = pot.getInterpolationType();
         std::string fn = pot.getFilename();
         real rc = pot.getCutoff();
-        return boost::python::make_tuple(itp, fn, rc);
+        bool sqr = pot.getUseSqrTable();
+        return boost::python::make_tuple(itp, fn, rc, sqr);
     }
 };
 
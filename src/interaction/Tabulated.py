@@ -29,16 +29,52 @@ espressopp.interaction.Tabulated
 ********************************
 
 
-.. function:: espressopp.interaction.Tabulated(itype, filename, cutoff)
+.. function:: espressopp.interaction.Tabulated(itype, filename, cutoff, sqrtable)
 
         Defines a tabulated potential.
 
         :param itype: interpolation type (1,2, or 3 for linear, Akima, or cubic splines)
         :param filename: table filename
         :param cutoff: (default: infinity) interaction cutoff
+        :param sqrtable: (default: False) look up the table in the squared distance
         :type itype: int
         :type filename: string
         :type cutoff: real or "infinity"
+        :type sqrtable: bool
+
+        With *sqrtable* the interpolated table is resampled on a grid in the
+        squared distance with 8 bins per point of the file. Forces and
+        energies are looked up in this grid, so no square root is taken.
+        They differ from the spline by the resampling error, and below the
+        first point of the file the first bin is extrapolated. The property
+        *sqrTable* switches this on and off.
+
+.. function:: espressopp.interaction.Tabulated(potential=potential, rmin=rmin, rmax=0.0, tolerance=1e-6)
+
+        Tabulates another pair potential once, e.g. an expensive analytic
+        one, and uses the table in its place.
+
+        :param potential: pair potential to tabulate
+        :param rmin: smallest distance of the table
+        :param rmax: (default: cutoff of potential) largest distance, becomes the cutoff
+        :param tolerance: (default: 1e-6) accuracy of energy and force
+        :type potential: Potential
+        :type rmin: real
+        :type rmax: real
+        :type tolerance: real
+
+        The number of bins is doubled until energy and force in the middle
+        of every bin deviate from the potential by less than *tolerance*,
+        relative to max(abs(value), 1). The error reached is in the property
+        *maxError*; a warning is logged if the tolerance could not be reached.
+        Below *rmin* the first bin is extrapolated. The energy contains the
+        shift of the potential.
+
+        >>> lj = espressopp.interaction.LennardJones(1.0, 1.0, cutoff=2.5, shift='auto')
+        >>> tab = espressopp.interaction.Tabulated(potential=lj, rmin=0.7, tolerance=1e-8)
+        >>> print(tab.maxError)
+        >>> interTab = espressopp.interaction.VerletListTabulated(vl)
+        >>> interTab.setPotential(type1=0, type2=0, potential=tab)
 
 .. function:: espressopp.interaction.VerletListAdressTabulated(vl, fixedtupleList)
 
@@ -609,10 +645,14 @@ from _espressopp import interaction_Tabulated, \
 
 class TabulatedLocal(PotentialLocal, interaction_Tabulated):
 
-    def __init__(self, itype, filename, cutoff=infinity):
+    def __init__(self, itype=None, filename=None, cutoff=infinity, sqrtable=False,
+                 potential=None, rmin=None, rmax=0.0, tolerance=1e-6):
 
         if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
-            cxxinit(self, interaction_Tabulated, itype, filename, cutoff)
+            if potential is not None:
+                cxxinit(self, interaction_Tabulated, potential, rmin, rmax, tolerance)
+            else:
+                cxxinit(self, interaction_Tabulated, itype, filename, cutoff, sqrtable)
 
 class VerletListAdressCGTabulatedLocal(InteractionLocal, interaction_VerletListAdressCGTabulated):
 
@@ -922,7 +962,7 @@ if pmi.isController:
         'The Tabulated potential.'
         pmiproxydefs = dict(
             cls = 'espressopp.interaction.TabulatedLocal',
-            pmiproperty = ['itype', 'filename', 'cutoff']
+            pmiproperty = ['itype', 'filename', 'cutoff', 'sqrTable', 'maxError']
             )
 
     class VerletListAdressCGTabulated(Interaction, metaclass=pmi.Proxy):
@@ -32,11 +32,19 @@
 #include "FixedTripleListInteractionTemplate.hpp"
 #include "FixedTripleListTypesInteractionTemplate.hpp"
 #include "FixedTripleListPIadressInteractionTemplate.hpp"
+#include <cmath>
+#include <vector>
 
 namespace espressopp
 {
 namespace interaction
 {
+namespace
+{
+// upper bound of the number of points of a sampled table
+const int maxNumPoints = (1 << 15) + 1;
+}  // namespace
+
 void TabulatedAngular::setFilename(int itype, const char* _filename)
 {
     boost::mpi::communicator world;
@@ -61,6 +69,49 @@ void TabulatedAngular::setFilename(int itype, const char* _filename)
     }
 }
 
+TabulatedAngular::TabulatedAngular(std::shared_ptr<AngularPotential> potential, real tolerance)
+{
+    std::shared_ptr<InterpolationCubic> cubic = std::make_shared<InterpolationCubic>();
+    std::vector<real> energy, force;
+
+    // refine until energy and force between the points are accurate enough
+    for (int numPoints = 65;; numPoints = 2 * numPoints - 1)
+    {
+        real delta = M_PI / (numPoints - 1);
+        energy.resize(numPoints);
+        force.resize(numPoints);
+        for (int i = 0; i < numPoints; i++)
+        {
+            energy[i] = potential->computeEnergy(i * delta);
+            force[i] = potential->computeForce(i * delta);
+        }
+        cubic->setValues(0.0, M_PI, energy, force);
+
+        maxError = 0.0;
+        for (int i = 0; i < numPoints - 1; i++)
+        {
+            real theta = (i + 0.5) * delta;
+            real e = potential->computeEnergy(theta);
+            real f = potential->computeForce(theta);
+            real errE = std::abs(cubic->getEnergy(theta) - e) / std::max(std::abs(e), 1.0);
+            real errF = std::abs(cubic->getForce(theta) - f) / std::max(std::abs(f), 1.0);
+            maxError = std::max(maxError, std::max(errE, errF));
+        }
+
+        if (maxError <= tolerance || numPoints >= maxNumPoints) break;
+    }
+
+    if (maxError > tolerance)
+    {
+        LOG4ESPP_WARN(theLogger, "tabulation error " << maxError << " above tolerance "
+                                                     << tolerance << " with " << energy.size()
+                                                     << " points");
+    }
+
+    table = cubic;
+    interpolationType = 3;
+}
+
 typedef class FixedTripleListInteractionTemplate<TabulatedAngular> FixedTripleListTabulatedAngular;
 typedef class FixedTripleListTypesInteractionTemplate<TabulatedAngular>
     FixedTripleListTypesTabulatedAngular;
@@ -76,7 +127,9 @@ void TabulatedAngular::registerPython()
 
     class_<TabulatedAngular, bases<AngularPotential> >("interaction_TabulatedAngular",
                                                        init<int, const char*>())
+        .def(init<std::shared_ptr<AngularPotential>, real>())
         .add_property("filename", &TabulatedAngular::getFilename, &TabulatedAngular::setFilename)
+        .add_property("maxError", &TabulatedAngular::getMaxError)
         .def_pickle(TabulatedAngular_pickle());
 
     class_<FixedTripleListTabulatedAngular, bases<Interaction> >(
@@ -33,35 +33,45 @@ namespace espressopp
 {
 namespace interaction
 {
+/** Angular potential interpolated from a table in theta. The table is read
+    from a file, or sampled once from another angular potential of theta
+    alone, see the last constructor.
+*/
 class TabulatedAngular : public AngularPotentialTemplate<TabulatedAngular>
 {
 private:
     std::string filename;
     std::shared_ptr<Interpolation> table;
     int interpolationType;
+    real maxError;
 
 public:
     static void registerPython();
 
-    TabulatedAngular()
+    TabulatedAngular() : maxError(-1.0)
     {
         // setCutoff(infinity);
         // std::cout << "using default tabulated potential ...\n";
     }
 
-    TabulatedAngular(int itype, const char* filename)
+    TabulatedAngular(int itype, const char* filename) : maxError(-1.0)
     {
         setFilename(itype, filename);
         setInterpolationType(itype);
     }
 
-    TabulatedAngular(int itype, const char* filename, real cutoff)
+    TabulatedAngular(int itype, const char* filename, real cutoff) : maxError(-1.0)
     {
         setFilename(itype, filename);
         setInterpolationType(itype);
         setCutoff(cutoff);
         std::cout << "using tabulated potential " << filename << "\n";
     }
+
+    /** Tabulate potential in [0, pi] with cubic splines. The number of points is
+        doubled until energy and force in the middle between the points are within
+        tolerance, relative to max(|value|, 1). */
+    TabulatedAngular(std::shared_ptr<AngularPotential> potential, real tolerance);
     /** Setter for the interpolation type */
     void setInterpolationType(int itype) { interpolationType = itype; }
 
@@ -72,6 +82,9 @@ public:
 
     const char* getFilename() const { return filename.c_str(); }
 
+    /** Largest relative error found when tabulating a potential, -1 for file tables */
+    real getMaxError() const { return maxError; }
+
     real _computeEnergyRaw(real theta) const
     {
         if (table)
@@ -35,6 +35,22 @@ espressopp.interaction.TabulatedAngular
                 :type itype: int
                 :type filename: str
 
+.. function:: espressopp.interaction.TabulatedAngular(potential=potential, tolerance=1e-6)
+
+                Tabulates another angular potential once, e.g. an expensive
+                analytic one, with cubic splines in [0, pi]. The number of
+                points is doubled until energy and force between the points
+                deviate from the potential by less than *tolerance*, relative
+                to max(abs(value), 1). The error reached is in the property
+                *maxError*. The potential must depend on the angle only, the
+                three-body terms of Stillinger-Weber and Tersoff have their own
+                *tabulate* method.
+
+                :param potential: angular potential to tabulate
+                :param tolerance: (default: 1e-6) accuracy of energy and force
+                :type potential: AngularPotential
+                :type tolerance: real
+
 .. function:: espressopp.interaction.FixedTripleListTabulatedAngular(system, ftl, potential)
 
                 :param system: The Espresso++ system object.
@@ -172,9 +188,12 @@ from _espressopp import interaction_TabulatedAngular, \
 
 
 class TabulatedAngularLocal(AngularPotentialLocal, interaction_TabulatedAngular):
-    def __init__(self, itype, filename):
+    def __init__(self, itype=None, filename=None, potential=None, tolerance=1e-6):
         if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
-            cxxinit(self, interaction_TabulatedAngular, itype, filename)
+            if potential is not None:
+                cxxinit(self, interaction_TabulatedAngular, potential, tolerance)
+            else:
+                cxxinit(self, interaction_TabulatedAngular, itype, filename)
 
 class FixedTripleListTabulatedAngularLocal(InteractionLocal, interaction_FixedTripleListTabulatedAngular):
 
@@ -261,7 +280,7 @@ if pmi.isController:
         'The TabulatedAngular potential.'
         pmiproxydefs = dict(
             cls = 'espressopp.interaction.TabulatedAngularLocal',
-            pmiproperty = ['itype', 'filename']
+            pmiproperty = ['itype', 'filename', 'maxError']
             )
 
     class FixedTripleListTabulatedAngular(Interaction, metaclass=pmi.Proxy):
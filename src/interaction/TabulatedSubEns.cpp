@@ -39,6 +39,7 @@ void TabulatedSubEns::setFilenames(int dim, int itype, boost::python::list _file
 {
     boost::mpi::communicator world;
     filenames.resize(dim);
+    sqrTables.resize(dim);
     colVarRef.setDimension(dim);
     numInteractions = dim;
     for (int i = 0; i < dim; ++i)
@@ -62,6 +63,10 @@ void TabulatedSubEns::setFilenames(int dim, int itype, boost::python::list _file
             tables[i] = std::make_shared<InterpolationCubic>();
             tables[i]->read(world, filenames[i].c_str());
         }
+
+        sqrTables[i].reset();
+        if (tables[i] && useSqrTable)
+            sqrTables[i] = std::make_shared<InterpolationSqr>(*tables[i]);
     }
 }
 
@@ -94,6 +99,19 @@ void TabulatedSubEns::addInteraction(int itype, boost::python::str fname, const
         tables.push_back(std::make_shared<InterpolationCubic>());
         tables[i]->read(world, filenames[i].c_str());
     }
+    sqrTables.push_back(useSqrTable ? std::make_shared<InterpolationSqr>(*tables[i])
+                                    : std::shared_ptr<InterpolationSqr>());
+}
+
+void TabulatedSubEns::setUseSqrTable(bool _useSqrTable)
+{
+    useSqrTable = _useSqrTable;
+    for (int i = 0; i < numInteractions; ++i)
+    {
+        sqrTables[i].reset();
+        if (tables[i] && useSqrTable)
+            sqrTables[i] = std::make_shared<InterpolationSqr>(*tables[i]);
+    }
 }
 
 void TabulatedSubEns::setColVarRef(const RealNDs &cvRefs)
@@ -279,6 +297,8 @@ void TabulatedSubEns::registerPython()
         .def("weight_set", &TabulatedSubEns::setWeight)
         .def("alpha_get", &TabulatedSubEns::getAlpha)
         .def("alpha_set", &TabulatedSubEns::setAlpha)
+        .def("sqrTable_get", &TabulatedSubEns::getUseSqrTable)
+        .def("sqrTable_set", &TabulatedSubEns::setUseSqrTable)
         .def("addInteraction", &TabulatedSubEns::addInteraction)
         .def("colVarRefs_get", &TabulatedSubEns::getColVarRefs)
         .def("colVarRef_get", &TabulatedSubEns::getColVarRef)
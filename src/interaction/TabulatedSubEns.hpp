@@ -25,6 +25,7 @@
 //#include <stdexcept>
 #include "Potential.hpp"
 #include "Interpolation.hpp"
+#include "InterpolationSqr.hpp"
 #include "RealND.hpp"
 #include "bc/BC.hpp"
 
@@ -35,7 +36,8 @@ namespace interaction
 /** This class provides methods to compute forces and energies of
     a tabulated potential.
 
-    The potential and forces must be provided in a file.
+    The potential and forces must be provided in a file. With useSqrTable
+    set the tables are resampled on a grid in r^2 (InterpolationSqr).
 
     Be careful: default and copy constructor of this class are used.
 */
@@ -46,7 +48,9 @@ private:
     int numInteractions;
     std::vector<std::string> filenames;
     std::vector<std::shared_ptr<Interpolation>> tables;
+    std::vector<std::shared_ptr<InterpolationSqr>> sqrTables;  // used if useSqrTable
     int interpolationType;
+    bool useSqrTable;
     // Reference values of the collective variable centers
     RealNDs colVarRef;
     // Weights of each table
@@ -81,6 +85,7 @@ public:
         colVarBondListSize = 0;
         colVarAngleListSize = 0;
         colVarDihedListSize = 0;
+        useSqrTable = false;
     }
 
     void addInteraction(int itype, boost::python::str fname, const RealND& _cvref);
@@ -90,6 +95,7 @@ public:
         numInteractions = _dim;
         colVarRef.setDimension(numInteractions);
         tables.resize(numInteractions);
+        sqrTables.resize(numInteractions);
         filenames.resize(numInteractions);
         weights.setDimension(numInteractions);
         weightSum.setDimension(numInteractions);
@@ -144,6 +150,11 @@ public:
 
     real getAlpha() const { return alpha; }
 
+    /** Look up the tables on a grid in r^2 instead of in r */
+    void setUseSqrTable(bool _useSqrTable);
+
+    bool getUseSqrTable() const { return useSqrTable; }
+
     void setAlpha(real _r) { alpha = _r; }
 
     void computeColVarWeights(const Real3D& dist, const bc::BC& bc);
@@ -153,6 +164,12 @@ public:
     real _computeEnergySqrRaw(real distSqr) const
     {
         real e = 0.;
+        if (useSqrTable)
+        {
+            for (int i = 0; i < numInteractions; ++i)
+                e += weights[i] * sqrTables[i]->getEnergySqr(distSqr);
+            return e;
+        }
         for (int i = 0; i < numInteractions; ++i)
             e += weights[i] * tables[i]->getEnergy(sqrt(distSqr));
         return e;
@@ -161,9 +178,17 @@ public:
     bool _computeForceRaw(Real3D& force, const Real3D& dist, real distSqr) const
     {
         real ffactor = 0;
-        real distrt = sqrt(distSqr);
-        for (int i = 0; i < numInteractions; ++i)
-            ffactor += weights[i] * tables[i]->getForce(distrt) / distrt;
+        if (useSqrTable)
+        {
+            for (int i = 0; i < numInteractions; ++i)
+                ffactor += weights[i] * sqrTables[i]->getForceFactorSqr(distSqr);
+        }
+        else
+        {
+            real distrt = sqrt(distSqr);
+            for (int i = 0; i < numInteractions; ++i)
+                ffactor += weights[i] * tables[i]->getForce(distrt) / distrt;
+        }
         force = dist * ffactor;
         return true;
     }
@@ -32,6 +32,16 @@ espressopp.interaction.TabulatedSubEns
                 :type filename:
                 :type cutoff:
 
+.. function:: espressopp.interaction.TabulatedSubEns.sqrTable_set(flag)
+
+                Look up the tables on a grid in the squared distance with 8
+                bins per point of the file, instead of interpolating them in
+                the distance. This saves the square root per pair; energy and
+                force then differ from the spline by the resampling error.
+
+                :param flag: (default: False)
+                :type flag: bool
+
 .. function:: espressopp.interaction.VerletListAdressTabulatedSubEns(vl, fixedtupleList)
 
                 :param vl:
@@ -263,7 +273,8 @@ if pmi.isController:
         pmiproxydefs = dict(
             cls = 'espressopp.interaction.TabulatedSubEnsLocal',
             pmicall = ['weight_get', 'weight_set',
-                       'alpha_get', 'alpha_set', 'targetProb_get', 'targetProb_set',
+                       'alpha_get', 'alpha_set', 'sqrTable_get', 'sqrTable_set',
+                       'targetProb_get', 'targetProb_set',
                                        'colVarSd_get', 'colVarSd_set',
                                        'dimension_get', 'filenames_get', 'filename_get',
                                        'filename_set', 'addInteraction', 'colVarRefs_get',
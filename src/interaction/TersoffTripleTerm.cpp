@@ -26,10 +26,24 @@
 #include "VerletListTripleInteractionTemplate.hpp"
 #include "FixedTripleListInteractionTemplate.hpp"
 
+#include <memory>
+
 namespace espressopp
 {
 namespace interaction
 {
+real TersoffTripleTerm::tabulate(real rmin, real tolerance)
+{
+    real B_ = B, lambda2_ = lambda2;
+    tableA = std::make_shared<InterpolationSqr>(
+        [B_, lambda2_](real r, real& fA, real& ffactor) {
+            fA = -B_ * exp(-lambda2_ * r);
+            ffactor = lambda2_ * fA / r;
+        },
+        rmin, R + D, tolerance);
+    return tableA->getMaxError();
+}
+
 //////////////////////////////////////////////////
 // REGISTRATION WITH PYTHON
 //////////////////////////////////////////////////
@@ -56,7 +70,8 @@ void TersoffTripleTerm::registerPython()
         .add_property("d", &TersoffTripleTerm::getd, &TersoffTripleTerm::setd)
         .add_property("theta0", &TersoffTripleTerm::getTheta0, &TersoffTripleTerm::setTheta0)
         .add_property("cutoff1", &TersoffTripleTerm::getCutoff1, &TersoffTripleTerm::setCutoff1)
-        .add_property("cutoff2", &TersoffTripleTerm::getCutoff2, &TersoffTripleTerm::setCutoff2);
+        .add_property("cutoff2", &TersoffTripleTerm::getCutoff2, &TersoffTripleTerm::setCutoff2)
+        .def("tabulate", &TersoffTripleTerm::tabulate);
 
     class_<VerletListTersoffTripleTerm, bases<Interaction> >(
         "interaction_VerletListTersoffTripleTerm",
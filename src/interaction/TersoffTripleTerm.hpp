@@ -25,6 +25,7 @@
 #define _INTERACTION_TERSOFFTRIPLETERM_HPP
 
 #include "AngularPotential.hpp"
+#include "InterpolationSqr.hpp"
 #include <cmath>
 
 #ifndef M_PIl
@@ -37,6 +38,10 @@ namespace interaction
 {
 /* This class provides methods to compute forces and energies of
    the TersoffTripleTerm potential.
+
+   The attractive factor fA(r) = -B exp(-lambda2 r) of the first leg can be
+   tabulated in r^2, see tabulate(). The cutoff function and the bond order
+   stay analytic. Setting a parameter drops the table.
  */
 class TersoffTripleTerm : public AngularPotentialTemplate<TersoffTripleTerm>
 {
@@ -63,6 +68,9 @@ private:
     real c2, d2, Pi_2D, cosTheta0;
     real rc1, rc2;
 
+    // fA in r^2, none if computed analytically
+    std::shared_ptr<InterpolationSqr> tableA;
+
 public:
     static void registerPython();
 
@@ -192,8 +200,14 @@ public:
         // convert degrees to radians
         theta0 = theta0 * M_PIl / 180;
         cosTheta0 = cos(theta0);
+
+        tableA.reset();
     }
 
+    /** Tabulate fA between rmin and R + D with the given relative accuracy,
+        returns the largest error found. */
+    real tabulate(real rmin, real tolerance);
+
     real _computeEnergy(const Real3D& r12, const Real3D& r32) const
     {
         // 2 is central particle
@@ -206,7 +220,7 @@ public:
             return 0.0;
         else
         {
-            real fA = -B * exp(-lambda2 * d12);
+            real fA = tableA ? tableA->getEnergySqr(d12 * d12) : -B * exp(-lambda2 * d12);
             real fC_j = 0.0;
             real fC_k = 0.0;
             if (d12 < R - D)
@@ -257,8 +271,19 @@ public:
             Real3D e12 = r12 * inv_d12;
             Real3D e32 = r32 * inv_d32;
 
-            real fA = -B * exp(-lambda2 * d12);
-            Real3D D12_fA = -lambda2 * fA * e12;
+            real fA;
+            Real3D D12_fA;
+            if (tableA)
+            {
+                real d12Sqr = d12 * d12;
+                fA = tableA->getEnergySqr(d12Sqr);
+                D12_fA = -tableA->getForceFactorSqr(d12Sqr) * r12;
+            }
+            else
+            {
+                fA = -B * exp(-lambda2 * d12);
+                D12_fA = -lambda2 * fA * e12;
+            }
             real fC_j = 0.0;
             Real3D D12_fC_j = 0.0;
             if (d12 < R - D)
@@ -41,6 +41,19 @@ the Tersoff Triple Term potential.
 
 
 
+.. function:: espressopp.interaction.TersoffTripleTerm.tabulate(rmin, tolerance)
+
+                Tabulates :math:`f_A(r) = -B e^{-\lambda_2 r}` in :math:`r^2` between
+                *rmin* and :math:`R + D`, refining until the relative error is below
+                *tolerance*. The cutoff function and the bond order stay analytic.
+                Changing any parameter afterwards drops the table again.
+
+                :param rmin: smallest distance in the table
+                :param tolerance: (default: 1e-6)
+                :type rmin: real
+                :type tolerance: real
+                :rtype: the largest relative error found
+
 .. function:: espressopp.interaction.VerletListTersoffTripleTerm(system, vl3)
 
                 :param system:
@@ -121,6 +134,10 @@ class TersoffTripleTermLocal(AngularPotentialLocal, interaction_TersoffTripleTer
                     n, beta, m, lambda3, gamma,
                     c, d, theta0, cutoff1, cutoff2)
 
+    def tabulate(self, rmin, tolerance=1e-6):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.tabulate(self, rmin, tolerance)
+
 ##  def __init__(self, gamma=0.0, theta0=0.0, lmbd=0.0, epsilon=1.0, sigma=1.0, cutoff=infinity):
 ##    """Initialize the local TersoffTripleTerm object."""
 ##    if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
@@ -169,7 +186,8 @@ if pmi.isController:
     ##                      'sigma2', 'cutoff1', 'cutoff2']
           pmiproperty = [ 'B', 'lambda2', 'R', 'D',
                           'n', 'beta', 'm', 'lambda3',
-                          'c', 'd', 'theta0', 'cutoff1', 'cutoff2']
+                          'c', 'd', 'theta0', 'cutoff1', 'cutoff2'],
+          pmicall = ['tabulate']
         )
 
     class VerletListTersoffTripleTerm(Interaction, metaclass=pmi.Proxy):
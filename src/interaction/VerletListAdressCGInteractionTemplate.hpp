@@ -190,8 +190,8 @@ inline void VerletListAdressCGInteractionTemplate<_Potential>::addForces()
     // calculate CG forces/velocities and distribute them to AT particles. In contrast, in H-AdResS,
     // we calculate AT forces from intra-molecular interactions and inter-molecular center-of-mass
     // interactions and just update the positions of the center-of-mass CG particles.
-    std::set<Particle *> cgZone = verletList->getCGZone();
-    for (std::set<Particle *>::iterator it = cgZone.begin(); it != cgZone.end(); ++it)
+    const std::vector<Particle *> &cgZone = verletList->getCGZone();
+    for (std::vector<Particle *>::const_iterator it = cgZone.begin(); it != cgZone.end(); ++it)
     {
         Particle &vp = **it;
 
@@ -224,15 +224,15 @@ inline void VerletListAdressCGInteractionTemplate<_Potential>::addForces()
 template <typename _Potential>
 inline real VerletListAdressCGInteractionTemplate<_Potential>::computeEnergy()
 {
-    std::set<Particle *> cgZone = verletList->getCGZone();
-    for (std::set<Particle *>::iterator it = cgZone.begin(); it != cgZone.end(); ++it)
+    const std::vector<Particle *> &cgZone = verletList->getCGZone();
+    for (std::vector<Particle *>::const_iterator it = cgZone.begin(); it != cgZone.end(); ++it)
     {
         Particle &vp = **it;
         vp.lambda() = 0.0;
     }
 
-    std::set<Particle *> adrZone = verletList->getAdrZone();
-    for (std::set<Particle *>::iterator it = adrZone.begin(); it != adrZone.end(); ++it)
+    const std::vector<Particle *> &adrZone = verletList->getAdrZone();
+    for (std::vector<Particle *>::const_iterator it = adrZone.begin(); it != adrZone.end(); ++it)
     {
         Particle &vp = **it;
 
@@ -0,0 +1,393 @@
+/*
+  Copyright (C) 2012,2013,2014,2015,2016,2017,2018
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ESPP_CLASS
+#ifndef _INTERACTION_VERLETLISTCOMBINEDINTERACTIONTEMPLATE_HPP
+#define _INTERACTION_VERLETLISTCOMBINEDINTERACTIONTEMPLATE_HPP
+
+#include "types.hpp"
+#include "Interaction.hpp"
+#include "Real3D.hpp"
+#include "Tensor.hpp"
+#include "Particle.hpp"
+#include "VerletList.hpp"
+#include "esutil/Array2D.hpp"
+#include "bc/BC.hpp"
+
+#include "storage/Storage.hpp"
+
+namespace espressopp
+{
+namespace interaction
+{
+/** Two potentials evaluated in one traversal of a common Verlet list.
+
+    Equivalent to two VerletListInteractionTemplate instances on the same
+    list, but each pair is loaded and its forces are written only once. Every
+    potential applies its own cutoff, so the list has to be built for the
+    larger one.
+*/
+template <typename _Potential1, typename _Potential2>
+class VerletListCombinedInteractionTemplate : public Interaction
+{
+protected:
+    typedef _Potential1 Potential1;
+    typedef _Potential2 Potential2;
+
+public:
+    VerletListCombinedInteractionTemplate(std::shared_ptr<VerletList> _verletList)
+        : verletList(_verletList)
+    {
+        potentialArray1 = esutil::Array2D<Potential1, esutil::enlarge>(0, 0, Potential1());
+        potentialArray2 = esutil::Array2D<Potential2, esutil::enlarge>(0, 0, Potential2());
+        ntypes = 0;
+    }
+
+    virtual ~VerletListCombinedInteractionTemplate(){};
+
+    void setVerletList(std::shared_ptr<VerletList> _verletList) { verletList = _verletList; }
+
+    std::shared_ptr<VerletList> getVerletList() { return verletList; }
+
+    void setPotential1(int type1, int type2, const Potential1 &potential)
+    {
+        ntypes = std::max(ntypes, std::max(type1 + 1, type2 + 1));
+        potentialArray1.at(type1, type2) = potential;
+        potentialArray1.at(type2, type1) = potential;
+        // keep both arrays at the same size
+        potentialArray2.at(type1, type2);
+    }
+
+    void setPotential2(int type1, int type2, const Potential2 &potential)
+    {
+        ntypes = std::max(ntypes, std::max(type1 + 1, type2 + 1));
+        potentialArray2.at(type1, type2) = potential;
+        potentialArray2.at(type2, type1) = potential;
+        potentialArray1.at(type1, type2);
+    }
+
+    Potential1 &getPotential1(int type1, int type2) { return potentialArray1.at(type1, type2); }
+
+    Potential2 &getPotential2(int type1, int type2) { return potentialArray2.at(type1, type2); }
+
+    virtual void addForces();
+    virtual real computeEnergy();
+    virtual real computeEnergyDeriv();
+    virtual real computeEnergyAA();
+    virtual real computeEnergyCG();
+    virtual real computeEnergyAA(int atomtype);
+    virtual real computeEnergyCG(int atomtype);
+    virtual void computeVirialX(std::vector<real> &p_xx_total, int bins);
+    virtual real computeVirial();
+    virtual void computeVirialTensor(Tensor &w);
+    virtual void computeVirialTensor(Tensor &w, real z);
+    virtual void computeVirialTensor(Tensor *w, int n);
+    virtual real getMaxCutoff();
+    virtual int bondType() { return Nonbonded; }
+
+protected:
+    /// sum of the forces of both potentials, false if the pair is beyond both cutoffs
+    inline bool computeForce(Real3D &force, const Particle &p1, const Particle &p2) const
+    {
+        const int type1 = p1.type();
+        const int type2 = p2.type();
+        Real3D force2(0.0);
+        bool inside1 = potentialArray1(type1, type2)._computeForce(force, p1, p2);
+        bool inside2 = potentialArray2(type1, type2)._computeForce(force2, p1, p2);
+        if (!inside1) force = force2;
+        else if (inside2) force += force2;
+        return inside1 || inside2;
+    }
+
+    /// force loop over the CSR layout of the verlet list
+    void addForcesCSR();
+
+    int ntypes;
+    std::shared_ptr<VerletList> verletList;
+    esutil::Array2D<Potential1, esutil::enlarge> potentialArray1;
+    esutil::Array2D<Potential2, esutil::enlarge> potentialArray2;
+};
+
+//////////////////////////////////////////////////
+// INLINE IMPLEMENTATION
+//////////////////////////////////////////////////
+template <typename _Potential1, typename _Potential2>
+inline void VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::addForces()
+{
+    LOG4ESPP_DEBUG(_Potential1::theLogger, "loop over verlet list pairs and add forces");
+
+    int vlmaxtype = verletList->getMaxType();
+    // force a resize
+    potentialArray1.at(vlmaxtype, vlmaxtype);
+    potentialArray2.at(vlmaxtype, vlmaxtype);
+
+    System &system = verletList->getSystemRef();
+    if (system.shearOffset != .0 && system.ifViscosity)
+    {
+        // as in VerletListInteractionTemplate, the xz-/zx- components of the stress tensor
+        // need the minimum image across the sheared boundary
+        real Lx = system.bc->getBoxL()[0];
+        real Lz = system.bc->getBoxL()[2];
+        real offs = system.shearOffset;
+
+        for (PairList::Iterator it(verletList->getPairs()); it.isValid(); ++it)
+        {
+            Particle &p1 = *it->first;
+            Particle &p2 = *it->second;
+
+            Real3D dist;
+            Real3D dist_tmp(.0);
+            if (p1.position()[2] - p2.position()[2] > Lz / 2.0)
+            {
+                dist_tmp[0] = -offs;
+                int xtmp = static_cast<int>(
+                    floor((p1.position()[0] + dist_tmp[0] - p2.position()[0]) / Lx + 0.5));
+                dist_tmp[0] -= (xtmp + .0) * Lx;
+            }
+            else if (p1.position()[2] - p2.position()[2] < -Lz / 2.0)
+            {
+                dist_tmp[0] = offs;
+                int xtmp = static_cast<int>(
+                    floor((p1.position()[0] + dist_tmp[0] - p2.position()[0]) / Lx + 0.5));
+                dist_tmp[0] -= (xtmp + .0) * Lx;
+            }
+            system.bc->getMinimumImageVectorBox(dist, p1.position() + dist_tmp, p2.position());
+
+            Real3D force(0.0);
+            if (computeForce(force, p1, p2))
+            {
+                p1.force() += force;
+                p2.force() -= force;
+
+                system.dyadicP_xz += dist[0] * force[2];
+                system.dyadicP_zx += dist[2] * force[0];
+            }
+        }
+    }
+    else if (verletList->getUseCSR())
+    {
+        addForcesCSR();
+    }
+    else
+    {
+        for (PairList::Iterator it(verletList->getPairs()); it.isValid(); ++it)
+        {
+            Particle &p1 = *it->first;
+            Particle &p2 = *it->second;
+
+            Real3D force(0.0);
+            if (computeForce(force, p1, p2))
+            {
+                p1.force() += force;
+                p2.force() -= force;
+                LOG4ESPP_TRACE(_Potential1::theLogger,
+                               "id1=" << p1.id() << " id2=" << p2.id() << " force=" << force);
+            }
+        }
+    }
+}
+
+template <typename _Potential1, typename _Potential2>
+inline void VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::addForcesCSR()
+{
+    const std::vector<Particle *> &first = verletList->getCSRParticles();
+    const std::vector<size_t> &offsets = verletList->getCSROffsets();
+    const std::vector<Particle *> &neighbors = verletList->getCSRNeighbors();
+
+    for (size_t i = 0; i < first.size(); ++i)
+    {
+        Particle &p1 = *first[i];
+        Real3D force1(0.0);
+
+        for (size_t j = offsets[i], end = offsets[i + 1]; j < end; ++j)
+        {
+            Particle &p2 = *neighbors[j];
+
+            Real3D force(0.0);
+            if (computeForce(force, p1, p2))
+            {
+                force1 += force;
+                p2.force() -= force;
+            }
+        }
+        p1.force() += force1;
+    }
+}
+
+template <typename _Potential1, typename _Potential2>
+inline real VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeEnergy()
+{
+    LOG4ESPP_DEBUG(_Potential1::theLogger,
+                   "loop over verlet list pairs and sum up potential energies");
+
+    real es = 0.0;
+    for (PairList::Iterator it(verletList->getPairs()); it.isValid(); ++it)
+    {
+        Particle &p1 = *it->first;
+        Particle &p2 = *it->second;
+        int type1 = p1.type();
+        int type2 = p2.type();
+        es += potentialArray1(type1, type2)._computeEnergy(p1, p2);
+        es += potentialArray2(type1, type2)._computeEnergy(p1, p2);
+    }
+
+    // reduce over all CPUs
+    real esum;
+    boost::mpi::all_reduce(*getVerletList()->getSystem()->comm, es, esum, std::plus<real>());
+    return esum;
+}
+
+template <typename _Potential1, typename _Potential2>
+inline real VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeEnergyDeriv()
+{
+    LOG4ESPP_WARN(_Potential1::theLogger, "Warning! computeEnergyDeriv() is not yet implemented.");
+    return 0.0;
+}
+
+template <typename _Potential1, typename _Potential2>
+inline real VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeEnergyAA()
+{
+    LOG4ESPP_WARN(_Potential1::theLogger, "Warning! computeEnergyAA() is not yet implemented.");
+    return 0.0;
+}
+
+template <typename _Potential1, typename _Potential2>
+inline real VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeEnergyAA(
+    int atomtype)
+{
+    LOG4ESPP_WARN(_Potential1::theLogger,
+                  "Warning! computeEnergyAA(int atomtype) is not yet implemented.");
+    return 0.0;
+}
+
+template <typename _Potential1, typename _Potential2>
+inline real VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeEnergyCG()
+{
+    LOG4ESPP_WARN(_Potential1::theLogger, "Warning! computeEnergyCG() is not yet implemented.");
+    return 0.0;
+}
+
+template <typename _Potential1, typename _Potential2>
+inline real VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeEnergyCG(
+    int atomtype)
+{
+    LOG4ESPP_WARN(_Potential1::theLogger,
+                  "Warning! computeEnergyCG(int atomtype) is not yet implemented.");
+    return 0.0;
+}
+
+template <typename _Potential1, typename _Potential2>
+inline void VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeVirialX(
+    std::vector<real> &p_xx_total, int bins)
+{
+    LOG4ESPP_WARN(_Potential1::theLogger, "Warning! computeVirialX() is not yet implemented.");
+}
+
+template <typename _Potential1, typename _Potential2>
+inline real VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeVirial()
+{
+    LOG4ESPP_DEBUG(_Potential1::theLogger, "loop over verlet list pairs and sum up virial");
+
+    real w = 0.0;
+    for (PairList::Iterator it(verletList->getPairs()); it.isValid(); ++it)
+    {
+        Particle &p1 = *it->first;
+        Particle &p2 = *it->second;
+
+        Real3D force(0.0, 0.0, 0.0);
+        if (computeForce(force, p1, p2))
+        {
+            Real3D r21 = p1.position() - p2.position();
+            w = w + r21 * force;
+        }
+    }
+
+    // reduce over all CPUs
+    real wsum;
+    boost::mpi::all_reduce(*mpiWorld, w, wsum, std::plus<real>());
+    return wsum;
+}
+
+template <typename _Potential1, typename _Potential2>
+inline void VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeVirialTensor(
+    Tensor &w)
+{
+    LOG4ESPP_DEBUG(_Potential1::theLogger, "loop over verlet list pairs and sum up virial tensor");
+
+    Tensor wlocal(0.0);
+    for (PairList::Iterator it(verletList->getPairs()); it.isValid(); ++it)
+    {
+        Particle &p1 = *it->first;
+        Particle &p2 = *it->second;
+
+        Real3D force(0.0, 0.0, 0.0);
+        if (computeForce(force, p1, p2))
+        {
+            Real3D r21 = p1.position() - p2.position();
+            wlocal += Tensor(r21, force);
+        }
+    }
+
+    // reduce over all CPUs
+    Tensor wsum(0.0);
+    boost::mpi::all_reduce(*mpiWorld, (double *)&wlocal, 6, (double *)&wsum, std::plus<double>());
+    w += wsum;
+}
+
+template <typename _Potential1, typename _Potential2>
+inline void VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeVirialTensor(
+    Tensor &w, real z)
+{
+    LOG4ESPP_WARN(_Potential1::theLogger,
+                  "Warning! computeVirialTensor(Tensor &w, real z) is not yet implemented, "
+                  "use separate interactions for the local pressure tensor.");
+}
+
+template <typename _Potential1, typename _Potential2>
+inline void VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::computeVirialTensor(
+    Tensor *w, int n)
+{
+    LOG4ESPP_WARN(_Potential1::theLogger,
+                  "Warning! computeVirialTensor(Tensor *w, int n) is not yet implemented, "
+                  "use separate interactions for the local pressure tensor.");
+}
+
+template <typename _Potential1, typename _Potential2>
+inline real VerletListCombinedInteractionTemplate<_Potential1, _Potential2>::getMaxCutoff()
+{
+    // a type pair set for one potential only leaves the default of the other one, whose
+    // cutoff is infinite; no pair beyond the cutoff of the verlet list is ever seen
+    const real vlCutoff = verletList->getVerletCutoff() - verletList->getSystemRef().getSkin();
+    real cutoff = 0.0;
+    for (int i = 0; i < ntypes; i++)
+    {
+        for (int j = 0; j < ntypes; j++)
+        {
+            cutoff = std::max(cutoff, std::min(vlCutoff, getPotential1(i, j).getCutoff()));
+            cutoff = std::max(cutoff, std::min(vlCutoff, getPotential2(i, j).getCutoff()));
+        }
+    }
+    return cutoff;
+}
+}  // namespace interaction
+}  // namespace espressopp
+#endif
@@ -0,0 +1,144 @@
+/*
+  Copyright (C) 2012,2013,2014,2015,2016,2017,2018
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// ESPP_CLASS
+#ifndef _INTERACTION_VERLETLISTDPDINTERACTIONTEMPLATE_HPP
+#define _INTERACTION_VERLETLISTDPDINTERACTIONTEMPLATE_HPP
+
+#include "types.hpp"
+#include "VerletListInteractionTemplate.hpp"
+#include "integrator/DPDThermostat.hpp"
+
+namespace espressopp
+{
+namespace interaction
+{
+/** Verlet list interaction that evaluates the DPD dissipative and random
+    pair forces of a DPDThermostat in the same pair traversal as the
+    conservative potential.
+
+    The thermostat is switched to fused mode while the interaction is part
+    of the system: it no longer loops over the Verlet list at aftInitF and no
+    longer calls updateGhostsV(), the ghost velocities are sent together with
+    the positions in updateGhosts() instead. After System::removeInteraction()
+    the thermostat does its own pass again. Both have to use the same
+    VerletList.
+*/
+template <typename _Potential>
+class VerletListDPDInteractionTemplate : public VerletListInteractionTemplate<_Potential>
+{
+protected:
+    typedef _Potential Potential;
+    typedef VerletListInteractionTemplate<_Potential> Super;
+
+public:
+    VerletListDPDInteractionTemplate(std::shared_ptr<VerletList> _verletList,
+                                     std::shared_ptr<integrator::DPDThermostat> _thermostat)
+        : Super(_verletList), thermostat(_thermostat)
+    {
+        if (thermostat->getVerletList() != _verletList)
+        {
+            throw std::runtime_error(
+                "VerletListDPDInteractionTemplate: the DPD thermostat has to use the same "
+                "VerletList as the interaction");
+        }
+    }
+
+    virtual ~VerletListDPDInteractionTemplate()
+    {
+        if (attached) thermostat->detachFused();
+    }
+
+    std::shared_ptr<integrator::DPDThermostat> getThermostat() { return thermostat; }
+
+    virtual void addForces();
+
+    virtual void addedToSystem()
+    {
+        thermostat->attachFused();
+        attached = true;
+    }
+
+    virtual void removedFromSystem()
+    {
+        if (attached) thermostat->detachFused();
+        attached = false;
+    }
+
+protected:
+    std::shared_ptr<integrator::DPDThermostat> thermostat;
+    bool attached = false;
+};
+
+//////////////////////////////////////////////////
+// INLINE IMPLEMENTATION
+//////////////////////////////////////////////////
+template <typename _Potential>
+inline void VerletListDPDInteractionTemplate<_Potential>::addForces()
+{
+    LOG4ESPP_DEBUG(_Potential::theLogger,
+                   "loop over verlet list pairs and add conservative and DPD forces");
+
+    System &system = this->verletList->getSystemRef();
+    integrator::DPDThermostat &dpd = *thermostat;
+
+    if (system.shearOffset != .0 && system.ifViscosity)
+    {
+        // the stress tensor bookkeeping lives in the plain template
+        Super::addForces();
+        for (PairList::Iterator it(this->verletList->getPairs()); it.isValid(); ++it)
+        {
+            Particle &p1 = *it->first;
+            Particle &p2 = *it->second;
+            Real3D r = p1.position() - p2.position();
+            dpd.thermalizePair(p1, p2, r, r.sqr());
+        }
+        return;
+    }
+
+    int vlmaxtype = this->verletList->getMaxType();
+    Potential max_pot = this->potentialArray.at(vlmaxtype, vlmaxtype);  // force a resize
+
+    for (PairList::Iterator it(this->verletList->getPairs()); it.isValid(); ++it)
+    {
+        Particle &p1 = *it->first;
+        Particle &p2 = *it->second;
+        int type1 = p1.type();
+        int type2 = p2.type();
+        const Potential &potential = this->potentialArray(type1, type2);
+
+        Real3D force(0.0);
+        if (potential._computeForce(force, p1, p2))
+        {
+            p1.force() += force;
+            p2.force() -= force;
+            LOG4ESPP_TRACE(_Potential::theLogger,
+                           "id1=" << p1.id() << " id2=" << p2.id() << " force=" << force);
+        }
+
+        Real3D r = p1.position() - p2.position();
+        dpd.thermalizePair(p1, p2, r, r.sqr());
+    }
+}
+}  // namespace interaction
+}  // namespace espressopp
+#endif
@@ -159,8 +159,8 @@ protected:
     boost::unordered_map<Particle *, real>
         energydiff;  // Energydifference V_AA - V_CG map for particles in hybrid region for drift
                      // term calculation in H-AdResS
-    std::set<Particle *> adrZone;  // Virtual particles in AdResS zone (HY and AT region)
-    std::set<Particle *> cgZone;
+    std::vector<Particle *> adrZone;  // Virtual particles in AdResS zone (HY and AT region)
+    std::vector<Particle *> cgZone;
 };
 
 //////////////////////////////////////////////////
@@ -172,10 +172,9 @@ VerletListHadressATATCGInteractionTemplate<_PotentialAT1, _PotentialAT2, _Potent
 {
     LOG4ESPP_INFO(theLogger, "add forces computed by the Verlet List");
 
-    std::set<Particle *> cgZone = verletList->getCGZone();
-    std::set<Particle *> adrZone = verletList->getAdrZone();
+    const std::vector<Particle *> &adrZone = verletList->getAdrZone();
 
-    for (std::set<Particle *>::iterator it = adrZone.begin(); it != adrZone.end(); ++it)
+    for (std::vector<Particle *>::const_iterator it = adrZone.begin(); it != adrZone.end(); ++it)
     {
         Particle &p = **it;
         // intitialize energy diff AA-CG
@@ -346,7 +345,7 @@ VerletListHadressATATCGInteractionTemplate<_PotentialAT1, _PotentialAT2, _Potent
 
     // H-AdResS - Drift Term part 3
     // Iterate over all particles in the hybrid region and calculate drift force
-    for (std::set<Particle *>::iterator it = adrZone.begin(); it != adrZone.end(); ++it)
+    for (std::vector<Particle *>::const_iterator it = adrZone.begin(); it != adrZone.end(); ++it)
     {  // Iterate over all particles
         Particle &vp = **it;
         real w = vp.lambda();
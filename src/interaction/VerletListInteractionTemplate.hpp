@@ -101,6 +101,9 @@ public:
     virtual int bondType() { return Nonbonded; }
 
 protected:
+    /// force loop over the CSR layout of the verlet list
+    void addForcesCSR();
+
     int ntypes;
     std::shared_ptr<VerletList> verletList;
     esutil::Array2D<Potential, esutil::enlarge> potentialArray;
@@ -161,6 +164,8 @@ inline void VerletListInteractionTemplate<_Potential>::addForces()
             LOG4ESPP_TRACE(_Potential::theLogger, "id1=" << p1.id() << " id2=" << p2.id() << " force=" << force);
           }
         }
+    }else if (verletList->getUseCSR()){
+        addForcesCSR();
     }else{
         for (PairList::Iterator it(verletList->getPairs()); it.isValid(); ++it)
         {
@@ -184,6 +189,37 @@ inline void VerletListInteractionTemplate<_Potential>::addForces()
     }
 }
 
+template <typename _Potential>
+inline void VerletListInteractionTemplate<_Potential>::addForcesCSR()
+{
+    const std::vector<Particle *> &first = verletList->getCSRParticles();
+    const std::vector<size_t> &offsets = verletList->getCSROffsets();
+    const std::vector<Particle *> &neighbors = verletList->getCSRNeighbors();
+
+    for (size_t i = 0; i < first.size(); ++i)
+    {
+        Particle &p1 = *first[i];
+        const int type1 = p1.type();
+        Real3D force1(0.0);
+
+        for (size_t j = offsets[i], end = offsets[i + 1]; j < end; ++j)
+        {
+            Particle &p2 = *neighbors[j];
+            const Potential &potential = potentialArray(type1, p2.type());
+
+            Real3D force(0.0);
+            if (potential._computeForce(force, p1, p2))
+            {
+                force1 += force;
+                p2.force() -= force;
+                LOG4ESPP_TRACE(_Potential::theLogger,
+                               "id1=" << p1.id() << " id2=" << p2.id() << " force=" << force);
+            }
+        }
+        p1.force() += force1;
+    }
+}
+
 template <typename _Potential>
 inline real VerletListInteractionTemplate<_Potential>::computeEnergy()
 {
@@ -192,19 +228,37 @@ inline real VerletListInteractionTemplate<_Potential>::computeEnergy()
 
     real e = 0.0;
     real es = 0.0;
-    for (PairList::Iterator it(verletList->getPairs()); it.isValid(); ++it)
+    if (verletList->getUseCSR())
     {
-        Particle &p1 = *it->first;
-        Particle &p2 = *it->second;
-        int type1 = p1.type();
-        int type2 = p2.type();
-        const Potential &potential = getPotential(type1, type2);
-        // std::shared_ptr<Potential> potential = getPotential(type1, type2);
-        e = potential._computeEnergy(p1, p2);
-        // e   = potential->_computeEnergy(p1, p2);
-        es += e;
-        LOG4ESPP_TRACE(_Potential::theLogger,
-                       "id1=" << p1.id() << " id2=" << p2.id() << " potential energy=" << e);
+        const std::vector<Particle *> &first = verletList->getCSRParticles();
+        const std::vector<size_t> &offsets = verletList->getCSROffsets();
+        const std::vector<Particle *> &neighbors = verletList->getCSRNeighbors();
+        for (size_t i = 0; i < first.size(); ++i)
+        {
+            Particle &p1 = *first[i];
+            for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+            {
+                Particle &p2 = *neighbors[j];
+                es += getPotential(p1.type(), p2.type())._computeEnergy(p1, p2);
+            }
+        }
+    }
+    else
+    {
+        for (PairList::Iterator it(verletList->getPairs()); it.isValid(); ++it)
+        {
+            Particle &p1 = *it->first;
+            Particle &p2 = *it->second;
+            int type1 = p1.type();
+            int type2 = p2.type();
+            const Potential &potential = getPotential(type1, type2);
+            // std::shared_ptr<Potential> potential = getPotential(type1, type2);
+            e = potential._computeEnergy(p1, p2);
+            // e   = potential->_computeEnergy(p1, p2);
+            es += e;
+            LOG4ESPP_TRACE(_Potential::theLogger,
+                           "id1=" << p1.id() << " id2=" << p2.id() << " potential energy=" << e);
+        }
     }
 
     // reduce over all CPUs
@@ -135,7 +135,7 @@ protected:
     boost::unordered_map<Particle *, real>
         energydiff;  // Energydifference V_AA - V_CG map for particles in hybrid region for drift
                      // term calculation in H-AdResS
-    std::set<Particle *> adrZone;  // Virtual particles in AdResS zone (HY and AT region)
+    std::vector<Particle *> adrZone;  // Virtual particles in AdResS zone (HY and AT region)
 };
 
 //////////////////////////////////////////////////
@@ -145,10 +145,10 @@ template <typename _PotentialQM, typename _PotentialCL>
 inline void VerletListPIadressInteractionTemplate<_PotentialQM, _PotentialCL>::addForces()
 {
     // Get the adrZone
-    std::set<Particle *> adrZone = verletList->getAdrZone();
+    const std::vector<Particle *> &adrZone = verletList->getAdrZone();
 
     // Initialize the energy diff map to zero (only necessary for particles in the hybrid region)
-    for (std::set<Particle *>::iterator it = adrZone.begin(); it != adrZone.end(); ++it)
+    for (std::vector<Particle *>::const_iterator it = adrZone.begin(); it != adrZone.end(); ++it)
     {
         Particle &p = **it;
         if (p.lambda() < 1.0 && p.lambda() > 0.0)
@@ -370,7 +370,7 @@ inline void VerletListPIadressInteractionTemplate<_PotentialQM, _PotentialCL>::a
 
     // Drift Term application
     // Iterate over all particles in the hybrid region and calculate drift force
-    for (std::set<Particle *>::iterator it = adrZone.begin(); it != adrZone.end(); ++it)
+    for (std::vector<Particle *>::const_iterator it = adrZone.begin(); it != adrZone.end(); ++it)
     {  // Iterate over all particles
         Particle &vp = **it;
         real w = vp.lambda();
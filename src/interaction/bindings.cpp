@@ -78,6 +78,7 @@
 #include "TersoffTripleTerm.hpp"
 
 #include "CoulombKSpaceP3M.hpp"
+#include "CoulombKSpaceSPME.hpp"
 #include "Potential.hpp"
 #include "PotentialVSpherePair.hpp"
 #include "SingleParticlePotential.hpp"
@@ -151,6 +152,7 @@ void registerPython()
     TersoffTripleTerm::registerPython();
 
     CoulombKSpaceP3M::registerPython();
+    CoulombKSpaceSPME::registerPython();
 
     ConstrainCOM::registerPython();
     ConstrainRG::registerPython();
@@ -38,6 +38,9 @@ class CellListAllPairsIterator
 public:
     CellListAllPairsIterator();
     CellListAllPairsIterator(CellList &cl);
+    /** pairs of the cells in cl as above, followed by the pairs of the cells in
+        neighborOnly with their neighbor cells, but not the pairs inside these cells */
+    CellListAllPairsIterator(CellList &cl, CellList &neighborOnly);
 
     CellListAllPairsIterator &operator++();
 
@@ -53,6 +56,9 @@ private:
     ParticlePair current;
 
     bool inSelfLoop;
+    // false while going over the cells of the second list
+    bool selfPairs;
+    CellList *nextCells;
 
     // current cell
     CellList::Iterator cit;
@@ -63,35 +69,69 @@ private:
     NeighborCellList::Iterator ncit;
     // current neighbor particle
     ParticleList::Iterator npit;
+
+    void init(CellList &cl);
+    /// switch to the second cell list, returns false if there are no more cells
+    bool nextCellList();
+    /// starting from a finished npit, find the next pair
+    void findPair();
 };
 
 //////////////////////////////////////////////////
 // INLINE IMPLEMENTATION
 inline CellListAllPairsIterator::CellListAllPairsIterator() {}
 
-inline CellListAllPairsIterator::CellListAllPairsIterator(CellList &cl)
+inline CellListAllPairsIterator::CellListAllPairsIterator(CellList &cl) : nextCells(0)
 {
+    init(cl);
+}
+
+inline CellListAllPairsIterator::CellListAllPairsIterator(CellList &cl, CellList &neighborOnly)
+    : nextCells(&neighborOnly)
+{
+    init(cl);
+}
+
+inline void CellListAllPairsIterator::init(CellList &cl)
+{
+    selfPairs = true;
     cit = CellList::Iterator(cl);
-    if (cit.isDone()) return;
+    if (cit.isDone() && !nextCellList()) return;
     inSelfLoop = true;
-    pit = ParticleList::Iterator((*cit)->particles);
-    while (pit.isDone())
+    if (selfPairs)
     {
-        ++cit;
-        if (cit.isDone()) return;
         pit = ParticleList::Iterator((*cit)->particles);
+        npit = pit;
+        if (npit.isValid()) ++npit;
+    }
+    else
+    {
+        pit = ParticleList::Iterator();
+        npit = pit;
     }
+    findPair();
+}
 
-    npit = pit;
-    this->operator++();
+inline bool CellListAllPairsIterator::nextCellList()
+{
+    if (!selfPairs || !nextCells) return false;
+    selfPairs = false;
+    cit = CellList::Iterator(*nextCells);
+    return cit.isValid();
 }
 
 inline CellListAllPairsIterator &CellListAllPairsIterator::operator++()
 {
     ++npit;
+    findPair();
+    return *this;
+}
+
+inline void CellListAllPairsIterator::findPair()
+{
     while (npit.isDone())
     {
-        ++pit;
+        if (pit.isValid()) ++pit;
         while (pit.isDone())
         {
             if (inSelfLoop)
@@ -112,12 +152,18 @@ inline CellListAllPairsIterator &CellListAllPairsIterator::operator++()
             {
                 LOG4ESPP_TRACE(theLogger, "ncit.isDone(), go to next cell");
                 ++cit;
-                if (cit.isDone())
+                if (cit.isDone() && !nextCellList())
                 {
                     LOG4ESPP_TRACE(theLogger, "cit.isDone(), LOOP FINISHED");
-                    return *this;
+                    return;
                 }
                 inSelfLoop = true;
+                if (!selfPairs)
+                {
+                    // no pairs inside the cell, go on with its neighbors
+                    pit = ParticleList::Iterator();
+                    continue;
+                }
             }
             // assert(inSelfLoop || ncit.isValid());
             pit = ParticleList::Iterator((*cit)->particles);
@@ -140,7 +186,6 @@ inline CellListAllPairsIterator &CellListAllPairsIterator::operator++()
 
     LOG4ESPP_TRACE(theLogger,
                    "current pair: (" << current.first->id() << ", " << current.second->id() << ")");
-    return *this;
 }
 
 inline bool CellListAllPairsIterator::isValid() const { return cit.isValid(); }
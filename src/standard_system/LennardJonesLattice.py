@@ -0,0 +1,70 @@
+#  Copyright (C) 2026
+#      Max Planck Institute for Polymer Research & JGU Mainz
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+r"""
+**********************************************
+espressopp.standard_system.LennardJonesLattice
+**********************************************
+
+
+.. function:: espressopp.standard_system.LennardJonesLattice(num_particles, rho, T, rc, skin, dt, seed, **storage_properties)
+
+                :param int num_particles:
+                :param real rho: (default: 0.8442)
+                :param real T: (default: 1.0)
+                :param real rc: (default: 2.5)
+                :param real skin: (default: 0.3)
+                :param real dt: (default: 0.005)
+                :param int seed: (default: 12345)
+
+                Return a Lennard-Jones fluid (epsilon = sigma = 1, no shift) as
+                system, integrator, Verlet list and interaction.
+                The particles sit on a randomly displaced simple cubic lattice of
+                density rho and get Gaussian velocities of temperature T, both only
+                depend on seed, so every call returns the same configuration.
+                The keyword arguments are set as properties of the storage before
+                the particles are added, e.g. eighthShell=True.
+"""
+import random
+import espressopp
+from espressopp.tools import lattice, velocities
+from espressopp.standard_system.Default import Default
+
+def LennardJonesLattice(num_particles, rho=0.8442, T=1.0, rc=2.5, skin=0.3, dt=0.005, seed=12345,
+                        **storage_properties):
+
+    x, y, z, Lx, Ly, Lz = lattice.createCubic(num_particles, rho=rho, perfect=False,
+                                              RNG=random.Random(seed).random)
+    vx, vy, vz = velocities.gaussian(T=T, N=num_particles, zero_momentum=True, seed=seed)
+
+    system, integrator = Default((Lx, Ly, Lz), rc=rc, skin=skin, dt=dt)
+    for name, value in storage_properties.items():
+        setattr(system.storage, name, value)
+    system.storage.addParticles([[i + 1, 0, 1.0, espressopp.Real3D(x[i], y[i], z[i]),
+                                  espressopp.Real3D(vx[i], vy[i], vz[i])]
+                                 for i in range(num_particles)], 'id', 'type', 'mass', 'pos', 'v')
+    system.storage.decompose()
+
+    vl = espressopp.VerletList(system, cutoff=rc)
+    interLJ = espressopp.interaction.VerletListLennardJones(vl)
+    interLJ.setPotential(type1=0, type2=0,
+                         potential=espressopp.interaction.LennardJones(1.0, 1.0, cutoff=rc, shift=0))
+    system.addInteraction(interLJ)
+
+    return system, integrator, vl, interLJ
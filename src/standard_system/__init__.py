@@ -20,6 +20,7 @@
 
 
 from espressopp.standard_system.LennardJones import *
+from espressopp.standard_system.LennardJonesLattice import *
 from espressopp.standard_system.PolymerMelt import *
 from espressopp.standard_system.Minimal import *
 from espressopp.standard_system.Default import *
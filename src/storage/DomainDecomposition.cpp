@@ -38,6 +38,7 @@
 
 #include "iterator/CellListIterator.hpp"
 #include "esutil/Error.hpp"
+#include "SpaceFillingCurve.hpp"
 
 #include "boost/serialization/vector.hpp"
 
@@ -69,7 +70,7 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<System> _system,
                                          const Int3D& _nodeGrid,
                                          const Int3D& _cellGrid,
                                          int _halfCellInt)
-    : Storage(_system, _halfCellInt), exchangeBufferSize(0)
+    : Storage(_system, _halfCellInt), exchangeBufferSize(0), eighthShell(false), ghostPlansValid(false)
 {
     LOG4ESPP_INFO(logger, "node grid = " << _nodeGrid[0] << "x" << _nodeGrid[1] << "x"
                                          << _nodeGrid[2] << " cell grid = " << _cellGrid[0] << "x"
@@ -166,6 +167,33 @@ void DomainDecomposition::markCells()
             }
         }
     }
+
+    if (spatialSort) orderRealCells();
+}
+
+void DomainDecomposition::orderRealCells()
+{
+    Cell* cell0 = &cells[0];
+    if (!spatialSort)
+    {
+        // markCells order, which is the order of the cell index
+        std::sort(realCells.begin(), realCells.end());
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, Cell*> > keys;
+    keys.reserve(realCells.size());
+    for (CellList::Iterator it(realCells); it.isValid(); ++it)
+    {
+        int m, n, o;
+        cellGrid.mapIndexToPosition(m, n, o, *it - cell0);
+        keys.push_back(std::make_pair(mortonKey(m, n, o), *it));
+    }
+    std::sort(keys.begin(), keys.end());
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        realCells[i] = keys[i].second;
+    }
 }
 
 // TODO one should take care of rc and system size
@@ -320,6 +348,13 @@ void DomainDecomposition::initCellInteractions()
 {
     LOG4ESPP_DEBUG(logger, "setting up neighbors for " << cells.size() << " cells");
 
+    ghostPairCells.clear();
+    if (eighthShell)
+    {
+        initCellInteractionsEighthShell();
+        return;
+    }
+
     for (int o = cellGrid.getInnerCellsBegin(2); o < cellGrid.getInnerCellsEnd(2); ++o)
     {
         for (int n = cellGrid.getInnerCellsBegin(1); n < cellGrid.getInnerCellsEnd(1); ++n)
@@ -367,8 +402,101 @@ void DomainDecomposition::initCellInteractions()
     LOG4ESPP_DEBUG(logger, "done");
 }
 
+void DomainDecomposition::initCellInteractionsEighthShell()
+{
+    // only the real cells and the upper ghost frame are filled
+    int begin[3], end[3], frameEnd[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        begin[i] = cellGrid.getInnerCellsBegin(i);
+        end[i] = cellGrid.getInnerCellsEnd(i);
+        frameEnd[i] = cellGrid.getFrameGridSize(i);
+    }
+
+    for (int o = begin[2]; o < frameEnd[2]; ++o)
+    {
+        for (int n = begin[1]; n < frameEnd[1]; ++n)
+        {
+            for (int m = begin[0]; m < frameEnd[0]; ++m)
+            {
+                longint cellIdx = cellGrid.mapPositionToIndex(m, n, o);
+                Cell* cell = &cells[cellIdx];
+                bool isReal = cellGrid.isInnerCell(m, n, o);
+
+                for (int p = o - halfCellInt; p <= o + halfCellInt; ++p)
+                {
+                    for (int q = n - halfCellInt; q <= n + halfCellInt; ++q)
+                    {
+                        for (int r = m - halfCellInt; r <= m + halfCellInt; ++r)
+                        {
+                            if (p == o && q == n && r == m) continue;
+                            if (r < begin[0] || q < begin[1] || p < begin[2]) continue;
+                            if (r >= frameEnd[0] || q >= frameEnd[1] || p >= frameEnd[2]) continue;
+                            // the pair belongs to the CPU with the lower corner of both cells
+                            if (std::min(m, r) >= end[0] || std::min(n, q) >= end[1] ||
+                                std::min(o, p) >= end[2])
+                                continue;
+
+                            longint cell2Idx = cellGrid.mapPositionToIndex(r, q, p);
+                            // ghost cells only keep the pairs they own
+                            if (!isReal && cell2Idx < cellIdx) continue;
+                            cell->neighborCells.push_back(
+                                NeighborCellInfo(&cells[cell2Idx], (cell2Idx < cellIdx)));
+                        }
+                    }
+                }
+
+                if (!isReal && !cell->neighborCells.empty()) ghostPairCells.push_back(cell);
+            }
+        }
+    }
+
+    LOG4ESPP_DEBUG(logger, ghostPairCells.size() << " ghost cells own pairs");
+}
+
+void DomainDecomposition::setEighthShell(bool _eighthShell)
+{
+    if (eighthShell == _eighthShell) return;
+    if (_eighthShell && getSystem()->shearRate != 0.0)
+    {
+        throw std::runtime_error(
+            "DomainDecomposition: eighth-shell ghosts are not available with Lees-Edwards shear");
+    }
+    eighthShell = _eighthShell;
+
+    invalidateGhosts();
+    for (CellList::Iterator it(ghostCells); it.isValid(); ++it) (*it)->particles.clear();
+    for (size_t i = 0; i < cells.size(); ++i) cells[i].neighborCells.clear();
+    for (int i = 0; i < 6; i++)
+    {
+        commCells[i].reals.clear();
+        commCells[i].ghosts.clear();
+    }
+    initCellInteractions();
+    prepareGhostCommunication();
+
+    exchangeGhosts();
+    onCellAdjust();
+    try
+    {
+        // fixed tuple lists and some Verlet lists reject eighth-shell ghosts
+        onParticlesChanged();
+    }
+    catch (...)
+    {
+        setEighthShell(!_eighthShell);
+        throw;
+    }
+}
+
 void DomainDecomposition::remapNeighbourCells(int cell_shift)
 {
+    if (eighthShell)
+        throw std::runtime_error(
+            "remapNeighbourCells error: not available with eighth-shell ghost communication");
+    // commCells of the z direction change
+    ghostPlansValid = false;
+
 //if (rename("FLAG_P","FLAG_P")==0 && getSystem()->comm->rank()==getSystem()->irank)
 //std::cout<<"SHIFT> "<<getSystem()->ghostShift<<" \n";
     //cell_shift=1: right shift for top ghost layer; cell_shift=-1: left shift
@@ -1047,12 +1175,21 @@ void DomainDecomposition::exchangeGhosts()
 {
     LOG4ESPP_DEBUG(logger, "exchangeGhosts -> ghost communication sizes first, real->ghost");
     doGhostCommunication(true, true, dataOfExchangeGhosts);
+    buildGhostPlans();
+}
+
+void DomainDecomposition::invalidateGhosts()
+{
+    ghostPlansValid = false;
+    Storage::invalidateGhosts();
 }
 
+void DomainDecomposition::realParticlesModified() { ghostPlansValid = false; }
+
 void DomainDecomposition::updateGhosts()
 {
     LOG4ESPP_DEBUG(logger, "updateGhosts -> ghost communication no sizes, real->ghost");
-    doGhostCommunication(false, true, dataOfUpdateGhosts);
+    doGhostCommunication(false, true, getDataOfUpdateGhosts());
 }
 
 void DomainDecomposition::updateGhostsV()
@@ -1067,6 +1204,173 @@ void DomainDecomposition::collectGhostForces()
     doGhostCommunication(false, false);
 }
 
+void DomainDecomposition::buildGhostPlans()
+{
+    auto fillPlan = [](GhostPlan& plan, const CommCells& comm) {
+        plan.reals.clear();
+        plan.ghosts.clear();
+        plan.realStart.clear();
+        plan.ghostStart.clear();
+        plan.leX.clear();
+        for (Cell* cell : comm.reals)
+        {
+            plan.realStart.push_back(plan.reals.size());
+            for (Particle& p : cell->particles) plan.reals.push_back(&p);
+        }
+        plan.realStart.push_back(plan.reals.size());
+        for (Cell* cell : comm.ghosts)
+        {
+            plan.ghostStart.push_back(plan.ghosts.size());
+            for (Particle& p : cell->particles) plan.ghosts.push_back(&p);
+        }
+        plan.ghostStart.push_back(plan.ghosts.size());
+    };
+    for (int dir = 0; dir < 6; ++dir) fillPlan(ghostPlans[dir], commCells[dir]);
+    for (int i = 0; i < 2; ++i) fillPlan(ghostPlansBkp[i], commCells_bkp[i]);
+
+    /* Lees-Edwards x reference of the reals sent in z. With one CPU in z it is the x of
+       the ghost cell, as in Storage::copyRealsToGhosts_LEBC. Otherwise it is the x distance
+       of the real cell to the ghost cell, without the x offset of the receiving CPU. */
+    const int xcells = getInt3DCellGrid()[0];
+    const int xgrid = xcells * getSystem()->NGridSize[0];
+    const real Lx = getSystem()->bc->getBoxL()[0];
+    const real cellSizeX = cellGrid.getCellSize(0);
+    for (int dir = 4; dir < 6; ++dir)
+    {
+        GhostPlan& plan = ghostPlans[dir];
+        const CommCells& comm = commCells[dir];
+        plan.leX.resize(plan.reals.size());
+        for (size_t i = 0; i < comm.reals.size() && i < comm.ghosts.size(); ++i)
+        {
+            real x;
+            if (nodeGrid.getGridSize(2) == 1)
+            {
+                x = ((comm.ghosts[i] - getFirstCell()) % (xgrid + 2) - 0.5) / (xgrid + .0) * Lx;
+            }
+            else
+            {
+                const int cell_x1 = nodeGrid.getNodePosition(0) * xcells +
+                                    (comm.reals[i] - getFirstCell()) % (xcells + 2) - 1;
+                const int cell_x2 = (comm.ghosts[i] - getFirstCell()) % (xcells + 2) - 1;
+                x = (cell_x1 - cell_x2) * cellSizeX;
+            }
+            std::fill(plan.leX.begin() + plan.realStart[i], plan.leX.begin() + plan.realStart[i + 1],
+                      x);
+        }
+    }
+    ghostPlansValid = true;
+}
+
+void DomainDecomposition::copyGhostPlan(int dir, int extradata, const Real3D& shift)
+{
+    GhostPlan& plan = ghostPlans[dir];
+    Particle* const* reals = plan.reals.data();
+    Particle* const* ghosts = plan.ghosts.data();
+    for (size_t i = 0, end = plan.reals.size(); i < end; ++i)
+    {
+        ghosts[i]->copyAsGhost(*reals[i], extradata, shift);
+    }
+}
+
+void DomainDecomposition::copyGhostPlanLE(int dir, int extradata, const Real3D& shift, real offset)
+{
+    GhostPlan& plan = ghostPlans[dir];
+    Particle* const* reals = plan.reals.data();
+    Particle* const* ghosts = plan.ghosts.data();
+    const real* leX = plan.leX.data();
+    const real Lx = getSystem()->bc->getBoxL()[0];
+    for (size_t i = 0, end = plan.reals.size(); i < end; ++i)
+    {
+        const real x = reals[i]->position()[0];
+        real xs = x + offset;
+        while (xs < leX[i] - Lx / 2.0) xs += Lx;
+        while (xs > leX[i] + Lx / 2.0) xs -= Lx;
+        Real3D leShift = shift;
+        leShift[0] += xs - x;
+        ghosts[i]->copyAsGhost(*reals[i], extradata, leShift);
+    }
+}
+
+void DomainDecomposition::addGhostPlanForces(int dir)
+{
+    GhostPlan& plan = ghostPlans[dir];
+    Particle* const* reals = plan.reals.data();
+    Particle* const* ghosts = plan.ghosts.data();
+    for (size_t i = 0, end = plan.reals.size(); i < end; ++i)
+    {
+        reals[i]->particleForce() += ghosts[i]->particleForce();
+    }
+}
+
+void DomainDecomposition::packGhostPlan(OutBuffer& buf,
+                                        const GhostPlan& plan,
+                                        size_t first,
+                                        size_t last,
+                                        int extradata,
+                                        const Real3D& shift)
+{
+    for (size_t i = plan.realStart[first], end = plan.realStart[last]; i < end; ++i)
+    {
+        buf.write(*plan.reals[i], extradata, shift);
+    }
+}
+
+void DomainDecomposition::packGhostPlanLE(OutBuffer& buf,
+                                          const GhostPlan& plan,
+                                          size_t first,
+                                          size_t last,
+                                          int extradata,
+                                          const Real3D& shift,
+                                          real offset,
+                                          real nodeX)
+{
+    const real Lx = getSystem()->bc->getBoxL()[0];
+    for (size_t i = plan.realStart[first], end = plan.realStart[last]; i < end; ++i)
+    {
+        // the image of the real cell closest to the ghost cell on the receiver
+        const int image = static_cast<int>(floor((plan.leX[i] - nodeX + offset) / Lx + 0.5));
+        Real3D leShift = shift;
+        leShift[0] += offset - image * Lx;
+        buf.write(*plan.reals[i], extradata, leShift);
+    }
+}
+
+void DomainDecomposition::unpackGhostPlan(
+    InBuffer& buf, const GhostPlan& plan, size_t first, size_t last, int extradata)
+{
+    for (size_t i = plan.ghostStart[first], end = plan.ghostStart[last]; i < end; ++i)
+    {
+        Particle* p = plan.ghosts[i];
+        buf.read(*p, extradata);
+        if (extradata & DATA_PROPERTIES) updateInLocalParticles(p, true);
+        p->ghost() = 1;
+    }
+}
+
+void DomainDecomposition::packGhostPlanForces(OutBuffer& buf,
+                                              const GhostPlan& plan,
+                                              size_t first,
+                                              size_t last)
+{
+    for (size_t i = plan.ghostStart[first], end = plan.ghostStart[last]; i < end; ++i)
+    {
+        buf.write(plan.ghosts[i]->particleForce());
+    }
+}
+
+void DomainDecomposition::unpackAndAddGhostPlanForces(InBuffer& buf,
+                                                      const GhostPlan& plan,
+                                                      size_t first,
+                                                      size_t last)
+{
+    for (size_t i = plan.realStart[first], end = plan.realStart[last]; i < end; ++i)
+    {
+        ParticleForce f;
+        buf.read(f);
+        plan.reals[i]->particleForce() += f;
+    }
+}
+
 void DomainDecomposition::fillCells(std::vector<Cell*>& cv,
                                     const int leftBoundary[3],
                                     const int rightBoundary[3])
@@ -1123,7 +1427,9 @@ void DomainDecomposition::prepareGhostCommunication()
             int otherCoord = (coord + offset) % 3;
             if (otherCoord < coord)
             {
-                leftBoundary[otherCoord] = 0;
+                // with eighth-shell there is no lower ghost frame
+                leftBoundary[otherCoord] =
+                    eighthShell ? cellGrid.getInnerCellsBegin(otherCoord) : 0;
                 rightBoundary[otherCoord] = cellGrid.getFrameGridSize(otherCoord);
             }
             else
@@ -1133,8 +1439,8 @@ void DomainDecomposition::prepareGhostCommunication()
             }
         }
 
-        //  lr loop: left right - loop
-        for (int lr = 0; lr < 2; ++lr)
+        //  lr loop: left right - loop, eighth-shell only sends to the left
+        for (int lr = 0; lr < (eighthShell ? 1 : 2); ++lr)
         {
             int dir = 2 * coord + lr;
 
@@ -1184,6 +1490,11 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
  value. */
  
     real offs=getSystem()->shearOffset;
+    if (eighthShell && offs != 0.0) {
+        throw std::runtime_error("DomainDecomposition::doGhostCommunication: eighth-shell ghosts are not available with Lees-Edwards shear");
+    }
+    // between two resorts the flat plans replace the walk over the cells
+    bool usePlans = ghostPlansValid && !sizesFirst;
 
     for (int _coord = 0; _coord < 3; ++_coord) {
         /* inverted processing order for ghost force communication,
@@ -1195,8 +1506,8 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
         int coord = realToGhosts ? _coord : (2 - _coord);
         real curCoordBoxL = getSystem()->bc->getBoxL()[coord];
 
-        // lr loop: left right
-        for (int lr = 0; lr < 2; ++lr) {
+        // lr loop: left right, eighth-shell only imports ghosts from the right
+        for (int lr = 0; lr < (eighthShell ? 1 : 2); ++lr) {
             int dir                 = 2 * coord + lr;
             int oppositeDir = 2 * coord + (1 - lr);
 
@@ -1214,7 +1525,15 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
                     throw std::runtime_error("DomainDecomposition::doGhostCommunication: send/recv cell structure mismatch during local copy");
                 }
 
-                if (offs>.0 && coord==2){
+                if (usePlans && ghostPlans[dir].reals.size() == ghostPlans[dir].ghosts.size()){
+                    if (!realToGhosts) {
+                        addGhostPlanForces(dir);
+                    } else if (offs>.0 && coord==2 && shift[2]!=0.0) {
+                        copyGhostPlanLE(dir, extradata, shift, offs*shift[2]/curCoordBoxL);
+                    } else {
+                        copyGhostPlan(dir, extradata, shift);
+                    }
+                }else if (offs>.0 && coord==2){
                     for (int i = 0, end = commCells[dir].ghosts.size(); i < end; ++i) {
                         if (realToGhosts) {
                             copyRealsToGhosts_LEBC(*commCells[dir].reals[i], *commCells[dir].ghosts[i], extradata, shift);
@@ -1249,6 +1568,12 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
                         }
                     }
 
+                    // the plans of commCells_bkp exist once the layers were saved before a resort
+                    GhostPlan& bkpPlan = ghostPlansBkp[dir-4];
+                    bool useBkpPlan = usePlans &&
+                        bkpPlan.realStart.size() == commCells_bkp[dir-4].reals.size() + 1 &&
+                        bkpPlan.ghostStart.size() == commCells_bkp[dir-4].ghosts.size() + 1;
+
                     int incell_shift=((getSystem()->ghostShift)%getInt3DCellGrid()[0]+getInt3DCellGrid()[0])%getInt3DCellGrid()[0];
                     int new_dir=(nodeGrid.getNodePosition(2)>0 ? -3:-6)+dir;
                     int sz01=(getInt3DCellGrid()[1]+2)*(getInt3DCellGrid()[0]+1-incell_shift);
@@ -1422,7 +1747,11 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
                                 //absolute x-positions (counts in cells) of current real&ghost cells
                                 int cell_x1,cell_x2,itmp;
                                 real cx_flag=(shift[2]>.0 ? 1.0:-1.0);
-                                for (int i = rsize[k], end = rsize[k+1]; i < end; ++i) {
+                                if (usePlans) {
+                                    real nodeX=(cnode[k]%getInt3DNodeGrid()[0])*getInt3DCellGrid()[0]*cellGrid.getCellSize(0);
+                                    packGhostPlanLE(outBuffer, ghostPlans[dir], rsize[k], rsize[k+1], extradata, shift, cx_flag*offs, nodeX);
+                                }
+                                else for (int i = rsize[k], end = rsize[k+1]; i < end; ++i) {
                                     cell_x1=nodeGrid.getNodePosition(0)*getInt3DCellGrid()[0]+(commCells[dir].reals[i]-getFirstCell())%(getInt3DCellGrid()[0]+2)-1;
                                     cell_x2=cnode[k]%getInt3DNodeGrid()[0]*getInt3DCellGrid()[0]+(commCells[dir].ghosts[i]-getFirstCell())%(getInt3DCellGrid()[0]+2)-1;
                                     itmp= static_cast<int>(floor(((cell_x1-cell_x2)*cellGrid.getCellSize(0)+cx_flag*offs)/Lx+0.5));
@@ -1447,7 +1776,10 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
                                 if (k==0) receiver = nodeGrid.getNodeNeighborIndex(oppositeDir);
                                 sender = cnode[k];
                                 
-                                if (k==0) for (int i = 0, end = commCells_bkp[dir-4].ghosts.size(); i < end; ++i) {
+                                if (k==0 && useBkpPlan) {
+                                    packGhostPlanForces(outBuffer, bkpPlan, 0, commCells_bkp[dir-4].ghosts.size());
+                                }
+                                else if (k==0) for (int i = 0, end = commCells_bkp[dir-4].ghosts.size(); i < end; ++i) {
                                     packForces(outBuffer, *commCells_bkp[dir-4].ghosts[i]);
                                 }
         
@@ -1467,7 +1799,10 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
                                 if (k==0) receiver = nodeGrid.getNodeNeighborIndex(dir);
                                 sender = cnode[k];
         
-                                if (k==0) for (int i = 0, end = commCells_bkp[dir-4].reals.size(); i < end; ++i) {
+                                if (k==0 && useBkpPlan) {
+                                    packGhostPlan(outBuffer, bkpPlan, 0, commCells_bkp[dir-4].reals.size(), extradata, shift);
+                                }
+                                else if (k==0) for (int i = 0, end = commCells_bkp[dir-4].reals.size(); i < end; ++i) {
                                     packPositionsEtc(outBuffer, *commCells_bkp[dir-4].reals[i], extradata, shift);
                                 }
 //if (getSystem()->comm->rank()==getSystem()->irank)
@@ -1484,7 +1819,10 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
                                 receiver = cnode[k];
                                 if (k==0) sender = nodeGrid.getNodeNeighborIndex(dir);
                                 
-                                for (int i = gsize[k], end = gsize[k+1]; i < end; ++i) {
+                                if (usePlans) {
+                                    packGhostPlanForces(outBuffer, ghostPlans[dir], gsize[k], gsize[k+1]);
+                                }
+                                else for (int i = gsize[k], end = gsize[k+1]; i < end; ++i) {
                                     packForces(outBuffer, *commCells[dir].ghosts[i]);
                                 }
         
@@ -1506,9 +1844,14 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
                                 // unpack received data
 //if (rename("FLAG_P","FLAG_P")==0 && getSystem()->comm->rank()==getSystem()->irank)
 //std::cout<<"    Before-UPK> "<<dir<<" \n";
-                                if (k==0) for (int i = 0, end = commCells_bkp[dir-4].reals.size(); i < end; ++i) {
+                                if (k==0 && useBkpPlan) {
+                                    unpackGhostPlan(inBuffer, bkpPlan, 0, commCells_bkp[dir-4].reals.size(), extradata);
+                                }
+                                else if (k==0) for (int i = 0, end = commCells_bkp[dir-4].reals.size(); i < end; ++i) {
                                     unpackPositionsEtc(*commCells_bkp[dir-4].ghosts[i], inBuffer, extradata);
                                 }
+                            }else if (usePlans) {
+                                unpackAndAddGhostPlanForces(inBuffer, ghostPlans[dir], rsize[k], rsize[k+1]);
                             }else{
                                 for (int i = rsize[k], end = rsize[k+1]; i < end; ++i) {
                                     unpackAndAddForces(*commCells[dir].reals[i], inBuffer);
@@ -1517,9 +1860,14 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
                         }else if ((new_dir>0 ? new_dir:-new_dir)==1){
                             if (realToGhosts) {
                                 // unpack received data
-                                for (int i = rsize[k], end = rsize[k+1]; i < end; ++i) {
+                                if (usePlans) {
+                                    unpackGhostPlan(inBuffer, ghostPlans[dir], rsize[k], rsize[k+1], extradata);
+                                }
+                                else for (int i = rsize[k], end = rsize[k+1]; i < end; ++i) {
                                     unpackPositionsEtc(*commCells[dir].ghosts[i], inBuffer, extradata);
                                 }
+                            }else if (k==0 && useBkpPlan) {
+                                unpackAndAddGhostPlanForces(inBuffer, bkpPlan, 0, commCells_bkp[dir-4].reals.size());
                             }else{
                                 if (k==0) for (int i = 0, end = commCells_bkp[dir-4].reals.size(); i < end; ++i) {
                                     unpackAndAddForces(*commCells_bkp[dir-4].reals[i], inBuffer);
@@ -1572,15 +1920,23 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
                         receiver = nodeGrid.getNodeNeighborIndex(dir);
                         sender = nodeGrid.getNodeNeighborIndex(oppositeDir);
 
-                        for (int i = 0, end = commCells[dir].reals.size(); i < end; ++i) {
-                            packPositionsEtc(outBuffer, *commCells[dir].reals[i], extradata, shift);
+                        if (usePlans) {
+                            packGhostPlan(outBuffer, ghostPlans[dir], 0, commCells[dir].reals.size(), extradata, shift);
+                        } else {
+                            for (int i = 0, end = commCells[dir].reals.size(); i < end; ++i) {
+                                packPositionsEtc(outBuffer, *commCells[dir].reals[i], extradata, shift);
+                            }
                         }
                     }
                     else {
                         receiver = nodeGrid.getNodeNeighborIndex(oppositeDir);
                         sender = nodeGrid.getNodeNeighborIndex(dir);
-                        for (int i = 0, end = commCells[dir].ghosts.size(); i < end; ++i) {
-                            packForces(outBuffer, *commCells[dir].ghosts[i]);
+                        if (usePlans) {
+                            packGhostPlanForces(outBuffer, ghostPlans[dir], 0, commCells[dir].ghosts.size());
+                        } else {
+                            for (int i = 0, end = commCells[dir].ghosts.size(); i < end; ++i) {
+                                packForces(outBuffer, *commCells[dir].ghosts[i]);
+                            }
                         }
                     }
 
@@ -1594,7 +1950,14 @@ doGhostCommunication(bool sizesFirst, bool realToGhosts, int extradata)
                     }
 
                     // unpack received data
-                    if (realToGhosts) {
+                    if (usePlans) {
+                        if (realToGhosts) {
+                            unpackGhostPlan(inBuffer, ghostPlans[dir], 0, commCells[dir].ghosts.size(), extradata);
+                        } else {
+                            unpackAndAddGhostPlanForces(inBuffer, ghostPlans[dir], 0, commCells[dir].reals.size());
+                        }
+                    }
+                    else if (realToGhosts) {
                         for (int i = 0, end = commCells[dir].reals.size(); i < end; ++i) {
                             unpackPositionsEtc(*commCells[dir].ghosts[i], inBuffer, extradata);
                         }
@@ -1623,7 +1986,9 @@ void DomainDecomposition::registerPython()
         .def("mapPositionToNodeClipped", &DomainDecomposition::mapPositionToNodeClipped)
         .def("getCellGrid", &DomainDecomposition::getInt3DCellGrid)
         .def("getNodeGrid", &DomainDecomposition::getInt3DNodeGrid)
-        .def("cellAdjust", &DomainDecomposition::cellAdjust);
+        .def("cellAdjust", &DomainDecomposition::cellAdjust)
+        .add_property("eighthShell", &DomainDecomposition::getEighthShell,
+                      &DomainDecomposition::setEighthShell);
 }
 
 }  // namespace storage
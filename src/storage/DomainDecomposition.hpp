@@ -82,12 +82,25 @@ public:
     virtual void updateGhostsV();
     virtual void collectGhostForces();
 
+    /** Eighth-shell ghost communication: ghosts are only imported from the upper
+        neighbors in x, y and z (including the edges and the corner), and a pair is
+        computed on the CPU that owns the componentwise lower corner of the two cells.
+        This roughly halves the ghost particles and the communicated data. Some ghost
+        cells then own pairs with other ghosts, see Storage::getGhostPairCells.
+        Only for nonbonded pair interactions. Fixed tuple lists find their partners among
+        the ghosts, which may now be missing. They refuse the mode, as do VerletListTriple,
+        VerletListAdress and the Lees-Edwards shear. */
+    virtual bool getEighthShell() const { return eighthShell; }
+    void setEighthShell(bool _eighthShell);
+
     static void registerPython();
 
 protected:
     virtual bool checkIsRealParticle(longint id, const Real3D& pos);
     virtual void decomposeRealParticles();
     virtual void exchangeGhosts();
+    virtual void invalidateGhosts();
+    virtual void realParticlesModified();
 
     virtual void doGhostCommunication(bool sizesFirst,
                                       bool realToGhosts,
@@ -95,14 +108,41 @@ protected:
 
     void prepareGhostCommunication();
 
+    struct GhostPlan;
+
+    /// flatten commCells into ghostPlans, valid until the next resort
+    void buildGhostPlans();
+    /// local periodic images from the plan of one direction
+    void copyGhostPlan(int dir, int extradata, const Real3D& shift);
+    /// local Lees-Edwards images, every particle is wrapped around the x of its ghost cell
+    void copyGhostPlanLE(int dir, int extradata, const Real3D& shift, real offset);
+    void addGhostPlanForces(int dir);
+    /** pack and unpack the particles of the comm cells [first, last) of a plan for a
+        neighbor CPU */
+    void packGhostPlan(OutBuffer& buf, const GhostPlan& plan, size_t first, size_t last,
+                       int extradata, const Real3D& shift);
+    /** the same across the sheared z boundary of a parallel run, see buildGhostPlans for
+        the x offsets */
+    void packGhostPlanLE(OutBuffer& buf, const GhostPlan& plan, size_t first, size_t last,
+                         int extradata, const Real3D& shift, real offset, real nodeX);
+    void unpackGhostPlan(InBuffer& buf, const GhostPlan& plan, size_t first, size_t last,
+                         int extradata);
+    void packGhostPlanForces(OutBuffer& buf, const GhostPlan& plan, size_t first, size_t last);
+    void unpackAndAddGhostPlanForces(InBuffer& buf, const GhostPlan& plan, size_t first,
+                                     size_t last);
+
     /// init global Verlet list
     void initCellInteractions();
+    /// neighbor cells and pair owning ghost cells for the eighth-shell communication
+    void initCellInteractionsEighthShell();
     /// set the grids and allocate space accordingly
     void remapNeighbourCells(int cell_shift);
     /// set the grids and allocate space accordingly
     void createCellGrid(const Int3D& nodeGrid, const Int3D& cellGrid);
     /// sort cells into local/ghost cell arrays
     void markCells();
+    /// order realCells along a Morton curve of the cell grid, or in grid order
+    virtual void orderRealCells();
     /// fill a list of cells with the cells from a certain region of the domain grid
     void fillCells(std::vector<Cell*>&, const int leftBoundary[3], const int rightBoundary[3]);
 
@@ -122,6 +162,9 @@ protected:
     /// expected capacity of send/recv buffers for neighbor communication
     size_t exchangeBufferSize;
 
+    /// import ghosts only from the upper neighbors
+    bool eighthShell;
+
     /** which cells to send and receive during one communication step.
         In case this is a communication with ourselves, the send-cells
         are transferred to the recv-cells. */
@@ -136,6 +179,25 @@ protected:
     CommCells commCells[6];
     CommCells commCells_bkp[2];
 
+    /** the particles of commCells in send and receive order. The particles do
+        not change between two resorts, so updateGhosts and collectGhostForces
+        only loop over these flat arrays instead of walking the cells again. */
+    struct GhostPlan
+    {
+        std::vector<Particle*> reals;
+        std::vector<Particle*> ghosts;
+        /// first particle of every comm cell in reals and ghosts, one more entry at the end
+        std::vector<size_t> realStart;
+        std::vector<size_t> ghostStart;
+        /// Lees-Edwards x reference of every entry of reals, only for the z directions
+        std::vector<real> leX;
+    };
+    GhostPlan ghostPlans[6];
+    /// plans of commCells_bkp, the unshifted z layers of the parallel Lees-Edwards exchange
+    GhostPlan ghostPlansBkp[2];
+    /// set by exchangeGhosts, cleared when the particles or commCells change
+    bool ghostPlansValid;
+
     static LOG4ESPP_DECL_LOGGER(logger);
 };
 }  // namespace storage
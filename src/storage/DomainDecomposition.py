@@ -45,6 +45,20 @@ espressopp.storage.DomainDecomposition
 .. function:: espressopp.storage.DomainDecomposition.getNodeGrid()
 
                 :rtype:
+
+.. attribute:: espressopp.storage.DomainDecomposition.eighthShell
+
+                If True, ghosts are only imported from the upper neighbors in x, y
+                and z, and every pair is computed on the CPU that owns the lower
+                corner of the two cells. This roughly halves the ghost communication.
+                Only for nonbonded pair interactions without Lees-Edwards shear.
+                Bonded (fixed tuple) lists are not supported, since a bond partner
+                below the subdomain is no longer a ghost. Creating a fixed tuple list,
+                VerletListTriple or VerletListAdress on such a storage raises an
+                error, and so does switching it on while one of them exists.
+                Default is False.
+
+                :type: bool
 """
 from espressopp import pmi
 from espressopp.esutil import cxxinit
@@ -74,7 +88,8 @@ if pmi.isController:
     class DomainDecomposition(Storage):
         pmiproxydefs = dict(
           cls = 'espressopp.storage.DomainDecompositionLocal',
-          pmicall = ['getCellGrid', 'getNodeGrid', 'cellAdjust']
+          pmicall = ['getCellGrid', 'getNodeGrid', 'cellAdjust'],
+          pmiproperty = ['eighthShell']
         )
         def __init__(self, system,
                      nodeGrid='auto',
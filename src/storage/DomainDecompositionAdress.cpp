@@ -372,6 +372,7 @@ void DomainDecompositionAdress::decompose()
     // std::cout << " ---- decompose ----\n";
     invalidateGhosts();
     decomposeRealParticles();
+    sortRealParticles();
     // std::cout << getSystem()->comm->rank() << ": (onTuplesChanged) ";
     onTuplesChanged();  // for AdResS, renamed to not confuse with bonds
     // std::cout << " ---- exchange ghosts ---- \n";
@@ -1018,7 +1019,7 @@ void DomainDecompositionAdress::exchangeGhosts()
 void DomainDecompositionAdress::updateGhosts()
 {
     LOG4ESPP_DEBUG(logger, "updateGhosts -> ghost communication no sizes, real->ghost");
-    doGhostCommunication(false, true, dataOfUpdateGhosts);
+    doGhostCommunication(false, true, getDataOfUpdateGhosts());
 }
 
 void DomainDecompositionAdress::updateGhostsV()
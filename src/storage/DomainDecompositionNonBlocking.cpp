@@ -289,6 +289,9 @@ void DomainDecompositionNonBlocking::doGhostCommunication(bool sizesFirst,
                                << (realToGhosts ? "reals to ghosts " : "ghosts to reals ")
                                << extradata);
 
+    // between two resorts the flat plans replace the walk over the cells
+    bool usePlans = ghostPlansValid && !sizesFirst;
+
     /* direction loop: x, y, z.
    Here we could in principle build in a one sided ghost
    communication, simply by taking the lr loop only over one
@@ -304,8 +307,8 @@ void DomainDecompositionNonBlocking::doGhostCommunication(bool sizesFirst,
         int coord = realToGhosts ? _coord : (2 - _coord);
         real curCoordBoxL = getSystem()->bc->getBoxL()[coord];
 
-        // lr loop: left right
-        for (int lr = 0; lr < 2; ++lr)
+        // lr loop: left right, eighth-shell only imports ghosts from the right
+        for (int lr = 0; lr < (eighthShell ? 1 : 2); ++lr)
         {
             int dir = 2 * coord + lr;
             int oppositeDir = 2 * coord + (1 - lr);
@@ -328,6 +331,15 @@ void DomainDecompositionNonBlocking::doGhostCommunication(bool sizesFirst,
                         "mismatch during local copy");
                 }
 
+                if (usePlans && ghostPlans[dir].reals.size() == ghostPlans[dir].ghosts.size())
+                {
+                    if (realToGhosts)
+                        copyGhostPlan(dir, extradata, shift);
+                    else
+                        addGhostPlanForces(dir);
+                    continue;
+                }
+
                 for (int i = 0, end = commCells[dir].ghosts.size(); i < end; ++i)
                 {
                     if (realToGhosts)
@@ -404,18 +416,35 @@ void DomainDecompositionNonBlocking::doGhostCommunication(bool sizesFirst,
                 {
                     receiver = nodeGrid.getNodeNeighborIndex(dir);
                     sender = nodeGrid.getNodeNeighborIndex(oppositeDir);
-                    for (int i = 0, end = commCells[dir].reals.size(); i < end; ++i)
+                    if (usePlans)
+                    {
+                        packGhostPlan(outBufferG, ghostPlans[dir], 0, commCells[dir].reals.size(),
+                                      extradata, shift);
+                    }
+                    else
                     {
-                        packPositionsEtc(outBufferG, *commCells[dir].reals[i], extradata, shift);
+                        for (int i = 0, end = commCells[dir].reals.size(); i < end; ++i)
+                        {
+                            packPositionsEtc(outBufferG, *commCells[dir].reals[i], extradata,
+                                             shift);
+                        }
                     }
                 }
                 else
                 {
                     receiver = nodeGrid.getNodeNeighborIndex(oppositeDir);
                     sender = nodeGrid.getNodeNeighborIndex(dir);
-                    for (int i = 0, end = commCells[dir].ghosts.size(); i < end; ++i)
+                    if (usePlans)
+                    {
+                        packGhostPlanForces(outBufferG, ghostPlans[dir], 0,
+                                            commCells[dir].ghosts.size());
+                    }
+                    else
                     {
-                        packForces(outBufferG, *commCells[dir].ghosts[i]);
+                        for (int i = 0, end = commCells[dir].ghosts.size(); i < end; ++i)
+                        {
+                            packForces(outBufferG, *commCells[dir].ghosts[i]);
+                        }
                     }
                 }
 
@@ -436,7 +465,16 @@ void DomainDecompositionNonBlocking::doGhostCommunication(bool sizesFirst,
                 mpi::wait_all(reqs, reqs + 2);
 
                 // unpack received data
-                if (realToGhosts)
+                if (usePlans)
+                {
+                    if (realToGhosts)
+                        unpackGhostPlan(inBufferG, ghostPlans[dir], 0, commCells[dir].ghosts.size(),
+                                        extradata);
+                    else
+                        unpackAndAddGhostPlanForces(inBufferG, ghostPlans[dir], 0,
+                                                    commCells[dir].reals.size());
+                }
+                else if (realToGhosts)
                 {
                     for (int i = 0, end = commCells[dir].reals.size(); i < end; ++i)
                     {
@@ -0,0 +1,77 @@
+/*
+  Copyright (C) 2012,2013
+      Max Planck Institute for Polymer Research
+  Copyright (C) 2008,2009,2010,2011
+      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+
+  This file is part of ESPResSo++.
+
+  ESPResSo++ is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ESPResSo++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _STORAGE_SPACEFILLINGCURVE_HPP
+#define _STORAGE_SPACEFILLINGCURVE_HPP
+/*
+  Morton (Z-order) keys used to lay out cells and particles along a
+  space-filling curve, see Storage::setSpatialSort.
+*/
+
+#include <cstdint>
+#include "types.hpp"
+#include "Real3D.hpp"
+
+namespace espressopp
+{
+namespace storage
+{
+/// number of bins per dimension used for particle keys (21 bits)
+static const real mortonResolution = real(1 << 21);
+
+/// spread the lower 21 bits of x so that there are two zero bits between each
+inline uint64_t mortonSpread(uint64_t x)
+{
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8) & 0x100f00f00f00f00fULL;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2) & 0x1249249249249249ULL;
+    return x;
+}
+
+/// interleave three 21 bit coordinates into one 63 bit key
+inline uint64_t mortonKey(uint64_t x, uint64_t y, uint64_t z)
+{
+    return mortonSpread(x) | (mortonSpread(y) << 1) | (mortonSpread(z) << 2);
+}
+
+/** key of a position, binned with the given scale relative to origin.
+    Positions outside of [0, mortonResolution) bins are clipped. */
+inline uint64_t mortonKey(const Real3D& pos, const Real3D& origin, const Real3D& scale)
+{
+    uint64_t bin[3];
+    for (int d = 0; d < 3; ++d)
+    {
+        real b = (pos[d] - origin[d]) * scale[d];
+        if (b < 0)
+            b = 0;
+        else if (b >= mortonResolution)
+            b = mortonResolution - 1;
+        bin[d] = static_cast<uint64_t>(b);
+    }
+    return mortonKey(bin[0], bin[1], bin[2]);
+}
+}  // namespace storage
+}  // namespace espressopp
+#endif
@@ -37,8 +37,10 @@
 #include "Particle.hpp"
 #include "Buffer.hpp"
 #include "esutil/Error.hpp"
+#include "SpaceFillingCurve.hpp"
 
 #include <iostream>
+#include <algorithm>
 #include <boost/unordered/unordered_map.hpp>
 #include <boost/python/numpy.hpp>
 
@@ -60,6 +62,8 @@ const int Storage::dataOfExchangeGhosts = DATA_PROPERTIES;
 
 Storage::Storage(std::shared_ptr<System> system, int halfCellInt)
     : SystemAccess(system),
+      ghostVelocityRequests(0),
+      spatialSort(false),
       halfCellInt(halfCellInt),
       inBuffer(*system->comm),
       outBuffer(*system->comm)
@@ -300,6 +304,7 @@ Particle *Storage::addParticle(longint id, const Real3D &p, bool checkIfRealPart
     // std::cout << "add particle: " << n.id() << " (" << n.position() << ")\n";
 
     appendIndexedParticle(cell->particles, n);
+    realParticlesModified();
 
     LOG4ESPP_TRACE(logger, "got particle id =" << id << " @ " << p << " ; put it into cell "
                                                << cell - getFirstCell());
@@ -328,6 +333,7 @@ int Storage::removeParticle(longint id)
         cell->particles.resize(newSize);
 
         updateLocalParticles(cell->particles);
+        realParticlesModified();
 
         onParticlesChanged();
         Particle *p1 = lookupRealParticle(id);
@@ -352,6 +358,7 @@ void Storage::removeAllParticles()
     {
         (*it)->particles.clear();
     }
+    realParticlesModified();
     onParticlesChanged();
 }
 
@@ -593,14 +600,76 @@ void Storage::invalidateGhosts()
     }
 }
 
+real Storage::getMaxCellCutoff()
+{
+    Int3D cellGrid = getInt3DCellGrid();
+    real cs0 = (getLocalBoxXMax() - getLocalBoxXMin()) / cellGrid[0];
+    real cs1 = (getLocalBoxYMax() - getLocalBoxYMin()) / cellGrid[1];
+    real cs2 = (getLocalBoxZMax() - getLocalBoxZMin()) / cellGrid[2];
+    return std::min(std::min(cs0, cs1), cs2) * halfCellInt;
+}
+
 void Storage::decompose()
 {
     invalidateGhosts();
     decomposeRealParticles();
+    sortRealParticles();
     exchangeGhosts();
     onParticlesChanged();
 }
 
+void Storage::setSpatialSort(bool _spatialSort)
+{
+    spatialSort = _spatialSort;
+    orderRealCells();
+    // lists and plans that cached the order of the real cells rebuild
+    onParticlesChanged();
+}
+
+void Storage::sortRealParticles()
+{
+    if (!spatialSort) return;
+
+    const Real3D boxMin(getLocalBoxXMin(), getLocalBoxYMin(), getLocalBoxZMin());
+    const Real3D boxMax(getLocalBoxXMax(), getLocalBoxYMax(), getLocalBoxZMax());
+    Real3D scale;
+    for (int d = 0; d < 3; ++d)
+    {
+        scale[d] = mortonResolution / (boxMax[d] - boxMin[d]);
+    }
+
+    std::vector<std::pair<uint64_t, size_t> > keys;
+    ParticleList sorted;
+
+    for (CellList::Iterator it(realCells); it.isValid(); ++it)
+    {
+        ParticleList &particles = (*it)->particles;
+        size_t n = particles.size();
+        if (n < 2) continue;
+
+        keys.resize(n);
+        bool inOrder = true;
+        for (size_t i = 0; i < n; ++i)
+        {
+            keys[i].first = mortonKey(particles[i].position(), boxMin, scale);
+            keys[i].second = i;
+            if (i > 0 && keys[i].first < keys[i - 1].first) inOrder = false;
+        }
+        if (inOrder) continue;
+
+        std::sort(keys.begin(), keys.end());
+
+        sorted.clear();
+        sorted.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            sorted.push_back(particles[keys[i].second]);
+        }
+        particles.swap(sorted);
+        updateLocalParticles(particles);
+    }
+}
+
 void Storage::packPositionsEtc(OutBuffer &buf, Cell &_reals, int extradata, const Real3D &shift)
 {
     ParticleList &reals = _reals.particles;
@@ -1038,7 +1107,9 @@ void Storage::registerPython()
         .def("lookupRealParticle", &Storage::lookupRealParticle,
              return_value_policy<reference_existing_object>())
         .def("decompose", &Storage::decompose)
+        .add_property("spatialSort", &Storage::getSpatialSort, &Storage::setSpatialSort)
         .def("getRealParticleIDs", &Storage::getRealParticleIDs)
+        .def("getNGhostParticles", &Storage::getNGhostParticles)
         .add_property("system", &Storage::getSystem)
         .def("addParticlesFromArray", &addParticlesFromArray);
 }
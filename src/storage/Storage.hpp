@@ -71,6 +71,10 @@ public:
     /** It should return cell grid as an integer vector*/
     virtual Int3D getInt3DCellGrid() = 0;
 
+    /** Largest cutoff+skin covered by the current cell grid, i.e. the
+        smallest local cell size times halfCellInt. */
+    real getMaxCellCutoff();
+
     virtual real getLocalBoxXMin() = 0;
     virtual real getLocalBoxYMin() = 0;
     virtual real getLocalBoxZMin() = 0;
@@ -174,6 +178,13 @@ public:
     CellList& getLocalCells() { return localCells; }
     CellList& getRealCells() { return realCells; }
     CellList& getGhostCells() { return ghostCells; }
+    /** ghost cells that own pairs with other ghosts, only used with eighth-shell ghost
+        communication (see DomainDecomposition). All-pairs loops go over their neighbor cells
+        after the real cells, but not over the pairs inside these cells. */
+    CellList& getGhostPairCells() { return ghostPairCells; }
+    /** true if only part of the ghosts are imported, see DomainDecomposition. Code that
+        needs all neighbors of its real particles has to refuse to run then. */
+    virtual bool getEighthShell() const { return false; }
 
     python::list getRealParticleIDs();
 
@@ -208,6 +219,21 @@ public:
     */
     virtual void decompose();
 
+    /** Switch the space-filling-curve ordering on or off. When on, the
+        real cells are traversed along a Morton curve of their grid
+        coordinates and decompose() sorts the particles of every real
+        cell by the Morton key of their position, so that particles
+        close in space are also close in memory. Particle pointers
+        change on every sort; onParticlesChanged (and onTuplesChanged
+        for AdResS) is emitted as usual at the end of decompose(), so
+        Verlet and bonded lists rebuild from particle ids. Switching the
+        flag reorders the real cells at once and emits onParticlesChanged
+        as well, the particles are sorted by the next decompose(). Off by
+        default.
+    */
+    void setSpatialSort(bool _spatialSort);
+    bool getSpatialSort() const { return spatialSort; }
+
     /** copy minimal information from the real to the ghost
         particles.  Typically this copies the positions and maybe the
         velocities from real to ghost particles. Particle order is
@@ -223,6 +249,20 @@ public:
      * Needed for DPD thermostat for example.
      */
     virtual void updateGhostsV() = 0;
+
+    /**
+     * Ask for velocities to be carried along with every updateGhosts().
+     * Pair thermostats evaluated inside the force loop use this instead of
+     * an extra updateGhostsV() communication round. Requests are counted,
+     * so every request(true) has to be matched by a request(false).
+     */
+    void requestGhostVelocities(bool request)
+    {
+        ghostVelocityRequests += request ? 1 : -1;
+        if (ghostVelocityRequests < 0) ghostVelocityRequests = 0;
+    }
+    bool getGhostVelocities() const { return ghostVelocityRequests > 0; }
+
     virtual void remapNeighbourCells(int cshift) = 0;
 
     /** read back forces from ghost particles by two-sided
@@ -301,9 +341,35 @@ protected:
     static const int dataOfUpdateGhosts;
     static const int dataOfExchangeGhosts;
 
+    /** data elements actually sent by updateGhosts(), i.e. dataOfUpdateGhosts
+        plus the momentum if ghost velocities were requested */
+    int getDataOfUpdateGhosts() const
+    {
+        return dataOfUpdateGhosts | (ghostVelocityRequests > 0 ? DATA_MOMENTUM : 0);
+    }
+
+    /// number of outstanding requestGhostVelocities(true) calls
+    int ghostVelocityRequests;
+
+    /// reorder cells and particles along a space-filling curve, see setSpatialSort()
+    bool spatialSort;
+
+    /** Order the list of real cells. Called whenever the cell structure or
+        the spatialSort flag changes; the default keeps the current order. */
+    virtual void orderRealCells() {}
+
+    /** Sort the particles within each real cell along a Morton curve if
+        spatialSort is set. Called by decompose() right after
+        decomposeRealParticles(); updates the localParticles index.
+    */
+    void sortRealParticles();
+
     /// remove ghost particles from the localParticles index
     virtual void invalidateGhosts();
 
+    /// particles were added to or removed from the real cells outside of decompose()
+    virtual void realParticlesModified() {}
+
     /** pack real particle data for sending. At least positions, maybe
         shifted, and possibly additional data according to extradata.
 
@@ -402,6 +468,8 @@ protected:
     CellList realCells;
     /** list of ghost cells */
     CellList ghostCells;
+    /** list of ghost cells that own pairs, empty unless eighth-shell */
+    CellList ghostPairCells;
     /** all cells on this CPU. Just an index of the cells */
     CellList localCells;
 
@@ -91,6 +91,13 @@ All derived classes implement at least the following methods:
 
   The property 'system' returns the System object of the storage.
 
+* 'spatialSort':
+
+  If set to True, decompose() sorts the particles of every cell along a
+  Morton (Z-order) space-filling curve and the cells are traversed in the
+  same order, which keeps neighboring particles close in memory.
+  Default is False.
+
 Examples:
 
 >>> s.storage.addParticles([[1, espressopp.Real3D(3,3,3)], [2, espressopp.Real3D(4,4,4)]],'id','pos')
@@ -137,6 +144,12 @@ Examples:
 
                 :rtype:
 
+.. function:: espressopp.storage.Storage.getNGhostParticles()
+
+                Number of ghost particles, one entry per CPU.
+
+                :rtype: list of int
+
 .. function:: espressopp.storage.Storage.modifyParticle(pid, property, value)
 
                 :param pid:
@@ -423,6 +436,10 @@ class StorageLocal(object):
         if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
             return self.cxxclass.getRealParticleIDs(self)
 
+    def getNGhostParticles(self):
+        if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
+            return self.cxxclass.getNGhostParticles(self)
+
     def printRealParticles(self):
         if not (pmi._PMIComm and pmi._PMIComm.isActive()) or pmi._MPIcomm.rank in pmi._PMIComm.getMPIcpugroup():
             for pid in self.getRealParticleIDs():
@@ -538,8 +555,8 @@ if pmi.isController:
     class Storage(metaclass=pmi.Proxy):
         pmiproxydefs = dict(
             pmicall = [ "decompose", "addParticles", "setFixedTuplesAdress", "removeAllParticles", "addParticlesArray"],
-            pmiproperty = [ "system" ],
-            pmiinvoke = ["getRealParticleIDs", "printRealParticles"]
+            pmiproperty = [ "system", "spatialSort" ],
+            pmiinvoke = ["getRealParticleIDs", "getNGhostParticles", "printRealParticles"]
             )
 
         def particleExists(self, pid):
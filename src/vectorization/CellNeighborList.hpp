@@ -33,7 +33,9 @@ namespace vectorization
 /// second index corresponds to one cell in particleArray
 /// first index corresponds to neighbor cells
 /// zeroth column contains the index in localcells
-/// first column (first index) contains size N, so columns [1,N+1) represent the neighbors
+/// first column (first index) contains size N, so columns [3,N+3) represent the neighbors
+/// second column is 1 if the pairs within the cell belong to this row, 0 for the ghost cells
+/// that own pairs in the eighth-shell scheme
 class CellNeighborList : private esutil::Array2D<size_t, esutil::enlarge>
 {
 private:
@@ -61,7 +63,10 @@ public:
             if (!nc.useForAllPairs) nnbrs0++;
 
         // Reserve the maximum number of cells
-        Super::resize(nnbrs0 + 2, numCells);
+        Super::resize(nnbrs0 + 3, numCells);
+
+        std::vector<bool> isReal(numCells, false);
+        for (const Cell* cell : realCells) isReal[cell - cell0] = true;
 
         // copy neighbor information, skip cells with no neighbors
         size_t irow = 0;
@@ -74,6 +79,7 @@ public:
             {
                 this->cellId(irow) = icell;
                 this->numNeighbors(irow) = jnbr;
+                this->selfPairs(irow) = isReal[icell];
                 ++irow;
             }
         }
@@ -83,17 +89,19 @@ public:
     }
 
     inline void clear() { Super::clear(); }
-    inline reference at(size_type row, size_type nbr) { return Super::at(nbr + 2, row); }
+    inline reference at(size_type row, size_type nbr) { return Super::at(nbr + 3, row); }
     inline const_reference at(size_type row, size_type nbr) const
     {
-        return Super::operator()(nbr + 2, row);
+        return Super::operator()(nbr + 3, row);
     }
     inline size_type numCells() const { return Super::size_m(); }
-    inline size_type maxNumNeighbors() const { return Super::size_n() - 2; }
+    inline size_type maxNumNeighbors() const { return Super::size_n() - 3; }
     inline reference& cellId(size_type row) { return Super::at(0, row); }
     inline const_reference& cellId(size_type row) const { return Super::operator()(0, row); }
     inline reference& numNeighbors(size_type row) { return Super::at(1, row); }
     inline const_reference& numNeighbors(size_type row) const { return Super::operator()(1, row); }
+    inline reference& selfPairs(size_type row) { return Super::at(2, row); }
+    inline const_reference& selfPairs(size_type row) const { return Super::operator()(2, row); }
 
     void print()
     {
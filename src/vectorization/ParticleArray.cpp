@@ -20,6 +20,7 @@
 
 #include "ParticleArray.hpp"
 #include "Cell.hpp"
+#include <cmath>
 #include <iostream>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -210,6 +211,83 @@ void ParticleArray::addToForceOnly(CellList& srcCells) const
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+void ParticleArray::updateRelativePositions(real const* origin, real const* cellSize)
+{
+    const size_t q_size = ESPP_FIT_TO_VECTOR_WIDTH_FLOAT(reserve_size_);
+    if (q_x.size() < q_size)
+    {
+        q_x.resize(q_size);
+        q_y.resize(q_size);
+        q_z.resize(q_size);
+        g_x.resize(q_size);
+        g_y.resize(q_size);
+        g_z.resize(q_size);
+        fq_x.resize(q_size);
+        fq_y.resize(q_size);
+        fq_z.resize(q_size);
+    }
+
+    real invCellSize[3];
+    for (int i = 0; i < 3; i++)
+    {
+        q_cellSize[i] = cellSize[i];
+        invCellSize[i] = 1.0 / cellSize[i];
+    }
+
+    const size_t numCells = sizes_.size();
+    for (size_t ic = 0; ic < numCells; ic++)
+    {
+        const size_t start = cellRange_[ic];
+        const size_t end = start + sizes_[ic];
+        const size_t data_end = cellRange_[ic + 1];
+        for (size_t pi = start; pi < end; pi++)
+        {
+            real pos[3];
+            if (mode == ESPP_VEC_AOS)
+            {
+                pos[0] = position[pi].x;
+                pos[1] = position[pi].y;
+                pos[2] = position[pi].z;
+            }
+            else
+            {
+                pos[0] = p_x[pi];
+                pos[1] = p_y[pi];
+                pos[2] = p_z[pi];
+            }
+            // the cell of the position, not of the storage, ghosts may be shifted by the shear
+            real g[3];
+            for (int i = 0; i < 3; i++) g[i] = std::floor((pos[i] - origin[i]) * invCellSize[i]);
+            g_x[pi] = g[0];
+            g_y[pi] = g[1];
+            g_z[pi] = g[2];
+            q_x[pi] = pos[0] - (origin[0] + g[0] * cellSize[0]);
+            q_y[pi] = pos[1] - (origin[1] + g[1] * cellSize[1]);
+            q_z[pi] = pos[2] - (origin[2] + g[2] * cellSize[2]);
+        }
+        for (size_t pi = end; pi < data_end; pi++)
+        {
+            q_x[pi] = large_pos_float;
+            q_y[pi] = large_pos_float;
+            q_z[pi] = large_pos_float;
+            g_x[pi] = 0.0f;
+            g_y[pi] = 0.0f;
+            g_z[pi] = 0.0f;
+        }
+    }
+    // fill the last float lane
+    for (size_t pi = data_size_; pi < mixedDataSize(); pi++)
+    {
+        q_x[pi] = large_pos_float;
+        q_y[pi] = large_pos_float;
+        q_z[pi] = large_pos_float;
+        g_x[pi] = 0.0f;
+        g_y[pi] = 0.0f;
+        g_z[pi] = 0.0f;
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 bool ParticleArray::checkSizes()
 {
@@ -132,6 +132,18 @@ public:
     void updateFromPositionOnly(CellList const& srcCells);
     void addToForceOnly(CellList& srcCells) const;
 
+    /** Fill the single precision positions of the mixed precision kernels. Every position is
+        stored relative to the origin of the cell of the grid (origin, cellSize) it falls into,
+        the cell coordinates are stored as floats, which represent small integers exactly.
+        The distance of two particles is then (q_i - q_j) + (g_i - g_j) * cellSize without
+        the rounding error of the absolute coordinates. The arrays are padded to a multiple of
+        ESPP_VECTOR_WIDTH_FLOAT. */
+    void updateRelativePositions(real const* origin, real const* cellSize);
+    /// size of the single precision arrays including the padding to float lanes
+    std::size_t mixedDataSize() const { return ESPP_FIT_TO_VECTOR_WIDTH_FLOAT(data_size_); }
+    bool mixedPrecision() const { return mixed; }
+    void setMixedPrecision(bool _mixed) { mixed = _mixed; }
+
     std::vector<size_t> const& cellRange() const { return cellRange_; }
     std::vector<size_t> const& sizes() const { return sizes_; }
     bool checkSizes();
@@ -148,6 +160,21 @@ public:
     AlignedVector<real> f_z;
     AlignedVector<ulongint> type;
 
+    /* single precision positions relative to the cell origin and cell coordinates, only
+       filled in mixed precision mode (for both SOA and AOS) */
+    AlignedVector<float> q_x;
+    AlignedVector<float> q_y;
+    AlignedVector<float> q_z;
+    AlignedVector<float> g_x;
+    AlignedVector<float> g_y;
+    AlignedVector<float> g_z;
+    float q_cellSize[3];
+    /* single precision forces of the mixed precision kernels, added to the double precision
+       forces at the end of the force loop */
+    AlignedVector<float> fq_x;
+    AlignedVector<float> fq_y;
+    AlignedVector<float> fq_z;
+
 protected:
     /// start=cellRange_[i] to end=cellRange_[i+1] for cell[i] including padding
     std::vector<size_t> cellRange_;
@@ -155,6 +182,7 @@ protected:
     std::vector<size_t> sizes_;
 
     Mode mode;
+    bool mixed = false;
 
     std::size_t size_ = 0;
     std::size_t data_size_ = 0;     // including padding
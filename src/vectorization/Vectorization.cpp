@@ -77,6 +77,7 @@ void Vectorization::disconnect()
 void Vectorization::resetParticles()
 {
     particleArray.copyFrom(getSystem()->storage->getLocalCells(), mode);
+    if (particleArray.mixedPrecision()) updateRelativePositions();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -117,6 +118,7 @@ void Vectorization::befCalcForces()
 
     // overwrite particleArray positon data
     particleArray.updateFromPositionOnly(getSystem()->storage->getLocalCells());
+    if (particleArray.mixedPrecision()) updateRelativePositions();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -127,6 +129,26 @@ void Vectorization::updateForces()
     particleArray.addToForceOnly(getSystem()->storage->getLocalCells());
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// switch the single precision kernels on or off
+void Vectorization::setMixedPrecision(bool mixed)
+{
+    particleArray.setMixedPrecision(mixed);
+    if (mixed) updateRelativePositions();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// positions relative to the cell origin for the mixed precision kernels
+void Vectorization::updateRelativePositions()
+{
+    std::shared_ptr<storage::DomainDecomposition> dd =
+        std::dynamic_pointer_cast<storage::DomainDecomposition>(getSystem()->storage);
+    if (!dd)
+        throw std::runtime_error("Vectorization: mixed precision requires DomainDecomposition");
+    CellGrid const& grid = dd->getCellGrid();
+    particleArray.updateRelativePositions(grid.getMyLeft(), grid.getCellSize());
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// registration with python
 void Vectorization::registerPython()
@@ -135,7 +157,9 @@ void Vectorization::registerPython()
 
     class_<Vectorization, std::shared_ptr<Vectorization> >(
         "Vectorization", init<std::shared_ptr<System>, std::shared_ptr<MDIntegrator>, Mode>())
-        .def(init<std::shared_ptr<System>, std::shared_ptr<MDIntegrator> >());
+        .def(init<std::shared_ptr<System>, std::shared_ptr<MDIntegrator> >())
+        .add_property("mixedPrecision", &Vectorization::getMixedPrecision,
+                      &Vectorization::setMixedPrecision);
 
     enum_<Mode>("VectorizationMode").value("SOA", ESPP_VEC_SOA).value("AOS", ESPP_VEC_AOS);
 }
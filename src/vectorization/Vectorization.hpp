@@ -51,6 +51,12 @@ public:
     ParticleArray& getParticleArray() { return particleArray; }
     CellNeighborList const& getNeighborList() const { return neighborList; }
 
+    /** In mixed precision mode the kernels evaluate and sum up the pair forces in single
+        precision from positions relative to the cell origin, the sums are added to the double
+        precision forces. The Verlet list itself is still built in double precision. */
+    bool getMixedPrecision() const { return particleArray.mixedPrecision(); }
+    void setMixedPrecision(bool mixed);
+
     static void registerPython();
 
 private:
@@ -59,6 +65,7 @@ private:
     void befCalcForces();
     void updatePositions();
     void updateForces();
+    void updateRelativePositions();
 
     CellNeighborList neighborList;
     void resetCells();
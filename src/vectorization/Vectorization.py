@@ -32,6 +32,14 @@ espressopp.vectorization.Vectorization
     :param integrator: integrator object
     :param mode: (default='' equiv to 'SOA') 'SOA' for structure of arrays and 'AOS' for array of structures
 
+.. attribute:: espressopp.vectorization.Vectorization.mixedPrecision
+
+    (default: False) if True, the vectorized pair kernels compute distances and forces
+    in single precision from positions relative to the cell origin, the forces of each
+    particle are summed up in single precision and added to the double precision forces.
+    This covers Lennard-Jones as well as WCA, i.e. a Lennard-Jones potential cut at the
+    minimum with shift='auto'. The Verlet list is still built in double precision.
+
 """
 
 AOS = 'AOS'
@@ -53,5 +61,6 @@ class VectorizationLocal(_espressopp.Vectorization):
 if pmi.isController:
     class Vectorization(object, metaclass=pmi.Proxy):
         pmiproxydefs = dict(
-            cls = 'espressopp.vectorization.VectorizationLocal'
+            cls = 'espressopp.vectorization.VectorizationLocal',
+            pmiproperty = ['mixedPrecision']
         )
@@ -102,7 +102,8 @@ void VerletList::rebuildPairs()
     // add particles to adress zone
     CellList cl = getSystem()->storage->getRealCells();
     LOG4ESPP_DEBUG(theLogger, "local cell list size = " << cl.size());
-    for (CellListAllPairsIterator it(cl); it.isValid(); ++it)
+    for (CellListAllPairsIterator it(cl, getSystem()->storage->getGhostPairCells()); it.isValid();
+         ++it)
     {
         checkPair(*it->first, *it->second);
         LOG4ESPP_DEBUG(theLogger,
@@ -127,6 +128,11 @@ void VerletList::rebuild()
     const bool VEC_MODE_AOS = getParticleArray().mode_aos();
     const bool PACK_NEIGHBORS = true;
 
+    if (clusterPairs)
+    {
+        rebuildClusters();
+    }
+    else
     {
         if (VEC_MODE_AOS)
         {
@@ -165,6 +171,10 @@ void VerletList::rebuild_p_nc_pack_stencil()
         const auto* __restrict pa_p_z = particleArray.p_z.data();
         const auto* __restrict pa_p_type = particleArray.type.data();
 
+        // the mixed precision kernels run on float lanes
+        const size_t lanes =
+            particleArray.mixedPrecision() ? ESPP_VECTOR_WIDTH_FLOAT : ESPP_VECTOR_WIDTH;
+
         // number of cells with neighbors
         const size_t numRealCells = cellNborList.numCells();
         const size_t numCells = particleArray.sizes().size();
@@ -185,7 +195,8 @@ void VerletList::rebuild_p_nc_pack_stencil()
         size_t max_cell_size = 0, nplist_reserve;
         for (size_t icell = 0; icell < numCells; icell++)
             max_cell_size = std::max(max_cell_size, sizes[icell]);
-        size_t max_pairs_per_cell = max_cell_size * max_cell_size * (max_nneighbors + 1);
+        size_t max_pairs_per_cell =
+            max_cell_size * (max_cell_size * (max_nneighbors + 1) + lanes - 1);
         nplist_reserve = neighborList.nplist.size();  // re-use previous allocation
 
         /////////////////////////////////////////////////////////////////////////////////////////////
@@ -316,6 +327,7 @@ void VerletList::rebuild_p_nc_pack_stencil()
 
             size_t cell_id = cellNborList.cellId(irow);
             size_t cell_nnbrs = cellNborList.numNeighbors(irow);
+            bool cell_self = cellNborList.selfPairs(irow);
             size_t cell_start = cellRange[cell_id];
             size_t cell_size = sizes[cell_id];
             size_t cell_end = cell_start + cell_size;
@@ -337,6 +349,7 @@ void VerletList::rebuild_p_nc_pack_stencil()
                 }
 
                 // self-loop
+                if (cell_self)
                 {
                     size_t ncell_id = cell_id;
 
@@ -468,8 +481,8 @@ void VerletList::rebuild_p_nc_pack_stencil()
                 if (new_pairs)
                 {
                     // pad remaining part of list with stray neighbor particle
-                    size_t num_rem = num_pairs % ESPP_VECTOR_WIDTH;
-                    size_t num_pad = (num_rem > 0) * (ESPP_VECTOR_WIDTH - num_rem);
+                    size_t num_rem = num_pairs % lanes;
+                    size_t num_pad = (num_rem > 0) * (lanes - num_rem);
                     size_t padding = cellRange[last_ncell] + sizes[last_ncell];
                     for (size_t pad = 0; pad < num_pad; pad++)
                         neighborList.nplist[num_pairs++] = padding;
@@ -502,6 +515,215 @@ void VerletList::rebuild_p_nc_pack_stencil()
 
 /*-------------------------------------------------------------*/
 
+void VerletList::setClusterPairs(bool _clusterPairs)
+{
+    clusterPairs = _clusterPairs;
+    rebuild();
+}
+
+void VerletList::gatherClusters()
+{
+    const int W = ESPP_VECTOR_WIDTH;
+    const auto& particleArray = vec->getParticleArray();
+    const bool VEC_MODE_AOS = particleArray.mode_aos();
+    ClusterList& cl = clusterList;
+    const size_t numClusters = cl.start.size();
+    const size_t total = numClusters * W;
+    if (cl.x.size() < total)
+    {
+        cl.x.resize(total);
+        cl.y.resize(total);
+        cl.z.resize(total);
+        cl.f_x.resize(total);
+        cl.f_y.resize(total);
+        cl.f_z.resize(total);
+        cl.type.resize(total);
+    }
+
+    for (size_t c = 0; c < numClusters; c++)
+    {
+        const int start = cl.start[c];
+        const int size = cl.size[c];
+        const size_t base = c * W;
+        for (int k = 0; k < size; k++)
+        {
+            if (VEC_MODE_AOS)
+            {
+                const auto& pos = particleArray.position[start + k];
+                cl.x[base + k] = pos.x;
+                cl.y[base + k] = pos.y;
+                cl.z[base + k] = pos.z;
+                cl.type[base + k] = pos.t;
+            }
+            else
+            {
+                cl.x[base + k] = particleArray.p_x[start + k];
+                cl.y[base + k] = particleArray.p_y[start + k];
+                cl.z[base + k] = particleArray.p_z[start + k];
+                cl.type[base + k] = particleArray.type[start + k];
+            }
+        }
+        // padding is far away from everything, but not from other padding
+        for (int k = size; k < W; k++)
+        {
+            cl.x[base + k] = large_pos;
+            cl.y[base + k] = large_pos;
+            cl.z[base + k] = large_pos;
+            cl.type[base + k] = 0;
+        }
+    }
+    std::fill(cl.f_x.begin(), cl.f_x.begin() + total, 0.0);
+    std::fill(cl.f_y.begin(), cl.f_y.begin() + total, 0.0);
+    std::fill(cl.f_z.begin(), cl.f_z.begin() + total, 0.0);
+}
+
+void VerletList::scatterClusterForces()
+{
+    const int W = ESPP_VECTOR_WIDTH;
+    auto& particleArray = vec->getParticleArray();
+    const bool VEC_MODE_AOS = particleArray.mode_aos();
+    const ClusterList& cl = clusterList;
+
+    for (size_t c = 0; c < cl.start.size(); c++)
+    {
+        const int start = cl.start[c];
+        const size_t base = c * W;
+        for (int k = 0; k < cl.size[c]; k++)
+        {
+            if (VEC_MODE_AOS)
+            {
+                auto& force = particleArray.force[start + k];
+                force.x += cl.f_x[base + k];
+                force.y += cl.f_y[base + k];
+                force.z += cl.f_z[base + k];
+            }
+            else
+            {
+                particleArray.f_x[start + k] += cl.f_x[base + k];
+                particleArray.f_y[start + k] += cl.f_y[base + k];
+                particleArray.f_z[start + k] += cl.f_z[base + k];
+            }
+        }
+    }
+}
+
+void VerletList::rebuildClusters()
+{
+    const int W = ESPP_VECTOR_WIDTH;
+    const auto& cellNborList = vec->getNeighborList();
+    const auto& particleArray = vec->getParticleArray();
+    const size_t* cellRange = particleArray.cellRange().data();
+    const size_t* sizes = particleArray.sizes().data();
+    const size_t numCells = particleArray.sizes().size();
+    ClusterList& cl = clusterList;
+
+    // cut the cells into clusters, the clusters of cell c are [cellClusters[c], cellClusters[c+1])
+    cl.clear();
+    std::vector<int> cellClusters(numCells + 1);
+    for (size_t c = 0; c < numCells; c++)
+    {
+        cellClusters[c] = cl.start.size();
+        for (size_t s = 0; s < sizes[c]; s += W)
+        {
+            cl.start.push_back(cellRange[c] + s);
+            cl.size.push_back(std::min<size_t>(W, sizes[c] - s));
+        }
+    }
+    cellClusters[numCells] = cl.start.size();
+    gatherClusters();
+
+    // bounding boxes
+    const size_t numClusters = cl.start.size();
+    std::vector<real> bbMin(3 * numClusters), bbMax(3 * numClusters);
+    for (size_t c = 0; c < numClusters; c++)
+    {
+        const size_t base = c * W;
+        real* lo = &bbMin[3 * c];
+        real* hi = &bbMax[3 * c];
+        lo[0] = hi[0] = cl.x[base];
+        lo[1] = hi[1] = cl.y[base];
+        lo[2] = hi[2] = cl.z[base];
+        for (int k = 1; k < cl.size[c]; k++)
+        {
+            lo[0] = std::min(lo[0], cl.x[base + k]);
+            lo[1] = std::min(lo[1], cl.y[base + k]);
+            lo[2] = std::min(lo[2], cl.z[base + k]);
+            hi[0] = std::max(hi[0], cl.x[base + k]);
+            hi[1] = std::max(hi[1], cl.y[base + k]);
+            hi[2] = std::max(hi[2], cl.z[base + k]);
+        }
+        for (int k = 0; k < cl.size[c]; k++) max_type = std::max(max_type, cl.type[base + k]);
+    }
+    auto bbDistSqr = [&](int ic, int jc) {
+        real d2 = 0.0;
+        for (int i = 0; i < 3; i++)
+        {
+            real d = std::max(bbMin[3 * jc + i] - bbMax[3 * ic + i],
+                              bbMin[3 * ic + i] - bbMax[3 * jc + i]);
+            if (d > 0.0) d2 += d * d;
+        }
+        return d2;
+    };
+
+    // cluster pairs, the same cell pairs as the neighbor list of single particles
+    for (size_t irow = 0; irow < cellNborList.numCells(); irow++)
+    {
+        const size_t cell_id = cellNborList.cellId(irow);
+        const size_t cell_nnbrs = cellNborList.numNeighbors(irow);
+        const bool cell_self = cellNborList.selfPairs(irow);
+        for (int ic = cellClusters[cell_id]; ic < cellClusters[cell_id + 1]; ic++)
+        {
+            const size_t prev = cl.cj.size();
+            if (cell_self)
+            {
+                for (int jc = ic; jc < cellClusters[cell_id + 1]; jc++)
+                    if (bbDistSqr(ic, jc) <= cutsq) cl.cj.push_back(jc);
+            }
+            for (size_t inbr = 0; inbr < cell_nnbrs; inbr++)
+            {
+                const size_t ncell_id = cellNborList.at(irow, inbr);
+                for (int jc = cellClusters[ncell_id]; jc < cellClusters[ncell_id + 1]; jc++)
+                    if (bbDistSqr(ic, jc) <= cutsq) cl.cj.push_back(jc);
+            }
+            if (cl.cj.size() > prev)
+            {
+                cl.ci.push_back(ic);
+                cl.cjrange.push_back(cl.cj.size());
+            }
+        }
+    }
+
+    // count the particle pairs within the Verlet cutoff for localSize
+    int cj_min = 0;
+    for (size_t k = 0; k < cl.ci.size(); k++)
+    {
+        const int ic = cl.ci[k];
+        for (int n = cj_min; n < cl.cjrange[k]; n++)
+        {
+            const int jc = cl.cj[n];
+            for (int ii = 0; ii < cl.size[ic]; ii++)
+            {
+                const size_t i = ic * W + ii;
+                const int jj_min = (jc == ic) ? ii + 1 : 0;
+                for (int jj = jj_min; jj < W; jj++)
+                {
+                    const size_t j = jc * W + jj;
+                    const real dx = cl.x[i] - cl.x[j];
+                    const real dy = cl.y[i] - cl.y[j];
+                    const real dz = cl.z[i] - cl.z[j];
+                    num_pairs += (dx * dx + dy * dy + dz * dz <= cutsq);
+                }
+            }
+        }
+        cj_min = cl.cjrange[k];
+    }
+
+    LOG4ESPP_DEBUG(theLogger, "rebuilt cluster pair list, " << cl.ci.size() << " i clusters, "
+                                                            << cl.cj.size() << " cluster pairs");
+}
+
+/*-------------------------------------------------------------*/
+
 void VerletList::checkPair(Particle& pt1, Particle& pt2)
 {
     Real3D d = pt1.position() - pt2.position();
@@ -596,6 +818,7 @@ void VerletList::registerPython()
         init<std::shared_ptr<System>, std::shared_ptr<Vectorization>, real, bool>())
         .add_property("system", &SystemAccess::getSystem)
         .add_property("builds", &VerletList::getBuilds, &VerletList::setBuilds)
+        .add_property("clusterPairs", &VerletList::getClusterPairs, &VerletList::setClusterPairs)
         .def("totalSize", &VerletList::totalSize)
         .def("localSize", &VerletList::localSize)
         .def("getPair", &VerletList::getPair)
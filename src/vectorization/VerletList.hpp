@@ -74,6 +74,36 @@ public:
         }
     };
 
+    /** Cluster pair list. The particles of every cell are cut into clusters of
+        ESPP_VECTOR_WIDTH consecutive entries of the particle array, and two clusters are
+        paired if their bounding boxes are closer than the Verlet cutoff. The force kernels
+        then loop over all ESPP_VECTOR_WIDTH x ESPP_VECTOR_WIDTH particles of a cluster pair
+        with masks, instead of checking a padded list of single neighbors. The clusters are
+        only compact if the particles of a cell are, so storage.spatialSort should be on.
+     */
+    struct ClusterList
+    {
+        std::vector<int> start;    // first particle of each cluster in the particle array
+        std::vector<int> size;     // number of particles of each cluster
+        std::vector<int> ci;       // clusters that have j clusters
+        std::vector<int> cjrange;  // end of the j clusters of ci[k] in cj
+        std::vector<int> cj;
+
+        // positions, types and forces in cluster order, ESPP_VECTOR_WIDTH per cluster
+        AlignedVector<real> x, y, z;
+        AlignedVector<real> f_x, f_y, f_z;
+        AlignedVector<std::uint64_t> type;
+
+        void clear()
+        {
+            start.clear();
+            size.clear();
+            ci.clear();
+            cjrange.clear();
+            cj.clear();
+        }
+    };
+
     /** Build a verlet list of all particle pairs stored in Vectorization
         whose distance is less than a given cutoff.
 
@@ -90,6 +120,18 @@ public:
 
     NeighborList& getNeighborList() { return neighborList; }
 
+    ClusterList& getClusterList() { return clusterList; }
+
+    /** Build the cluster pair list instead of the neighbor list of single particles */
+    bool getClusterPairs() const { return clusterPairs; }
+    void setClusterPairs(bool _clusterPairs);
+
+    /** Copy the current positions into the cluster order and zero the cluster forces */
+    void gatherClusters();
+
+    /** Add the cluster forces to the particle array */
+    void scatterClusterForces();
+
     ParticleArray& getParticleArray();
 
     python::tuple getPair(int i);
@@ -141,8 +183,12 @@ protected:
     template <bool VEC_MODE_AOS, bool PACK_NEIGHBORS>
     void rebuild_p_nc_pack_stencil();
 
+    void rebuildClusters();
+
     PairList vlPairs;
     NeighborList neighborList;
+    ClusterList clusterList;
+    bool clusterPairs = false;
     boost::unordered_set<std::pair<longint, longint> > exList;  // exclusion list
 
     std::uint64_t max_type;
@@ -62,6 +62,15 @@ NOTE:
 
                 :rtype:
 
+.. attribute:: espressopp.vectorization.VerletList.clusterPairs
+
+                If True, the list pairs clusters of ESPP_VECTOR_WIDTH particles whose
+                bounding boxes are within the Verlet cutoff, and the force kernels work
+                on dense cluster x cluster blocks. Switch on storage.spatialSort as well
+                to get compact clusters. Default is False.
+
+                :type: bool
+
 .. function:: espressopp.vectorization.VerletList.rebuildPairs()
 
                 Rebuilds the non-vectorized Particle pair list which is needed when calculating the energy
@@ -130,7 +139,7 @@ if pmi.isController:
     class VerletList(object, metaclass=pmi.Proxy):
         pmiproxydefs = dict(
           cls = 'espressopp.vectorization.VerletListLocal',
-          pmiproperty = [ 'builds' ],
+          pmiproperty = [ 'builds', 'clusterPairs' ],
           pmicall = [ 'totalSize', 'exclude', 'connect', 'disconnect', 'getVerletCutoff', 'resetTimers','rebuildPairs'],
           pmiinvoke = [ 'getAllPairs','getTimers' ]
         )
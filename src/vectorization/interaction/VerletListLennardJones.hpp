@@ -64,6 +64,13 @@ protected:
         real ff1, ff2;
     };
 
+    struct LJCoefficientsMixed
+    {
+        LJCoefficientsMixed(float const &ff1, float const &ff2) : ff1(ff1), ff2(ff2) {}
+        LJCoefficientsMixed() {}
+        float ff1, ff2;
+    };
+
 public:
     VerletListLennardJones(std::shared_ptr<VerletList> _verletList) : verletList(_verletList)
     {
@@ -116,17 +123,27 @@ public:
         p_types = potentialArray.size_m();
         ffs = AlignedVector<LJCoefficients>(np_types * p_types);
         cutoffSqr = AlignedVector<real>(np_types * p_types);
+        ffsMixed = AlignedVector<LJCoefficientsMixed>(np_types * p_types);
+        cutoffSqrMixed = AlignedVector<float>(np_types * p_types);
         AlignedVector<LJCoefficients>::iterator it1 = ffs.begin();
         AlignedVector<real>::iterator it3 = cutoffSqr.begin();
+        AlignedVector<LJCoefficientsMixed>::iterator it4 = ffsMixed.begin();
+        AlignedVector<float>::iterator it5 = cutoffSqrMixed.begin();
         for (auto &p : potentialArray)
         {
             *(it1++) = LJCoefficients(p.getff1(), p.getff2());
             *(it3++) = p.getCutoffSqr();
+            *(it4++) = LJCoefficientsMixed(p.getff1(), p.getff2());
+            *(it5++) = p.getCutoffSqr();
         }
         needRebuildPotential = false;
     }
     template <bool ONETYPE, bool VEC_MODE_AOS>
     void addForces_impl();
+    template <bool ONETYPE, bool VEC_MODE_AOS>
+    void addForces_mixed();
+    template <bool ONETYPE>
+    void addForces_cluster();
     virtual void addForces();
     virtual real computeEnergy();
     virtual real computeEnergyDeriv();
@@ -151,6 +168,8 @@ protected:
     size_t np_types, p_types;
     AlignedVector<LJCoefficients> ffs;
     AlignedVector<real> cutoffSqr;
+    AlignedVector<LJCoefficientsMixed> ffsMixed;
+    AlignedVector<float> cutoffSqrMixed;
     bool needRebuildPotential = true;
 };
 
@@ -168,6 +187,27 @@ inline void VerletListLennardJones::addForces()
     Potential max_pot = getPotential(vlmaxtype, vlmaxtype);
     if (needRebuildPotential) rebuildPotential();
     bool VEC_MODE_AOS = verletList->getParticleArray().mode_aos();
+    if (verletList->getClusterPairs())
+    {
+        if (np_types == 1 && p_types == 1)
+            addForces_cluster<true>();
+        else
+            addForces_cluster<false>();
+        return;
+    }
+    if (verletList->getParticleArray().mixedPrecision())
+    {
+        if (np_types == 1 && p_types == 1)
+            if (VEC_MODE_AOS)
+                addForces_mixed<true, true>();
+            else
+                addForces_mixed<true, false>();
+        else if (VEC_MODE_AOS)
+            addForces_mixed<false, true>();
+        else
+            addForces_mixed<false, false>();
+        return;
+    }
     if (np_types == 1 && p_types == 1)
         if (VEC_MODE_AOS)
             addForces_impl<true, true>();
@@ -336,6 +376,283 @@ inline void VerletListLennardJones::addForces_impl()
     }
 }
 
+/** Same loop as addForces_impl with single precision distances, force factors and forces.
+    The distances are built from positions relative to the cell origin, so they carry no
+    rounding error of the absolute coordinates. The forces are summed up per particle in the
+    float arrays of the particle array and only added to the double precision forces at the
+    end. Neighbor lists and float arrays are padded to ESPP_VECTOR_WIDTH_FLOAT. */
+template <bool ONETYPE, bool VEC_MODE_AOS>
+inline void VerletListLennardJones::addForces_mixed()
+{
+    float ff1_, ff2_, cutoffSqr_;
+    if (ONETYPE)
+    {
+        ff1_ = ffsMixed[0].ff1;
+        ff2_ = ffsMixed[0].ff2;
+        cutoffSqr_ = cutoffSqrMixed[0];
+    }
+
+    auto &particleArray = verletList->getParticleArray();
+    auto &neighborList = verletList->getNeighborList();
+
+    const Real3DInt *pa_pos = particleArray.position.data();
+    Real4D *pa_force = particleArray.force.data();
+
+    const ulongint *__restrict pa_type = particleArray.type.data();
+    const float *__restrict pa_q_x = particleArray.q_x.data();
+    const float *__restrict pa_q_y = particleArray.q_y.data();
+    const float *__restrict pa_q_z = particleArray.q_z.data();
+    const float *__restrict pa_g_x = particleArray.g_x.data();
+    const float *__restrict pa_g_y = particleArray.g_y.data();
+    const float *__restrict pa_g_z = particleArray.g_z.data();
+    float *__restrict pa_fq_x = particleArray.fq_x.data();
+    float *__restrict pa_fq_y = particleArray.fq_y.data();
+    float *__restrict pa_fq_z = particleArray.fq_z.data();
+    real *__restrict pa_f_x = particleArray.f_x.data();
+    real *__restrict pa_f_y = particleArray.f_y.data();
+    real *__restrict pa_f_z = particleArray.f_z.data();
+    const float cell_x = particleArray.q_cellSize[0];
+    const float cell_y = particleArray.q_cellSize[1];
+    const float cell_z = particleArray.q_cellSize[2];
+
+    const int mixed_size = particleArray.mixedDataSize();
+#ifdef __INTEL_COMPILER
+#pragma vector always
+#pragma vector aligned
+#endif
+    for (int i = 0; i < mixed_size; i++)
+    {
+        pa_fq_x[i] = 0.0f;
+        pa_fq_y[i] = 0.0f;
+        pa_fq_z[i] = 0.0f;
+    }
+
+    const auto *__restrict plist = neighborList.plist.data();
+    const auto *__restrict prange = neighborList.prange.data();
+    const auto *__restrict nplist = neighborList.nplist.data();
+    const int ip_max = neighborList.plist.size();
+
+    int in_min = 0;
+    for (int ip = 0; ip < ip_max; ip++)
+    {
+        int p = plist[ip];
+        int p_lookup;
+        if (!ONETYPE)
+        {
+            if (VEC_MODE_AOS)
+                p_lookup = pa_pos[p].t * np_types;
+            else
+                p_lookup = pa_type[p] * np_types;
+        }
+        const float p_q_x = pa_q_x[p];
+        const float p_q_y = pa_q_y[p];
+        const float p_q_z = pa_q_z[p];
+        const float p_g_x = pa_g_x[p];
+        const float p_g_y = pa_g_y[p];
+        const float p_g_z = pa_g_z[p];
+
+        float f_x = 0.0f;
+        float f_y = 0.0f;
+        float f_z = 0.0f;
+
+        const int in_max = prange[ip];
+
+#ifdef __INTEL_COMPILER
+#pragma vector always
+#pragma ivdep
+#endif
+        for (int in = in_min; in < in_max; in++)
+        {
+            auto np_ii = nplist[in];
+            int np_lookup;
+            if (!ONETYPE)
+            {
+                if (VEC_MODE_AOS)
+                    np_lookup = pa_pos[np_ii].t + p_lookup;
+                else
+                    np_lookup = pa_type[np_ii] + p_lookup;
+            }
+
+            // the difference of the cell coordinates is an exact small integer
+            const float dist_x = (p_q_x - pa_q_x[np_ii]) + (p_g_x - pa_g_x[np_ii]) * cell_x;
+            const float dist_y = (p_q_y - pa_q_y[np_ii]) + (p_g_y - pa_g_y[np_ii]) * cell_y;
+            const float dist_z = (p_q_z - pa_q_z[np_ii]) + (p_g_z - pa_g_z[np_ii]) * cell_z;
+
+            const float distSqr = dist_x * dist_x + dist_y * dist_y + dist_z * dist_z;
+            if (!ONETYPE)
+            {
+                cutoffSqr_ = cutoffSqrMixed[np_lookup];
+            }
+
+#if defined(ESPP_VECTOR_MASK)
+            if (distSqr <= cutoffSqr_)
+#endif
+            {
+                float frac2 = 1.0f / distSqr;
+                float frac6 = frac2 * frac2 * frac2;
+                float ffactor;
+
+                if (ONETYPE)
+                    ffactor = ff1_ * frac6 - ff2_;
+                else
+                    ffactor = ffsMixed[np_lookup].ff1 * frac6 - ffsMixed[np_lookup].ff2;
+
+#if !defined(ESPP_VECTOR_MASK)
+                if (distSqr > cutoffSqr_) ffactor = 0.0f;
+#endif
+
+                ffactor = frac6 * ffactor * frac2;
+
+                f_x += dist_x * ffactor;
+                f_y += dist_y * ffactor;
+                f_z += dist_z * ffactor;
+
+                pa_fq_x[np_ii] -= dist_x * ffactor;
+                pa_fq_y[np_ii] -= dist_y * ffactor;
+                pa_fq_z[np_ii] -= dist_z * ffactor;
+            }
+        }
+        pa_fq_x[p] += f_x;
+        pa_fq_y[p] += f_y;
+        pa_fq_z[p] += f_z;
+
+        in_min = in_max;
+    }
+
+    // widen to double precision, the padding particles carry no force
+    const std::vector<size_t> &cellRange = particleArray.cellRange();
+    const std::vector<size_t> &sizes = particleArray.sizes();
+    for (size_t ic = 0; ic < sizes.size(); ic++)
+    {
+        const size_t start = cellRange[ic];
+        const size_t end = start + sizes[ic];
+        if (VEC_MODE_AOS)
+        {
+            for (size_t i = start; i < end; i++)
+            {
+                pa_force[i].x += pa_fq_x[i];
+                pa_force[i].y += pa_fq_y[i];
+                pa_force[i].z += pa_fq_z[i];
+            }
+        }
+        else
+        {
+#ifdef __INTEL_COMPILER
+#pragma vector always
+#pragma ivdep
+#endif
+            for (size_t i = start; i < end; i++)
+            {
+                pa_f_x[i] += pa_fq_x[i];
+                pa_f_y[i] += pa_fq_y[i];
+                pa_f_z[i] += pa_fq_z[i];
+            }
+        }
+    }
+}
+
+/** Force loop over the cluster pair list. Every cluster pair is a dense
+    ESPP_VECTOR_WIDTH x ESPP_VECTOR_WIDTH block, pairs beyond the cutoff and the lower
+    triangle of a cluster with itself are masked out. */
+template <bool ONETYPE>
+inline void VerletListLennardJones::addForces_cluster()
+{
+    const int W = ESPP_VECTOR_WIDTH;
+    real ff1_, ff2_, cutoffSqr_;
+    if (ONETYPE)
+    {
+        ff1_ = ffs[0].ff1;
+        ff2_ = ffs[0].ff2;
+        cutoffSqr_ = cutoffSqr[0];
+    }
+
+    verletList->gatherClusters();
+    auto &cl = verletList->getClusterList();
+
+    const real *__restrict c_x = cl.x.data();
+    const real *__restrict c_y = cl.y.data();
+    const real *__restrict c_z = cl.z.data();
+    const ulongint *__restrict c_type = cl.type.data();
+    real *__restrict c_f_x = cl.f_x.data();
+    real *__restrict c_f_y = cl.f_y.data();
+    real *__restrict c_f_z = cl.f_z.data();
+    const int *__restrict ci = cl.ci.data();
+    const int *__restrict cjrange = cl.cjrange.data();
+    const int *__restrict cj = cl.cj.data();
+    const int *__restrict csize = cl.size.data();
+    const int ci_max = cl.ci.size();
+
+    int cj_min = 0;
+    for (int k = 0; k < ci_max; k++)
+    {
+        const int ic = ci[k];
+        const int cj_max = cjrange[k];
+        for (int n = cj_min; n < cj_max; n++)
+        {
+            const int jc = cj[n];
+            const bool diagonal = (jc == ic);
+            const int j0 = jc * W;
+            for (int ii = 0; ii < csize[ic]; ii++)
+            {
+                const int i = ic * W + ii;
+                const real p_x = c_x[i];
+                const real p_y = c_y[i];
+                const real p_z = c_z[i];
+                int p_lookup;
+                if (!ONETYPE) p_lookup = c_type[i] * np_types;
+
+                real f_x = 0.0;
+                real f_y = 0.0;
+                real f_z = 0.0;
+
+#ifdef __INTEL_COMPILER
+#pragma vector always
+#pragma vector aligned
+#pragma ivdep
+#endif
+                for (int jj = 0; jj < W; jj++)
+                {
+                    const real dist_x = p_x - c_x[j0 + jj];
+                    const real dist_y = p_y - c_y[j0 + jj];
+                    const real dist_z = p_z - c_z[j0 + jj];
+                    const real distSqr = dist_x * dist_x + dist_y * dist_y + dist_z * dist_z;
+
+                    int np_lookup;
+                    if (!ONETYPE)
+                    {
+                        np_lookup = c_type[j0 + jj] + p_lookup;
+                        cutoffSqr_ = cutoffSqr[np_lookup];
+                    }
+
+                    const bool mask = (distSqr <= cutoffSqr_) && (!diagonal || jj > ii);
+                    // the masked pairs include the particle itself, keep 1/distSqr finite
+                    const real frac2 = 1.0 / (mask ? distSqr : 1.0);
+                    const real frac6 = frac2 * frac2 * frac2;
+                    real ffactor;
+                    if (ONETYPE)
+                        ffactor = ff1_ * frac6 - ff2_;
+                    else
+                        ffactor = ffs[np_lookup].ff1 * frac6 - ffs[np_lookup].ff2;
+                    ffactor = mask ? frac6 * ffactor * frac2 : 0.0;
+
+                    f_x += dist_x * ffactor;
+                    f_y += dist_y * ffactor;
+                    f_z += dist_z * ffactor;
+                    c_f_x[j0 + jj] -= dist_x * ffactor;
+                    c_f_y[j0 + jj] -= dist_y * ffactor;
+                    c_f_z[j0 + jj] -= dist_z * ffactor;
+                }
+                c_f_x[i] += f_x;
+                c_f_y[i] += f_y;
+                c_f_z[i] += f_z;
+            }
+        }
+        cj_min = cj_max;
+    }
+
+    verletList->scatterClusterForces();
+}
+
 inline real VerletListLennardJones::computeEnergy()
 {
     LOG4ESPP_DEBUG(_Potential::theLogger,
@@ -41,6 +41,12 @@
 #define ESPP_FIT_TO_VECTOR_WIDTH(SIZE) \
     ((((SIZE) + ESPP_VECTOR_WIDTH - 1) / ESPP_VECTOR_WIDTH) * ESPP_VECTOR_WIDTH)
 
+// number of single precision lanes, used by the mixed precision kernels
+#define ESPP_VECTOR_WIDTH_FLOAT (2 * ESPP_VECTOR_WIDTH)
+
+#define ESPP_FIT_TO_VECTOR_WIDTH_FLOAT(SIZE) \
+    ((((SIZE) + ESPP_VECTOR_WIDTH_FLOAT - 1) / ESPP_VECTOR_WIDTH_FLOAT) * ESPP_VECTOR_WIDTH_FLOAT)
+
 #include <vector>
 #include <boost/align/aligned_allocator.hpp>
 
@@ -56,6 +62,10 @@ using AlignedVector = std::vector<T, boost::alignment::aligned_allocator<T, Alig
 // compatible only with real = double
 static const real large_pos = 7.74099e150;
 
+// padding of the single precision relative positions of the mixed precision kernels, small
+// enough that the squared distance to any particle stays finite
+static const float large_pos_float = 1.0e18f;
+
 }  // namespace vectorization
 }  // namespace espressopp
 
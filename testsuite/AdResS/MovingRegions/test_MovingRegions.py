@@ -0,0 +1,125 @@
+#!/usr/bin/env python
+#
+#  Copyright (C) 2026
+#      Max Planck Institute for Polymer Research & JGU Mainz
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# -*- coding: utf-8 -*-
+#
+
+import math
+import random
+import espressopp
+import mpi4py.MPI as MPI
+import unittest
+
+box = (12.0, 12.0, 12.0)
+dEx = 1.5
+dHy = 1.0
+skin = 0.3
+ncenters = 4
+
+class TestMovingRegions(unittest.TestCase):
+    def setUp(self):
+        system = espressopp.System()
+        system.rng = espressopp.esutil.RNG()
+        system.bc = espressopp.bc.OrthorhombicBC(system.rng, box)
+        system.skin = skin
+        system.comm = MPI.COMM_WORLD
+        nodeGrid = espressopp.tools.decomp.nodeGrid(espressopp.MPI.COMM_WORLD.size, box, rc=1.5, skin=skin)
+        cellGrid = espressopp.tools.decomp.cellGrid(box, nodeGrid, rc=1.5, skin=skin)
+        system.storage = espressopp.storage.DomainDecompositionAdress(system, nodeGrid, cellGrid)
+        self.system = system
+
+        # the centers start next to the subdomain borders (the box border with one CPU along
+        # an axis) and at the periodic box border, and move across them during the run
+        border = [box[d] / nodeGrid[d] for d in range(3)]
+        centers = [
+            ((border[0] - 0.1, border[1] + 0.1, border[2] - 0.05), (1.0, -1.0, 1.0)),
+            ((border[0] + 0.1, 0.5 * border[1], border[2] + 0.1), (-1.0, 0.5, -1.0)),
+            ((0.1, box[1] - 0.1, 0.05), (-1.0, 1.0, -1.0)),
+            ((box[0] - 0.2, 0.2, 0.5 * box[2]), (1.0, -1.0, 0.5)),
+        ]
+
+        # one AT particle per VP, VPs on a jittered lattice with random velocities
+        rng = random.Random(42)
+        vps = [pos for pos, v in centers]
+        vels = [v for pos, v in centers]
+        n = 6
+        for i in range(n):
+            for j in range(n):
+                for k in range(n):
+                    vps.append(tuple((l + 0.5 + rng.uniform(-0.3, 0.3)) * box[0] / n for l in (i, j, k)))
+                    vels.append(tuple(rng.uniform(-1.0, 1.0) for d in range(3)))
+        self.nvps = len(vps)
+
+        particle_list = []
+        tuples = []
+        for i, (pos, v) in enumerate(zip(vps, vels)):
+            vp, at = i + 1, self.nvps + i + 1
+            particle_list.append((vp, 1, espressopp.Real3D(pos), espressopp.Real3D(v), 1.0, 0))
+            particle_list.append((at, 0, espressopp.Real3D(pos), espressopp.Real3D(v), 1.0, 1))
+            tuples.append((vp, at))
+        system.storage.addParticles(particle_list, 'id', 'type', 'pos', 'v', 'mass', 'adrat')
+        ftpl = espressopp.FixedTupleListAdress(system.storage)
+        ftpl.addTuples(tuples)
+        system.storage.setFixedTuplesAdress(ftpl)
+        system.storage.decompose()
+
+        self.vl = espressopp.VerletListAdress(system, cutoff=1.5, adrcut=1.5, dEx=dEx, dHy=dHy,
+                                              pids=list(range(1, ncenters + 1)), sphereAdr=True)
+
+        integrator = espressopp.integrator.VelocityVerlet(system)
+        integrator.dt = 0.01
+        integrator.addExtension(espressopp.integrator.Adress(system, self.vl, ftpl))
+        espressopp.tools.AdressDecomp(system, integrator)
+        self.integrator = integrator
+
+    def reference(self):
+        # what every CPU computed with the all-gathered centers: distance to the nearest
+        # center over all periodic images
+        pos = [self.system.storage.getParticle(pid).pos for pid in range(1, self.nvps + 1)]
+        centers = pos[:ncenters]
+        result = []
+        for p in pos:
+            min1sq = min(sum((p[d] - c[d] - box[d] * round((p[d] - c[d]) / box[d])) ** 2
+                             for d in range(3)) for c in centers)
+            result.append(min1sq)
+        return result
+
+    def weight(self, distanceSqr):
+        if distanceSqr < dEx ** 2:
+            return 1.0
+        if distanceSqr > (dEx + dHy) ** 2:
+            return 0.0
+        return math.cos(0.5 * math.pi / dHy * (math.sqrt(distanceSqr) - dEx)) ** 2
+
+    def test_moving_centers(self):
+        adrsq = (dEx + dHy + skin) ** 2
+        for step in range(5):
+            self.integrator.run(40)
+            # inAdrZone is evaluated on the rebuild, lambda every step
+            self.vl.rebuild()
+            for pid, min1sq in zip(range(1, self.nvps + 1), self.reference()):
+                p = self.system.storage.getParticle(pid)
+                self.assertAlmostEqual(p.lambda_adr, self.weight(min1sq), places=8)
+                # skip the particles right at the border of the zone
+                if abs(math.sqrt(min1sq) - math.sqrt(adrsq)) > 1e-8:
+                    self.assertEqual(p.inAdrZone, min1sq <= adrsq)
+
+if __name__ == '__main__':
+    unittest.main()
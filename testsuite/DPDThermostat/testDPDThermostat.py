@@ -162,6 +162,104 @@ class TestDPDThermostat(unittest.TestCase):
         self.assertAlmostEqual(f_expected[1][1],f_result[1][1],places=5)
         self.assertAlmostEqual(f_expected[1][2],f_result[1][2],places=5)
 
+    def _run_lj_dpd(self, fused):
+        box=(10,10,10)
+        nodeGrid = espressopp.tools.decomp.nodeGrid(espressopp.MPI.COMM_WORLD.size,box, rc=1.5, skin=0.3)
+        cellGrid = espressopp.tools.decomp.cellGrid(box, nodeGrid, rc=1.5, skin=0.3)
+        self.system.storage = espressopp.storage.DomainDecomposition(self.system, nodeGrid, cellGrid)
+
+        particle_list = [
+            (1, 0, espressopp.Real3D(5.0, 5.0, 5.0), espressopp.Real3D( 0.5, 0.25, 0.25), 1.0),
+            (2, 0, espressopp.Real3D(6.1, 5.2, 5.0), espressopp.Real3D(-0.25, 0.5, -0.25), 1.0),
+            (3, 0, espressopp.Real3D(5.4, 5.9, 5.3), espressopp.Real3D( 0.1, -0.3, 0.2), 1.0)
+        ]
+        self.system.storage.addParticles(particle_list, 'id', 'type', 'pos', 'v', 'mass')
+        self.system.storage.decompose()
+
+        vl = espressopp.VerletList(self.system, cutoff=1.5)
+
+        integrator = espressopp.integrator.VelocityVerlet(self.system)
+        integrator.dt = 0.01
+
+        dpd = espressopp.integrator.DPDThermostat(self.system,vl)
+        dpd.gamma = 2.0
+        dpd.tgamma = 5.0
+        dpd.temperature = 2.0
+        integrator.addExtension(dpd)
+
+        pot = espressopp.interaction.LennardJones(epsilon=1.0, sigma=1.0, cutoff=1.5, shift='auto')
+        if fused:
+            interLJ = espressopp.interaction.VerletListDPDLennardJones(vl, dpd)
+        else:
+            interLJ = espressopp.interaction.VerletListLennardJones(vl)
+        interLJ.setPotential(type1=0, type2=0, potential=pot)
+        self.system.addInteraction(interLJ)
+
+        self.system.rng.seed(1)
+        integrator.run(0)
+        self.assertEqual(dpd.fused, fused)
+
+        return [ self.system.storage.getParticle(pid).f for pid in (1, 2, 3) ]
+
+    def test_fused(self):
+        # the fused pair loop has to give the same forces as the separate thermostat pass
+        f_separate = self._run_lj_dpd(False)
+        self.setUp()
+        f_fused = self._run_lj_dpd(True)
+
+        for fs, ff in zip(f_separate, f_fused):
+            for k in range(3):
+                self.assertAlmostEqual(fs[k], ff[k], places=8)
+
+    def test_fused_removed(self):
+        # after removing the fused interaction the thermostat has to do its own pass again
+        box=(5,5,5)
+        nodeGrid = espressopp.tools.decomp.nodeGrid(espressopp.MPI.COMM_WORLD.size,box, rc=1.0, skin=0.3)
+        cellGrid = espressopp.tools.decomp.cellGrid(box, nodeGrid, rc=1.0, skin=0.3)
+        self.system.bc = espressopp.bc.OrthorhombicBC(self.system.rng, box)
+        self.system.storage = espressopp.storage.DomainDecomposition(self.system, nodeGrid, cellGrid)
+
+        # particles at rest on a lattice, only the thermostat can heat them up
+        pid = 0
+        particle_list = []
+        for i in range(7):
+            for j in range(7):
+                for k in range(7):
+                    pid += 1
+                    pos = espressopp.Real3D((i+0.5)*5.0/7, (j+0.5)*5.0/7, (k+0.5)*5.0/7)
+                    particle_list.append((pid, 0, pos, espressopp.Real3D(0.0), 1.0))
+        self.system.storage.addParticles(particle_list, 'id', 'type', 'pos', 'v', 'mass')
+        self.system.storage.decompose()
+
+        vl = espressopp.VerletList(self.system, cutoff=1.0)
+
+        integrator = espressopp.integrator.VelocityVerlet(self.system)
+        integrator.dt = 0.01
+
+        dpd = espressopp.integrator.DPDThermostat(self.system,vl)
+        dpd.gamma = 4.5
+        dpd.tgamma = 0.0
+        dpd.temperature = 1.0
+        integrator.addExtension(dpd)
+
+        pot = espressopp.interaction.SoftCosine(A=1.0, cutoff=1.0, shift=0.0)
+        interSC = espressopp.interaction.VerletListDPDSoftCosine(vl, dpd)
+        interSC.setPotential(type1=0, type2=0, potential=pot)
+        self.system.addInteraction(interSC)
+        self.assertTrue(dpd.fused)
+
+        # interSC is still referenced here, the thermostat must not stay fused
+        self.system.removeInteraction(0)
+        self.assertFalse(dpd.fused)
+
+        integrator.run(1000)
+        temperature = espressopp.analysis.Temperature(self.system)
+        T = 0.0
+        for n in range(10):
+            integrator.run(100)
+            T += temperature.compute() / 10
+        self.assertAlmostEqual(T, dpd.temperature, delta=0.1)
+
 
 if __name__ == '__main__':
     unittest.main()
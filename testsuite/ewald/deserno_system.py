@@ -0,0 +1,51 @@
+#  Copyright (C) 2026
+#      Max Planck Institute for Polymer Research & JGU Mainz
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+# the Deserno test system shared by the K space tests of this directory
+
+import espressopp
+import mpi4py.MPI as MPI
+
+from espressopp import Real3D
+from espressopp.tools import espresso_old
+
+alpha = 1.112583061
+rspacecutoff = 4.9
+skin = 0.09
+
+def setup_system():
+    # returns the system, the box and (position, charge) of every particle
+    Lx, Ly, Lz, x, y, z, type, q, vx, vy, vz, fx, fy, fz, bondpairs = \
+        espresso_old.read('ini_struct_deserno.dat')
+    box = (Lx, Ly, Lz)
+
+    system = espressopp.System()
+    system.rng = espressopp.esutil.RNG()
+    system.bc = espressopp.bc.OrthorhombicBC(system.rng, box)
+    system.skin = skin
+    nodeGrid = espressopp.tools.decomp.nodeGrid(MPI.COMM_WORLD.size, box, rspacecutoff, skin)
+    cellGrid = espressopp.tools.decomp.cellGrid(box, nodeGrid, rspacecutoff, skin)
+    system.storage = espressopp.storage.DomainDecomposition(system, nodeGrid, cellGrid)
+
+    props = ['id', 'pos', 'type', 'q']
+    particles = [(Real3D(x[i], y[i], z[i]), q[i]) for i in range(len(x))]
+    system.storage.addParticles([[i, pos, type[i], qi] for i, (pos, qi) in enumerate(particles)],
+                                *props)
+    system.storage.decompose()
+    return system, box, particles
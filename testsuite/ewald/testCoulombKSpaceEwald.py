@@ -0,0 +1,88 @@
+#  Copyright (C) 2026
+#      Max Planck Institute for Polymer Research & JGU Mainz
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+import cmath
+import math
+import unittest
+import espressopp
+
+from espressopp import Real3D
+from deserno_system import alpha, setup_system
+
+# few enough k vectors for the direct sum in Python
+kmax = 8
+
+def direct_sum(box, shearOffset, particles):
+    # the k space sum particle by particle, as it was done before the tiles: the
+    # same k vectors as CoulombKSpaceEwald, with kz tilted by the shear
+    Lx, Ly, Lz = box
+    cottheta = shearOffset / Lz
+    skmaxsq = (kmax / min(box)) ** 2
+    V = 2. * math.pi * Lx * Ly * Lz
+    energy = -sum(qi * qi for pos, qi in particles) * alpha / math.sqrt(math.pi)
+    forces = [[0., 0., 0.] for p in particles]
+    for kx in range(kmax + 1):
+        for ky in range(-kmax, kmax + 1):
+            for kz in range(-kmax, kmax + 1):
+                m = (kx / Lx, ky / Ly, kz / Lz - cottheta * kx / Lx)
+                msq = sum(c * c for c in m)
+                if msq >= skmaxsq or (kx, ky, kz) == (0, 0, 0):
+                    continue
+                # the kx < 0 half is the complex conjugate
+                weight = (1. if kx == 0 else 2.) * math.exp(-msq * (math.pi / alpha) ** 2) / (msq * V)
+                k = [2. * math.pi * c for c in m]
+                eik = [cmath.exp(1j * sum(k[d] * pos[d] for d in range(3))) for pos, qi in particles]
+                S = sum(qi * e for (pos, qi), e in zip(particles, eik))
+                energy += weight * abs(S) ** 2
+                for f, (pos, qi), e in zip(forces, particles, eik):
+                    fabs = -2. * weight * qi * (S * e.conjugate()).imag
+                    for d in range(3):
+                        f[d] += fabs * k[d]
+    return energy, forces
+
+class TestCoulombKSpaceEwald(unittest.TestCase):
+    def compare_direct(self, shear):
+        # the tiles hold 32 particles, the 100 charges leave the last one partly filled
+        system, box, particles = setup_system()
+        system.shearOffset = shear * box[0]
+
+        # the potential takes the offset on construction
+        pot = espressopp.interaction.CoulombKSpaceEwald(system, 1.0, alpha, kmax)
+        interaction = espressopp.interaction.CellListCoulombKSpaceEwald(system.storage, pot)
+        system.addInteraction(interaction)
+        integrator = espressopp.integrator.VelocityVerlet(system)
+        integrator.dt = 0.0001
+        integrator.run(0)
+
+        energy, forces = direct_sum(box, system.shearOffset, particles)
+        self.assertAlmostEqual(interaction.computeEnergy() / energy, 1.0, places=10)
+        for i, f in enumerate(forces):
+            self.assertLess((system.storage.getParticle(i).f - Real3D(*f)).abs(), 1e-10)
+        return energy
+
+    def test_unsheared(self):
+        self.compare_direct(0.0)
+
+    def test_sheared(self):
+        # and the shear has to change the result at all
+        energy = self.compare_direct(0.3)
+        self.assertGreater(abs(energy / self.compare_direct(0.0) - 1.0), 1e-3)
+
+if __name__ == '__main__':
+    unittest.main()
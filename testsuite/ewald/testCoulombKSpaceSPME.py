@@ -0,0 +1,83 @@
+#  Copyright (C) 2012,2013
+#      Max Planck Institute for Polymer Research
+#  Copyright (C) 2008,2009,2010,2011
+#      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+import unittest
+import espressopp
+
+from deserno_system import alpha, setup_system
+
+def kspace_result(system, num_particles, interaction):
+    system.addInteraction(interaction)
+    integrator = espressopp.integrator.VelocityVerlet(system)
+    integrator.dt = 0.0001
+    integrator.run(0)
+    forces = [system.storage.getParticle(i).f for i in range(num_particles)]
+    energy = interaction.computeEnergy()
+    system.removeInteraction(0)
+    return energy, forces
+
+class TestCoulombKSpaceSPME(unittest.TestCase):
+    def test_compare_ewald(self):
+        # the K space part alone has to agree with the Ewald sum
+        system, box, particles = setup_system()
+        num_particles = len(particles)
+
+        ewald_pot = espressopp.interaction.CoulombKSpaceEwald(system, 1.0, alpha, 30)
+        ewald_int = espressopp.interaction.CellListCoulombKSpaceEwald(system.storage, ewald_pot)
+        energy_ewald, forces_ewald = kspace_result(system, num_particles, ewald_int)
+
+        spme_pot = espressopp.interaction.CoulombKSpaceSPME(system, 1.0, alpha, (32, 32, 32), 6)
+        spme_int = espressopp.interaction.CellListCoulombKSpaceSPME(system.storage, spme_pot)
+        energy_spme, forces_spme = kspace_result(system, num_particles, spme_int)
+
+        self.assertAlmostEqual(energy_spme / energy_ewald, 1.0, places=4)
+        for f0, f1 in zip(forces_ewald, forces_spme):
+            self.assertLess((f0 - f1).abs(), 1e-3)
+
+    def test_compare_ewald_sheared(self):
+        # Lees-Edwards cell with the images across z displaced along x, both sums must
+        # use the same sheared reciprocal lattice; the Ewald potential takes the offset
+        # on construction, SPME on the first force calculation
+        system, box, particles = setup_system()
+        num_particles = len(particles)
+        system.shearOffset = 0.3 * system.bc.boxL[0]
+
+        ewald_pot = espressopp.interaction.CoulombKSpaceEwald(system, 1.0, alpha, 30)
+        ewald_int = espressopp.interaction.CellListCoulombKSpaceEwald(system.storage, ewald_pot)
+        energy_ewald, forces_ewald = kspace_result(system, num_particles, ewald_int)
+
+        spme_pot = espressopp.interaction.CoulombKSpaceSPME(system, 1.0, alpha, (32, 32, 32), 6)
+        spme_int = espressopp.interaction.CellListCoulombKSpaceSPME(system.storage, spme_pot)
+        energy_spme, forces_spme = kspace_result(system, num_particles, spme_int)
+
+        self.assertAlmostEqual(energy_spme / energy_ewald, 1.0, places=4)
+        for f0, f1 in zip(forces_ewald, forces_spme):
+            self.assertLess((f0 - f1).abs(), 1e-3)
+
+        # and the shear has to change the result at all
+        system.shearOffset = 0.0
+        spme_pot = espressopp.interaction.CoulombKSpaceSPME(system, 1.0, alpha, (32, 32, 32), 6)
+        spme_int = espressopp.interaction.CellListCoulombKSpaceSPME(system.storage, spme_pot)
+        energy_unsheared, forces_unsheared = kspace_result(system, num_particles, spme_int)
+        self.assertGreater(abs(energy_unsheared / energy_spme - 1.0), 1e-3)
+
+if __name__ == '__main__':
+    unittest.main()
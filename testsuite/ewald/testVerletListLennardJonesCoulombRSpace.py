@@ -0,0 +1,126 @@
+#  Copyright (C) 2012,2013
+#      Max Planck Institute for Polymer Research
+#  Copyright (C) 2008,2009,2010,2011
+#      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+import unittest
+import espressopp
+import mpi4py.MPI as MPI
+
+from espressopp import Real3D
+from espressopp.tools import espresso_old
+
+alpha = 1.112583061
+rspacecutoff = 4.9
+ljcutoff = 2.5
+skin = 0.09
+
+def setup_system():
+    Lx, Ly, Lz, x, y, z, type, q, vx, vy, vz, fx, fy, fz, bondpairs = \
+        espresso_old.read('ini_struct_deserno.dat')
+    box = (Lx, Ly, Lz)
+
+    system = espressopp.System()
+    system.rng = espressopp.esutil.RNG()
+    system.bc = espressopp.bc.OrthorhombicBC(system.rng, box)
+    system.skin = skin
+    nodeGrid = espressopp.tools.decomp.nodeGrid(MPI.COMM_WORLD.size, box, rspacecutoff, skin)
+    cellGrid = espressopp.tools.decomp.cellGrid(box, nodeGrid, rspacecutoff, skin)
+    system.storage = espressopp.storage.DomainDecomposition(system, nodeGrid, cellGrid)
+
+    props = ['id', 'pos', 'type', 'q']
+    system.storage.addParticles([[i, Real3D(x[i], y[i], z[i]), type[i], q[i]]
+                                 for i in range(len(x))], *props)
+    system.storage.decompose()
+    return system, len(x)
+
+def result(system, num_particles, interactions):
+    for interaction in interactions:
+        system.addInteraction(interaction)
+    integrator = espressopp.integrator.VelocityVerlet(system)
+    integrator.dt = 0.0001
+    integrator.run(0)
+    forces = [system.storage.getParticle(i).f for i in range(num_particles)]
+    energy = sum(interaction.computeEnergy() for interaction in interactions)
+    for interaction in interactions:
+        system.removeInteraction(0)
+    return energy, forces
+
+class TestVerletListLennardJonesCoulombRSpace(unittest.TestCase):
+    def test_shared_list(self):
+        system, num_particles = setup_system()
+
+        vl = espressopp.VerletList.shared(system, rspacecutoff)
+        self.assertIs(espressopp.VerletList.shared(system, rspacecutoff), vl)
+        self.assertIsNot(espressopp.VerletList.shared(system, ljcutoff), vl)
+        self.assertIsNot(espressopp.VerletList.shared(system, rspacecutoff, [(0, 1)]), vl)
+        self.assertIs(espressopp.VerletList.shared(system, rspacecutoff, [(1, 0)]),
+                      espressopp.VerletList.shared(system, rspacecutoff, [(0, 1)]))
+
+        # the lists belong to the system
+        other, num_particles = setup_system()
+        self.assertIsNot(espressopp.VerletList.shared(other, rspacecutoff), vl)
+
+        # changing a shared list would change it for all its users
+        with self.assertRaises(RuntimeError):
+            vl.exclude([(0, 1)])
+        with self.assertRaises(RuntimeError):
+            vl.useCSR = True
+        with self.assertRaises(RuntimeError):
+            vl.pruneBuffer = 0.05
+        self.assertFalse(vl.useCSR)
+        self.assertEqual(vl.pruneBuffer, 0.0)
+
+    def test_max_cutoff(self):
+        # a type pair without a Coulomb potential must not make the cutoff infinite
+        system, num_particles = setup_system()
+        vl = espressopp.VerletList.shared(system, rspacecutoff)
+        combined_int = espressopp.interaction.VerletListLennardJonesCoulombRSpace(vl)
+        combined_int.setPotential1(type1=0, type2=0,
+                                   potential=espressopp.interaction.LennardJones(1.0, 1.0, ljcutoff))
+        system.addInteraction(combined_int)
+        self.assertAlmostEqual(system.maxCutoff, rspacecutoff, places=10)
+
+    def test_compare_separate(self):
+        # one loop over the pairs gives the same as two interactions on the same list
+        system, num_particles = setup_system()
+        vl = espressopp.VerletList.shared(system, rspacecutoff)
+
+        lj_pot = espressopp.interaction.LennardJones(1.0, 1.0, ljcutoff)
+        coulomb_pot = espressopp.interaction.CoulombRSpace(1.0, alpha, rspacecutoff)
+
+        lj_int = espressopp.interaction.VerletListLennardJones(vl)
+        lj_int.setPotential(type1=0, type2=0, potential=lj_pot)
+        coulomb_int = espressopp.interaction.VerletListCoulombRSpace(vl)
+        coulomb_int.setPotential(type1=0, type2=0, potential=coulomb_pot)
+        energy_separate, forces_separate = result(system, num_particles, [lj_int, coulomb_int])
+
+        combined_int = espressopp.interaction.VerletListLennardJonesCoulombRSpace(vl)
+        combined_int.setPotential1(type1=0, type2=0, potential=lj_pot)
+        combined_int.setPotential2(type1=0, type2=0, potential=coulomb_pot)
+        energy_combined, forces_combined = result(system, num_particles, [combined_int])
+
+        # only the order of the summation differs
+        self.assertAlmostEqual(energy_combined / energy_separate, 1.0, places=10)
+        for f0, f1 in zip(forces_separate, forces_combined):
+            self.assertLess((f0 - f1).abs(), 1e-10 * max(1.0, f0.abs()))
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,99 @@
+#  Copyright (C) 2012,2013
+#      Max Planck Institute for Polymer Research
+#  Copyright (C) 2008,2009,2010,2011
+#      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+import unittest
+import espressopp
+
+rc = 2.5
+num_particles = 6**3
+
+def setup_system():
+    system, integrator, vl, interLJ = espressopp.standard_system.LennardJonesLattice(num_particles, rc=rc)
+
+    tuner = espressopp.integrator.SkinTuner(system)
+    tuner.interval = 20
+    tuner.minSkin = 0.1
+    tuner.maxSkin = 0.6
+    integrator.addExtension(tuner)
+    return system, integrator, vl, tuner
+
+class TestSkinTuner(unittest.TestCase):
+    def check_pairs(self, system, vl):
+        # whatever skin the list was built with, no pair inside the cutoff may be missing
+        found = set()
+        for pairs in vl.getAllPairs():
+            found.update((min(pair), max(pair)) for pair in pairs)
+        box = system.bc.boxL
+        pos = [None] + [system.storage.getParticle(pid).pos for pid in range(1, num_particles + 1)]
+        for pid1 in range(1, num_particles + 1):
+            for pid2 in range(pid1 + 1, num_particles + 1):
+                dist2 = 0.0
+                for d in range(3):
+                    dx = pos[pid2][d] - pos[pid1][d]
+                    dx -= box[d] * round(dx / box[d])
+                    dist2 += dx * dx
+                if dist2 < rc * rc:
+                    self.assertIn((pid1, pid2), found)
+
+    def test_first_window(self):
+        # the first step of a run only starts the window, the skin moves by the
+        # initial relative step of 20% after interval more steps
+        system, integrator, vl, tuner = setup_system()
+        integrator.run(tuner.interval)
+        self.assertEqual(system.skin, 0.3)
+        self.assertLess(tuner.bestTime, 0.0)
+        integrator.run(1)
+        self.assertGreater(tuner.bestTime, 0.0)
+        # the lists are still valid for the old skin, the new one is set on the next resort
+        self.assertEqual(system.skin, 0.3)
+        system.storage.decompose()
+        self.assertAlmostEqual(system.skin, 0.36, places=12)
+        self.check_pairs(system, vl)
+
+    def test_tuning(self):
+        system, integrator, vl, tuner = setup_system()
+        for window in range(100):
+            integrator.run(tuner.interval)
+            self.assertGreaterEqual(system.skin, tuner.minSkin)
+            self.assertLessEqual(system.skin, tuner.maxSkin)
+            self.check_pairs(system, vl)
+            if tuner.converged:
+                break
+        self.assertTrue(tuner.converged)
+
+        # once converged the skin stays
+        system.storage.decompose()
+        skin = system.skin
+        self.assertEqual(skin, tuner.bestSkin)
+        integrator.run(5 * tuner.interval)
+        self.assertEqual(system.skin, skin)
+        self.check_pairs(system, vl)
+
+        # reset starts a new search from the tuned skin
+        tuner.reset()
+        self.assertFalse(tuner.converged)
+        integrator.run(tuner.interval + 1)
+        system.storage.decompose()
+        self.assertNotEqual(system.skin, skin)
+        self.check_pairs(system, vl)
+
+if __name__ == '__main__':
+    unittest.main()
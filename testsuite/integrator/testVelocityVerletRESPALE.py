@@ -0,0 +1,133 @@
+#  Copyright (C) 2012,2013
+#      Max Planck Institute for Polymer Research
+#  Copyright (C) 2008,2009,2010,2011
+#      Max-Planck-Institute for Polymer Research & Fraunhofer SCAI
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+import os
+import unittest
+import espressopp
+
+rc = 2.5
+shear = 0.5
+num_particles = 6**3
+
+def setup_system(bonds=False):
+    # the VelocityVerlet of the standard system is not used
+    system, _, vl, interLJ = espressopp.standard_system.LennardJonesLattice(num_particles, rc=rc)
+    interactions = [interLJ]
+
+    if bonds:
+        # chains of 6 along the rows of the lattice, the FENE bonds go on the short time step
+        fpl = espressopp.FixedPairList(system.storage)
+        fpl.addBonds([(i + 1, i + 2) for i in range(num_particles) if i % 6 != 5])
+        interFENE = espressopp.interaction.FixedPairListFENE(
+            system, fpl, espressopp.interaction.FENE(K=30.0, r0=0.0, rMax=1.5))
+        system.addInteraction(interFENE)
+        interactions.append(interFENE)
+
+    return system, interactions
+
+def positions(system):
+    return [system.storage.getParticle(pid).pos for pid in range(1, num_particles + 1)]
+
+def total_energy(system, interactions):
+    ekin = 0.0
+    for pid in range(1, num_particles + 1):
+        v = system.storage.getParticle(pid).v
+        ekin += 0.5 * v.sqr()
+    return ekin + sum(interaction.computeEnergy() for interaction in interactions)
+
+def run_system(respa, steps=200):
+    system, interactions = setup_system()
+
+    if respa:
+        integrator = espressopp.integrator.VelocityVerletRESPALE(system, shear=shear)
+        integrator.multistep = 1
+    else:
+        integrator = espressopp.integrator.VelocityVerletLE(system, shear=shear)
+    integrator.dt = 0.005
+
+    integrator.run(steps)
+    return integrator.step, positions(system)
+
+class TestVelocityVerletRESPALE(unittest.TestCase):
+    def test_single_step(self):
+        # with multistep = 1 the splitting must reproduce VelocityVerletLE
+        step0, pos0 = run_system(False)
+        step1, pos1 = run_system(True)
+
+        self.assertEqual(step0, step1)
+        for p0, p1 in zip(pos0, pos1):
+            for k in range(3):
+                self.assertAlmostEqual(p0[k], p1[k], places=5)
+
+    def test_outer_cadence(self):
+        # without fast forces, the slow forces kick once per multistep short steps with
+        # multistep * dt, which is plain velocity Verlet with the long time step
+        multistep = 4
+        steps = 50
+
+        system, interactions = setup_system()
+        integrator = espressopp.integrator.VelocityVerletRESPALE(system, shear=0.0)
+        integrator.multistep = multistep
+        integrator.dt = 0.002
+        integrator.run(steps)
+        self.assertEqual(integrator.step, multistep * steps)
+        pos1 = positions(system)
+
+        system, interactions = setup_system()
+        integrator = espressopp.integrator.VelocityVerletLE(system, shear=0.0)
+        integrator.dt = multistep * 0.002
+        integrator.run(steps)
+        pos0 = positions(system)
+
+        for p0, p1 in zip(pos0, pos1):
+            for k in range(3):
+                self.assertAlmostEqual(p0[k], p1[k], places=8)
+
+    def test_energy_drift(self):
+        # FENE on the short, LJ on the long time step, no shear: the energy must stay bounded
+        system, interactions = setup_system(bonds=True)
+        integrator = espressopp.integrator.VelocityVerletRESPALE(system, shear=0.0)
+        integrator.multistep = 4
+        integrator.dt = 0.002
+
+        energies = [total_energy(system, interactions)]
+        for block in range(10):
+            integrator.run(25)
+            energies.append(total_energy(system, interactions))
+
+        self.assertEqual(integrator.step, 10 * 25 * 4)
+        for energy in energies:
+            self.assertLess(abs(energy - energies[0]) / num_particles, 5e-3)
+        drift = sum(energies[-3:]) / 3 - sum(energies[1:4]) / 3
+        self.assertLess(abs(drift) / num_particles, 2e-3)
+
+    def test_viscosity_refused(self):
+        # the xz stress output is switched on by a FLAG_VIS file when the system is created
+        open('FLAG_VIS', 'w').close()
+        try:
+            system, interactions = setup_system()
+        finally:
+            os.remove('FLAG_VIS')
+        with self.assertRaises(RuntimeError):
+            espressopp.integrator.VelocityVerletRESPALE(system, shear=shear)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,148 @@
+#  Copyright (C) 2026
+#      Max Planck Institute for Polymer Research & JGU Mainz
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+import math
+import os
+import unittest
+import espressopp
+from espressopp import Real3D
+
+class TestTabulatedPotential(espressopp.tools.TestCase):
+    def setUp(self):
+        self.lj = espressopp.interaction.LennardJones(epsilon=1.0, sigma=1.0, cutoff=2.5, shift='auto')
+
+    def testAccuracy(self):
+        tab = espressopp.interaction.Tabulated(potential=self.lj, rmin=0.8, tolerance=1e-8)
+        self.assertLessEqual(tab.maxError, 1e-8)
+        self.assertAlmostEqual(tab.cutoff, 2.5)
+
+        for i in range(200):
+            r = 0.8 + i * 1.7 / 200
+            e = self.lj.computeEnergy(r)
+            f = self.lj.computeForce(r, 0.0, 0.0)[0]
+            self.assertLessEqual(abs(tab.computeEnergy(r) - e), 1e-8 * max(abs(e), 1.0))
+            self.assertLessEqual(abs(tab.computeForce(r, 0.0, 0.0)[0] - f), 1e-8 * max(abs(f), 1.0))
+
+        # beyond the cutoff
+        self.assertEqual(tab.computeEnergy(2.6), 0.0)
+
+    def testRange(self):
+        # a shorter table gets the smaller cutoff
+        tab = espressopp.interaction.Tabulated(potential=self.lj, rmin=0.9, rmax=2.0, tolerance=1e-6)
+        self.assertLessEqual(tab.maxError, 1e-6)
+        self.assertAlmostEqual(tab.cutoff, 2.0)
+        self.assertAlmostEqual(tab.computeEnergy(1.5), self.lj.computeEnergy(1.5), places=6)
+
+    def testFileTable(self):
+        lj = espressopp.interaction.LennardJones(epsilon=1.0, sigma=1.0, cutoff=2.5, shift=False)
+        filename = 'testTabulatedPotential_lj.tab'
+        espressopp.tools.writeTabFile(lj, filename, N=257, low=0.01, high=2.5)
+        spline = espressopp.interaction.Tabulated(itype=3, filename=filename, cutoff=2.5)
+        sqr = espressopp.interaction.Tabulated(itype=3, filename=filename, cutoff=2.5, sqrtable=True)
+        os.remove(filename)
+        self.assertFalse(spline.sqrTable)
+        self.assertTrue(sqr.sqrTable)
+
+        # the spline of a file table goes through its points
+        delta = (2.5 - 0.01) / 256
+        for i in range(80, 257, 4):
+            r = 0.01 + i * delta
+            e = lj.computeEnergy(r)
+            f = lj.computeForce(r, 0.0, 0.0)[0]
+            self.assertLessEqual(abs(spline.computeEnergy(r) - e), 1e-6 * max(abs(e), 1.0))
+            self.assertLessEqual(abs(spline.computeForce(r, 0.0, 0.0)[0] - f), 1e-6 * max(abs(f), 1.0))
+
+        # the r^2 grid follows the spline between the points
+        for i in range(80, 256, 4):
+            r = 0.01 + (i + 0.5) * delta
+            e = spline.computeEnergy(r)
+            f = spline.computeForce(r, 0.0, 0.0)[0]
+            self.assertLessEqual(abs(sqr.computeEnergy(r) - e), 1e-4 * max(abs(e), 1.0))
+            self.assertLessEqual(abs(sqr.computeForce(r, 0.0, 0.0)[0] - f), 1e-4 * max(abs(f), 1.0))
+
+    def testPairTerm(self):
+        # the Stillinger-Weber pair term is an ordinary pair potential
+        sw = espressopp.interaction.StillingerWeberPairTerm(A=7.05, B=0.6022, p=4, q=0, cutoff=1.8)
+        tab = espressopp.interaction.Tabulated(potential=sw, rmin=0.8, tolerance=1e-8)
+        self.assertLessEqual(tab.maxError, 1e-8)
+        for i in range(50):
+            r = 0.8 + i * 0.99 / 50
+            e = sw.computeEnergy(r)
+            self.assertLessEqual(abs(tab.computeEnergy(r) - e), 1e-8 * max(abs(e), 1.0))
+
+    def testAngular(self):
+        harmonic = espressopp.interaction.AngularHarmonic(K=2.0, theta0=1.9)
+        tab = espressopp.interaction.TabulatedAngular(potential=harmonic, tolerance=1e-8)
+        self.assertLessEqual(tab.maxError, 1e-8)
+        for i in range(1, 100):
+            theta = i * math.pi / 100
+            e = harmonic.computeEnergy(theta)
+            f = harmonic.computeForce(theta)
+            self.assertLessEqual(abs(tab.computeEnergy(theta) - e), 1e-8 * max(abs(e), 1.0))
+            self.assertLessEqual(abs(tab.computeForce(theta) - f), 1e-8 * max(abs(f), 1.0))
+
+    def _compareTriple(self, analytic, tabulated, fixedTripleList, legs):
+        system, integrator = espressopp.standard_system.Minimal(0, (10., 10., 10.), rc=3.0)
+        positions = [Real3D(5.0, 5.0, 5.0)] * 3
+        system.storage.addParticles([(i + 1, 0, positions[i]) for i in range(3)], 'id', 'type', 'pos')
+        system.storage.decompose()
+        ftl = espressopp.FixedTripleList(system.storage)
+        ftl.addTriples([(1, 2, 3)])
+        exact = fixedTripleList(system, ftl, analytic)
+        table = fixedTripleList(system, ftl, tabulated)
+
+        for d12, d32, theta in legs:
+            system.storage.modifyParticle(1, 'pos', Real3D(5.0 + d12, 5.0, 5.0))
+            system.storage.modifyParticle(3, 'pos', Real3D(5.0 + d32 * math.cos(theta),
+                                                           5.0 + d32 * math.sin(theta), 5.0))
+            e = exact.computeEnergy()
+            w = exact.computeVirial()
+            self.assertNotEqual(e, 0.0)
+            self.assertLessEqual(abs(table.computeEnergy() - e), 1e-6 * max(abs(e), 1.0))
+            self.assertLessEqual(abs(table.computeVirial() - w), 1e-6 * max(abs(w), 1.0))
+
+    def testStillingerWeberTripleTerm(self):
+        params = dict(gamma=1.2, theta0=109.47, lmbd=21.0, epsilon=1.0, sigma=1.0, cutoff=1.8)
+        analytic = espressopp.interaction.StillingerWeberTripleTerm(**params)
+        tabulated = espressopp.interaction.StillingerWeberTripleTerm(**params)
+        self.assertLessEqual(tabulated.tabulate(0.8, 1e-8), 1e-8)
+        self._compareTriple(analytic, tabulated,
+                            espressopp.interaction.FixedTripleListStillingerWeberTripleTerm,
+                            [(1.0, 1.1, 1.9), (1.3, 1.2, 1.5), (1.6, 1.7, 2.4), (1.75, 1.0, 2.0)])
+
+        # setting a parameter drops the tables
+        analytic.gamma1 = 1.3
+        tabulated.gamma1 = 1.3
+        self._compareTriple(analytic, tabulated,
+                            espressopp.interaction.FixedTripleListStillingerWeberTripleTerm,
+                            [(1.3, 1.2, 1.5)])
+
+    def testTersoffTripleTerm(self):
+        params = dict(B=471.18, lambda2=1.7322, R=2.85, D=0.15, n=0.78734, beta=1.1e-6, m=3.0,
+                      lambda3=1.7322, gamma=1.0, c=100390.0, d=16.217, theta0=126.74,
+                      cutoff1=3.0, cutoff2=3.0)
+        analytic = espressopp.interaction.TersoffTripleTerm(**params)
+        tabulated = espressopp.interaction.TersoffTripleTerm(**params)
+        self.assertLessEqual(tabulated.tabulate(1.5, 1e-8), 1e-8)
+        self._compareTriple(analytic, tabulated,
+                            espressopp.interaction.FixedTripleListTersoffTripleTerm,
+                            [(2.35, 2.35, 1.9), (2.2, 2.5, 2.2), (2.75, 2.3, 1.7), (2.9, 2.95, 2.0)])
+
+if __name__ == "__main__":
+    unittest.main()
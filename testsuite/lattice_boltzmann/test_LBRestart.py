@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+#
+#  Copyright (C) 2026
+#      Max Planck Institute for Polymer Research & JGU Mainz
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# -*- coding: utf-8 -*-
+
+import espressopp
+from espressopp import Real3D
+
+import h5py
+import numpy as np
+import random
+import shutil
+import unittest
+
+Ni = 8
+Npart = 64
+runSteps = 20
+
+def make_system(particles):
+    box = (Ni, Ni, Ni)
+    system = espressopp.System()
+    system.rng = espressopp.esutil.RNG()
+    system.bc = espressopp.bc.OrthorhombicBC(system.rng, box)
+    system.skin = 0.3
+    nodeGrid = espressopp.tools.decomp.nodeGrid(espressopp.MPI.COMM_WORLD.size)
+    cellGrid = espressopp.tools.decomp.cellGrid(box, nodeGrid, 1.0, system.skin)
+    system.storage = espressopp.storage.DomainDecomposition(system, nodeGrid, cellGrid)
+
+    # ideal gas, only coupled to the fluid
+    system.storage.addParticles(particles, 'id', 'type', 'mass', 'pos', 'v')
+    system.storage.decompose()
+
+    integrator = espressopp.integrator.VelocityVerlet(system)
+    integrator.dt = 0.005
+
+    # the number of coupled particles is fixed when the LB is created
+    lb = espressopp.integrator.LatticeBoltzmann(system, nodeGrid)
+    integrator.addExtension(lb)
+    lb.visc_b = 3.
+    lb.visc_s = 3.
+
+    return system, integrator, lb
+
+def read_conf(step):
+    with h5py.File('dump/lbConf.%d.h5' % step, 'r') as f:
+        return {name: f[name][...] for name in f}
+
+class TestLBRestart(unittest.TestCase):
+    def setUp(self):
+        shutil.rmtree('dump', ignore_errors=True)
+
+        rng = random.Random(7)
+        self.particles = [(pid, 0, 1.0,
+                           Real3D(*[rng.uniform(0., Ni) for d in range(3)]),
+                           Real3D(*[rng.uniform(-0.5, 0.5) for d in range(3)]))
+                          for pid in range(1, Npart + 1)]
+
+    def tearDown(self):
+        shutil.rmtree('dump', ignore_errors=True)
+
+    def test_roundtrip(self):
+        system, integrator, lb = make_system(self.particles)
+        initPop = espressopp.integrator.LBInitPopUniform(system, lb)
+        initPop.createDenVel(1., Real3D(0.))
+        integrator.run(runSteps)
+
+        # the fluid has to be moving and the particles have to feel it
+        lb.saveLBConf()
+        saved = read_conf(runSteps)
+        self.assertEqual(saved['particleForces'].shape, (Npart + 1, 3))
+        self.assertTrue(np.any(saved['particleForces'][1:] != 0.))
+        self.assertTrue(np.any(saved['couplForces'] != 0.))
+
+        particles = []
+        for pid in range(1, Npart + 1):
+            p = system.storage.getParticle(pid)
+            particles.append((pid, 0, 1.0, p.pos, p.v))
+
+        # restart from the checkpoint in a new system; run(0) reads it, hands the
+        # coupling forces to the particles and saves it again as step runSteps + 1
+        system, integrator, lb = make_system(particles)
+        integrator.step = runSteps
+        integrator.run(0)
+        restarted = read_conf(runSteps + 1)
+
+        self.assertEqual(sorted(saved.keys()), sorted(restarted.keys()))
+        for name in saved:
+            self.assertTrue(np.array_equal(saved[name], restarted[name]), name)
+
+        for pid in range(1, Npart + 1):
+            f = system.storage.getParticle(pid).f
+            for d in range(3):
+                self.assertEqual(f[d], saved['particleForces'][pid][d])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+#  Copyright (C) 2026
+#      Max Planck Institute for Polymer Research & JGU Mainz
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# -*- coding: utf-8 -*-
+
+import espressopp
+from espressopp import pmi
+from espressopp import Int3D
+from espressopp import Real3D
+
+import unittest
+
+# the lattice is split along z only, Nz has to be divisible by the number of CPUs
+Nx = Ny = 4
+Nz = 24
+initDen = 1.
+shearRate = 0.5
+dt = 0.005
+
+# sums of the moments over the real sites of each local z-plane, on every CPU
+pmi.exec_("""
+def lbPlaneMoments(lb, nz):
+    import mpi4py.MPI as MPI
+    from espressopp import Int3D
+    halo = 1
+    myNi = lb.getMyNi
+    z0 = MPI.COMM_WORLD.rank * nz // MPI.COMM_WORLD.size
+    planes = []
+    for k in range(halo, myNi[2] - halo):
+        mom = [0., 0., 0., 0.]
+        for i in range(halo, myNi[0] - halo):
+            for j in range(halo, myNi[1] - halo):
+                for l in range(4):
+                    mom[l] += lb.getLBMom(Int3D(i, j, k), l)
+        planes.append((z0 + k - halo, mom))
+    return planes
+""")
+
+class TestLeesEdwardsLB(unittest.TestCase):
+    def setUp(self):
+        box = (Nx, Ny, Nz)
+        system = espressopp.System()
+        system.rng = espressopp.esutil.RNG()
+        system.bc = espressopp.bc.OrthorhombicBC(system.rng, box)
+        system.skin = 0.3
+        nodeGrid = Int3D(1, 1, espressopp.MPI.COMM_WORLD.size)
+        cellGrid = espressopp.tools.decomp.cellGrid(box, nodeGrid, 1.0, system.skin)
+        system.storage = espressopp.storage.DomainDecomposition(system, nodeGrid, cellGrid)
+
+        integrator = espressopp.integrator.VelocityVerletLE(system, shear=shearRate)
+        integrator.dt = dt
+
+        lb = espressopp.integrator.LatticeBoltzmann(system, nodeGrid)
+        integrator.addExtension(lb)
+
+        initPop = espressopp.integrator.LBInitPopUniform(system, lb)
+        initPop.createDenVel(initDen, Real3D(0.))
+
+        self.system = system
+        self.integrator = integrator
+        self.lb = lb
+
+    def planes(self):
+        # density and mass flux per z-plane of the whole lattice
+        planes = {}
+        for cpuPlanes in pmi.invoke('lbPlaneMoments', self.lb, Nz):
+            for k, mom in cpuPlanes:
+                planes[k] = mom
+        self.assertEqual(sorted(planes.keys()), list(range(Nz)))
+        return [planes[k] for k in range(Nz)]
+
+    def check_conservation(self, planes, du):
+        area = Nx * Ny
+        mass = sum(mom[0] for mom in planes) / (area * Nz)
+        self.assertAlmostEqual(mass, initDen, places=10)
+        # the fluid starts at rest; what crosses the sliding plane at the top
+        # re-enters at the bottom, so no net momentum may be created
+        for l in range(1, 4):
+            self.assertAlmostEqual(sum(mom[l] for mom in planes) / (area * Nz), 0., delta=1e-4 * du)
+
+    def test_shear_profile(self):
+        # velocity jump across the sliding plane in lattice units
+        du = shearRate * Nz * dt
+
+        # profile still building up from the boundaries
+        self.integrator.run(100)
+        planes = self.planes()
+        self.check_conservation(planes, du)
+        self.assertGreater(planes[Nz - 1][1] / (Nx * Ny), 0.1 * du)
+
+        # steady state: linear v_x(z) with slope shearRate, zero mean
+        self.integrator.run(4000)
+        planes = self.planes()
+        self.check_conservation(planes, du)
+
+        for k in range(Nz):
+            den = planes[k][0]
+            vx = planes[k][1] / den
+            print(k, vx, du * (k - 0.5 * (Nz - 1)) / Nz)
+            self.assertAlmostEqual(vx, du * (k - 0.5 * (Nz - 1)) / Nz, delta=0.01 * du)
+            self.assertAlmostEqual(planes[k][2] / den, 0., delta=1e-4 * du)
+            self.assertAlmostEqual(planes[k][3] / den, 0., delta=1e-4 * du)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -80,6 +80,51 @@ class TestMinimizeEnergy(unittest.TestCase):
         self.assertLessEqual(minimize_energy.f_max, 1.0)
         self.assertLess(interaction.computeEnergy(), energy_before)
 
+    def _lj_cluster(self):
+        # a few overlapping particles, as after building a melt
+        particle_list = [
+            (1, espressopp.Real3D(2.0, 2.0, 2.0), 1.0),
+            (2, espressopp.Real3D(2.5, 2.1, 2.0), 1.0),
+            (3, espressopp.Real3D(2.2, 2.6, 2.1), 1.0),
+            (4, espressopp.Real3D(2.3, 2.3, 2.6), 1.0),
+            (5, espressopp.Real3D(2.9, 2.6, 2.4), 1.0),
+        ]
+        self.system.storage.addParticles(particle_list, 'id', 'pos', 'mass')
+        self.system.storage.decompose()
+        for pid in range(1, 6):
+            self.system.storage.modifyParticle(pid, 'v', espressopp.Real3D(0.1 * pid, -0.2, 0.3))
+
+        vl = espressopp.VerletList(self.system, cutoff=2.5)
+        lj = espressopp.interaction.LennardJones(sigma=1.0, epsilon=1.0, cutoff=2.5)
+        interaction = espressopp.interaction.VerletListLennardJones(vl)
+        interaction.setPotential(type1=0, type2=0, potential=lj)
+        self.system.addInteraction(interaction)
+        return interaction
+
+    def _check_method(self, method, max_steps):
+        interaction = self._lj_cluster()
+        energy_before = interaction.computeEnergy()
+        minimize_energy = espressopp.integrator.MinimizeEnergy(
+            self.system, gamma=0.0005, ftol=0.1, max_displacement=0.01, method=method)
+        self.assertEqual(minimize_energy.method, method)
+        self.assertTrue(minimize_energy.run(max_steps))
+        self.assertLessEqual(minimize_energy.f_max, 0.1)
+        self.assertLess(interaction.computeEnergy(), energy_before)
+        # the velocities used by the minimizer are given back
+        for pid in range(1, 6):
+            v = self.system.storage.getParticle(pid).v
+            self.assertEqual((v[0], v[1], v[2]), (0.1 * pid, -0.2, 0.3))
+
+    def test_fire(self):
+        self._check_method('fire', 5000)
+
+    def test_cg(self):
+        self._check_method('cg', 5000)
+
+    def test_unknown_method(self):
+        with self.assertRaises(Exception):
+            espressopp.integrator.MinimizeEnergy(self.system, 0.001, 0.0, 0.001, method='newton')
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -46,8 +46,7 @@ class TestRattle(unittest.TestCase):
         self.system = system
 
 
-    def test_rattle(self):
-
+    def setup_molecule(self):
         #add particles
         # 4-3-5
         #   |
@@ -95,6 +94,10 @@ class TestRattle(unittest.TestCase):
         adress = espressopp.integrator.Adress(self.system,vl,ftpl)
         integrator.addExtension(adress)
         espressopp.tools.AdressDecomp(self.system, integrator)
+        return integrator, constrainedBondsList, constraintDist2
+
+    def test_rattle(self):
+        integrator, constrainedBondsList, constraintDist2 = self.setup_molecule()
 
         rattle = espressopp.integrator.Rattle(self.system, maxit = 1000, tol = 1e-6, rptol = 1e-6)
         rattle.addConstrainedBonds(constrainedBondsList)
@@ -116,6 +119,29 @@ class TestRattle(unittest.TestCase):
             vsum += sqrlen(part.v)
         self.assertAlmostEqual(vsum,0.3842668659,places=6)
 
+    def test_lincs(self):
+        integrator, constrainedBondsList, constraintDist2 = self.setup_molecule()
+
+        rattle = espressopp.integrator.Rattle(self.system, lincsOrder = 16, lincsIter = 2)
+        rattle.addConstrainedBonds(constrainedBondsList)
+        integrator.addExtension(rattle)
+
+        integrator.run(50)
+
+        #the bond lengths are kept and there is no relative velocity along the bonds
+        for i,bond in enumerate(constrainedBondsList):
+            p1 = self.system.storage.getParticle(bond[0])
+            p2 = self.system.storage.getParticle(bond[1])
+            rab = self.system.bc.getMinimumImageVector(p1.pos,p2.pos)
+            self.assertAlmostEqual(constraintDist2[i],sqrlen(rab),places=8)
+            self.assertAlmostEqual((p1.v-p2.v)*rab,0.0,places=8)
+
+    def test_duplicate_bond(self):
+        rattle = espressopp.integrator.Rattle(self.system)
+        rattle.addConstrainedBonds([[1, 2, 0.1, 3.0, 1.0]])
+        with self.assertRaises(RuntimeError):
+            rattle.addConstrainedBonds([[1, 2, 0.1, 3.0, 1.0]])
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+#
+#  Copyright (C) 2026
+#      Max Planck Institute for Polymer Research & JGU Mainz
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+import math
+import unittest
+import espressopp
+import mpi4py.MPI as MPI
+
+mO, mH, distHH, distOH = 16.0, 1.0, 1.58, 1.0
+
+
+def sqrlen(vector):
+    return vector[0]*vector[0]+vector[1]*vector[1]+vector[2]*vector[2]
+
+
+class TestSettle(unittest.TestCase):
+    def setUp(self):
+        system = espressopp.System()
+        box = (10, 10, 10)
+        system.bc = espressopp.bc.OrthorhombicBC(system.rng, box)
+        system.skin = 0.3
+        system.comm = MPI.COMM_WORLD
+        nodeGrid = espressopp.tools.decomp.nodeGrid(espressopp.MPI.COMM_WORLD.size,box,rc=1.5,skin=system.skin)
+        cellGrid = espressopp.tools.decomp.cellGrid(box, nodeGrid, rc=1.5, skin=system.skin)
+        system.storage = espressopp.storage.DomainDecompositionAdress(system, nodeGrid, cellGrid)
+        self.system = system
+
+    def setup_water(self):
+        # two rigid waters, O-H1-H2 in the xy plane around a coarse-grained particle
+        Real3D = espressopp.Real3D
+        hy = math.sqrt(distOH*distOH - 0.25*distHH*distHH)
+        particle_list = []
+        tuples = []
+        for m, (x, v) in enumerate([(3.0, (0.3, -0.1, 0.2)), (6.0, (-0.2, 0.25, -0.15))]):
+            cg = 4*m + 1
+            com = Real3D(x, 3.0 + 2*mH*hy/(mO + 2*mH), 3.0)
+            particle_list += [
+                (cg,     1, com,                                 Real3D(0, 0, 0),          mO + 2*mH, 0),
+                (cg + 1, 0, Real3D(x, 3.0, 3.0),                 Real3D(*v),               mO, 1),
+                (cg + 2, 0, Real3D(x + 0.5*distHH, 3.0 + hy, 3.0), Real3D(0.4, 0.1*m, -0.3), mH, 1),
+                (cg + 3, 0, Real3D(x - 0.5*distHH, 3.0 + hy, 3.0), Real3D(-0.1, 0.5, 0.35),  mH, 1)]
+            tuples.append((cg, cg + 1, cg + 2, cg + 3))
+
+        self.system.storage.addParticles(particle_list, 'id', 'type', 'pos', 'v', 'mass', 'adrat')
+        ftpl = espressopp.FixedTupleListAdress(self.system.storage)
+        ftpl.addTuples(tuples)
+        self.system.storage.setFixedTuplesAdress(ftpl)
+        self.system.storage.decompose()
+        vl = espressopp.VerletListAdress(self.system, cutoff=1.5, adrcut=1.5,
+                                         dEx=5.0, dHy=1.0, pids=[1], sphereAdr=True)
+
+        integrator = espressopp.integrator.VelocityVerlet(self.system)
+        adress = espressopp.integrator.Adress(self.system, vl, ftpl)
+        integrator.addExtension(adress)
+        espressopp.tools.AdressDecomp(self.system, integrator)
+        return integrator, ftpl, [t[0] for t in tuples]
+
+    def test_settle(self):
+        integrator, ftpl, molecules = self.setup_water()
+
+        settle = espressopp.integrator.Settle(self.system, ftpl, mO=mO, mH=mH, distHH=distHH, distOH=distOH)
+        settle.addMolecules(molecules)
+        integrator.addExtension(settle)
+
+        integrator.run(50)
+
+        # the geometry is kept and there is no relative velocity along the bonds
+        for cg in molecules:
+            atoms = [self.system.storage.getParticle(cg + i) for i in range(1, 4)]
+            for (a, b), dist in [((0, 1), distOH), ((0, 2), distOH), ((1, 2), distHH)]:
+                rab = self.system.bc.getMinimumImageVector(atoms[a].pos, atoms[b].pos)
+                self.assertAlmostEqual(sqrlen(rab), dist*dist, places=10)
+                self.assertAlmostEqual((atoms[a].v - atoms[b].v)*rab, 0.0, places=10)
+
+    def test_duplicate_molecule(self):
+        integrator, ftpl, molecules = self.setup_water()
+
+        settle = espressopp.integrator.Settle(self.system, ftpl, mO=mO, mH=mH, distHH=distHH, distOH=distOH)
+        settle.addMolecules(molecules)
+        with self.assertRaises(RuntimeError):
+            settle.addMolecules([molecules[0]])
+
+
+if __name__ == '__main__':
+    unittest.main()
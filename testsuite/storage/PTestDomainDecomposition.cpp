@@ -443,6 +443,64 @@ BOOST_FIXTURE_TEST_CASE(checkGhosts, Fixture)
     BOOST_TEST_MESSAGE("done with collect ghost forces");
 }
 
+BOOST_FIXTURE_TEST_CASE(updateGhostsAfterMove, Fixture)
+{
+    /* one particle per inner cell, then move all reals by the same small
+       offset and check that updateGhosts carries the move to every ghost */
+    CellGrid cGrid = domdec->getCellGrid();
+    NodeGrid nGrid = domdec->getNodeGrid();
+
+    int c = 0;
+    for (int x = 0; x < cGrid.getGridSize(0); ++x)
+    {
+        for (int y = 0; y < cGrid.getGridSize(1); ++y)
+        {
+            for (int z = 0; z < cGrid.getGridSize(2); ++z)
+            {
+                Int3D ipos(x, y, z);
+                Real3D pos;
+                for (int i = 0; i < 3; ++i)
+                {
+                    ipos[i] += nGrid.getNodePosition(i) * cGrid.getGridSize(i);
+                    pos[i] = (0.5 + ipos[i]) * cGrid.getCellSize(i);
+                }
+                domdec->addParticle(c++, pos);
+            }
+        }
+    }
+    domdec->decompose();
+
+    Real3D move;
+    for (int i = 0; i < 3; ++i) move[i] = 0.1 * cGrid.getCellSize(i);
+    for (ESPPIterator<CellList> it(domdec->getRealCells()); it.isValid(); ++it)
+    {
+        for (size_t k = 0; k < (*it)->particles.size(); ++k)
+        {
+            (*it)->particles[k].position() += move;
+        }
+    }
+    domdec->updateGhosts();
+
+    for (ESPPIterator<CellList> it(domdec->getLocalCells()); it.isValid(); ++it)
+    {
+        ParticleList &pl = (*it)->particles;
+        BOOST_CHECK_EQUAL(pl.size(), 1);
+        if (pl.size() != 1) continue;
+
+        Int3D ipos;
+        cGrid.mapIndexToPosition(ipos, *it - domdec->getFirstCell());
+        Real3D pos;
+        for (int i = 0; i < 3; ++i)
+        {
+            int ip = ipos[i] - cGrid.getFrameWidth() +
+                     nGrid.getNodePosition(i) * cGrid.getGridSize(i);
+            pos[i] = (0.5 + ip) * cGrid.getCellSize(i) + move[i];
+        }
+        Real3D delta = pos - pl[0].position();
+        BOOST_CHECK_SMALL(delta * delta, 1e-10);
+    }
+}
+
 bool afterResortCalled = false;
 bool beforeResortCalled = false;
 
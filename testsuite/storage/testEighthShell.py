@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+#  Copyright (C) 2021
+#      Max Planck Institute for Polymer Research & JGU Mainz
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import unittest
+import espressopp
+
+num_particles = 8**3
+
+def setup_system(eighth_shell):
+    system, integrator, vl, interLJ = espressopp.standard_system.LennardJonesLattice(
+        num_particles, T=0.6, eighthShell=eighth_shell)
+    return system, integrator, vl
+
+def folded_positions(system):
+    box = system.bc.boxL
+    return {pid: [system.storage.getParticle(pid).pos[d] % box[d] for d in range(3)]
+            for pid in range(1, num_particles + 1)}
+
+class TestEighthShell(unittest.TestCase):
+    def grids(self, system):
+        nodeGrid = system.storage.getNodeGrid()
+        cellGrid = system.storage.getCellGrid()
+        self.box = [system.bc.boxL[d] for d in range(3)]
+        self.nodeGrid = [nodeGrid[d] for d in range(3)]
+        self.localBox = [self.box[d] / nodeGrid[d] for d in range(3)]
+        self.cellSize = [self.localBox[d] / cellGrid[d] for d in range(3)]
+
+    def rank_of(self, pos):
+        # ranks run over the node grid with x fastest
+        node = [min(int(pos[d] / self.localBox[d]), self.nodeGrid[d] - 1) for d in range(3)]
+        return node[0] + self.nodeGrid[0] * (node[1] + self.nodeGrid[1] * node[2])
+
+    def expected_ghosts(self, rank, positions, eighth_shell):
+        # images of the particles in the ghost frame of one cell around the subdomain,
+        # only the upper half of the frame with eighth shell
+        node = (rank % self.nodeGrid[0], rank // self.nodeGrid[0] % self.nodeGrid[1],
+                rank // (self.nodeGrid[0] * self.nodeGrid[1]))
+        ghosts = 0
+        for pos in positions.values():
+            images, reals = 1, 1
+            for d in range(3):
+                left = node[d] * self.localBox[d]
+                right = left + self.localBox[d]
+                shifted = [pos[d] + k * self.box[d] for k in (-1, 0, 1)]
+                inside = int(left <= pos[d] < right)
+                upper = sum(right <= s < right + self.cellSize[d] for s in shifted)
+                lower = sum(left - self.cellSize[d] <= s < left for s in shifted)
+                images *= inside + upper + (0 if eighth_shell else lower)
+                reals *= inside
+            ghosts += images - reals
+        return ghosts
+
+    def check_pairs(self, system, vl):
+        # every pair within the Verlet cutoff exactly once, on the CPU that owns the
+        # lower corner of the two cells
+        positions = folded_positions(system)
+        cutoff = vl.getVerletCutoff()
+        found = set()
+        for rank, pairs in enumerate(vl.getAllPairs()):
+            for pid1, pid2 in pairs:
+                pair = (min(pid1, pid2), max(pid1, pid2))
+                self.assertNotIn(pair, found)
+                found.add(pair)
+
+                p1, p2 = positions[pid1], positions[pid2]
+                corner = []
+                dist2 = 0.0
+                for d in range(3):
+                    dx = p2[d] - p1[d]
+                    dx -= self.box[d] * round(dx / self.box[d])
+                    corner.append(p1[d] if dx >= 0.0 else p2[d])
+                    dist2 += dx * dx
+                self.assertLess(dist2, (cutoff + 1e-10) ** 2)
+                self.assertEqual(self.rank_of(corner), rank)
+
+        for pid1 in range(1, num_particles + 1):
+            for pid2 in range(pid1 + 1, num_particles + 1):
+                dist2 = 0.0
+                for d in range(3):
+                    dx = positions[pid2][d] - positions[pid1][d]
+                    dx -= self.box[d] * round(dx / self.box[d])
+                    dist2 += dx * dx
+                if dist2 < (cutoff - 1e-10) ** 2:
+                    self.assertIn((pid1, pid2), found)
+
+    def test_ghost_count(self):
+        total = {}
+        for eighth_shell in (False, True):
+            system, integrator, vl = setup_system(eighth_shell)
+            self.grids(system)
+            positions = folded_positions(system)
+            ghosts = system.storage.getNGhostParticles()
+            for rank, nghosts in enumerate(ghosts):
+                self.assertEqual(nghosts, self.expected_ghosts(rank, positions, eighth_shell))
+            total[eighth_shell] = sum(ghosts)
+        self.assertLess(total[True], total[False])
+
+    def test_pair_ownership(self):
+        system, integrator, vl = setup_system(True)
+        self.grids(system)
+        self.check_pairs(system, vl)
+
+        # particles crossed cell and CPU borders; decompose() resorts and rebuilds the list
+        integrator.run(200)
+        system.storage.decompose()
+        self.check_pairs(system, vl)
+
+    def test_fixed_lists_refused(self):
+        # a bond partner below the subdomain is not a ghost with eighth shell
+        system, integrator, vl = setup_system(True)
+        with self.assertRaises(RuntimeError):
+            espressopp.FixedPairList(system.storage)
+        with self.assertRaises(RuntimeError):
+            espressopp.FixedTripleList(system.storage)
+
+        # switching it on with a fixed list fails and keeps the full ghost frame
+        system, integrator, vl = setup_system(False)
+        fpl = espressopp.FixedPairList(system.storage)
+        fpl.addBonds([(1, 2)])
+        with self.assertRaises(RuntimeError):
+            system.storage.eighthShell = True
+        self.assertFalse(system.storage.eighthShell)
+        self.assertEqual(fpl.totalSize(), 1)
+        self.grids(system)
+        positions = folded_positions(system)
+        for rank, nghosts in enumerate(system.storage.getNGhostParticles()):
+            self.assertEqual(nghosts, self.expected_ghosts(rank, positions, False))
+
+if __name__ == '__main__':
+    unittest.main()
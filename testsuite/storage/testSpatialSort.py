@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+#  Copyright (C) 2021
+#      Max Planck Institute for Polymer Research & JGU Mainz
+#
+#  This file is part of ESPResSo++.
+#
+#  ESPResSo++ is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ESPResSo++ is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import unittest
+import espressopp
+
+num_particles = 12**3
+
+def setup_system(spatial_sort):
+    system, integrator, vl, interLJ = espressopp.standard_system.LennardJonesLattice(
+        num_particles, T=0.6, spatialSort=spatial_sort)
+    return system, integrator
+
+def morton_key(bins):
+    # interleave the bits of the three coordinates, x lowest
+    key = 0
+    for bit in range(21):
+        for d in range(3):
+            key |= ((bins[d] >> bit) & 1) << (3 * bit + d)
+    return key
+
+class TestSpatialSort(unittest.TestCase):
+    def memory_order(self, system):
+        # (cell key, particle key) of the real particles of every CPU in the order
+        # they are stored, the cell key is the cell index for grid order
+        box = system.bc.boxL
+        nodeGrid = system.storage.getNodeGrid()
+        cellGrid = system.storage.getCellGrid()
+        localBox = [box[d] / nodeGrid[d] for d in range(3)]
+        scale = [(1 << 21) / localBox[d] for d in range(3)]
+        frameGrid = [cellGrid[d] + 2 for d in range(3)]
+
+        orders = []
+        for rank, pids in enumerate(system.storage.getRealParticleIDs()):
+            node = (rank % nodeGrid[0], rank // nodeGrid[0] % nodeGrid[1],
+                    rank // (nodeGrid[0] * nodeGrid[1]))
+            left = [node[d] * localBox[d] for d in range(3)]
+            order = []
+            for pid in pids:
+                pos = system.storage.getParticle(pid).pos
+                # cell position in the grid with the ghost frame
+                cell = [int((pos[d] - left[d]) * cellGrid[d] / localBox[d]) + 1 for d in range(3)]
+                bins = [min(max(int((pos[d] - left[d]) * scale[d]), 0), (1 << 21) - 1) for d in range(3)]
+                index = cell[0] + frameGrid[0] * (cell[1] + frameGrid[1] * cell[2])
+                order.append((cell, index, morton_key(bins)))
+            orders.append(order)
+        return orders
+
+    def check_order(self, system, spatial_sort):
+        for order in self.memory_order(system):
+            for (cell0, index0, key0), (cell1, index1, key1) in zip(order[:-1], order[1:]):
+                if not spatial_sort:
+                    self.assertLessEqual(index0, index1)
+                elif cell0 == cell1:
+                    self.assertLessEqual(key0, key1)
+                else:
+                    self.assertLess(morton_key(cell0), morton_key(cell1))
+
+    def test_order(self):
+        for spatial_sort in (False, True):
+            system, integrator = setup_system(spatial_sort)
+            self.check_order(system, spatial_sort)
+
+            # the particles moved to other cells and CPUs, decompose() sorts again
+            integrator.run(100)
+            system.storage.decompose()
+            self.check_order(system, spatial_sort)
+
+    def test_switch(self):
+        # switching the flag on a filled storage takes effect with the next decompose()
+        system, integrator = setup_system(False)
+        system.storage.spatialSort = True
+        system.storage.decompose()
+        self.check_order(system, True)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -108,6 +108,126 @@ class TestVerletList(unittest.TestCase) :
 
         self.assertEqual(vl.totalSize(), N * N * N * 13)
 
+    def test1CSR(self) :
+        system = espressopp.System()
+
+        N    = 6
+        SIZE = float(N)
+        box  = Real3D(SIZE)
+        system.bc = espressopp.bc.OrthorhombicBC(None, box)
+        system.skin = 0.001
+
+        cutoff = 1.733
+        comm = espressopp.MPI.COMM_WORLD
+        nodeGrid = (1, 1, comm.size)
+        cellGrid = [calcNumberCells(SIZE, nodeGrid[i], cutoff) for i in range(3)]
+        system.storage = espressopp.storage.DomainDecomposition(system, nodeGrid, cellGrid)
+
+        pid = 0
+        for i in range(N):
+            for j in range(N):
+                for k in range(N):
+                    system.storage.addParticle(pid, Real3D(i + 0.5, j + 0.5, k + 0.5))
+                    pid = pid + 1
+        system.storage.decompose()
+
+        # the CSR layout has to hold exactly the same pairs
+        vl = espressopp.VerletList(system, math.sqrt(2.0), exclusionlist=[(0, 1)])
+        vlCSR = espressopp.VerletList(system, math.sqrt(2.0), exclusionlist=[(0, 1)], useCSR=True)
+
+        self.assertEqual(vlCSR.totalSize(), N * N * N * 9 - 1)
+        self.assertEqual(vlCSR.totalSize(), vl.totalSize())
+
+        pairs = set(frozenset(p) for pl in vl.getAllPairs() for p in pl)
+        pairsCSR = set(frozenset(p) for pl in vlCSR.getAllPairs() for p in pl)
+        self.assertEqual(pairs, pairsCSR)
+
+        # switching the layout rebuilds the list
+        vlCSR.useCSR = False
+        self.assertEqual(vlCSR.totalSize(), vl.totalSize())
+
+    def test2Exclusions(self) :
+        system = espressopp.System()
+
+        N    = 6
+        SIZE = float(N)
+        box  = Real3D(SIZE)
+        system.bc = espressopp.bc.OrthorhombicBC(None, box)
+        system.skin = 0.001
+
+        cutoff = 1.733
+        comm = espressopp.MPI.COMM_WORLD
+        nodeGrid = (1, 1, comm.size)
+        cellGrid = [calcNumberCells(SIZE, nodeGrid[i], cutoff) for i in range(3)]
+        system.storage = espressopp.storage.DomainDecomposition(system, nodeGrid, cellGrid)
+
+        pid = 0
+        for i in range(N):
+            for j in range(N):
+                for k in range(N):
+                    system.storage.addParticle(pid, Real3D(i + 0.5, j + 0.5, k + 0.5))
+                    pid = pid + 1
+        system.storage.decompose()
+
+        # chains along z with exclusions to the first and second neighbors, the
+        # second neighbors are beyond the cutoff and must not change anything
+        exclusions = []
+        for c in range(N * N):
+            for k in range(N - 1):
+                exclusions.append((c * N + k, c * N + k + 1))
+            for k in range(N - 2):
+                exclusions.append((c * N + k + 2, c * N + k))
+
+        for useBuffers in (True, False):
+            vl = espressopp.VerletList(system, math.sqrt(2.0), exclusionlist=exclusions, useBuffers=useBuffers)
+            self.assertEqual(vl.totalSize(), N * N * N * 9 - N * N * (N - 1))
+
+            pairs = set(frozenset(p) for pl in vl.getAllPairs() for p in pl)
+            for ex in exclusions:
+                self.assertNotIn(frozenset(ex), pairs)
+
+            # exclusions added later are picked up by the next rebuild
+            vl.exclude([(0, N)])
+            self.assertEqual(vl.totalSize(), N * N * N * 9 - N * N * (N - 1) - 1)
+
+    def test3SparseExclusions(self) :
+        system = espressopp.System()
+
+        N    = 6
+        SIZE = float(N)
+        box  = Real3D(SIZE)
+        system.bc = espressopp.bc.OrthorhombicBC(None, box)
+        system.skin = 0.001
+
+        cutoff = 1.733
+        comm = espressopp.MPI.COMM_WORLD
+        nodeGrid = (1, 1, comm.size)
+        cellGrid = [calcNumberCells(SIZE, nodeGrid[i], cutoff) for i in range(3)]
+        system.storage = espressopp.storage.DomainDecomposition(system, nodeGrid, cellGrid)
+
+        # ids far apart, the exclusions must not be indexed up to the largest one
+        stride = 10**9
+        pid = 0
+        for i in range(N):
+            for j in range(N):
+                for k in range(N):
+                    system.storage.addParticle(pid * stride, Real3D(i + 0.5, j + 0.5, k + 0.5))
+                    pid = pid + 1
+        system.storage.decompose()
+
+        exclusions = []
+        for c in range(N * N):
+            for k in range(N - 1):
+                exclusions.append(((c * N + k) * stride, (c * N + k + 1) * stride))
+
+        for useBuffers in (True, False):
+            vl = espressopp.VerletList(system, math.sqrt(2.0), exclusionlist=exclusions, useBuffers=useBuffers)
+            self.assertEqual(vl.totalSize(), N * N * N * 9 - N * N * (N - 1))
+
+            pairs = set(frozenset(p) for pl in vl.getAllPairs() for p in pl)
+            for ex in exclusions:
+                self.assertNotIn(frozenset(ex), pairs)
+
 
 
 if __name__ == "__main__":
@@ -22,10 +22,11 @@ import espressopp
 from espressopp.tools import readxyz
 import time
 
-def generate_md(use_vec=True, vec_mode=""):
+def generate_md(use_vec=True, vec_mode="", mixed=False, cluster=False, wca=False):
     print('{}USING VECTORIZATION'.format('NOT ' if not use_vec else ''))
     if use_vec:
-        print('MODE={}'.format(vec_mode))
+        print('MODE={}{}{}{}'.format(vec_mode, ' MIXED PRECISION' if mixed else '',
+                                     ' CLUSTER PAIRS' if cluster else '', ' WCA' if wca else ''))
     nsteps      = 1
     isteps      = 10
     #
@@ -36,6 +37,9 @@ def generate_md(use_vec=True, vec_mode=""):
     timestep    = 0.005
     epsilon     = 1.0
     sigma       = 1.0
+    # WCA is Lennard-Jones cut at the minimum and shifted
+    rc_pot      = 2.0**(1.0/6.0) if wca else rc
+    shift       = 'auto' if wca else 0
 
     # ensure deterministic trajectories
     temperature = None
@@ -45,9 +49,11 @@ def generate_md(use_vec=True, vec_mode=""):
     box = (Lx, Ly, Lz)
     num_particles = len(pid)
     system, integrator = espressopp.standard_system.Default(box=box, rc=rc, skin=skin, dt=timestep, temperature=temperature)
+    system.storage.spatialSort = cluster
 
     if use_vec:
         vec = espressopp.vectorization.Vectorization(system, integrator, mode=vec_mode)
+        vec.mixedPrecision = mixed
 
     props = ['id', 'type', 'mass', 'pos', 'v']
     new_particles = []
@@ -60,12 +66,13 @@ def generate_md(use_vec=True, vec_mode=""):
     # Lennard-Jones with Verlet list
     if use_vec:
         vl      = espressopp.vectorization.VerletList(system, vec, cutoff = rc)
+        vl.clusterPairs = cluster
         interLJ = espressopp.vectorization.interaction.VerletListLennardJones(vl)
-        potLJ   = espressopp.vectorization.interaction.LennardJones(epsilon=1.0, sigma=1.0, cutoff=rc, shift=0)
+        potLJ   = espressopp.vectorization.interaction.LennardJones(epsilon=1.0, sigma=1.0, cutoff=rc_pot, shift=shift)
     else:
         vl      = espressopp.VerletList(system, cutoff = rc)
         interLJ = espressopp.interaction.VerletListLennardJones(vl)
-        potLJ   = espressopp.interaction.LennardJones(epsilon=1.0, sigma=1.0, cutoff=rc, shift=0)
+        potLJ   = espressopp.interaction.LennardJones(epsilon=1.0, sigma=1.0, cutoff=rc_pot, shift=shift)
 
     interLJ.setPotential(type1=0, type2=0, potential=potLJ)
     system.addInteraction(interLJ)
@@ -122,5 +129,53 @@ class TestVectorization(unittest.TestCase):
         for d in diff:
             self.assertAlmostEqual(d,0.0,8)
 
+    def test2(self):
+        ''' Ensure that the mixed precision kernels stay close to the double precision run '''
+        print('-'*70)
+        pos0 = generate_md(True,'AOS',mixed=True)
+        print('-'*70)
+        pos1 = generate_md(True,'SOA',mixed=True)
+        print('-'*70)
+        pos2 = generate_md(False)
+        print('-'*70)
+
+        for pos in [pos0, pos1]:
+            self.assertEqual(len(pos), len(pos2))
+            diff = [(pos[i]-pos2[i]).sqr() for i in range(len(pos2))]
+            for d in diff:
+                self.assertAlmostEqual(d,0.0,6)
+
+    def test3(self):
+        ''' Ensure that the cluster pair kernels give the same positions as the non-vec version '''
+        print('-'*70)
+        pos0 = generate_md(True,'AOS',cluster=True)
+        print('-'*70)
+        pos1 = generate_md(True,'SOA',cluster=True)
+        print('-'*70)
+        pos2 = generate_md(False)
+        print('-'*70)
+
+        for pos in [pos0, pos1]:
+            self.assertEqual(len(pos), len(pos2))
+            diff = [(pos[i]-pos2[i]).sqr() for i in range(len(pos2))]
+            for d in diff:
+                self.assertAlmostEqual(d,0.0,8)
+
+    def test4(self):
+        ''' Ensure that the mixed precision kernels stay close to the double precision run for WCA '''
+        print('-'*70)
+        pos0 = generate_md(True,'AOS',mixed=True,wca=True)
+        print('-'*70)
+        pos1 = generate_md(True,'SOA',mixed=True,wca=True)
+        print('-'*70)
+        pos2 = generate_md(False,wca=True)
+        print('-'*70)
+
+        for pos in [pos0, pos1]:
+            self.assertEqual(len(pos), len(pos2))
+            diff = [(pos[i]-pos2[i]).sqr() for i in range(len(pos2))]
+            for d in diff:
+                self.assertAlmostEqual(d,0.0,6)
+
 if __name__ == "__main__":
     unittest.main()
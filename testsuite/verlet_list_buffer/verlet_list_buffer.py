@@ -85,6 +85,38 @@ def sort_pairs(pairs):
     pairs = sorted(pairs)
     return pairs
 
+def generate_md(skin, pruneBuffer, extension=True):
+    print('SKIN {} PRUNE BUFFER {}'.format(skin, pruneBuffer))
+    rc = 2.5
+
+    pid, type, xpos, ypos, zpos, xvel, yvel, zvel, Lx, Ly, Lz = readxyz("lennard_jones_fluid_10000.xyz")
+    num_particles = len(pid)
+
+    # NVE, the thermostat noise would depend on the cell grid
+    system, integrator = espressopp.standard_system.Default(box=(Lx, Ly, Lz), rc=rc, skin=skin, dt=0.005, temperature=None)
+
+    props = ['id', 'type', 'mass', 'pos', 'v']
+    new_particles = []
+    for i in range(num_particles):
+        new_particles.append([i + 1, 0, 1.0, espressopp.Real3D(xpos[i], ypos[i], zpos[i]), espressopp.Real3D(xvel[i], yvel[i], zvel[i])])
+    system.storage.addParticles(new_particles, *props)
+    system.storage.decompose()
+
+    vl      = espressopp.VerletList(system, cutoff = rc)
+    potLJ   = espressopp.interaction.LennardJones(epsilon=1.0, sigma=1.0, cutoff=rc, shift=0)
+    interLJ = espressopp.interaction.VerletListLennardJones(vl)
+    interLJ.setPotential(type1=0, type2=0, potential=potLJ)
+    system.addInteraction(interLJ)
+
+    if pruneBuffer > 0.0:
+        vl.pruneBuffer = pruneBuffer
+        if extension:
+            integrator.addExtension(espressopp.integrator.VerletListPruning(system, vl))
+
+    integrator.run(100)
+
+    return interLJ.computeEnergy(), vl.builds, vl.prunes
+
 class TestVerletListBuffer(unittest.TestCase):
     def test1vl(self):
         print('-'*70)
@@ -97,5 +129,43 @@ class TestVerletListBuffer(unittest.TestCase):
         for i in range(len(pairs1)):
             self.assertEqual(pairs1[i],pairs2[i])
 
+    def test2pruning(self):
+        # a large skin with a pruned inner list gives the same forces as a small skin
+        epot1, builds1, prunes1 = generate_md(0.3, 0.0)
+        epot2, builds2, prunes2 = generate_md(1.0, 0.3)
+
+        self.assertEqual(prunes1, 0)
+        self.assertGreater(prunes2, builds2)
+        self.assertLess(builds2, builds1)
+        self.assertAlmostEqual(epot1 / 10000, epot2 / 10000, places=6)
+
+    def test3noextension(self):
+        # without the pruning extension the inner list is never used
+        epot1, builds1, prunes1 = generate_md(1.0, 0.0)
+        epot2, builds2, prunes2 = generate_md(1.0, 0.3, extension=False)
+
+        self.assertEqual(prunes2, 0)
+        self.assertEqual(builds1, builds2)
+        self.assertAlmostEqual(epot1 / 10000, epot2 / 10000, places=6)
+
+    def test4disconnect(self):
+        system, integrator = espressopp.standard_system.LennardJones(1000, box=(10, 10, 10), rc=2.5, skin=1.0)
+        vl = espressopp.VerletList(system, cutoff=2.5)
+        vl.pruneBuffer = 0.3
+        npairs = vl.totalSize()
+
+        pruning = espressopp.integrator.VerletListPruning(system, vl)
+        integrator.addExtension(pruning)
+        self.assertGreater(vl.prunes, 0)
+        self.assertLess(vl.totalSize(), npairs)
+
+        # back to the full list once the extension is gone
+        pruning.disconnect()
+        self.assertEqual(vl.totalSize(), npairs)
+
+        # the buffer has to be smaller than the skin
+        with self.assertRaises(ValueError):
+            vl.pruneBuffer = 1.0
+
 if __name__ == "__main__":
     unittest.main()